@@ -0,0 +1,89 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2025 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_BASE_BINARY_HEAP_H
+#define LILY_BASE_BINARY_HEAP_H
+
+#include <base/macros.h>
+#include <base/types.h>
+
+#include <stdbool.h>
+
+/*
+    BinaryHeap<T>
+*/
+typedef struct BinaryHeap
+{
+    void **buffer; // void**?
+    Usize len;
+    Usize capacity;
+    // Return true if `lhs` must be popped before `rhs`.
+    bool (*cmp)(const void *lhs, const void *rhs);
+} BinaryHeap;
+
+/**
+ *
+ * @brief Construct BinaryHeap type.
+ * @param cmp Return true if `lhs` must be popped before `rhs` (e.g.
+ * `lhs > rhs` for a max heap).
+ */
+CONSTRUCTOR(BinaryHeap *,
+            BinaryHeap,
+            bool (*cmp)(const void *lhs, const void *rhs));
+
+/**
+ *
+ * @brief Check if the binary heap is empty.
+ */
+bool
+empty__BinaryHeap(const BinaryHeap *self);
+
+/**
+ *
+ * @brief Push an item to the binary heap in O(log n).
+ */
+void
+push__BinaryHeap(BinaryHeap *self, void *item);
+
+/**
+ *
+ * @brief Remove the first item (according to `cmp`) in O(log n).
+ */
+void *
+pop__BinaryHeap(BinaryHeap *self);
+
+/**
+ *
+ * @brief Get the first item (according to `cmp`) without removing it.
+ */
+void *
+peek__BinaryHeap(const BinaryHeap *self);
+
+/**
+ *
+ * @brief Free BinaryHeap type.
+ */
+DESTRUCTOR(BinaryHeap, BinaryHeap *self);
+
+#endif // LILY_BASE_BINARY_HEAP_H
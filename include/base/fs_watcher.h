@@ -53,8 +53,10 @@ CONSTRUCTOR(FsWatcher, FsWatcher, Int32 flags);
  * @brief Add to watch.
  * @param path directory or filename path.
  * @param mask On Linux see <sys/inotify.h> header (IN_MODIFY, IN_OPEN, ...).
+ * @return the watch descriptor, or -1 if the path can't be watched (e.g. it
+ * has been removed).
  */
-void
+Int32
 add__FsWatcher(FsWatcher *self, const char *path, Int32 mask);
 
 /**
@@ -68,7 +70,7 @@ get_fd__FsWatcher(const FsWatcher *self);
  *
  * @brief Free FsWatcher type.
  */
-DESTRUCTOR(FsWatcher, FsWatcher, const FsWatcher *self);
+DESTRUCTOR(FsWatcher, const FsWatcher *self);
 
 #else
 #warning "not yet implemented for this OS"
@@ -0,0 +1,85 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2025 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_BASE_JOBSERVER_H
+#define LILY_BASE_JOBSERVER_H
+
+#include <base/types.h>
+
+/*
+    Jobserver (client of the GNU make jobserver)
+
+    When the process runs under `make -jN` (or any tool which implements the
+    protocol), each thread started in addition to the calling thread must
+    first take a token from the jobserver, and give it back at its end, so
+    that the total number of jobs stays at N.
+*/
+
+/**
+ *
+ * @brief Connect to the jobserver described by the `--jobserver-auth` (or
+ * `--jobserver-fds`) option of MAKEFLAGS. The fifo form
+ * (`--jobserver-auth=fifo:PATH`) and the pipe form
+ * (`--jobserver-auth=R,W`) are supported.
+ * @param makeflags const char*? - The value of the MAKEFLAGS environment
+ * variable.
+ * @return true if the jobserver is connected.
+ * @note Without jobserver (or on an unsupported OS), the other functions do
+ * nothing.
+ */
+bool
+init__Jobserver(const char *makeflags);
+
+/**
+ *
+ * @brief Check if the jobserver is connected.
+ */
+bool
+is_active__Jobserver();
+
+/**
+ *
+ * @brief Try to take up to `wanted` tokens, without blocking.
+ * @return the number of taken tokens (always `wanted` without jobserver).
+ * @note The tokens which are still taken when the process exits are given
+ * back (e.g. on errors).
+ */
+Usize
+try_acquire__Jobserver(Usize wanted);
+
+/**
+ *
+ * @brief Give back the tokens taken with try_acquire__Jobserver.
+ */
+void
+release__Jobserver(Usize count);
+
+/**
+ *
+ * @brief Disconnect from the jobserver. All the tokens must be released.
+ */
+void
+close__Jobserver();
+
+#endif // LILY_BASE_JOBSERVER_H
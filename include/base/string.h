@@ -51,6 +51,14 @@
         FREE(String, s);         \
     }
 
+// NOTE: The String built from a string literal is built at compile time, so
+// it must never be modified nor freed.
+#define STRING_FROM_RAW(b)                                       \
+    (String)                                                     \
+    {                                                            \
+        .buffer = b, .len = sizeof(b) - 1, .capacity = sizeof(b) \
+    }
+
 typedef struct Vec Vec;
 
 typedef struct String
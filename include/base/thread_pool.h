@@ -0,0 +1,95 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2025 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_BASE_THREAD_POOL_H
+#define LILY_BASE_THREAD_POOL_H
+
+#include <base/macros.h>
+#include <base/types.h>
+
+/*
+    ThreadPool
+*/
+typedef struct ThreadPool
+{
+    Usize jobs; // Number of threads (the calling thread included).
+} ThreadPool;
+
+/**
+ *
+ * @brief Construct ThreadPool type.
+ * @param jobs If jobs is 0, the default number of jobs is used (see
+ * get_default_jobs__ThreadPool).
+ */
+CONSTRUCTOR(ThreadPool, ThreadPool, Usize jobs);
+
+/**
+ *
+ * @brief Get the default number of jobs. By default, it's the number of online
+ * processors.
+ */
+Usize
+get_default_jobs__ThreadPool();
+
+/**
+ *
+ * @brief Set the default number of jobs (e.g. from the command line).
+ * @param jobs If jobs is 0, the number of online processors is used.
+ */
+void
+set_default_jobs__ThreadPool(Usize jobs);
+
+/**
+ *
+ * @brief Reserve up to `wanted` threads (the calling thread excluded) for a
+ * nested run. The budget is shared by all the nested runs, so that the number
+ * of threads running at the same time is capped by the default number of jobs.
+ * Under a jobserver, a token is also taken for each reserved thread (see
+ * try_acquire__Jobserver).
+ * @return the number of reserved threads (can be 0).
+ */
+Usize
+reserve_jobs__ThreadPool(Usize wanted);
+
+/**
+ *
+ * @brief Release the threads reserved with reserve_jobs__ThreadPool.
+ */
+void
+release_jobs__ThreadPool(Usize jobs);
+
+/**
+ *
+ * @brief Run task(ctx, i) for each i in [0, len), and wait for all the tasks.
+ * @note The tasks are picked in the order of the indexes by the threads of the
+ * pool (the calling thread is one of them), so the tasks must not depend on
+ * each other. The threads are only created for the duration of the run.
+ */
+void
+run__ThreadPool(const ThreadPool *self,
+                Usize len,
+                void (*task)(void *ctx, Usize index),
+                void *ctx);
+
+#endif // LILY_BASE_THREAD_POOL_H
@@ -100,6 +100,16 @@
     push_str__String(res, " }");
 #endif
 
+// NOTE: The Vec built from a list of items is built at compile time (at file
+// scope), so it must never be modified nor freed.
+// e.g. VEC_FROM_RAW(2, a, b)
+#define VEC_FROM_RAW(n, ...)                                          \
+    (Vec)                                                             \
+    {                                                                 \
+        .buffer = (void *[]){ __VA_ARGS__ }, .len = n, .capacity = n, \
+        .default_capacity = n                                         \
+    }
+
 typedef struct String String;
 
 typedef struct Vec
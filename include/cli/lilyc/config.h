@@ -26,12 +26,14 @@
 #define LILY_CLI_LILYC_CONFIG_H
 
 #include <base/macros.h>
+#include <base/types.h>
 
 typedef struct LilycConfig
 {
     const char *filename;
     const char *target; // const char*?
     const char *output; // const char*?
+    const char *daemon; // const char*? - The socket of the compile server.
     bool build;
     bool run_scanner;
     bool run_preparser;
@@ -62,6 +64,8 @@ typedef struct LilycConfig
     bool oz; // Include -OSize
     bool verbose;
     bool run;
+    Usize jobs; // 0 for the default number of jobs
+    bool watch;
 } LilycConfig;
 
 /**
@@ -73,6 +77,7 @@ inline CONSTRUCTOR(LilycConfig,
                    const char *filename,
                    const char *target,
                    const char *output,
+                   const char *daemon,
                    bool build,
                    bool run_scanner,
                    bool run_preparser,
@@ -102,11 +107,14 @@ inline CONSTRUCTOR(LilycConfig,
                    bool o3,
                    bool oz,
                    bool verbose,
-                   bool run)
+                   bool run,
+                   Usize jobs,
+                   bool watch)
 {
     return (LilycConfig){ .filename = filename,
                           .target = target,
                           .output = output,
+                          .daemon = daemon,
                           .build = build,
                           .run_scanner = run_scanner,
                           .run_preparser = run_preparser,
@@ -136,7 +144,9 @@ inline CONSTRUCTOR(LilycConfig,
                           .o3 = o3,
                           .oz = oz,
                           .verbose = verbose,
-                          .run = run };
+                          .run = run,
+                          .jobs = jobs,
+                          .watch = watch };
 }
 
 #endif // LILY_CLI_LILYC_CONFIG_H
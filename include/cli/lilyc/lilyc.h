@@ -64,6 +64,9 @@
     CliOption *output = NEW(CliOption, "--output");                            \
     CliOption *verbose = NEW(CliOption, "--verbose");                          \
     CliOption *run = NEW(CliOption, "--run");                                  \
+    CliOption *jobs = NEW(CliOption, "--jobs");                                \
+    CliOption *watch = NEW(CliOption, "--watch");                              \
+    CliOption *daemon = NEW(CliOption, "--daemon");                            \
                                                                                \
     build->$help(build, "Build a package (exe, lib, ...)")                     \
       ->$short_name(build, "-b");                                              \
@@ -109,6 +112,16 @@
                NEW(CliValue, CLI_VALUE_KIND_SINGLE, "FILENAME", true));        \
     verbose->$help(verbose, "Enable log step of the compiler");                \
     run->$short_name(run, "-r")->$help(run, "Run the compiled file");          \
+    jobs->$short_name(jobs, "-j")                                              \
+      ->$help(jobs, "Set the maximum number of threads (<N>: 0 for all CPUs)") \
+      ->$value(jobs, NEW(CliValue, CLI_VALUE_KIND_SINGLE, "N", true));         \
+    watch->$short_name(watch, "-w")                                            \
+      ->$help(watch,                                                           \
+              "Rebuild in a new process when a source file changes (Linux "    \
+              "only)");                                                        \
+    daemon                                                                     \
+      ->$help(daemon, "Send the compilation to the compile server (lilyd)")    \
+      ->$value(daemon, NEW(CliValue, CLI_VALUE_KIND_SINGLE, "SOCKET", true));  \
                                                                                \
     self->$option(self, build)                                                 \
       ->$option(self, dump_scanner)                                            \
@@ -144,7 +157,10 @@
       ->$option(self, Oz)                                                      \
       ->$option(self, output)                                                  \
       ->$option(self, verbose)                                                 \
-      ->$option(self, run);
+      ->$option(self, run)                                                     \
+      ->$option(self, jobs)                                                    \
+      ->$option(self, watch)                                                   \
+      ->$option(self, daemon);
 
 Cli
 build__CliLilyc(Vec *args);
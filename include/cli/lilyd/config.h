@@ -0,0 +1,53 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2025 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_CLI_LILYD_CONFIG_H
+#define LILY_CLI_LILYD_CONFIG_H
+
+#include <base/macros.h>
+#include <base/types.h>
+
+typedef struct LilydConfig
+{
+    const char *socket_path;
+    Usize idle_timeout; // Seconds without request before exiting (0: never)
+    Usize max_memory;   // Bytes of memory of each compilation (0: no limit)
+} LilydConfig;
+
+/**
+ *
+ * @brief Construct LilydConfig type.
+ */
+inline CONSTRUCTOR(LilydConfig,
+                   LilydConfig,
+                   const char *socket_path,
+                   Usize idle_timeout,
+                   Usize max_memory)
+{
+    return (LilydConfig){ .socket_path = socket_path,
+                          .idle_timeout = idle_timeout,
+                          .max_memory = max_memory };
+}
+
+#endif // LILY_CLI_LILYD_CONFIG_H
@@ -0,0 +1,55 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2025 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_COMMAND_LILYD_H
+#define LILY_COMMAND_LILYD_H
+
+#include <base/vec.h>
+
+#include <cli/lilyd/config.h>
+
+/**
+ *
+ * @brief Run the compile server: load the resources of the compiler and
+ * create the LLVM target machines once (see warm__LilyIrLlvm), then wait for
+ * the compile requests (`lilyc --daemon <SOCKET> ...`) on the UNIX socket,
+ * until no request is received during the idle timeout.
+ * @note Each request is compiled in a forked process, which starts with the
+ * resources already loaded.
+ */
+void
+run__Lilyd(const LilydConfig *config);
+
+/**
+ *
+ * @brief Send a compile request to the compile server, and wait for the end
+ * of the compilation. The outputs of the compilation are written on the
+ * standard output and the standard error of the client.
+ * @param args Vec<char* (&)>* (&) - The arguments of lilyc.
+ * @return The exit status of the compilation.
+ */
+int
+send_request__Lilyd(const char *socket_path, const Vec *args);
+
+#endif // LILY_COMMAND_LILYD_H
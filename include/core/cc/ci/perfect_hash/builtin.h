@@ -0,0 +1,71 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2025 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// NOTE: This file is generated by `scripts/perfect_hash_generator.py`
+// from `src/core/cc/ci/builtin.c`. Don't edit it by hand.
+
+#ifndef LILY_CORE_CC_CI_PERFECT_HASH_BUILTIN_H
+#define LILY_CORE_CC_CI_PERFECT_HASH_BUILTIN_H
+
+#include <core/shared/search.h>
+
+// clang-format off
+
+// builtin_function_names: 5 keys, 3 buckets
+#define BUILTIN_FUNCTION_NAMES_PERFECT_HASH_KEYS_LEN 5
+
+static const Uint16 builtin_function_names_displacements[3] = {
+    0, 2, 2,
+};
+
+static const Uint16 builtin_function_names_indexes[5] = {
+    3, 1, 4, 0, 2,
+};
+
+static const SearchPerfectHash builtin_function_names_perfect_hash = {
+    .displacements = builtin_function_names_displacements,
+    .displacements_len = 3,
+    .indexes = builtin_function_names_indexes
+};
+
+// builtin_type_names: 1 keys, 1 buckets
+#define BUILTIN_TYPE_NAMES_PERFECT_HASH_KEYS_LEN 1
+
+static const Uint16 builtin_type_names_displacements[1] = {
+    0,
+};
+
+static const Uint16 builtin_type_names_indexes[1] = {
+    0,
+};
+
+static const SearchPerfectHash builtin_type_names_perfect_hash = {
+    .displacements = builtin_type_names_displacements,
+    .displacements_len = 1,
+    .indexes = builtin_type_names_indexes
+};
+
+// clang-format on
+
+#endif // LILY_CORE_CC_CI_PERFECT_HASH_BUILTIN_H
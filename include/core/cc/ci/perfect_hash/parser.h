@@ -0,0 +1,54 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2025 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// NOTE: This file is generated by `scripts/perfect_hash_generator.py`
+// from `src/core/cc/ci/parser.c`. Don't edit it by hand.
+
+#ifndef LILY_CORE_CC_CI_PERFECT_HASH_PARSER_H
+#define LILY_CORE_CC_CI_PERFECT_HASH_PARSER_H
+
+#include <core/shared/search.h>
+
+// clang-format off
+
+// ci_standard_attributes: 16 keys, 8 buckets
+#define CI_STANDARD_ATTRIBUTES_PERFECT_HASH_KEYS_LEN 16
+
+static const Uint16 ci_standard_attributes_displacements[8] = {
+    9, 3, 0, 0, 1, 19, 5, 22,
+};
+
+static const Uint16 ci_standard_attributes_indexes[16] = {
+    1, 15, 2, 0, 6, 7, 14, 9, 12, 4, 13, 5, 11, 3, 10, 8,
+};
+
+static const SearchPerfectHash ci_standard_attributes_perfect_hash = {
+    .displacements = ci_standard_attributes_displacements,
+    .displacements_len = 8,
+    .indexes = ci_standard_attributes_indexes
+};
+
+// clang-format on
+
+#endif // LILY_CORE_CC_CI_PERFECT_HASH_PARSER_H
@@ -0,0 +1,126 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2025 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// NOTE: This file is generated by `scripts/perfect_hash_generator.py`
+// from `src/core/cc/ci/scanner.c`. Don't edit it by hand.
+
+#ifndef LILY_CORE_CC_CI_PERFECT_HASH_SCANNER_H
+#define LILY_CORE_CC_CI_PERFECT_HASH_SCANNER_H
+
+#include <core/shared/search.h>
+
+// clang-format off
+
+// ci_keywords: 64 keys, 32 buckets
+#define CI_KEYWORDS_PERFECT_HASH_KEYS_LEN 64
+
+static const Uint16 ci_keywords_displacements[32] = {
+    2, 2, 3, 1, 10, 4, 0, 8, 0, 1, 17, 1, 9, 0, 0, 0, 3, 0, 17, 7, 0, 4, 0, 11,
+    11, 36, 54, 12, 35, 190, 0, 43,
+};
+
+static const Uint16 ci_keywords_indexes[64] = {
+    63, 62, 24, 18, 26, 30, 43, 55, 61, 12, 45, 49, 46, 51, 19, 29, 35, 5, 11,
+    37, 27, 13, 42, 39, 21, 41, 1, 25, 54, 2, 36, 44, 50, 32, 60, 9, 7, 33, 16,
+    40, 15, 10, 52, 17, 56, 57, 58, 6, 31, 38, 20, 8, 53, 14, 47, 59, 28, 23,
+    34, 3, 22, 48, 0, 4,
+};
+
+static const SearchPerfectHash ci_keywords_perfect_hash = {
+    .displacements = ci_keywords_displacements,
+    .displacements_len = 32,
+    .indexes = ci_keywords_indexes
+};
+
+// ci_attributes: 8 keys, 4 buckets
+#define CI_ATTRIBUTES_PERFECT_HASH_KEYS_LEN 8
+
+static const Uint16 ci_attributes_displacements[4] = {
+    4, 2, 1, 0,
+};
+
+static const Uint16 ci_attributes_indexes[8] = {
+    5, 1, 3, 4, 0, 6, 2, 7,
+};
+
+static const SearchPerfectHash ci_attributes_perfect_hash = {
+    .displacements = ci_attributes_displacements,
+    .displacements_len = 4,
+    .indexes = ci_attributes_indexes
+};
+
+// ci_builtin_macros: 1 keys, 1 buckets
+#define CI_BUILTIN_MACROS_PERFECT_HASH_KEYS_LEN 1
+
+static const Uint16 ci_builtin_macros_displacements[1] = {
+    0,
+};
+
+static const Uint16 ci_builtin_macros_indexes[1] = {
+    0,
+};
+
+static const SearchPerfectHash ci_builtin_macros_perfect_hash = {
+    .displacements = ci_builtin_macros_displacements,
+    .displacements_len = 1,
+    .indexes = ci_builtin_macros_indexes
+};
+
+// ci_standard_predefined_macros: 7 keys, 4 buckets
+#define CI_STANDARD_PREDEFINED_MACROS_PERFECT_HASH_KEYS_LEN 7
+
+static const Uint16 ci_standard_predefined_macros_displacements[4] = {
+    0, 0, 0, 0,
+};
+
+static const Uint16 ci_standard_predefined_macros_indexes[7] = {
+    3, 6, 4, 5, 0, 1, 2,
+};
+
+static const SearchPerfectHash ci_standard_predefined_macros_perfect_hash = {
+    .displacements = ci_standard_predefined_macros_displacements,
+    .displacements_len = 4,
+    .indexes = ci_standard_predefined_macros_indexes
+};
+
+// ci_preprocessors: 16 keys, 8 buckets
+#define CI_PREPROCESSORS_PERFECT_HASH_KEYS_LEN 16
+
+static const Uint16 ci_preprocessors_displacements[8] = {
+    0, 2, 1, 1, 0, 13, 31, 4,
+};
+
+static const Uint16 ci_preprocessors_indexes[16] = {
+    11, 6, 15, 9, 4, 0, 2, 12, 14, 3, 10, 7, 8, 13, 1, 5,
+};
+
+static const SearchPerfectHash ci_preprocessors_perfect_hash = {
+    .displacements = ci_preprocessors_displacements,
+    .displacements_len = 8,
+    .indexes = ci_preprocessors_indexes
+};
+
+// clang-format on
+
+#endif // LILY_CORE_CC_CI_PERFECT_HASH_SCANNER_H
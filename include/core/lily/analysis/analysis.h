@@ -79,10 +79,30 @@ init_module__LilyAnalysis(LilyAnalysis *self);
 /**
  *
  * @brief Run the analysis.
+ * @note All the declarations of the package are checked on each run. Between
+ * two builds, only a package whose object key changes is analyzed again (see
+ * get_key__LilyCompilerOutputCache).
  */
+// TODO: Check the declarations through memoized queries (signature of a
+// function, data type of a field, resolution of an operator, ...) with their
+// dependencies and fingerprints, persisted between two runs, so that only the
+// declarations whose inputs have changed are checked again, and only the MIR
+// and the LLVM IR of the affected functions are generated again. The checked
+// declarations are graphs of borrowed pointers into the AST, so they can't be
+// persisted yet.
 void
 run__LilyAnalysis(LilyAnalysis *self);
 
+/**
+ *
+ * @brief Check a function whose body has not been checked by the analysis
+ * (see has_lazy_fun_body__LilyPackage), e.g. to report the errors of a
+ * function which is not reachable from the main function.
+ * @note Like run__LilyAnalysis, exit if the function contains errors.
+ */
+void
+check_lazy_fun__LilyAnalysis(LilyAnalysis *self, LilyCheckedDecl *fun);
+
 /**
  *
  * @brief Free LilyAnalysis type.
@@ -524,11 +524,27 @@ IMPL_FOR_DEBUG(to_string,
                const LilyCheckedDataTypeLen *self);
 #endif
 
+// NOTE: The resolved data types are hash-consed in the table of the program
+// (see `include/core/lily/analysis/checked/data_type_table.h`). The table
+// owns one immutable node for each structure (its own `interned` node), which
+// is shared by all the threads. An interned data type keeps its location and
+// its reference count, but borrows the payload of its interned node, so it's
+// passed to ref instead of being cloned and compared by pointer.
 struct LilyCheckedDataType
 {
     enum LilyCheckedDataTypeKind kind;
     const Location *location; // const Location*? (&)
     Usize ref_count;
+    LilyCheckedDataType *interned; // LilyCheckedDataType*? (&)
+    // NOTE: only set on the data types with a payload built at compile time
+    // (see LILY_CHECKED_STATIC_DATA_TYPE), which are never counted nor freed.
+    bool is_static;
+    // NOTE: only set on the nodes of the table.
+    Uint64 hash;
+    // NOTE: only set on the nodes of the table. This value indicates if two
+    // data types are equal (see eq__LilyCheckedDataType) only if they have
+    // the same structure (e.g. `mut T` is equal to `T`).
+    bool has_exact_eq;
     // NOTE: only using for compiler choice data type
     // (`LILY_CHECKED_DATA_TYPE_KIND_COMPILER_CHOICE` and
     // `LILY_CHECKED_DATA_TYPE_KIND_CONDITIONAL_COMPILER_CHOICE`). By default,
@@ -564,6 +580,30 @@ struct LilyCheckedDataType
     };
 };
 
+// NOTE: The primitive data types (without payload) are built at compile time.
+// They're the nodes of the primitive data types in all the tables of the
+// interned data types, so they're shared by all the programs, and they're
+// never counted nor freed. The slots of the other kinds are empty.
+extern LilyCheckedDataType
+  lily_checked_primitive_data_types[LILY_CHECKED_DATA_TYPE_KIND_UNKNOWN];
+
+#define LILY_CHECKED_PRIMITIVE_DATA_TYPE(k) \
+    (&lily_checked_primitive_data_types[LILY_CHECKED_DATA_TYPE_KIND_##k])
+
+// NOTE: Build a data type with a data type as payload (e.g. `*Any`) at compile
+// time. Like the primitive data types, it's never counted nor freed, but it's
+// not a node of a table of the interned data types, so it's compared by
+// structure (and interned like any other data type).
+// e.g.
+// static LilyCheckedDataType ptr_any = LILY_CHECKED_STATIC_DATA_TYPE(
+//   PTR, ptr, LILY_CHECKED_PRIMITIVE_DATA_TYPE(ANY));
+#define LILY_CHECKED_STATIC_DATA_TYPE(k, variant, data_type)       \
+    {                                                              \
+        .kind = LILY_CHECKED_DATA_TYPE_KIND_##k, .location = NULL, \
+        .ref_count = 0, .interned = NULL, .is_static = true,       \
+        .is_lock = true, .variant = data_type                      \
+    }
+
 /**
  *
  * @brief Construct LilyCheckedDataType type.
@@ -573,6 +613,14 @@ CONSTRUCTOR(LilyCheckedDataType *,
             enum LilyCheckedDataTypeKind kind,
             const Location *location);
 
+/**
+ *
+ * @brief Get the primitive data type of the kind (built at compile time).
+ * @return LilyCheckedDataType* (&)? (NULL if the kind isn't primitive)
+ */
+LilyCheckedDataType *
+get_primitive__LilyCheckedDataType(enum LilyCheckedDataTypeKind kind);
+
 /**
  *
  * @brief Construct LilyCheckedDataType type
@@ -782,6 +830,8 @@ VARIANT_CONSTRUCTOR(LilyCheckedDataType *,
 /**
  *
  * @brief Return true if the both data types are equal otherwise return false.
+ * @note The interned data types with an exact equality are compared by
+ * pointer.
  */
 bool
 eq__LilyCheckedDataType(LilyCheckedDataType *self, LilyCheckedDataType *other);
@@ -789,6 +839,8 @@ eq__LilyCheckedDataType(LilyCheckedDataType *self, LilyCheckedDataType *other);
 /**
  *
  * @brief Return true if the both data types are equal otherwise return false.
+ * @note The interned data types with an exact equality are compared by
+ * pointer.
  */
 bool
 eq_return_data_type__LilyCheckedDataType(LilyCheckedDataType *self,
@@ -808,6 +860,8 @@ get_return_data_type_of_conditional_compiler_choice(
 /**
  *
  * @brief Clone LilyCheckedDataType type.
+ * @note An interned data type is not cloned but passed to ref, so its
+ * location must not be changed by the owner of the clone.
  */
 LilyCheckedDataType *
 clone__LilyCheckedDataType(LilyCheckedDataType *self);
@@ -947,10 +1001,36 @@ is_unknown_data_type__LilyCheckedDataType(LilyCheckedDataType *self)
 inline LilyCheckedDataType *
 ref__LilyCheckedDataType(LilyCheckedDataType *self)
 {
-    ++self->ref_count;
+    // NOTE: The nodes of the table and the static data types are never freed
+    // by the packages (and they are shared by all the threads), so they are
+    // not counted.
+    if (self->interned != self && !self->is_static) {
+        ++self->ref_count;
+    }
+
     return self;
 }
 
+/**
+ *
+ * @brief Check if the data type can be interned: it's resolved (it doesn't
+ * contain unknown data type, compiler choice, compiler generic or array of
+ * unknown kind) and immutable after its analysis (it doesn't contain custom
+ * data type or result data type).
+ */
+bool
+is_internable__LilyCheckedDataType(const LilyCheckedDataType *self);
+
+/**
+ *
+ * @brief Free the payload of the data type, to borrow the payload of the
+ * interned node.
+ * @param interned LilyCheckedDataType* (&)
+ */
+void
+set_interned__LilyCheckedDataType(LilyCheckedDataType *self,
+                                  LilyCheckedDataType *interned);
+
 /**
  *
  * @brief Resolve generic data type. If the resolve of the generic data type
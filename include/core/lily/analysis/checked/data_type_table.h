@@ -0,0 +1,77 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2025 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_CORE_LILY_ANALYSIS_CHECKED_DATA_TYPE_TABLE_H
+#define LILY_CORE_LILY_ANALYSIS_CHECKED_DATA_TYPE_TABLE_H
+
+#include <base/macros.h>
+#include <base/types.h>
+
+#include <core/lily/analysis/checked/data_type.h>
+
+#include <pthread.h>
+
+#define LILY_CHECKED_DATA_TYPE_TABLE_DEFAULT_CAPACITY 256
+
+// NOTE: The table of the interned data types of the program (hash-consing):
+// each node of the table is immutable, and its children are nodes of the
+// table, so two structurally equal data types have the same node. The table
+// is shared by all the packages of the program, which are analyzed by several
+// threads.
+// TODO: add support for Windows.
+typedef struct LilyCheckedDataTypeTable
+{
+    // NOTE: The nodes are stored with open addressing, and the capacity is
+    // always a power of 2.
+    LilyCheckedDataType **nodes; // LilyCheckedDataType*?*
+    Usize capacity;
+    Usize len;
+    pthread_mutex_t mutex;
+} LilyCheckedDataTypeTable;
+
+/**
+ *
+ * @brief Construct LilyCheckedDataTypeTable type.
+ */
+CONSTRUCTOR(LilyCheckedDataTypeTable *, LilyCheckedDataTypeTable);
+
+/**
+ *
+ * @brief Intern the data type, if it can be interned (see
+ * is_internable__LilyCheckedDataType). The data type keeps its location, but
+ * its payload is replaced by the payload of its node in the table.
+ * @return LilyCheckedDataType* (the given data type)
+ */
+LilyCheckedDataType *
+intern__LilyCheckedDataTypeTable(LilyCheckedDataTypeTable *self,
+                                 LilyCheckedDataType *data_type);
+
+/**
+ *
+ * @brief Free LilyCheckedDataTypeTable type.
+ * @note All the interned data types must be freed before the table.
+ */
+DESTRUCTOR(LilyCheckedDataTypeTable, LilyCheckedDataTypeTable *self);
+
+#endif // LILY_CORE_LILY_ANALYSIS_CHECKED_DATA_TYPE_TABLE_H
@@ -31,6 +31,8 @@
 
 #include <core/lily/analysis/checked/data_type.h>
 
+#include <stdatomic.h>
+
 #define DEFAULT_OPERATORS_COUNT 663
 
 typedef struct LilyCheckedOperator
@@ -39,7 +41,9 @@ typedef struct LilyCheckedOperator
                     // [params, return_data_type]
     Vec *signature; // Vec<LilyCheckedDataType* (&)>* (&)
     bool is_default;
-    Usize ref_count;
+    // NOTE: The default operators are built at compile time, so they're
+    // never counted nor freed.
+    atomic_size_t ref_count;
 } LilyCheckedOperator;
 
 /**
@@ -59,7 +63,7 @@ CONSTRUCTOR(LilyCheckedOperator *,
 inline LilyCheckedOperator *
 ref__LilyCheckedOperator(LilyCheckedOperator *self)
 {
-    ++self->ref_count;
+    atomic_fetch_add(&self->ref_count, 1);
     return self;
 }
 
@@ -72,10 +76,12 @@ valid_operator__LilyCheckedOperator(String *name);
 
 /**
  *
- * @brief Load default operators.
+ * @brief Get the default operators with the given name (built at compile
+ * time).
+ * @return const Vec*? (&) // const Vec<LilyCheckedOperator* (&)>*?
  */
-LilyCheckedOperator **
-load_default_operators__LilyCheckedOperator();
+const Vec *
+get_default_operators__LilyCheckedOperator(char *name);
 
 /**
  *
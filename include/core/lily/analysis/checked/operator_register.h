@@ -25,11 +25,73 @@
 #ifndef LILY_CORE_LILY_ANALYSIS_CHECKED_OPERATOR_REGISTER_H
 #define LILY_CORE_LILY_ANALYSIS_CHECKED_OPERATOR_REGISTER_H
 
+#include <base/hash_map.h>
+
 #include <core/lily/analysis/checked/operator.h>
 
+#include <pthread.h>
+
+// NOTE: The operators resolved for a pair of interned operands (see
+// data_type_table.h), before the filter on the return data type.
+typedef struct LilyCheckedOperatorResolution
+{
+    const LilyCheckedDataType *left;  // const LilyCheckedDataType* (&)
+    const LilyCheckedDataType *right; // const LilyCheckedDataType* (&)
+    Vec *operators;                   // Vec<LilyCheckedOperator* (&)>*
+} LilyCheckedOperatorResolution;
+
+/**
+ *
+ * @brief Construct LilyCheckedOperatorResolution type.
+ */
+CONSTRUCTOR(LilyCheckedOperatorResolution *,
+            LilyCheckedOperatorResolution,
+            const LilyCheckedDataType *left,
+            const LilyCheckedDataType *right,
+            Vec *operators);
+
+/**
+ *
+ * @brief Free LilyCheckedOperatorResolution type.
+ */
+DESTRUCTOR(LilyCheckedOperatorResolution, LilyCheckedOperatorResolution *self);
+
+// NOTE: All the operators with the same name (the default operators, then the
+// operators of the package).
+typedef struct LilyCheckedOperatorRegisterEntry
+{
+    Vec *operators;   // Vec<LilyCheckedOperator* (&)>*
+    Vec *resolutions; // Vec<LilyCheckedOperatorResolution*>*
+} LilyCheckedOperatorRegisterEntry;
+
+/**
+ *
+ * @brief Construct LilyCheckedOperatorRegisterEntry type.
+ * @param default_operators const Vec<LilyCheckedOperator* (&)>*? (&)
+ */
+CONSTRUCTOR(LilyCheckedOperatorRegisterEntry *,
+            LilyCheckedOperatorRegisterEntry,
+            const Vec *default_operators);
+
+/**
+ *
+ * @brief Free LilyCheckedOperatorRegisterEntry type.
+ */
+DESTRUCTOR(LilyCheckedOperatorRegisterEntry,
+           LilyCheckedOperatorRegisterEntry *self);
+
 typedef struct LilyCheckedOperatorRegister
 {
     Vec *operators; // Vec<LilyCheckedOperator*>*
+    // NOTE: The operators are indexed by name, to avoid looking through all
+    // the default operators for each expression. The default operators are
+    // built at compile time (see get_default_operators__LilyCheckedOperator),
+    // so an entry is only created for a name which is extended by the package
+    // or whose resolutions are cached.
+    HashMap *index; // HashMap<LilyCheckedOperatorRegisterEntry*>*
+    // NOTE: Guards the operators, the index and the cached resolutions, which
+    // are lazily written by the lookups.
+    pthread_mutex_t mutex;
 } LilyCheckedOperatorRegister;
 
 /**
@@ -38,7 +100,9 @@ typedef struct LilyCheckedOperatorRegister
  */
 inline CONSTRUCTOR(LilyCheckedOperatorRegister, LilyCheckedOperatorRegister)
 {
-    return (LilyCheckedOperatorRegister){ .operators = NEW(Vec) };
+    return (LilyCheckedOperatorRegister){ .operators = NEW(Vec),
+                                          .index = NEW(HashMap),
+                                          .mutex = PTHREAD_MUTEX_INITIALIZER };
 }
 
 /**
@@ -56,7 +120,7 @@ add_operator__LilyCheckedOperatorRegister(LilyCheckedOperatorRegister *self,
  */
 LilyCheckedOperator *
 search_operator__LilyCheckedOperatorRegister(
-  const LilyCheckedOperatorRegister *self,
+  LilyCheckedOperatorRegister *self,
   char *name,
   Vec *signature);
 
@@ -67,10 +131,24 @@ search_operator__LilyCheckedOperatorRegister(
  */
 Vec *
 collect_all_operators__LilyCheckedOperatorRegister(
-  const LilyCheckedOperatorRegister *self,
+  LilyCheckedOperatorRegister *self,
   char *name,
   Usize signature_len);
 
+/**
+ *
+ * @brief Collect all binary operators with the given name, whose operands
+ * match the left and the right data types.
+ * @note The resolution is cached when the both data types are interned.
+ * @return Vec<LilyCheckedOperator* (&)>*
+ */
+Vec *
+collect_binary_operators__LilyCheckedOperatorRegister(
+  LilyCheckedOperatorRegister *self,
+  char *name,
+  LilyCheckedDataType *left,
+  LilyCheckedDataType *right);
+
 /**
  *
  * @brief Generate compiler choice according to the operator collection.
@@ -111,7 +189,6 @@ typecheck_binary__LilyCheckedOperatorRegister(
  *
  * @brief Free LilyCheckedOperatorRegister type.
  */
-DESTRUCTOR(LilyCheckedOperatorRegister,
-           const LilyCheckedOperatorRegister *self);
+DESTRUCTOR(LilyCheckedOperatorRegister, LilyCheckedOperatorRegister *self);
 
 #endif // LILY_CORE_LILY_ANALYSIS_CHECKED_OPERATOR_REGISTER_H
@@ -36,7 +36,10 @@
 #include <core/lily/analysis/checked/scope_response.h>
 #include <core/lily/shared/visibility.h>
 
+#include <pthread.h>
+
 typedef struct LilyCheckedParent LilyCheckedParent;
+typedef struct LilyCheckedScope LilyCheckedScope;
 typedef struct LilyCheckedStmtVariable LilyCheckedStmtVariable;
 typedef struct LilyCheckedBodyFunItem LilyCheckedBodyFunItem;
 
@@ -78,30 +81,117 @@ inline DESTRUCTOR(LilyCheckedScopeCatch, LilyCheckedScopeCatch *self)
     lily_free(self);
 }
 
+enum LilyCheckedScopeSymbolKind
+{
+    LILY_CHECKED_SCOPE_SYMBOL_KIND_ALIAS,
+    LILY_CHECKED_SCOPE_SYMBOL_KIND_CAPTURED_VARIABLE,
+    LILY_CHECKED_SCOPE_SYMBOL_KIND_CLASS,
+    LILY_CHECKED_SCOPE_SYMBOL_KIND_CONSTANT,
+    LILY_CHECKED_SCOPE_SYMBOL_KIND_ENUM,
+    LILY_CHECKED_SCOPE_SYMBOL_KIND_ENUM_OBJECT,
+    LILY_CHECKED_SCOPE_SYMBOL_KIND_ERROR,
+    LILY_CHECKED_SCOPE_SYMBOL_KIND_FUN,
+    LILY_CHECKED_SCOPE_SYMBOL_KIND_GENERIC,
+    LILY_CHECKED_SCOPE_SYMBOL_KIND_LABEL,
+    LILY_CHECKED_SCOPE_SYMBOL_KIND_MODULE,
+    LILY_CHECKED_SCOPE_SYMBOL_KIND_PARAM,
+    LILY_CHECKED_SCOPE_SYMBOL_KIND_RECORD,
+    LILY_CHECKED_SCOPE_SYMBOL_KIND_RECORD_OBJECT,
+    LILY_CHECKED_SCOPE_SYMBOL_KIND_TRAIT,
+    // NOTE: The fields of a record and the variants of an enum are also
+    // registered as variable in the scope of their declaration.
+    LILY_CHECKED_SCOPE_SYMBOL_KIND_VARIABLE,
+    LILY_CHECKED_SCOPE_SYMBOL_KIND_COUNT
+};
+
+static_assert(LILY_CHECKED_SCOPE_SYMBOL_KIND_COUNT <= 32,
+              "the kinds of a symbol must fit in a Uint32");
+
+#define LILY_CHECKED_SCOPE_SYMBOL_KIND_BIT(k) \
+    ((Uint32)1 << LILY_CHECKED_SCOPE_SYMBOL_KIND_##k)
+
+// NOTE: All the declarations of a scope sharing the same name are gathered in
+// one symbol, so a name is looked up once whatever the kind searched, and the
+// conflicts between two kinds are checked on the bitset of the symbol.
+typedef struct LilyCheckedScopeSymbol
+{
+    String *name; // String* (&)
+    Uint32 kinds; // bitset of enum LilyCheckedScopeSymbolKind
+    // LilyCheckedScopeContainer<Kind>*? indexed by
+    // enum LilyCheckedScopeSymbolKind
+    void *containers[LILY_CHECKED_SCOPE_SYMBOL_KIND_COUNT];
+} LilyCheckedScopeSymbol;
+
+/**
+ *
+ * @brief Construct LilyCheckedScopeSymbol type.
+ */
+CONSTRUCTOR(LilyCheckedScopeSymbol *, LilyCheckedScopeSymbol, String *name);
+
+/**
+ *
+ * @brief Convert LilyCheckedScopeSymbol in String.
+ * @note This function is only used to debug.
+ */
+#ifdef ENV_DEBUG
+String *
+IMPL_FOR_DEBUG(to_string,
+               LilyCheckedScopeSymbol,
+               const LilyCheckedScopeSymbol *self);
+#endif
+
+/**
+ *
+ * @brief Free LilyCheckedScopeSymbol type.
+ */
+DESTRUCTOR(LilyCheckedScopeSymbol, LilyCheckedScopeSymbol *self);
+
+// NOTE: Remember in which scope an identifier has been resolved the last time
+// it was searched from a given scope. The resolution stays valid as long as
+// no symbol has been added in the tree of scopes since (see the `version` of
+// the root scope).
+typedef struct LilyCheckedScopeResolution
+{
+    String *name;            // String*
+    LilyCheckedScope *scope; // LilyCheckedScope*? (&)
+    Usize version;
+} LilyCheckedScopeResolution;
+
+/**
+ *
+ * @brief Construct LilyCheckedScopeResolution type.
+ * @param scope LilyCheckedScope*? (&)
+ */
+CONSTRUCTOR(LilyCheckedScopeResolution *,
+            LilyCheckedScopeResolution,
+            const String *name,
+            LilyCheckedScope *scope,
+            Usize version);
+
+/**
+ *
+ * @brief Free LilyCheckedScopeResolution type.
+ */
+inline DESTRUCTOR(LilyCheckedScopeResolution, LilyCheckedScopeResolution *self)
+{
+    FREE(String, self->name);
+    lily_free(self);
+}
+
 typedef struct LilyCheckedScope
 {
     Usize id;
     HashMap *raises;              // HashMap<LilyCheckedDataType*>*?
     LilyCheckedScopeCatch *catch; // LilyCheckedScopeCatch*?
-    HashMap *
-      captured_variables; // HashMap<LilyCheckedScopeContainerCapturedVariable*>*?
-    HashMap *modules;     // HashMap<LilyCheckedScopeContainerModule*>*?
-    HashMap *constants;   // HashMap<LilyCheckedScopeContainerConstant*>*?
-    HashMap *enums;       // HashMap<LilyCheckedScopeContainerEnum*>*?
-    HashMap *records;     // HashMap<LilyCheckedScopeContainerRecord*>*?
-    HashMap *aliases;     // HashMap<LilyCheckedScopeContainerAlias*>*?
-    HashMap *errors;      // HashMap<LilyCheckedScopeContainerError*>*?
-    HashMap *enums_object; // HashMap<LilyCheckedScopeContainerEnumObject*>*?
-    HashMap
-      *records_object;  // HashMap<LilyCheckedScopeContainerRecordObject*>*?
-    HashMap *classes;   // HashMap<LilyCheckedScopeContainerClass*>*?
-    HashMap *traits;    // HashMap<LilyCheckedScopeContainerTrait*>*?
-    Vec *funs;          // Vec<LilyCheckedScopeContainerFun*>*?
-    HashMap *labels;    // HashMap<LilyCheckedScopeContainerLabel*>*?
-    HashMap *variables; // HashMap<LilyCheckedScopeContainerVariable*>*?
-    HashMap *params;    // HashMap<LilyCheckedScopeContainerVariable*>*?
-    HashMap *generics;  // HashMap<LilyCheckedScopeContainerGeneric*>*?
-    Vec *methods;       // Vec<LilyCheckedScopeContainerMethod*>*?
+    HashMap *symbols;             // HashMap<LilyCheckedScopeSymbol*>*?
+    HashMap *resolutions;   // HashMap<LilyCheckedScopeResolution*>*?
+    LilyCheckedScope *root; // LilyCheckedScope* (&)
+    // NOTE: Only used by the root scope, incremented each time a symbol is
+    // added to a scope of the tree (or a catch name is set).
+    Usize version;
+    // NOTE: Only used by the root scope. Guards the resolutions and the
+    // version of the tree.
+    pthread_mutex_t mutex;
     LilyCheckedParent *parent; // LilyCheckedParent*?
     LilyCheckedScopeDecls decls;
     bool has_return;
@@ -393,6 +483,8 @@ search_variant__LilyCheckedScope(LilyCheckedScope *self, const String *name);
 /**
  *
  * @brief Search an identifier in the scope.
+ * @note The scope where the identifier has been found (or not found) is
+ * remembered until a new symbol is added to the tree of scopes.
  */
 LilyCheckedScopeResponse
 search_identifier__LilyCheckedScope(LilyCheckedScope *self, const String *name);
@@ -441,6 +441,10 @@ typedef struct LilyCheckedScopeContainerFun
     String *name; // String* (&)
     // overload of function
     Vec *ids; // Vec<Usize*>*
+    // NOTE: The declarations of the overloads are resolved lazily from `ids`
+    // the first time the fun is searched (and when an overload has been
+    // pushed since), so the response of the search doesn't allocate.
+    Vec *decls; // Vec<LilyCheckedDecl* (&)>*
 } LilyCheckedScopeContainerFun;
 
 /**
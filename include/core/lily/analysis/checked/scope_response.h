@@ -119,7 +119,7 @@ typedef struct LilyCheckedScopeResponse
           *record_object;                   // LilyCheckedDeclRecordObject* (&)
         LilyCheckedDeclClass *class;        // LilyCheckedDeclClass* (&)
         LilyCheckedDeclTrait *trait;        // LilyCheckedDeclTrait* (&)
-        Vec *fun;                           // Vec<LilyCheckedDecl* (&)>*
+        Vec *fun;                           // Vec<LilyCheckedDecl* (&)>* (&)
         LilyCheckedStmtVariable *variable;  // LilyCheckedStmtVariable* (&)
         LilyCheckedDeclFunParam *fun_param; // LilyCheckedDeclFunParam* (&)
         LilyCheckedDeclMethodParam
@@ -478,6 +478,7 @@ inline VARIANT_CONSTRUCTOR(LilyCheckedScopeResponse,
  *
  * @brief Construct LilyCheckedScopeResponse type
  * (LILY_CHECKED_SCOPE_RESPONSE_KIND_FUN).
+ * @param fun Vec<LilyCheckedDecl* (&)>* (&)
  */
 inline VARIANT_CONSTRUCTOR(LilyCheckedScopeResponse,
                            LilyCheckedScopeResponse,
@@ -597,18 +598,4 @@ inline VARIANT_CONSTRUCTOR(LilyCheckedScopeResponse,
     };
 }
 
-/**
- *
- * @brief Free LilyCheckedScopeResponse type.
- * @note The destructor is only needed to call when kind is equal to
- * LILY_CHECKED_SCOPE_RESPONSE_KIND_FUN.
- */
-inline DESTRUCTOR(LilyCheckedScopeResponse,
-                  const LilyCheckedScopeResponse *self)
-{
-    if (self->kind == LILY_CHECKED_SCOPE_RESPONSE_KIND_FUN) {
-        FREE(Vec, self->fun);
-    }
-}
-
 #endif // LILY_CORE_LILY_ANALYSIS_CHECKED_SCOPE_RESPONSE_H
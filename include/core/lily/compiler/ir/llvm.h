@@ -49,8 +49,8 @@ extern "C"
         LLVMTargetMachineRef machine;
         LLVMMetadataRef file;
         LLVMMetadataRef compile_unit;
-        char *cpu;
-        char *features;
+        const char *cpu;      // const char* (&)
+        const char *features; // const char* (&)
         Usize cpu_len;
         Usize features_len;
     } LilyIrLlvm;
@@ -58,8 +58,37 @@ extern "C"
     /**
      *
      * @brief Construct LilyIrLlvm type.
+     * @param is_pic Generate position independent code (e.g. for the objects
+     * of a dynamic library).
      */
-    CONSTRUCTOR(LilyIrLlvm, LilyIrLlvm, const char *module_name);
+    CONSTRUCTOR(LilyIrLlvm, LilyIrLlvm, const char *module_name, bool is_pic);
+
+    /**
+     *
+     * @brief Initialize LLVM (targets, asm printers, ...), if it's not
+     * already initialized.
+     * @note This function is called by the constructor of LilyIrLlvm, but the
+     * compile server (lilyd) calls it in advance, so that each compilation
+     * (forked from the server) starts with LLVM initialized.
+     */
+    void init__LilyIrLlvm();
+
+    /**
+     *
+     * @brief Initialize LLVM, then create in advance `machines` target
+     * machines for the host (default relocation model), with their subtarget.
+     * @note The constructor of LilyIrLlvm takes these target machines before
+     * creating new ones. This is used by the compile server (lilyd) and by the
+     * watch mode of lilyc, which fork a process for each compilation.
+     */
+    void warm__LilyIrLlvm(Usize machines);
+
+    /**
+     *
+     * @brief Dispose the target machines created by warm__LilyIrLlvm and not
+     * yet taken.
+     */
+    void destroy_warm__LilyIrLlvm();
 
     /**
      *
@@ -79,6 +108,16 @@ extern "C"
      */
     void LilyLLVMRemoveFatalErrorHandler();
 
+    /**
+     *
+     * @brief Create the subtarget of the target machine for the functions
+     * with the given `target-cpu` and `target-features` attributes (see
+     * ADD_CUSTOM_HOST_ATTR). The target machine caches the subtarget.
+     */
+    void LilyLLVMWarmMachine(LLVMTargetMachineRef machine,
+                             const char *cpu,
+                             const char *features);
+
 #ifdef __cplusplus
 }
 #endif
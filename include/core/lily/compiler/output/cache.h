@@ -27,19 +27,24 @@
 
 #include <base/macros.h>
 #include <base/platform.h>
+#include <base/types.h>
 
 #ifdef LILY_WINDOWS_OS
 #define DIR_CACHE_NAME "out.lily\\"
 #define DIR_CACHE_BIN DIR_CACHE_NAME "bin\\"
 #define DIR_CACHE_LIB DIR_CACHE_NAME "lib\\"
 #define DIR_CACHE_OBJ DIR_CACHE_NAME "obj\\"
+#define DIR_CACHE_OBJ_EXT ".obj"
 #else
 #define DIR_CACHE_NAME "out.lily/"
 #define DIR_CACHE_BIN DIR_CACHE_NAME "bin/"
 #define DIR_CACHE_LIB DIR_CACHE_NAME "lib/"
 #define DIR_CACHE_OBJ DIR_CACHE_NAME "obj/"
+#define DIR_CACHE_OBJ_EXT ".o"
 #endif
 
+typedef struct LilyPackage LilyPackage;
+
 /**
  *
  * @brief Create cache.
@@ -48,9 +53,53 @@
  * out.lily/
  * ├── bin
  * ├── lib
- * └── obj
+ * ├── obj (see get_obj_path__LilyCompilerOutputCache)
+ * └── timings (see LilyCompilerOutputTimings)
  */
 void
 create_cache__LilyCompilerOutputCache();
 
+/**
+ *
+ * @brief Get the key of the object of the package, without its dependencies.
+ * The key is the hash of everything which changes the object: the source and
+ * the global name of the package, its status, the optimization level, the
+ * target, the relocation model, the version and the build of the compiler.
+ * @note The keys of the dependencies must be added with
+ * add_dependency_key__LilyCompilerOutputCache.
+ */
+Usize
+get_key__LilyCompilerOutputCache(const LilyPackage *package);
+
+/**
+ *
+ * @brief Get the key of the interface of the package, without its
+ * dependencies. The interface is the source of the package without the bodies
+ * of the functions which don't change the result of the analysis of its
+ * dependents (e.g. a non-generic function with an explicit signature).
+ * @note A dependent of the package only adds this key to its own key, so the
+ * dependent is not recompiled when only the body of such a function changes.
+ * This is only an early cutoff between packages: a package whose key changes
+ * is still parsed, analyzed and compiled as a whole.
+ */
+Usize
+get_interface_key__LilyCompilerOutputCache(const LilyPackage *package);
+
+/**
+ *
+ * @brief Add the key of a dependency to the key of the package.
+ * @note The result doesn't depend on the order in which the keys of the
+ * dependencies are added.
+ */
+Usize
+add_dependency_key__LilyCompilerOutputCache(Usize key, Usize dependency_key);
+
+/**
+ *
+ * @brief Get the path of the object of the package in the cache.
+ * @return char* e.g. out.lily/obj/<name>-<key>.o
+ */
+char *
+get_obj_path__LilyCompilerOutputCache(const LilyPackage *package, Usize key);
+
 #endif // LILY_CORE_LILY_COMPILER_OUTPUT_CACHE_H
@@ -0,0 +1,142 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2025 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_CORE_LILY_COMPILER_OUTPUT_TIMINGS_H
+#define LILY_CORE_LILY_COMPILER_OUTPUT_TIMINGS_H
+
+#include <base/hash_map.h>
+#include <base/macros.h>
+#include <base/string.h>
+#include <base/types.h>
+
+#include <core/lily/compiler/output/cache.h>
+
+#define LILY_COMPILER_OUTPUT_TIMINGS_PATH DIR_CACHE_NAME "timings"
+
+// NOTE: Used to estimate the cost of a package which has never been compiled,
+// when no other package has been compiled either.
+#define LILY_COMPILER_OUTPUT_TIMINGS_DEFAULT_NS_PER_BYTE 1000
+
+enum LilyCompilerOutputTimingsPhase
+{
+    LILY_COMPILER_OUTPUT_TIMINGS_PHASE_PARSER,
+    LILY_COMPILER_OUTPUT_TIMINGS_PHASE_ANALYSIS,
+    LILY_COMPILER_OUTPUT_TIMINGS_PHASE_MIR,
+    LILY_COMPILER_OUTPUT_TIMINGS_PHASE_IR,
+    LILY_COMPILER_OUTPUT_TIMINGS_PHASE_OBJ,
+    LILY_COMPILER_OUTPUT_TIMINGS_PHASE_COUNT
+};
+
+typedef struct LilyCompilerOutputTimingsPackage
+{
+    String *global_name;
+    Usize size; // Size of the source of the package (in bytes).
+    // Duration of each phase (in nanoseconds).
+    Uint64 durations[LILY_COMPILER_OUTPUT_TIMINGS_PHASE_COUNT];
+} LilyCompilerOutputTimingsPackage;
+
+/**
+ *
+ * @brief Construct LilyCompilerOutputTimingsPackage type.
+ */
+CONSTRUCTOR(LilyCompilerOutputTimingsPackage *,
+            LilyCompilerOutputTimingsPackage,
+            String *global_name,
+            Usize size,
+            const Uint64 *durations);
+
+/**
+ *
+ * @brief Get the sum of the durations of all the phases (in nanoseconds).
+ */
+Uint64
+get_total__LilyCompilerOutputTimingsPackage(
+  const LilyCompilerOutputTimingsPackage *self);
+
+/**
+ *
+ * @brief Free LilyCompilerOutputTimingsPackage type.
+ */
+DESTRUCTOR(LilyCompilerOutputTimingsPackage,
+           LilyCompilerOutputTimingsPackage *self);
+
+/**
+ *
+ * @brief The durations of the phases of each package, recorded during the
+ * previous builds (in `out.lily/timings`).
+ *
+ * e.g.
+ * 1
+ * <size> <parser> <analysis> <mir> <ir> <obj> <global_name>
+ */
+typedef struct LilyCompilerOutputTimings
+{
+    HashMap *packages;  // HashMap<LilyCompilerOutputTimingsPackage*>*
+    Uint64 ns_per_byte; // Average cost of a byte of source.
+} LilyCompilerOutputTimings;
+
+/**
+ *
+ * @brief Load the timings from the cache. If there is no timings in the cache
+ * (or if the timings are malformed), the timings are empty.
+ */
+LilyCompilerOutputTimings
+load__LilyCompilerOutputTimings();
+
+/**
+ *
+ * @brief Estimate the cost (in nanoseconds) of the compilation of the package.
+ * The recorded duration is used when the package has already been compiled,
+ * otherwise the cost is estimated from the size of the source.
+ */
+Uint64
+estimate__LilyCompilerOutputTimings(const LilyCompilerOutputTimings *self,
+                                    const String *global_name,
+                                    Usize size);
+
+/**
+ *
+ * @brief Record the durations of the phases of the package.
+ * @param durations const Uint64[LILY_COMPILER_OUTPUT_TIMINGS_PHASE_COUNT]
+ */
+void
+set__LilyCompilerOutputTimings(LilyCompilerOutputTimings *self,
+                               const String *global_name,
+                               Usize size,
+                               const Uint64 *durations);
+
+/**
+ *
+ * @brief Write the timings in the cache.
+ */
+void
+save__LilyCompilerOutputTimings(const LilyCompilerOutputTimings *self);
+
+/**
+ *
+ * @brief Free LilyCompilerOutputTimings type.
+ */
+DESTRUCTOR(LilyCompilerOutputTimings, const LilyCompilerOutputTimings *self);
+
+#endif // LILY_CORE_LILY_COMPILER_OUTPUT_TIMINGS_H
@@ -36,6 +36,7 @@
 #include <core/lily/analysis/checked/operator_register.h>
 #include <core/lily/compiler/ir.h>
 #include <core/lily/compiler/linker/linker.h>
+#include <core/lily/compiler/output/timings.h>
 #include <core/lily/functions/builtin.h>
 #include <core/lily/functions/sys.h>
 #include <core/lily/mir/mir.h>
@@ -51,7 +52,7 @@
 typedef struct LilyPackage LilyPackage;
 enum LilyPackageStatus;
 
-#define COMPILER_SET_ROOT_PACKAGE_IR(config, root_package)                    \
+#define COMPILER_SET_ROOT_PACKAGE_IR(config, root_package, p)                 \
     if (config->cc_ir) {                                                      \
         /* TODO: add a linker for CC */                                       \
         root_package->compiler.ir = NEW_VARIANT(LilyIr, cc, NEW(LilyIrCc));   \
@@ -63,8 +64,12 @@ enum LilyPackageStatus;
     } else if (config->js_ir) {                                               \
         self->compiler.ir = NEW_VARIANT(LilyIr, js, NEW(LilyIrJs));           \
     } else {                                                                  \
-        root_package->compiler.ir = NEW_VARIANT(                              \
-          LilyIr, llvm, NEW(LilyIrLlvm, root_package->global_name->buffer));  \
+        root_package->compiler.ir =                                           \
+          NEW_VARIANT(LilyIr,                                                 \
+                      llvm,                                                   \
+                      NEW(LilyIrLlvm,                                         \
+                          root_package->global_name->buffer,                  \
+                          p->kind == LILY_PROGRAM_KIND_DYNAMIC_LIB));         \
         root_package->compiler.linker = LILY_LINKER_KIND_LLVM;                \
     }
 
@@ -131,6 +136,21 @@ typedef struct LilyCompilerAdapter
     LilyIr ir;
     enum LilyLinkerKind linker;
     LilyLibrary *lib; // LilyLibrary*? (&)
+    // Duration of each phase (in nanoseconds), recorded in the cache for the
+    // scheduling of the next build (see LilyCompilerOutputTimings). It only
+    // covers the work of the phase (no wait on another package).
+    Uint64 durations[LILY_COMPILER_OUTPUT_TIMINGS_PHASE_COUNT];
+    // Key of the object in the cache (see get_key__LilyCompilerOutputCache).
+    Usize obj_key;
+    // Key of the interface of the package, which is added to the key of its
+    // dependents (see get_interface_key__LilyCompilerOutputCache).
+    Usize interface_key;
+    // The object of the package is in the cache, so the MIR, the IR and the
+    // compilation of the object are skipped.
+    bool obj_is_cached;
+    // The parser and the analysis of the package are needed, if the object of
+    // the package or the object of one of its dependents is not in the cache.
+    bool frontend_is_needed;
 } LilyCompilerAdapter;
 
 /**
@@ -146,6 +166,11 @@ inline CONSTRUCTOR(LilyCompilerAdapter,
         .output_exe_path = NULL,
         .config = config,
         .lib = NULL,
+        .durations = { 0 },
+        .obj_key = 0,
+        .interface_key = 0,
+        .obj_is_cached = false,
+        .frontend_is_needed = true,
     };
 }
 
@@ -173,10 +198,13 @@ build__LilyCompilerPackage(const LilyPackageCompilerConfig *config,
 /**
  *
  * @brief Build all packages of the library.
+ * @param config The config is borrowed by the packages, so it must outlive the
+ * library.
  * @return LilyLibrary*?
  */
 LilyLibrary *
-build_lib__LilyCompilerPackage(const LilycConfig *config,
+build_lib__LilyCompilerPackage(const LilyPackageCompilerConfig *config,
+                               const char *filename,
                                enum LilyVisibility visibility,
                                enum LilyPackageStatus status,
                                const char *default_path,
@@ -74,10 +74,11 @@ typedef struct LilyBuiltinFun
 
 /**
  *
- * @brief Function to load Lily builtin.
+ * @brief Get the Lily builtins (built at compile time).
+ * @return LilyBuiltinFun* (&)
  */
 LilyBuiltinFun *
-load_builtins__LilyBuiltin();
+get_builtins__LilyBuiltin();
 
 /**
  *
@@ -113,10 +114,4 @@ String *
 IMPL_FOR_DEBUG(to_string, LilyBuiltinFun, const LilyBuiltinFun *self);
 #endif
 
-/**
- *
- * @brief Free LilyBuiltinFun type.
- */
-DESTRUCTOR(LilyBuiltinFun, const LilyBuiltinFun *self);
-
 #endif // LILY_CORE_LILY_FUNCTIONS_BUILTIN_H
@@ -45,10 +45,11 @@ typedef struct LilySysFun
 
 /**
  *
- * @brief Function to load Lily sys.
+ * @brief Get the Lily sys functions (built at compile time).
+ * @return LilySysFun* (&)
  */
 LilySysFun *
-load_syss__LilySys();
+get_syss__LilySys();
 
 /**
  *
@@ -81,10 +82,4 @@ String *
 IMPL_FOR_DEBUG(to_string, LilySysFun, const LilySysFun *self);
 #endif
 
-/**
- *
- * @brief Free LilySysFun type.
- */
-DESTRUCTOR(LilySysFun, const LilySysFun *self);
-
 #endif // LILY_CORE_LILY_FUNCTIONS_SYS_H
@@ -101,11 +101,14 @@ build__LilyInterpreterPackage(const LilyPackageInterpreterConfig *config,
 
 /**
  *
- * @brief Build all packages of the library.
+ * @brief Build all packages of the library, without creating a VM.
+ * @param config The config is borrowed by the packages, so it must outlive the
+ * library.
  * @return LilyLibrary*?
  */
 LilyLibrary *
-build_lib__LilyInterpreterPackage(const LilyConfig *config,
+build_lib__LilyInterpreterPackage(const LilyPackageInterpreterConfig *config,
+                                  const char *filename,
                                   enum LilyVisibility visibility,
                                   enum LilyPackageStatus status,
                                   const char *default_path,
@@ -0,0 +1,106 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2025 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_CORE_LILY_PACKAGE_DEPENDENCY_GRAPH_H
+#define LILY_CORE_LILY_PACKAGE_DEPENDENCY_GRAPH_H
+
+#include <base/hash_map.h>
+#include <base/macros.h>
+#include <base/types.h>
+#include <base/vec.h>
+
+typedef struct LilyPackage LilyPackage;
+
+// NOTE: The dependency graph indexes the packages (and the sub packages) of a
+// root package by their global name, so that each dependency is resolved once.
+// The cycles (Tarjan's algorithm) and the layers are calculated in linear time
+// in the number of packages and dependencies.
+
+typedef struct LilyPackageDependencyGraphNode
+{
+    LilyPackage *package; // LilyPackage* (&)
+    Vec *dependencies;    // Vec<LilyPackageDependencyGraphNode* (&)>*
+    Usize id;             // Index of the node in the graph.
+    Usize layer;          // Length of the longest path to a leaf.
+    Usize index;          // Visit order (Tarjan's algorithm).
+    Usize low_link;       // Lowest index reachable (Tarjan's algorithm).
+    bool is_on_stack;
+} LilyPackageDependencyGraphNode;
+
+/**
+ *
+ * @brief Construct LilyPackageDependencyGraphNode type.
+ */
+CONSTRUCTOR(LilyPackageDependencyGraphNode *,
+            LilyPackageDependencyGraphNode,
+            LilyPackage *package,
+            Usize id);
+
+/**
+ *
+ * @brief Free LilyPackageDependencyGraphNode type.
+ */
+DESTRUCTOR(LilyPackageDependencyGraphNode,
+           LilyPackageDependencyGraphNode *self);
+
+typedef struct LilyPackageDependencyGraph
+{
+    Vec *nodes;      // Vec<LilyPackageDependencyGraphNode*>*
+    HashMap *lookup; // HashMap<LilyPackageDependencyGraphNode* (&)>*
+    // NOTE: Each cycle is a path of the graph, where the last node depends on
+    // the first node.
+    Vec *cycles; // Vec<Vec<LilyPackageDependencyGraphNode* (&)>*>*
+    // NOTE: The layer `n` contains the packages whose dependencies are all in
+    // the layers before `n`, so the packages of a layer can be built at the
+    // same time. The layers are empty if the graph has a cycle.
+    Vec *layers; // Vec<Vec<LilyPackageDependencyGraphNode* (&)>*>*
+} LilyPackageDependencyGraph;
+
+/**
+ *
+ * @brief Construct LilyPackageDependencyGraph type, from the root package and
+ * its sub packages (the nodes are in the same order as the packages, starting
+ * with the root package).
+ * @note The `package_dependencies` of the packages must be resolved.
+ */
+CONSTRUCTOR(LilyPackageDependencyGraph,
+            LilyPackageDependencyGraph,
+            LilyPackage *root_package);
+
+/**
+ *
+ * @brief Get the node of the package.
+ * @return LilyPackageDependencyGraphNode*? (&)
+ */
+LilyPackageDependencyGraphNode *
+get_node__LilyPackageDependencyGraph(const LilyPackageDependencyGraph *self,
+                                     const LilyPackage *package);
+
+/**
+ *
+ * @brief Free LilyPackageDependencyGraph type.
+ */
+DESTRUCTOR(LilyPackageDependencyGraph, const LilyPackageDependencyGraph *self);
+
+#endif // LILY_CORE_LILY_PACKAGE_DEPENDENCY_GRAPH_H
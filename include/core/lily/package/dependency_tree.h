@@ -48,7 +48,8 @@ typedef struct LilyPackage LilyPackage;
 */
 
 // NOTE: The dependency tree does not deal with the dependency of packages on
-// libraries.
+// libraries. The trees are built from LilyPackageDependencyGraph: a package is
+// a child of the tree of its first dependency.
 typedef struct LilyPackageDependencyTree
 {
     LilyPackage *package; // LilyPackage* (&)
@@ -66,33 +67,6 @@ CONSTRUCTOR(LilyPackageDependencyTree *,
             LilyPackage *package,
             Vec *dependencies);
 
-/**
- *
- * @brief Determine the right tree to push the package according the package
- * dependencies.
- * @param trees Vec<LilyPackageDependencyTree*>*
- */
-LilyPackageDependencyTree *
-determine_tree__LilyPackageDependencyTree(Vec *trees, LilyPackage *package);
-
-/**
- *
- * @brief Add package to dependency tree.
- * @param trees Vec<LilyPackageDependencyTree*>*
- */
-void
-add_package__LilyPackageDependencyTree(LilyPackageDependencyTree *self,
-                                       Vec *trees,
-                                       LilyPackage *package);
-
-/**
- *
- * @brief Verify if the package is added in the tree.
- */
-LilyPackageDependencyTree *
-is_added__LilyPackageDependencyTree(LilyPackageDependencyTree *self,
-                                    LilyPackage *package);
-
 /**
  *
  * @brief Convert LilyPackageDependencyTree in String.
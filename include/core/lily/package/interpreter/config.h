@@ -36,6 +36,7 @@ typedef struct LilyPackageInterpreterConfig
     bool verbose;
     Usize max_heap;
     Usize max_stack;
+    bool lazy; // See has_lazy_fun_body__LilyPackage.
 } LilyPackageInterpreterConfig;
 
 /**
@@ -47,12 +48,14 @@ inline CONSTRUCTOR(LilyPackageInterpreterConfig,
                    Vec *args,
                    bool verbose,
                    Usize max_heap,
-                   Usize max_stack)
+                   Usize max_stack,
+                   bool lazy)
 {
     return (LilyPackageInterpreterConfig){ .args = args,
                                            .verbose = verbose,
                                            .max_heap = max_heap,
-                                           .max_stack = max_stack };
+                                           .max_stack = max_stack,
+                                           .lazy = lazy };
 }
 
 /**
@@ -62,9 +65,11 @@ inline CONSTRUCTOR(LilyPackageInterpreterConfig,
 inline LilyPackageInterpreterConfig
 default__LilyPackageInterpreterConfig()
 {
-    return (LilyPackageInterpreterConfig){
-        .args = NULL, .verbose = false, .max_heap = 0, .max_stack = 0
-    };
+    return (LilyPackageInterpreterConfig){ .args = NULL,
+                                           .verbose = false,
+                                           .max_heap = 0,
+                                           .max_stack = 0,
+                                           .lazy = false };
 }
 
 /**
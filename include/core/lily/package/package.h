@@ -34,6 +34,12 @@
 #include <core/lily/package/program.h>
 #include <core/lily/precompiler/precompiler.h>
 
+#include <stdatomic.h>
+
+// NOTE: From this length (in bytes) of the file, the scanner and the preparser
+// are pipelined (see run_pipelined__LilyPreparser).
+#define LILY_PACKAGE_PIPELINE_MIN_FILE_LEN 1048576 // 1 MiB
+
 #define LOG_VERBOSE(package, msg)                                          \
     switch (package->kind) {                                               \
         case LILY_PACKAGE_KIND_COMPILER:                                   \
@@ -68,21 +74,10 @@
         root_package->global_name = from__String("main");              \
     }
 
-#define LOAD_ROOT_PACKAGE_RESOURCES(root_package, p)                          \
-    /* Load builtins and syss */                                              \
-    root_package->builtins = p->resources.builtins;                           \
-    root_package->syss = p->resources.syss;                                   \
-                                                                              \
-    /* Load default operators in operator register                            \
-    In a normal case where we wanted to add an operator to the register, we'd \
-    use `add_operator__LilyCheckedOperatorRegister`, but in this case it's    \
-    guaranteed that no operator repeats itself, so to increase loading speed  \
-    we'll add it directly to the vector without checking. */                  \
-    for (Usize i = 0; i < DEFAULT_OPERATORS_COUNT; ++i) {                     \
-        push__Vec(root_package->operator_register.operators,                  \
-                  ref__LilyCheckedOperator(                                   \
-                    root_package->program->resources.default_operators[i]));  \
-    }
+#define LOAD_ROOT_PACKAGE_RESOURCES(root_package, p) \
+    /* Load builtins and syss */                     \
+    root_package->builtins = p->resources.builtins;  \
+    root_package->syss = p->resources.syss;
 
 enum LilyPackageStatus
 {
@@ -116,6 +111,11 @@ typedef struct LilyPackage
     Usize count_error;
     Usize count_warning;
 
+    // count the macro expansions of the package (reported in verbose mode)
+    atomic_size_t count_macro_expansion;
+    atomic_size_t count_memoized_macro_expansion;
+    atomic_size_t macro_expansion_duration; // ns
+
     File file;
     LilyScanner scanner;
     LilyPreparser preparser;
@@ -257,6 +257,52 @@ add_builtin_fun_to_builtin_usage__LilyPackage(LilyPackage *self,
 void
 add_sys_fun_to_sys_usage__LilyPackage(LilyPackage *self, LilySysFun *fun_sys);
 
+/**
+ *
+ * @brief Return true if the bodies of the functions of the package are parsed
+ * and checked on demand, i.e. only when the function is reachable from the
+ * main function (the first call to the function checks it) or explicitly
+ * requested with check_lazy_fun__LilyAnalysis.
+ * @note This mode is opt-in (`lily run --lazy`), because the functions which
+ * are not reachable from the main function are neither parsed nor checked, so
+ * their errors are not reported. The bodies are always parsed eagerly for the
+ * compiler, which must build all the functions of the package.
+ */
+bool
+has_lazy_fun_body__LilyPackage(const LilyPackage *self);
+
+/**
+ *
+ * @brief Return true if the emission of the package is driven by its API,
+ * i.e. only the public functions, the operators and the functions they call
+ * (see the dependencies of LilyCheckedDeclFun) are lowered to the MIR. This is
+ * the case of a package imported by the root package of the compiler, whose
+ * private functions can't be called by its dependents.
+ * @note All the functions of the package are still checked, so all of their
+ * diagnostics are reported.
+ */
+bool
+has_api_driven_emission__LilyPackage(const LilyPackage *self);
+
+/**
+ *
+ * @brief Run the scanner and the preparser of the package.
+ * @note The scanner and the preparser are pipelined, if the file is large and
+ * the tokens are not dumped.
+ */
+void
+run_scanner_and_preparser__LilyPackage(LilyPackage *self, bool dump_scanner);
+
+/**
+ *
+ * @brief Release the tokens of the package, once all its declarations are
+ * parsed. The tokens of the macros are kept, because the macros can still be
+ * expanded by the other packages.
+ * @note The tokens are only released in pipelined mode.
+ */
+void
+release_tokens__LilyPackage(LilyPackage *self);
+
 /**
  *
  * @brief Free LilyPackage type.
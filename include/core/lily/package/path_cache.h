@@ -0,0 +1,58 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2025 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_CORE_LILY_PACKAGE_PATH_CACHE_H
+#define LILY_CORE_LILY_PACKAGE_PATH_CACHE_H
+
+enum LilyPackagePathKind
+{
+    LILY_PACKAGE_PATH_KIND_NONE,
+    LILY_PACKAGE_PATH_KIND_FILE,
+    LILY_PACKAGE_PATH_KIND_DIR
+};
+
+/**
+ *
+ * @brief Get the kind of the path (i.e. if the path doesn't exist, is a file
+ * or is a directory).
+ * @note The directory of the path is read only once per build, then its
+ * listing is shared by all the threads. So resolving all the packages (and
+ * all the cached objects) of a directory costs one `readdir`
+ * instead of a `stat` or an `access` per path.
+ * @note A file created (or removed) after the first read of its directory is
+ * not seen, so this cache must only be used for the files which are not
+ * written by the build before being looked up (e.g. the sources of the
+ * packages, or the cache of the previous builds).
+ */
+enum LilyPackagePathKind
+get_kind__LilyPackagePathCache(const char *path);
+
+/**
+ *
+ * @brief Forget all the directories read by the cache.
+ */
+void
+clear__LilyPackagePathCache();
+
+#endif // LILY_CORE_LILY_PACKAGE_PATH_CACHE_H
@@ -28,6 +28,7 @@
 #include <base/macros.h>
 #include <base/vec.h>
 
+#include <core/lily/analysis/checked/data_type_table.h>
 #include <core/lily/analysis/checked/operator.h>
 #include <core/lily/functions/builtin.h>
 #include <core/lily/functions/sys.h>
@@ -36,12 +37,17 @@ typedef struct LilyPackage LilyPackage;
 
 // This types is used to load the basic resources of the program.
 // e.g. default operator, builtins, syss, analysed library, ...
+// NOTE: The resources are shared by all the packages, which are created and
+// precompiled by several threads. So the resources are never modified after
+// their load, except the table of the interned data types (which is locked).
+// The builtins, the syss and the default operators are built at compile time
+// (see get_default_operators__LilyCheckedOperator).
 typedef struct LilyProgramResources
 {
-    LilyBuiltinFun *builtins;
-    LilySysFun *syss;
-    LilyCheckedOperator **default_operators;
+    LilyBuiltinFun *builtins; // LilyBuiltinFun* (&)
+    LilySysFun *syss;         // LilySysFun* (&)
     Vec *libs; // Vec<LilyLibrary*>*
+    LilyCheckedDataTypeTable *data_types;
 } LilyProgramResources;
 
 /**
@@ -51,10 +57,10 @@ typedef struct LilyProgramResources
 inline CONSTRUCTOR(LilyProgramResources, LilyProgramResources)
 {
     return (LilyProgramResources){
-        .builtins = load_builtins__LilyBuiltin(),
-        .syss = load_syss__LilySys(),
-        .default_operators = load_default_operators__LilyCheckedOperator(),
-        .libs = NEW(Vec)
+        .builtins = get_builtins__LilyBuiltin(),
+        .syss = get_syss__LilySys(),
+        .libs = NEW(Vec),
+        .data_types = NEW(LilyCheckedDataTypeTable)
     };
 }
 
@@ -83,6 +89,16 @@ typedef struct LilyProgram
  */
 CONSTRUCTOR(LilyProgram, LilyProgram, enum LilyProgramKind kind);
 
+/**
+ *
+ * @brief Load the resources of the next program in advance.
+ * @note The next constructed program takes the preloaded resources instead of
+ * loading them. This is used by the compile server (lilyd), which loads the
+ * resources once, then forks a process for each compilation.
+ */
+void
+preload__LilyProgram();
+
 /**
  *
  * @brief Free LilyProgram type.
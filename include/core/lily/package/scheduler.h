@@ -0,0 +1,131 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2025 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_CORE_LILY_PACKAGE_SCHEDULER_H
+#define LILY_CORE_LILY_PACKAGE_SCHEDULER_H
+
+#include <base/binary_heap.h>
+#include <base/hash_map.h>
+#include <base/macros.h>
+#include <base/types.h>
+#include <base/vec.h>
+
+#include <core/lily/package/dependency_tree.h>
+
+#include <pthread.h>
+
+// NOTE: The scheduler flattens the dependency trees into a DAG, and runs a
+// package as soon as all of its dependencies (and its parent in the tree) are
+// done, instead of running a whole tree per thread. When several packages are
+// ready, the package with the longest critical path (the most expensive chain
+// of packages which depends on it) runs first, so that the end of the build
+// is not left to a single long chain.
+
+typedef struct LilyPackageSchedulerNode
+{
+    LilyPackageDependencyTree *tree; // LilyPackageDependencyTree* (&)
+    Vec *dependents;                 // Vec<LilyPackageSchedulerNode* (&)>*
+    Usize pending;                   // Number of dependencies not done yet.
+    Usize id;                        // Discovery order of the node.
+    Uint64 cost;                     // Estimated cost of the package.
+    Uint64 priority;                 // Cost of the longest path to the end.
+} LilyPackageSchedulerNode;
+
+/**
+ *
+ * @brief Construct LilyPackageSchedulerNode type.
+ */
+CONSTRUCTOR(LilyPackageSchedulerNode *,
+            LilyPackageSchedulerNode,
+            LilyPackageDependencyTree *tree,
+            Usize id);
+
+/**
+ *
+ * @brief Free LilyPackageSchedulerNode type.
+ */
+DESTRUCTOR(LilyPackageSchedulerNode, LilyPackageSchedulerNode *self);
+
+typedef struct LilyPackageScheduler
+{
+    Vec *nodes;        // Vec<LilyPackageSchedulerNode*>*
+    HashMap *lookup;   // HashMap<LilyPackageSchedulerNode* (&)>*
+    BinaryHeap *ready; // BinaryHeap<LilyPackageSchedulerNode* (&)>*
+    Usize remaining;   // Number of nodes which are not done yet.
+    Usize running;     // Number of nodes which are running.
+    void (*run)(LilyPackageDependencyTree *tree);
+    pthread_mutex_t mutex; // Protects `ready`, `remaining` and the nodes.
+    pthread_cond_t cond;   // Signaled when a node is ready or all are done.
+} LilyPackageScheduler;
+
+/**
+ *
+ * @brief Construct LilyPackageScheduler type.
+ * @param trees Vec<LilyPackageDependencyTree*>* (&)
+ * @param run Function called (from a worker thread) to compile a package.
+ */
+CONSTRUCTOR(LilyPackageScheduler,
+            LilyPackageScheduler,
+            const Vec *trees,
+            void (*run)(LilyPackageDependencyTree *tree));
+
+/**
+ *
+ * @brief Get the nodes in a topological order (a node comes after all of its
+ * dependencies).
+ * @return Vec<LilyPackageSchedulerNode* (&)>*
+ */
+Vec *
+get_order__LilyPackageScheduler(const LilyPackageScheduler *self);
+
+/**
+ *
+ * @brief Set the estimated cost of each package, and calculate the critical
+ * path of each node (its cost plus the most expensive path of its dependents).
+ * @note Without costs, the ready packages run in the discovery order.
+ */
+void
+set_costs__LilyPackageScheduler(LilyPackageScheduler *self,
+                                Uint64 (*get_cost)(const LilyPackage *package,
+                                                   void *ctx),
+                                void *ctx);
+
+/**
+ *
+ * @brief Run all the packages of the scheduler, and wait for all of them. The
+ * worker threads are reserved in the budget shared by all the thread pools (see
+ * reserve_jobs__ThreadPool), the calling thread being one of the workers.
+ * @note The independent packages run in parallel, so `run` must only lock the
+ * structures which are really shared between the packages.
+ */
+void
+run__LilyPackageScheduler(LilyPackageScheduler *self);
+
+/**
+ *
+ * @brief Free LilyPackageScheduler type.
+ */
+DESTRUCTOR(LilyPackageScheduler, LilyPackageScheduler *self);
+
+#endif // LILY_CORE_LILY_PACKAGE_SCHEDULER_H
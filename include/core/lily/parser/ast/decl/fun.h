@@ -35,6 +35,8 @@
 #include <core/lily/shared/visibility.h>
 #include <core/shared/location.h>
 
+typedef struct LilyParser LilyParser;
+
 enum LilyAstDeclFunParamKind
 {
     LILY_AST_DECL_FUN_PARAM_KIND_DEFAULT,
@@ -113,7 +115,12 @@ typedef struct LilyAstDeclFun
     Vec *generic_params; // Vec<LilyAstGenericParam>*?
     Vec *params;         // Vec<LilyAstDeclFunParam*|LilyAstDeclMethodParam*>*?
     LilyAstDataType *return_data_type; // LilyAstDataType*?
-    Vec *body;                         // Vec<LilyAstBodyFunItem*>*
+    Vec *body;                         // Vec<LilyAstBodyFunItem*>*?
+    // NOTE: When the body is parsed on demand (see
+    // has_lazy_fun_body__LilyPackage), `body` is NULL until
+    // parse_lazy_fun_body__LilyParser is called.
+    Vec *lazy_body;          // Vec<LilyPreparserFunBodyItem*>*? (&)
+    LilyParser *lazy_parser; // LilyParser*? (&)
     Vec *req;                          // Vec<LilyAstExpr*>*?
     Vec *when;                         // Vec<LilyAstExpr*>*?
     enum LilyVisibility visibility;
@@ -135,6 +142,8 @@ inline CONSTRUCTOR(LilyAstDeclFun,
                    Vec *params,
                    LilyAstDataType *return_data_type,
                    Vec *body,
+                   Vec *lazy_body,
+                   LilyParser *lazy_parser,
                    Vec *req,
                    Vec *when,
                    enum LilyVisibility visibility,
@@ -149,6 +158,8 @@ inline CONSTRUCTOR(LilyAstDeclFun,
                              .params = params,
                              .return_data_type = return_data_type,
                              .body = body,
+                             .lazy_body = lazy_body,
+                             .lazy_parser = lazy_parser,
                              .req = req,
                              .when = when,
                              .visibility = visibility,
@@ -31,6 +31,7 @@
 #include <base/vec.h>
 
 #include <core/lily/parser/ast/data_type.h>
+#include <core/lily/parser/ast/decl/fun.h>
 #include <core/lily/parser/ast/expr.h>
 #include <core/lily/preparser/preparser.h>
 
@@ -62,6 +63,11 @@ struct LilyParser
     LilyPackage *root_package;
     LilyPreparserDecl *current;              // LilyPreparserDecl*?
     const LilyPreparserInfo *preparser_info; // LilyPreparserInfo*? (&)
+    // NOTE: The counters of the package, except for the copies of the parser
+    // used by the tasks of parse_decls_in_parallel__LilyParser, which count in
+    // the buffer of their task.
+    Usize *count_error;   // Usize* (&)
+    Usize *count_warning; // Usize* (&)
     // LilyDumpConfig *dump_config;
     Usize position;
     // NOTE: All optional null values of this struct are possible in case the
@@ -103,6 +109,15 @@ TEST(LilyAstExpr *, parse_expr, LilyParseBlock *self);
 void
 run__LilyParser(LilyParser *self, bool parse_for_macro_expand);
 
+/**
+ *
+ * @brief Parse the body of the function, if the body has not been parsed yet
+ * (see has_lazy_fun_body__LilyPackage).
+ * @note Like run__LilyParser, exit if the body contains errors.
+ */
+void
+parse_lazy_fun_body__LilyParser(LilyAstDeclFun *fun);
+
 /**
  *
  * @brief Free LilyParser type.
@@ -25,11 +25,14 @@
 #ifndef LILY_CORE_LILY_PRECOMPILE_H
 #define LILY_CORE_LILY_PRECOMPILE_H
 
+#include <base/hash_map.h>
 #include <base/macros.h>
 
 #include <core/lily/package/dependency_tree.h>
 #include <core/lily/preparser/preparser.h>
 
+#include <pthread.h>
+
 typedef struct LilyPackage LilyPackage;
 
 enum LilyImportValueKind
@@ -238,12 +241,44 @@ IMPL_FOR_DEBUG(to_string, LilyMacroParam, const LilyMacroParam *self);
  */
 DESTRUCTOR(LilyMacroParam, LilyMacroParam *self);
 
+enum LilyMacroExpansionItemKind
+{
+    LILY_MACRO_EXPANSION_ITEM_KIND_EXPAND,      // expand token of the param
+    LILY_MACRO_EXPANSION_ITEM_KIND_MACRO_TOKEN, // token of the macro
+    LILY_MACRO_EXPANSION_ITEM_KIND_PARAM_TOKEN  // token of the param
+};
+
+typedef struct LilyMacroExpansionItem
+{
+    enum LilyMacroExpansionItemKind kind;
+    Usize param; // unused with the token of the macro
+    Usize index; // unused with the expand token
+} LilyMacroExpansionItem;
+
+// NOTE: The memoized expansion only keeps where each token of the expansion
+// comes from, so that the expansion can be rebuilt with the tokens (and the
+// locations) of any macro expand with the same parameters.
+typedef struct LilyMacroExpansion
+{
+    String *key;
+    LilyMacroExpansionItem *items;
+    Usize len;
+} LilyMacroExpansion;
+
+/**
+ *
+ * @brief Free LilyMacroExpansion type.
+ */
+DESTRUCTOR(LilyMacroExpansion, LilyMacroExpansion *self);
+
 typedef struct LilyMacro
 {
     String *name;
     Vec *params; // Vec<LilyMacroParam*>*?
     Vec *tokens; // Vec<LilyToken* (&)>*
     Location location;
+    HashMap *expansions; // HashMap<LilyMacroExpansion*>*
+    pthread_mutex_t expansions_mutex;
 } LilyMacro;
 
 /**
@@ -277,6 +312,53 @@ void
 IMPL_FOR_DEBUG(debug, LilyMacro, const LilyMacro *self);
 #endif
 
+/**
+ *
+ * @brief Get the key of the memoized expansion of the macro with these
+ * parameters.
+ * @param params Vec<Vec<LilyToken* (&)>* (&)>* (&)
+ */
+String *
+get_expansion_key__LilyMacro(const Vec *params);
+
+/**
+ *
+ * @brief Get the memoized expansion of the macro with this key.
+ * @return LilyMacroExpansion*? (&)
+ */
+const LilyMacroExpansion *
+get_expansion__LilyMacro(LilyMacro *self, const String *key);
+
+/**
+ *
+ * @brief Memoize the expansion of the macro with these parameters.
+ * @param key String* (got by get_expansion_key__LilyMacro)
+ * @param params Vec<Vec<LilyToken* (&)>* (&)>* (&)
+ * @param expand_tokens Vec<LilyToken*?>* (&)
+ * @param tokens Tokens of the expansion (Vec<LilyToken* (&)>* (&)).
+ */
+void
+add_expansion__LilyMacro(LilyMacro *self,
+                         String *key,
+                         const Vec *params,
+                         const Vec *expand_tokens,
+                         const Vec *tokens);
+
+/**
+ *
+ * @brief Rebuild the tokens of the expansion with the parameters of the macro
+ * expand.
+ * @param params Vec<Vec<LilyToken* (&)>* (&)>* (&)
+ * @param expand_tokens Vec<LilyToken*?>* (&)
+ * @param tokens Vec<LilyToken* (&)>* (&)
+ */
+void
+apply_expansion__LilyMacro(const LilyMacro *self,
+                           const LilyMacroExpansion *expansion,
+                           const Vec *params,
+                           const Vec *expand_tokens,
+                           Vec *tokens);
+
 /**
  *
  * @brief Free LilyMacro type.
@@ -30,6 +30,7 @@
 
 #include <core/lily/scanner/scanner.h>
 #include <core/lily/scanner/token.h>
+#include <core/lily/scanner/token_buffer.h>
 #include <core/lily/shared/visibility.h>
 
 typedef struct LilyPreparserImport
@@ -1575,6 +1576,8 @@ typedef struct LilyPreparserInfo
     Vec *private_macros;  // Vec<LilyPreparserMacro*>*
     Vec *decls;           // Vec<LilyPreparserDecl*>*
     LilyPreparserPackage *package;
+    bool destroy_all; // The value of LilyPreparser.destroy_all for the items
+                      // of the info (set by run__LilyPreparser).
 } LilyPreparserInfo;
 
 /**
@@ -1592,7 +1595,9 @@ DESTRUCTOR(LilyPreparserInfo, const LilyPreparserInfo *self);
 typedef struct LilyPreparser
 {
     const File *file;
-    const Vec *tokens; // Vec<LilyToken*>*(&)
+    const LilyTokenBuffer *tokens; // const LilyTokenBuffer* (&)
+    LilyTokenStream *stream; // LilyTokenStream*? (&) - It's set in pipelined
+                             // mode (see run_pipelined__LilyPreparser).
     LilyToken *current;
     Usize position;
     Usize count_error;
@@ -1602,6 +1607,11 @@ typedef struct LilyPreparser
                       // precompiler is enable (or in the preparser or
                       // precompiler test). NOTE: These are just a few examples,
                       // you can apply it in other cases if necessary.
+    // NOTE: The following fields are the state of the declaration (or the item
+    // of the function body) being preparsed.
+    enum LilyVisibility visibility_decl;
+    Location location_decl;
+    Location location_fun_body_item;
 } LilyPreparser;
 
 /**
@@ -1611,7 +1621,7 @@ typedef struct LilyPreparser
 CONSTRUCTOR(LilyPreparser,
             LilyPreparser,
             const File *file,
-            const Vec *tokens,
+            const LilyTokenBuffer *tokens,
             const char *default_package_access,
             bool destroy_all);
 
@@ -1687,4 +1697,20 @@ preparse_lambda__LilyPreparser(LilyPreparser *self);
 void
 run__LilyPreparser(LilyPreparser *self, LilyPreparserInfo *info);
 
+/**
+ *
+ * @brief Run the scanner and the preparser at the same time (pipelined mode).
+ * The scanner runs on another thread and pushes the tokens into a bounded
+ * stream, which is consumed by the preparser.
+ * @param scanner The scanner of the same file as the preparser (the stream of
+ * the scanner must not be set). The stream is owned by the scanner, so the
+ * scanner must outlive the items of the preparser (or its tokens must be kept,
+ * see release__LilyTokenStream).
+ * @note The tokens can't be dumped in this mode.
+ */
+void
+run_pipelined__LilyPreparser(LilyPreparser *self,
+                             LilyPreparserInfo *info,
+                             LilyScanner *scanner);
+
 #endif // LILY_CORE_LILY_PREPARSER_H
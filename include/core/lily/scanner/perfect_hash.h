@@ -0,0 +1,75 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2025 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// NOTE: This file is generated by `scripts/perfect_hash_generator.py`
+// from `src/core/lily/scanner/scanner.c`. Don't edit it by hand.
+
+#ifndef LILY_CORE_LILY_SCANNER_PERFECT_HASH_H
+#define LILY_CORE_LILY_SCANNER_PERFECT_HASH_H
+
+#include <core/shared/search.h>
+
+// clang-format off
+
+// lily_keywords: 68 keys, 34 buckets
+#define LILY_KEYWORDS_PERFECT_HASH_KEYS_LEN 68
+
+static const Uint16 lily_keywords_displacements[34] = {
+    0, 2, 4, 4, 38, 1, 0, 0, 37, 0, 5, 3, 6, 0, 0, 19, 0, 11, 0, 21, 1, 0, 15,
+    35, 83, 32, 44, 0, 25, 13, 1, 0, 7, 81,
+};
+
+static const Uint16 lily_keywords_indexes[68] = {
+    24, 29, 59, 17, 16, 5, 1, 35, 39, 25, 8, 58, 64, 18, 46, 54, 14, 15, 43, 9,
+    19, 49, 57, 11, 52, 33, 38, 7, 3, 20, 31, 47, 32, 10, 34, 27, 12, 42, 55,
+    26, 4, 36, 61, 66, 37, 13, 53, 6, 63, 51, 44, 40, 56, 65, 45, 28, 48, 62,
+    22, 23, 50, 60, 0, 30, 2, 21, 67, 41,
+};
+
+static const SearchPerfectHash lily_keywords_perfect_hash = {
+    .displacements = lily_keywords_displacements,
+    .displacements_len = 34,
+    .indexes = lily_keywords_indexes
+};
+
+// lily_at_keywords: 7 keys, 4 buckets
+#define LILY_AT_KEYWORDS_PERFECT_HASH_KEYS_LEN 7
+
+static const Uint16 lily_at_keywords_displacements[4] = {
+    2, 1, 0, 4,
+};
+
+static const Uint16 lily_at_keywords_indexes[7] = {
+    4, 3, 0, 5, 2, 6, 1,
+};
+
+static const SearchPerfectHash lily_at_keywords_perfect_hash = {
+    .displacements = lily_at_keywords_displacements,
+    .displacements_len = 4,
+    .indexes = lily_at_keywords_indexes
+};
+
+// clang-format on
+
+#endif // LILY_CORE_LILY_SCANNER_PERFECT_HASH_H
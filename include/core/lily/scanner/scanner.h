@@ -30,32 +30,77 @@
 #include <base/vec.h>
 
 #include <core/lily/scanner/token.h>
+#include <core/lily/scanner/token_buffer.h>
+#include <core/lily/scanner/token_stream.h>
 #include <core/shared/diagnostic.h>
+#include <core/shared/file.h>
 #include <core/shared/scanner.h>
 
 typedef struct LilyScanner
 {
-    Vec *tokens; // Vec<LilyToken*>*
+    LilyTokenBuffer tokens;
+    // NOTE: If the stream is set, the tokens are pushed into the stream instead
+    // of the buffer (see run_pipelined__LilyPreparser).
+    LilyTokenStream *stream; // LilyTokenStream*?
     Scanner base;
 } LilyScanner;
 
+typedef struct LilyScannerEdit
+{
+    Usize start_position; // Start position in the old content
+    Usize end_position;   // End position (excluded) in the old content
+    const char *replacement;
+} LilyScannerEdit;
+
+// NOTE: The tokens in [start, old_end) of the old buffer have been replaced by
+// the tokens in [start, new_end) of the new buffer. The locations of the tokens
+// after new_end have been shifted.
+typedef struct LilyScannerChange
+{
+    Usize start;
+    Usize old_end;
+    Usize new_end;
+} LilyScannerChange;
+
 /**
  *
  * @brief Construct LilyScanner type.
  */
 inline CONSTRUCTOR(LilyScanner, LilyScanner, Source source, Usize *count_error)
 {
-    return (LilyScanner){ .tokens = NEW(Vec),
+    return (LilyScanner){ .tokens = NEW(LilyTokenBuffer),
+                          .stream = NULL,
                           .base = NEW(Scanner, source, count_error) };
 }
 
 /**
  *
  * @brief Run the scanner.
+ * @return Return true if an error has been emitted. The scanner exits on
+ * errors, unless the diagnostics of the current thread are buffered (see
+ * set_buffer__Diagnostic), then the caller must not run the preparser.
+ * @note If the stream is set, the stream is closed at the end of the file
+ * (and the tokens can't be dumped).
  */
-void
+bool
 run__LilyScanner(LilyScanner *self, bool dump_scanner);
 
+/**
+ *
+ * @brief Re-scan the tokens after an edit of the file.
+ * @param file It's the file of the source of the scanner. The edit is applied
+ * to the file by this function.
+ * @return Return the range of the tokens which have changed.
+ * @note The scan is resumed from the nearest token boundary before the edit,
+ * and it's stopped as soon as the scanner re-synchronizes with the old tokens
+ * after the edit. Unlike run__LilyScanner, this function doesn't exit if an
+ * error is emitted, so the caller must check the count of errors. The stream
+ * must not be set. The pointers to the tokens outside of the returned range
+ * stay valid.
+ */
+LilyScannerChange
+relex__LilyScanner(LilyScanner *self, File *file, const LilyScannerEdit *edit);
+
 /**
  *
  * @brief Free LilyScanner type.
@@ -649,6 +649,15 @@ IMPL_FOR_DEBUG(debug, LilyToken, const LilyToken *self);
 LilyToken *
 clone__LilyToken(const LilyToken *self);
 
+/**
+ *
+ * @brief Free the payload of LilyToken type (e.g. identifier_normal), without
+ * freeing the token itself.
+ * @note This function is used to free the tokens stored in LilyTokenBuffer.
+ */
+void
+free_payload__LilyToken(LilyToken *self);
+
 /**
  *
  * @brief Free LilyToken type.
@@ -0,0 +1,177 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2025 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_CORE_LILY_SCANNER_TOKEN_BUFFER_H
+#define LILY_CORE_LILY_SCANNER_TOKEN_BUFFER_H
+
+#include <base/assert.h>
+#include <base/new.h>
+#include <base/types.h>
+#include <base/vec.h>
+
+#include <core/lily/scanner/token.h>
+
+#define LILY_TOKEN_BUFFER_DEFAULT_CAPACITY 128
+#define LILY_TOKEN_BUFFER_CHUNK_CAPACITY 4096
+
+// NOTE: Unlike a Vec<LilyToken*>, the tokens are stored contiguously in
+// memory, in chunks of at most LILY_TOKEN_BUFFER_CHUNK_CAPACITY tokens (the
+// first chunk contains LILY_TOKEN_BUFFER_DEFAULT_CAPACITY tokens, then the size
+// of the chunks is doubled, so a small file doesn't reserve a full chunk). The
+// chunks are never reallocated nor moved, so a pointer to a token stays valid
+// until the buffer is freed, even when other tokens are pushed or spliced (the
+// preparser and the parser keep pointers to the tokens). The order of the
+// tokens is given by `items`, so splice__LilyTokenBuffer only moves pointers.
+typedef struct LilyTokenBuffer
+{
+    LilyToken **items; // LilyToken* (&)*?
+    Usize len;
+    Usize capacity;
+    Vec *chunks; // Vec<LilyToken*>*?
+    Usize chunk_len; // Number of tokens stored in the last chunk.
+    Usize chunk_capacity; // Number of tokens of the last chunk.
+    bool own_payloads; // It's false when the payloads of the tokens are owned
+                       // by another buffer (e.g. the tokens of a macro).
+} LilyTokenBuffer;
+
+/**
+ *
+ * @brief Construct LilyTokenBuffer type.
+ */
+inline CONSTRUCTOR(LilyTokenBuffer, LilyTokenBuffer)
+{
+    return (LilyTokenBuffer){ .items = NULL,
+                              .len = 0,
+                              .capacity = 0,
+                              .chunks = NULL,
+                              .chunk_len = 0,
+                              .chunk_capacity = 0,
+                              .own_payloads = true };
+}
+
+/**
+ *
+ * @brief Construct LilyTokenBuffer type from a Vec<LilyToken*>.
+ * @note The tokens are not copied (the buffer points to the tokens of the
+ * Vec), so the tokens of the Vec must outlive the buffer.
+ */
+LilyTokenBuffer
+from_vec__LilyTokenBuffer(const Vec *tokens);
+
+/**
+ *
+ * @brief Push a token to the buffer.
+ * @note The token is moved into the buffer (the given pointer is freed).
+ */
+void
+push__LilyTokenBuffer(LilyTokenBuffer *self, LilyToken *token);
+
+/**
+ *
+ * @brief Take a free slot of the last chunk (a new chunk is allocated, if the
+ * last chunk is full).
+ * @note The token built in the slot is only added to the order of the tokens
+ * by push_slot__LilyTokenBuffer. The slot itself is released with the buffer,
+ * so a dropped token must only free its payload (free_payload__LilyToken).
+ * @return LilyToken* (&)
+ */
+LilyToken *
+take_slot__LilyTokenBuffer(LilyTokenBuffer *self);
+
+/**
+ *
+ * @brief Push a token built in a slot of the buffer (see
+ * take_slot__LilyTokenBuffer), without copying it.
+ */
+void
+push_slot__LilyTokenBuffer(LilyTokenBuffer *self, LilyToken *slot);
+
+// NOTE: When a buffer is set on the current thread (see
+// set_slots__LilyTokenBuffer), the constructors of LilyToken build the tokens
+// in the slots of this buffer instead of allocating them one by one on the
+// heap. The scanner sets its buffer while it's scanning, so the tokens are
+// never copied nor freed one by one.
+
+/**
+ *
+ * @brief Set the buffer in which the tokens constructed by the current thread
+ * are built.
+ * @param buffer LilyTokenBuffer*? (&) - If the buffer is NULL, the tokens are
+ * allocated on the heap again.
+ */
+void
+set_slots__LilyTokenBuffer(LilyTokenBuffer *buffer);
+
+/**
+ *
+ * @brief Get the buffer in which the tokens constructed by the current thread
+ * are built.
+ * @return LilyTokenBuffer*? (&)
+ */
+LilyTokenBuffer *
+get_slots__LilyTokenBuffer();
+
+/**
+ *
+ * @brief Replace the tokens between start and end (excluded) by the tokens of
+ * the given buffer.
+ * @note The chunks of the given buffer are moved into the buffer, so the
+ * given buffer is empty after the call, and the pointers to its tokens stay
+ * valid. The payloads of the replaced tokens are freed.
+ */
+void
+splice__LilyTokenBuffer(LilyTokenBuffer *self,
+                        Usize start,
+                        Usize end,
+                        LilyTokenBuffer *tokens);
+
+/**
+ *
+ * @brief Get the token at the given index.
+ * @return LilyToken* (&)
+ */
+inline LilyToken *
+get__LilyTokenBuffer(const LilyTokenBuffer *self, Usize index)
+{
+    ASSERT(index < self->len);
+
+    return self->items[index];
+}
+
+/**
+ *
+ * @brief Convert the buffer in Vec<LilyToken* (&)>*.
+ * @note This function is used when a Vec of tokens is expected (e.g.
+ * LilyParseBlock).
+ */
+Vec *
+to_vec__LilyTokenBuffer(const LilyTokenBuffer *self);
+
+/**
+ *
+ * @brief Free LilyTokenBuffer type.
+ */
+DESTRUCTOR(LilyTokenBuffer, const LilyTokenBuffer *self);
+
+#endif // LILY_CORE_LILY_SCANNER_TOKEN_BUFFER_H
@@ -0,0 +1,118 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2025 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_CORE_LILY_SCANNER_TOKEN_STREAM_H
+#define LILY_CORE_LILY_SCANNER_TOKEN_STREAM_H
+
+#include <base/new.h>
+#include <base/types.h>
+#include <base/vec.h>
+
+#include <core/lily/scanner/token.h>
+
+#include <pthread.h>
+
+#define LILY_TOKEN_STREAM_RING_CAPACITY 4096
+#define LILY_TOKEN_STREAM_CHUNK_CAPACITY 4096
+
+// NOTE: The stream is used to run the scanner (the producer) and the preparser
+// (the consumer) at the same time on two threads. The producer pushes the
+// tokens into a bounded ring, and waits when the ring is full (back-pressure).
+// The consumer moves the tokens out of the ring into chunks, which are never
+// reallocated, so a pointer to a received token stays valid until the stream
+// is freed (the preparser keeps pointers to the tokens in its items), or until
+// its chunk is released (see release__LilyTokenStream).
+typedef struct LilyTokenStream
+{
+    // NOTE: The following fields are shared by the producer and the consumer,
+    // they're protected by the mutex.
+    LilyToken *ring;
+    Usize ring_start;
+    Usize ring_len;
+    bool is_closed;
+    pthread_mutex_t mutex;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+    // NOTE: The following fields are only used by the consumer.
+    Vec *chunks; // Vec<LilyToken*?>* - The released chunks are set to NULL.
+    Usize len;   // Number of tokens received by the consumer.
+} LilyTokenStream;
+
+/**
+ *
+ * @brief Construct LilyTokenStream type.
+ */
+CONSTRUCTOR(LilyTokenStream *, LilyTokenStream);
+
+/**
+ *
+ * @brief Push a token to the stream (producer side). If the ring is full, wait
+ * for the consumer.
+ * @note The token is moved into the stream (the given pointer is freed).
+ */
+void
+push__LilyTokenStream(LilyTokenStream *self, LilyToken *token);
+
+/**
+ *
+ * @brief Close the stream (producer side), after the last token is pushed.
+ */
+void
+close__LilyTokenStream(LilyTokenStream *self);
+
+/**
+ *
+ * @brief Check if the token at the given index exists (consumer side). If the
+ * token is not yet received, wait for the producer.
+ * @return Return false if the stream is closed before this token.
+ */
+bool
+has__LilyTokenStream(LilyTokenStream *self, Usize index);
+
+/**
+ *
+ * @brief Get the token at the given index (consumer side).
+ * @return LilyToken* (&)
+ */
+LilyToken *
+get__LilyTokenStream(LilyTokenStream *self, Usize index);
+
+/**
+ *
+ * @brief Release the received tokens (consumer side), once they're no longer
+ * used. The chunks which contain one of the kept tokens are not released.
+ * @param kept Vec<LilyToken* (&)>* - The tokens which must stay valid (e.g.
+ * the tokens of the macros).
+ * @note The stream must be closed and entirely received.
+ */
+void
+release__LilyTokenStream(LilyTokenStream *self, const Vec *kept);
+
+/**
+ *
+ * @brief Free LilyTokenStream type.
+ */
+DESTRUCTOR(LilyTokenStream, LilyTokenStream *self);
+
+#endif // LILY_CORE_LILY_SCANNER_TOKEN_STREAM_H
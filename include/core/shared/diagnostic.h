@@ -696,4 +696,62 @@ emit_note__Diagnostic(Diagnostic self);
 void
 emit__Diagnostic(Diagnostic self, Usize *count_error);
 
+// NOTE: When a buffer is set on the current thread (see
+// set_buffer__Diagnostic), the emitted diagnostics are stored in the buffer
+// instead of being printed, and the errors and the warnings are counted in the
+// buffer. This is used to emit the diagnostics of tasks run in parallel in a
+// deterministic order (see flush__DiagnosticBuffer).
+typedef struct DiagnosticBuffer
+{
+    Vec *messages; // Vec<String*>*
+    Usize count_error;
+    Usize count_warning;
+} DiagnosticBuffer;
+
+/**
+ *
+ * @brief Construct DiagnosticBuffer type.
+ */
+inline CONSTRUCTOR(DiagnosticBuffer, DiagnosticBuffer)
+{
+    return (DiagnosticBuffer){ .messages = NEW(Vec),
+                               .count_error = 0,
+                               .count_warning = 0 };
+}
+
+/**
+ *
+ * @brief Set the buffer of the current thread.
+ * @param buffer DiagnosticBuffer*? (&) - If the buffer is NULL, the
+ * diagnostics are printed again.
+ */
+void
+set_buffer__Diagnostic(DiagnosticBuffer *buffer);
+
+/**
+ *
+ * @brief Get the buffer of the current thread.
+ * @return DiagnosticBuffer*? (&)
+ */
+DiagnosticBuffer *
+get_buffer__Diagnostic();
+
+/**
+ *
+ * @brief Print the diagnostics of the buffer, and add the counts of the buffer
+ * to the given counters. The buffer is empty after the call.
+ * @note If a buffer is set on the current thread (e.g. the tasks are run by a
+ * task), the diagnostics and the counts are moved to this buffer instead.
+ */
+void
+flush__DiagnosticBuffer(DiagnosticBuffer *self,
+                        Usize *count_error,
+                        Usize *count_warning);
+
+/**
+ *
+ * @brief Free DiagnosticBuffer type.
+ */
+DESTRUCTOR(DiagnosticBuffer, const DiagnosticBuffer *self);
+
 #endif // LILY_CORE_SHARED_DIAGNOSTIC_H
@@ -51,6 +51,31 @@ inline CONSTRUCTOR(File, File, char *name, char *content)
                    .len = get_size__File(name) + 1 };
 }
 
+/**
+ *
+ * @brief Replace the content between start and end (excluded) by the
+ * replacement.
+ */
+inline void
+replace__File(File *self, Usize start, Usize end, const char *replacement)
+{
+    Usize replacement_len = strlen(replacement);
+    Usize len = self->len - (end - start) + replacement_len;
+    char *content = lily_malloc(len + 1);
+
+    memcpy(content, self->content, start);
+    memcpy(content + start, replacement, replacement_len);
+    memcpy(content + start + replacement_len,
+           self->content + end,
+           self->len - end);
+    content[len] = '\0';
+
+    lily_free(self->content);
+
+    self->content = content;
+    self->len = len;
+}
+
 /**
  *
  * @brief Free File type.
@@ -151,7 +151,8 @@ peek_char__Scanner(const Scanner *self, const Usize n);
 /**
  *
  * @brief Generic function for obtaining a keyword from any scanner.
- * @param keywords Expect an array sorted in ascending order.
+ * @param keywords_perfect_hash Minimal perfect hash of the keywords (generated
+ * by `scripts/perfect_hash_generator.py`).
  * @return If the return value is -1, this means that the function has not found
  * a keyword, or that this is an identifier.
  */
@@ -159,9 +160,11 @@ inline Int32
 get_keyword__Scanner(const String *id,
                      const SizedStr keywords[],
                      const Int32 keyword_ids[],
-                     const Usize keywords_len)
+                     const Usize keywords_len,
+                     const SearchPerfectHash *keywords_perfect_hash)
 {
-    return get_id__Search(id, keywords, keyword_ids, keywords_len);
+    return get_id_with_perfect_hash__Search(
+      id, keywords, keyword_ids, keywords_len, keywords_perfect_hash);
 }
 
 #endif // LILY_CORE_SHARED_SCANNER_H
@@ -29,6 +29,19 @@
 #include <base/string.h>
 #include <base/types.h>
 
+/**
+ *
+ * @brief Minimal perfect hash of a table of ids, generated at build time by
+ * `scripts/perfect_hash_generator.py`.
+ */
+typedef struct SearchPerfectHash
+{
+    const Uint16 *displacements;
+    Usize displacements_len;
+    const Uint16 *indexes; // indexes[slot] is the index of the id stored at the
+                           // slot
+} SearchPerfectHash;
+
 /**
  *
  * @brief Generic function to search id from available ids.
@@ -42,4 +55,20 @@ get_id__Search(const String *id,
                const Int32 ids[],
                const Usize ids_s_len);
 
+/**
+ *
+ * @brief Search id from available ids with the minimal perfect hash of the ids
+ * (one hash and one comparison).
+ * @param ids_s The order of the ids doesn't matter, but it must be the same as
+ * when the perfect hash was generated.
+ * @return If the return value is -1, this means that the function has not found
+ * the id.
+ */
+Int32
+get_id_with_perfect_hash__Search(const String *id,
+                                 const SizedStr ids_s[],
+                                 const Int32 ids[],
+                                 const Usize ids_s_len,
+                                 const SearchPerfectHash *perfect_hash);
+
 #endif // LILY_CORE_SHARED_SEARCH_H
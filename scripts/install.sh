@@ -97,9 +97,10 @@ mkdir $INSTALL_LATEST_PM_LIB_DIR_PATH
 # Create $HOME/.lily/latest/.version and write the latest version
 echo "$LATEST_VERSION" > $INSTALL_LATEST_DIR_PATH/.version
 
-# Copy `lily`, `lilyc` and `ci` to $INSTALL_LATEST_BIN_DIR_PATH
+# Copy `lily`, `lilyc`, `lilyd` and `ci` to $INSTALL_LATEST_BIN_DIR_PATH
 cp $LOCAL_BIN_DIR/lily $INSTALL_LATEST_BIN_DIR_PATH
 cp $LOCAL_BIN_DIR/lilyc $INSTALL_LATEST_BIN_DIR_PATH
+cp $LOCAL_BIN_DIR/lilyd $INSTALL_LATEST_BIN_DIR_PATH
 cp $LOCAL_BIN_DIR/ci $INSTALL_LATEST_BIN_DIR_PATH
 
 # Copy `liblily_sys.so/dylib` and `liblily_builtin.so/dylib` to $INSTALL_LATEST_LIB_DIR_PATH.
@@ -0,0 +1,270 @@
+#!/bin/python3
+
+# MIT License
+#
+# Copyright (c) 2022-2025 ArthurPV
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+# This script generates the minimal perfect hash tables used by
+# `get_id_with_perfect_hash__Search` (see `include/core/shared/search.h`).
+#
+# The keys are read from the `SizedStr` tables of the source files listed in
+# `TABLES`, so the source file stays the only place where a keyword is added
+# or removed. The generated header only contains the displacements, which map
+# a key to its index in the `SizedStr` table (and so to the same index in the
+# ids table).
+#
+# Usage:
+#   ./scripts/perfect_hash_generator.py [--check]
+#
+# NOTE: The hash functions below must be kept in sync with `hash_fnv1a_64`
+# (`src/base/hash/fnv.c`) and `get_slot__SearchPerfectHash`
+# (`src/core/shared/search.c`).
+
+from dataclasses import dataclass
+
+import os
+import re
+import sys
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+
+MASK_64 = (1 << 64) - 1
+
+FNV1A_64_OFFSET = 0xcbf29ce484222325
+FNV1A_64_PRIME = 0x100000001b3
+
+SLOT_MULTIPLIER = 0x9e3779b97f4a7c15
+SLOT_MIX = 0xff51afd7ed558ccd
+
+MAX_DISPLACEMENT = 0xffff
+
+LICENSE = """/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2025 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+"""
+
+@dataclass
+class Table:
+    source : str
+    output : str
+    names : list[str]
+
+TABLES = [
+    Table("src/core/lily/scanner/scanner.c",
+          "include/core/lily/scanner/perfect_hash.h",
+          ["lily_keywords", "lily_at_keywords"]),
+    Table("src/core/cc/ci/scanner.c",
+          "include/core/cc/ci/perfect_hash/scanner.h",
+          ["ci_keywords",
+           "ci_attributes",
+           "ci_builtin_macros",
+           "ci_standard_predefined_macros",
+           "ci_preprocessors"]),
+    Table("src/core/cc/ci/parser.c",
+          "include/core/cc/ci/perfect_hash/parser.h",
+          ["ci_standard_attributes"]),
+    Table("src/core/cc/ci/builtin.c",
+          "include/core/cc/ci/perfect_hash/builtin.h",
+          ["builtin_function_names", "builtin_type_names"]),
+]
+
+def hash_fnv1a_64(key: str) -> int:
+    hash = FNV1A_64_OFFSET
+
+    for c in key.encode("ascii"):
+        hash ^= c
+        hash = (hash * FNV1A_64_PRIME) & MASK_64
+
+    return hash
+
+def get_bucket(hash: int, buckets_len: int) -> int:
+    return (hash >> 32) % buckets_len
+
+def get_slot(hash: int, displacement: int, keys_len: int) -> int:
+    h = hash ^ ((displacement * SLOT_MULTIPLIER) & MASK_64)
+    h ^= h >> 33
+    h = (h * SLOT_MIX) & MASK_64
+    h ^= h >> 33
+
+    return h % keys_len
+
+def parse_table(content: str, name: str) -> list[str]:
+    match = re.search(r"static\s+(?:const\s+)?SizedStr\s+" + name +
+                      r"\s*\[[^\]]*\]\s*=\s*\{(.*?)\};",
+                      content,
+                      re.DOTALL)
+
+    if match is None:
+        raise Exception(f"table `{name}` not found")
+
+    return re.findall(r"SIZED_STR_FROM_RAW\(\"([^\"]*)\"\)", match.group(1))
+
+def generate_displacements(keys: list[str]) -> tuple[list[int], list[int]]:
+    """
+    Hash and displace: the keys are distributed in buckets, then the biggest
+    buckets look first for a displacement which puts all of their keys in free
+    slots.
+    @return (displacements, indexes) where indexes[slot] is the index of the
+    key (in the source table) stored at this slot.
+    """
+    buckets_len = max(1, (len(keys) + 1) // 2)
+    buckets = [[] for _ in range(buckets_len)]
+    hashes = [hash_fnv1a_64(key) for key in keys]
+
+    for index, hash in enumerate(hashes):
+        buckets[get_bucket(hash, buckets_len)].append(index)
+
+    displacements = [0] * buckets_len
+    slots = [-1] * len(keys)
+
+    for bucket_index in sorted(range(buckets_len),
+                               key=lambda i: len(buckets[i]),
+                               reverse=True):
+        bucket = buckets[bucket_index]
+
+        if not bucket:
+            break
+
+        for displacement in range(MAX_DISPLACEMENT + 1):
+            bucket_slots = [get_slot(hashes[index], displacement, len(keys))
+                            for index in bucket]
+
+            if len(set(bucket_slots)) == len(bucket_slots) and \
+                all(slots[slot] == -1 for slot in bucket_slots):
+                for index, slot in zip(bucket, bucket_slots):
+                    slots[slot] = index
+
+                displacements[bucket_index] = displacement
+                break
+        else:
+            raise Exception(f"no displacement found for the keys: {keys}")
+
+    return (displacements, slots)
+
+def generate_array_items(items: list[int]) -> str:
+    res = ""
+    line = "   "
+
+    for item in items:
+        item = f" {item},"
+
+        if len(line) + len(item) > 80:
+            res += line + "\n"
+            line = "   "
+
+        line += item
+
+    return res + line + "\n};\n\n"
+
+def generate_table(name: str, keys: list[str]) -> str:
+    if len(set(keys)) != len(keys):
+        raise Exception(f"table `{name}` contains duplicate keys")
+
+    displacements, indexes = generate_displacements(keys)
+    res = f"// {name}: {len(keys)} keys, {len(displacements)} buckets\n"
+    res += f"#define {name.upper()}_PERFECT_HASH_KEYS_LEN {len(keys)}\n\n"
+    res += f"static const Uint16 {name}_displacements[{len(displacements)}] = {{\n"
+
+    res += generate_array_items(displacements)
+    res += f"static const Uint16 {name}_indexes[{len(indexes)}] = {{\n"
+    res += generate_array_items(indexes)
+    res += f"static const SearchPerfectHash {name}_perfect_hash = {{\n"
+    res += f"    .displacements = {name}_displacements,\n"
+    res += f"    .displacements_len = {len(displacements)},\n"
+    res += f"    .indexes = {name}_indexes\n"
+    res += "};\n"
+
+    return res
+
+def get_header_guard(output: str) -> str:
+    parts = os.path.splitext(output)[0].split("/")[1:]
+
+    # NOTE: If the folder and the file have the same name, we avoid repeating
+    # the same name (see CODING_STYLES.md).
+    if len(parts) > 1 and parts[-1] == parts[-2]:
+        parts.pop()
+
+    return "LILY_" + "_".join(parts).upper() + "_H"
+
+def generate_header(table: Table) -> str:
+    with open(os.path.join(ROOT, table.source), "r") as f:
+        content = f.read()
+
+    guard = get_header_guard(table.output)
+    res = LICENSE + "\n"
+    res += "// NOTE: This file is generated by "
+    res += "`scripts/perfect_hash_generator.py`\n"
+    res += f"// from `{table.source}`. Don't edit it by hand.\n\n"
+    res += f"#ifndef {guard}\n#define {guard}\n\n"
+    res += "#include <core/shared/search.h>\n\n"
+    res += "// clang-format off\n"
+
+    for name in table.names:
+        res += "\n" + generate_table(name, parse_table(content, name))
+
+    res += "\n// clang-format on\n"
+    res += f"\n#endif // {guard}\n"
+
+    return res
+
+def main():
+    check = "--check" in sys.argv[1:]
+    has_diff = False
+
+    for table in TABLES:
+        header = generate_header(table)
+        output = os.path.join(ROOT, table.output)
+
+        if check:
+            with open(output, "r") as f:
+                if f.read() != header:
+                    print(f"error: {table.output} is out of date, please run "
+                          "`make perfect_hash`")
+                    has_diff = True
+        else:
+            with open(output, "w") as f:
+                f.write(header)
+
+    if has_diff:
+        sys.exit(1)
+
+if __name__ == "__main__":
+    main()
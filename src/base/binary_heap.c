@@ -0,0 +1,146 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2025 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/alloc.h>
+#include <base/assert.h>
+#include <base/binary_heap.h>
+
+/// @brief Move up the item at `index` until its parent must be popped before
+/// it.
+static void
+sift_up__BinaryHeap(BinaryHeap *self, Usize index);
+
+/// @brief Move down the item at `index` until its children must be popped
+/// after it.
+static void
+sift_down__BinaryHeap(BinaryHeap *self, Usize index);
+
+CONSTRUCTOR(BinaryHeap *,
+            BinaryHeap,
+            bool (*cmp)(const void *lhs, const void *rhs))
+{
+    BinaryHeap *self = lily_malloc(sizeof(BinaryHeap));
+
+    self->buffer = NULL;
+    self->len = 0;
+    self->capacity = 0;
+    self->cmp = cmp;
+
+    return self;
+}
+
+void
+sift_up__BinaryHeap(BinaryHeap *self, Usize index)
+{
+    while (index > 0) {
+        Usize parent = (index - 1) / 2;
+
+        if (!self->cmp(self->buffer[index], self->buffer[parent])) {
+            break;
+        }
+
+        SWAP(self->buffer[index], self->buffer[parent]);
+        index = parent;
+    }
+}
+
+void
+sift_down__BinaryHeap(BinaryHeap *self, Usize index)
+{
+    for (;;) {
+        Usize first = index;
+        Usize left = 2 * index + 1;
+        Usize right = left + 1;
+
+        if (left < self->len &&
+            self->cmp(self->buffer[left], self->buffer[first])) {
+            first = left;
+        }
+
+        if (right < self->len &&
+            self->cmp(self->buffer[right], self->buffer[first])) {
+            first = right;
+        }
+
+        if (first == index) {
+            break;
+        }
+
+        SWAP(self->buffer[index], self->buffer[first]);
+        index = first;
+    }
+}
+
+bool
+empty__BinaryHeap(const BinaryHeap *self)
+{
+    return self->len == 0;
+}
+
+void
+push__BinaryHeap(BinaryHeap *self, void *item)
+{
+    if (self->len == self->capacity) {
+        self->capacity = self->capacity ? self->capacity * 2 : 4;
+        self->buffer =
+          self->buffer ? lily_realloc(self->buffer, PTR_SIZE * self->capacity)
+                       : lily_malloc(PTR_SIZE * self->capacity);
+    }
+
+    self->buffer[self->len] = item;
+    sift_up__BinaryHeap(self, self->len++);
+}
+
+void *
+pop__BinaryHeap(BinaryHeap *self)
+{
+    ASSERT(self->len > 0);
+
+    void *res = self->buffer[0];
+
+    self->buffer[0] = self->buffer[--self->len];
+
+    if (self->len > 0) {
+        sift_down__BinaryHeap(self, 0);
+    }
+
+    return res;
+}
+
+void *
+peek__BinaryHeap(const BinaryHeap *self)
+{
+    ASSERT(self->len > 0);
+
+    return self->buffer[0];
+}
+
+DESTRUCTOR(BinaryHeap, BinaryHeap *self)
+{
+    if (self->buffer) {
+        lily_free(self->buffer);
+    }
+
+    lily_free(self);
+}
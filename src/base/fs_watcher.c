@@ -44,23 +44,27 @@ CONSTRUCTOR(FsWatcher, FsWatcher, Int32 flags)
     return (FsWatcher){ .fd = fd, .wd = { .content = NULL, .len = 0 } };
 }
 
-void
+Int32
 add__FsWatcher(FsWatcher *self, const char *path, Int32 mask)
 {
     Int32 new_wd_item = inotify_add_watch(self->fd, path, mask);
 
-    ASSERT(new_wd_item != -1);
+    if (new_wd_item == -1) {
+        return -1;
+    }
 
     if (!self->wd.content) {
         self->wd.content = malloc(sizeof(Int32));
         *self->wd.content = new_wd_item;
         ++self->wd.len;
-        return;
+        return new_wd_item;
     }
 
     self->wd.content =
       realloc(self->wd.content, sizeof(Int32) * (self->wd.len + 1));
     self->wd.content[self->wd.len++] = new_wd_item;
+
+    return new_wd_item;
 }
 
 Int32
@@ -71,7 +75,7 @@ get_fd__FsWatcher(const FsWatcher *self)
     return self->fd;
 }
 
-DESTRUCTOR(FsWatcher, FsWatcher, const FsWatcher *self)
+DESTRUCTOR(FsWatcher, const FsWatcher *self)
 {
     close(self->fd);
 
@@ -0,0 +1,347 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2025 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <base/alloc.h>
+#include <base/assert.h>
+#include <base/jobserver.h>
+#include <base/platform.h>
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef LILY_UNIX_OS
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <unistd.h>
+#endif
+
+// NOTE: The file descriptor used to read the tokens is always opened in
+// non-blocking mode by the client, so the non-blocking mode doesn't leak to
+// the other clients of the jobserver (the file descriptors inherited from make
+// are shared with them).
+static int read_fd = -1;
+static int write_fd = -1;
+// The write file descriptor of the pipe form belongs to make.
+static bool write_fd_is_owned = false;
+// It's true when the read file descriptor shares the blocking file description
+// of make (see reopen_fd__Jobserver).
+static bool read_fd_is_blocking = false;
+
+// The tokens are given back with the same value, since make can use it to
+// send the status of the build (e.g. `-` when a job has failed).
+static char *tokens = NULL; // char*?
+static Usize tokens_len = 0;
+static Usize tokens_capacity = 0;
+static pthread_mutex_t tokens_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+#ifdef LILY_UNIX_OS
+// The process which has taken the tokens (a forked process doesn't give back
+// the tokens of its parent).
+static pid_t tokens_pid = -1;
+static bool release_at_exit_is_registered = false;
+
+/**
+ *
+ * @brief Give back the tokens which are still taken when the process exits
+ * (e.g. `exit(1)` after an error), so that they're not lost for make.
+ */
+static void
+release_at_exit__Jobserver();
+
+/**
+ *
+ * @brief Open a new non-blocking file description of the pipe.
+ * @return the file descriptor or -1.
+ */
+static int
+reopen_fd__Jobserver(int fd);
+
+/**
+ *
+ * @brief Get the value of the option in MAKEFLAGS.
+ * @return const char*? (&) - The value ends at the next space.
+ */
+static const char *
+get_option__Jobserver(const char *makeflags, const char *option);
+
+int
+reopen_fd__Jobserver(int fd)
+{
+    if (fcntl(fd, F_GETFD) == -1) {
+        // NOTE: The file descriptor is closed (e.g. the rule isn't prefixed by
+        // `+`, so make didn't pass the jobserver).
+        return -1;
+    }
+
+#ifdef LILY_LINUX_OS
+    char path[64];
+
+    snprintf(path, sizeof(path), "/proc/self/fd/%d", fd);
+
+    int new_fd = open(path, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+
+    if (new_fd != -1) {
+        return new_fd;
+    }
+#endif
+
+    // NOTE: Without a new file description, the file descriptor stays in
+    // blocking mode, and O_NONBLOCK can't be set on it without changing the
+    // mode of make and of the other clients. Even after a poll, a token taken
+    // by another client before the read would block the read, so no token is
+    // read from this file descriptor (see try_acquire__Jobserver).
+    read_fd_is_blocking = true;
+
+    return dup(fd);
+}
+
+void
+release_at_exit__Jobserver()
+{
+    if (!is_active__Jobserver() || getpid() != tokens_pid) {
+        return;
+    }
+
+    // NOTE: The mutex is never held for long, because the reads never block.
+    pthread_mutex_lock(&tokens_mutex);
+
+    while (tokens_len > 0) {
+        char token = tokens[--tokens_len];
+
+        while (write(write_fd, &token, 1) == -1 && errno == EINTR) {
+        }
+    }
+
+    pthread_mutex_unlock(&tokens_mutex);
+}
+
+const char *
+get_option__Jobserver(const char *makeflags, const char *option)
+{
+    const char *res = NULL;
+    Usize option_len = strlen(option);
+
+    // NOTE: The last option wins (e.g. a sub make which overrides it).
+    for (const char *current = strstr(makeflags, option); current;
+         current = strstr(current + option_len, option)) {
+        if (current == makeflags || current[-1] == ' ') {
+            res = current + option_len;
+        }
+    }
+
+    return res;
+}
+#endif
+
+bool
+init__Jobserver(const char *makeflags)
+{
+    ASSERT(read_fd == -1 && write_fd == -1);
+
+#ifdef LILY_UNIX_OS
+    if (!makeflags) {
+        return false;
+    }
+
+    const char *auth = get_option__Jobserver(makeflags, "--jobserver-auth=");
+
+    if (!auth) {
+        auth = get_option__Jobserver(makeflags, "--jobserver-fds=");
+    }
+
+    if (!auth) {
+        return false;
+    }
+
+    if (!strncmp(auth, "fifo:", 5)) {
+        const char *path_begin = auth + 5;
+        Usize path_len = strcspn(path_begin, " ");
+        char *path = lily_malloc(path_len + 1);
+
+        memcpy(path, path_begin, path_len);
+        path[path_len] = '\0';
+
+        read_fd = open(path, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+        write_fd = open(path, O_WRONLY | O_CLOEXEC);
+        write_fd_is_owned = true;
+
+        lily_free(path);
+    } else {
+        int r = -1;
+        int w = -1;
+
+        if (sscanf(auth, "%d,%d", &r, &w) == 2 && r >= 0 && w >= 0 &&
+            fcntl(w, F_GETFD) != -1) {
+            read_fd = reopen_fd__Jobserver(r);
+            write_fd = w;
+        }
+    }
+
+    if (read_fd == -1 || write_fd == -1) {
+        if (read_fd != -1) {
+            close(read_fd);
+        }
+
+        if (write_fd != -1 && write_fd_is_owned) {
+            close(write_fd);
+        }
+
+        read_fd = -1;
+        write_fd = -1;
+        write_fd_is_owned = false;
+        read_fd_is_blocking = false;
+
+        return false;
+    }
+
+    tokens_pid = getpid();
+
+    if (!release_at_exit_is_registered) {
+        atexit(&release_at_exit__Jobserver);
+        release_at_exit_is_registered = true;
+    }
+
+    return true;
+#else
+    (void)makeflags;
+
+    return false;
+#endif
+}
+
+bool
+is_active__Jobserver()
+{
+    return read_fd != -1;
+}
+
+Usize
+try_acquire__Jobserver(Usize wanted)
+{
+    if (!is_active__Jobserver()) {
+        return wanted;
+    }
+
+#ifdef LILY_UNIX_OS
+    Usize acquired = 0;
+
+    // NOTE: Only the implicit token of the process is used (see
+    // reopen_fd__Jobserver).
+    if (read_fd_is_blocking) {
+        return 0;
+    }
+
+    pthread_mutex_lock(&tokens_mutex);
+
+    while (acquired < wanted) {
+        struct pollfd poll_fd = { .fd = read_fd, .events = POLLIN };
+        char token;
+
+        if (poll(&poll_fd, 1, 0) != 1) {
+            break;
+        }
+
+        ssize_t n = read(read_fd, &token, 1);
+
+        if (n == -1 && errno == EINTR) {
+            continue;
+        } else if (n != 1) {
+            // NOTE: No token is available (EAGAIN) or the jobserver is
+            // closed.
+            break;
+        }
+
+        if (tokens_len == tokens_capacity) {
+            tokens_capacity = tokens_capacity ? tokens_capacity * 2 : 8;
+            tokens = lily_realloc(tokens, tokens_capacity);
+        }
+
+        tokens[tokens_len++] = token;
+        ++acquired;
+    }
+
+    pthread_mutex_unlock(&tokens_mutex);
+
+    return acquired;
+#else
+    return wanted;
+#endif
+}
+
+void
+release__Jobserver(Usize count)
+{
+    if (!is_active__Jobserver()) {
+        return;
+    }
+
+#ifdef LILY_UNIX_OS
+    pthread_mutex_lock(&tokens_mutex);
+
+    ASSERT(count <= tokens_len);
+
+    for (Usize i = 0; i < count; ++i) {
+        char token = tokens[--tokens_len];
+
+        while (write(write_fd, &token, 1) == -1 && errno == EINTR) {
+        }
+    }
+
+    pthread_mutex_unlock(&tokens_mutex);
+#endif
+}
+
+void
+close__Jobserver()
+{
+    if (!is_active__Jobserver()) {
+        return;
+    }
+
+    ASSERT(tokens_len == 0);
+
+#ifdef LILY_UNIX_OS
+    close(read_fd);
+
+    if (write_fd_is_owned) {
+        close(write_fd);
+    }
+#endif
+
+    read_fd = -1;
+    write_fd = -1;
+    write_fd_is_owned = false;
+    read_fd_is_blocking = false;
+
+    if (tokens) {
+        lily_free(tokens);
+        tokens = NULL;
+        tokens_capacity = 0;
+    }
+}
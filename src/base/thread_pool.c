@@ -0,0 +1,176 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2025 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/alloc.h>
+#include <base/assert.h>
+#include <base/jobserver.h>
+#include <base/platform.h>
+#include <base/thread_pool.h>
+
+#include <pthread.h>
+#include <stdatomic.h>
+
+#ifdef LILY_WINDOWS_OS
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+typedef struct ThreadPoolRun
+{
+    Usize len;
+    void (*task)(void *ctx, Usize index);
+    void *ctx;
+    atomic_size_t next; // Index of the next task to run.
+} ThreadPoolRun;
+
+/// @brief Get the number of online processors (at least 1).
+static Usize
+get_cpu_count__ThreadPool();
+
+/// @brief Run the tasks until there is no more task to pick.
+/// @param run ThreadPoolRun* (&)
+/// @return NULL
+static void *
+work__ThreadPool(void *run);
+
+static atomic_size_t default_jobs = 0;
+
+// Number of threads reserved by the nested runs (see reserve_jobs__ThreadPool).
+static atomic_size_t reserved_jobs = 0;
+
+CONSTRUCTOR(ThreadPool, ThreadPool, Usize jobs)
+{
+    return (ThreadPool){ .jobs = jobs ? jobs : get_default_jobs__ThreadPool() };
+}
+
+Usize
+get_cpu_count__ThreadPool()
+{
+#ifdef LILY_WINDOWS_OS
+    SYSTEM_INFO info;
+
+    GetSystemInfo(&info);
+
+    return info.dwNumberOfProcessors > 0 ? info.dwNumberOfProcessors : 1;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return count > 0 ? count : 1;
+#endif
+}
+
+Usize
+get_default_jobs__ThreadPool()
+{
+    Usize jobs = atomic_load(&default_jobs);
+
+    return jobs ? jobs : get_cpu_count__ThreadPool();
+}
+
+void
+set_default_jobs__ThreadPool(Usize jobs)
+{
+    atomic_store(&default_jobs, jobs);
+}
+
+Usize
+reserve_jobs__ThreadPool(Usize wanted)
+{
+    // NOTE: The calling thread of the outermost run is not reserved.
+    Usize max = get_default_jobs__ThreadPool() - 1;
+    Usize reserved = atomic_load(&reserved_jobs);
+
+    for (;;) {
+        Usize available = reserved < max ? max - reserved : 0;
+        Usize jobs = wanted < available ? wanted : available;
+
+        if (jobs == 0) {
+            return 0;
+        }
+
+        if (atomic_compare_exchange_weak(
+              &reserved_jobs, &reserved, reserved + jobs)) {
+            // NOTE: Under a jobserver (e.g. `make -jN`), each reserved thread
+            // also needs a token, so the reservation can be smaller.
+            Usize acquired = try_acquire__Jobserver(jobs);
+
+            if (acquired < jobs) {
+                atomic_fetch_sub(&reserved_jobs, jobs - acquired);
+            }
+
+            return acquired;
+        }
+    }
+}
+
+void
+release_jobs__ThreadPool(Usize jobs)
+{
+    release__Jobserver(jobs);
+    atomic_fetch_sub(&reserved_jobs, jobs);
+}
+
+void *
+work__ThreadPool(void *run)
+{
+    ThreadPoolRun *self = run;
+
+    for (Usize i = atomic_fetch_add(&self->next, 1); i < self->len;
+         i = atomic_fetch_add(&self->next, 1)) {
+        self->task(self->ctx, i);
+    }
+
+    return NULL;
+}
+
+void
+run__ThreadPool(const ThreadPool *self,
+                Usize len,
+                void (*task)(void *ctx, Usize index),
+                void *ctx)
+{
+    ThreadPoolRun run = { .len = len, .task = task, .ctx = ctx, .next = 0 };
+    Usize threads_len = (self->jobs < len ? self->jobs : len);
+
+    // NOTE: The calling thread is one of the threads of the pool.
+    threads_len = threads_len > 0 ? threads_len - 1 : 0;
+
+    pthread_t *threads =
+      threads_len > 0 ? lily_malloc(sizeof(pthread_t) * threads_len) : NULL;
+
+    for (Usize i = 0; i < threads_len; ++i) {
+        ASSERT(!pthread_create(&threads[i], NULL, &work__ThreadPool, &run));
+    }
+
+    work__ThreadPool(&run);
+
+    for (Usize i = 0; i < threads_len; ++i) {
+        pthread_join(threads[i], NULL);
+    }
+
+    if (threads) {
+        lily_free(threads);
+    }
+}
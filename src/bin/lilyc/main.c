@@ -24,12 +24,17 @@
 
 #include <base/cli/args.h>
 #include <base/cli/result.h>
+#include <base/platform.h>
 
 #include <cli/lilyc/lilyc.h>
 #include <cli/lilyc/parse_config.h>
 
 #include <command/lilyc/lilyc.h>
 
+#ifdef LILY_UNIX_OS
+#include <command/lilyd/lilyd.h>
+#endif
+
 #include <llvm-c/Core.h>
 
 int
@@ -40,13 +45,24 @@ main(int argc, char **argv)
     Vec *res = cli.$parse(&cli);
 
     FREE(Cli, &cli);
-    FREE(Vec, args);
 
     LilycConfig config = run__LilycParseConfig(res);
 
     FREE_BUFFER_ITEMS(res->buffer, res->len, CliResult);
     FREE(Vec, res);
 
+#ifdef LILY_UNIX_OS
+    if (config.daemon) {
+        int status = send_request__Lilyd(config.daemon, args);
+
+        FREE(Vec, args);
+
+        return status;
+    }
+#endif
+
+    FREE(Vec, args);
+
     run__Lilyc(&config);
 
     LLVMShutdown();
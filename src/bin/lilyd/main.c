@@ -0,0 +1,53 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2025 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/cli/args.h>
+#include <base/cli/result.h>
+
+#include <cli/lilyd/lilyd.h>
+#include <cli/lilyd/parse_config.h>
+
+#include <command/lilyd/lilyd.h>
+
+#include <llvm-c/Core.h>
+
+int
+main(int argc, char **argv)
+{
+    Vec *args = build__CliArgs(argc, argv);
+    Cli cli = build__CliLilyd(args);
+    Vec *res = cli.$parse(&cli);
+
+    FREE(Cli, &cli);
+    FREE(Vec, args);
+
+    LilydConfig config = run__LilydParseConfig(res);
+
+    FREE_BUFFER_ITEMS(res->buffer, res->len, CliResult);
+    FREE(Vec, res);
+
+    run__Lilyd(&config);
+
+    LLVMShutdown();
+}
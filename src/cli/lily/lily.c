@@ -235,6 +235,7 @@ run_options__CliLily(CliCommand *cmd)
     CliOption *args = NEW(CliOption, "---");
     CliOption *max_stack = NEW(CliOption, "--max-stack");
     CliOption *max_heap = NEW(CliOption, "--max-heap");
+    CliOption *lazy = NEW(CliOption, "--lazy");
 
     verbose->$short_name(verbose, "-v")
       ->$help(verbose, "Enable log step of the interpreter");
@@ -249,11 +250,15 @@ run_options__CliLily(CliCommand *cmd)
       ->$value(max_heap,
                NEW(CliValue, CLI_VALUE_KIND_SINGLE, "CAPACITY", false))
       ->$help(max_heap, "Set a max heap capacity in BYTES");
+    lazy->$help(lazy,
+                "Only parse and check the functions reachable from main (the "
+                "errors of the other functions are not reported)");
 
     return cmd->$option(cmd, verbose)
       ->$option(cmd, args)
       ->$option(cmd, max_stack)
-      ->$option(cmd, max_heap);
+      ->$option(cmd, max_heap)
+      ->$option(cmd, lazy);
 }
 
 CliCommand *
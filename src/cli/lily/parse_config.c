@@ -61,6 +61,7 @@
 #define RUN_ARGS_OPTION 4
 #define RUN_MAX_STACK_OPTION 5
 #define RUN_MAX_HEAP_OPTION 6
+#define RUN_LAZY_OPTION 7
 
 // NOTE: The following options, are builtin:
 /*
@@ -260,6 +261,7 @@ LilyConfig
 parse_run__LilyParseConfig(const Vec *results)
 {
     bool verbose = false;
+    bool lazy = false;
     char *filename = NULL;
     Vec *args = init__Vec(1, "<app>");
     char *max_stack = NULL, *max_heap = NULL;
@@ -291,6 +293,9 @@ parse_run__LilyParseConfig(const Vec *results)
                     case RUN_MAX_HEAP_OPTION:
                         max_heap = current->option->value->single;
                         break;
+                    case RUN_LAZY_OPTION:
+                        lazy = true;
+                        break;
                     default:
                         UNREACHABLE("unknown option");
                 }
@@ -321,7 +326,8 @@ parse_run__LilyParseConfig(const Vec *results)
                            verbose,
                            args,
                            max_stack_capacity,
-                           max_heap_capacity));
+                           max_heap_capacity,
+                           lazy));
 }
 
 LilyConfig
@@ -23,7 +23,10 @@
  */
 
 #include <base/assert.h>
+#include <base/atoi.h>
 #include <base/cli/result.h>
+#include <base/optional.h>
+#include <base/platform.h>
 
 #include <cli/emit.h>
 #include <cli/lilyc/parse_config.h>
@@ -77,6 +80,11 @@
 #define VERBOSE_OPTION 40
 #define R_OPTION 41
 #define RUN_OPTION 42
+#define J_OPTION 43
+#define JOBS_OPTION 44
+#define W_OPTION 45
+#define WATCH_OPTION 46
+#define DAEMON_OPTION 47
 
 LilycConfig
 run__LilycParseConfig(const Vec *results)
@@ -95,8 +103,11 @@ run__LilycParseConfig(const Vec *results)
     bool o0 = false, o1 = false, o2 = false, o3 = false, oz = false;
     bool verbose = false;
     bool run = false;
+    bool watch = false;
     const char *target = NULL;
     const char *output = NULL;
+    const char *daemon = NULL;
+    const char *jobs = NULL;
     VecIter iter = NEW(VecIter, results);
     CliResult *current = NULL;
 
@@ -219,6 +230,27 @@ run__LilycParseConfig(const Vec *results)
                     case R_OPTION:
                     case RUN_OPTION:
                         run = true;
+                        break;
+                    case J_OPTION:
+                    case JOBS_OPTION:
+                        ASSERT(current->option->value);
+                        ASSERT(current->option->value->kind ==
+                               CLI_RESULT_VALUE_KIND_SINGLE);
+
+                        jobs = current->option->value->single;
+
+                        break;
+                    case W_OPTION:
+                    case WATCH_OPTION:
+                        watch = true;
+                        break;
+                    case DAEMON_OPTION:
+                        ASSERT(current->option->value);
+                        ASSERT(current->option->value->kind ==
+                               CLI_RESULT_VALUE_KIND_SINGLE);
+
+                        daemon = current->option->value->single;
+
                         break;
                     default:
                         UNREACHABLE("unknown option");
@@ -238,10 +270,57 @@ run__LilycParseConfig(const Vec *results)
         exit(1);
     }
 
+    if (watch && daemon) {
+        EMIT_ERROR("you cannot use `-w` or `--watch` option with `--daemon` "
+                   "option");
+        exit(1);
+    }
+
+#ifndef LILY_UNIX_OS
+    if (daemon) {
+        EMIT_ERROR("`--daemon` option is only supported on Unix");
+        exit(1);
+    }
+#endif
+
+#ifndef LILY_LINUX_OS
+    if (watch) {
+        EMIT_ERROR("`-w` or `--watch` option is only supported on Linux");
+        exit(1);
+    }
+#endif
+
+    // Check the value of some options.
+
+    Usize jobs_value = 0;
+
+    if (jobs) {
+        bool is_number = *jobs != '\0';
+
+        for (const char *c = jobs; *c && is_number; ++c) {
+            is_number = *c >= '0' && *c <= '9';
+        }
+
+        Optional *jobs_op = is_number ? atoi_safe__Usize(jobs, 10) : NONE;
+
+        if (is_none__Optional(jobs_op)) {
+            FREE(Optional, jobs_op);
+
+            EMIT_ERROR(
+              "expected a number of jobs with `-j` or `--jobs` option");
+            exit(1);
+        }
+
+        jobs_value = (Usize)(Uptr)get__Optional(jobs_op);
+
+        FREE(Optional, jobs_op);
+    }
+
     return NEW(LilycConfig,
                filename,
                target,
                output,
+               daemon,
                build,
                run_scanner,
                run_preparser,
@@ -271,5 +350,7 @@ run__LilycParseConfig(const Vec *results)
                o3,
                oz,
                verbose,
-               run);
+               run,
+               jobs_value,
+               watch);
 }
@@ -0,0 +1,53 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2025 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <cli/lilyd/lilyd.h>
+#include <cli/version.h>
+
+Cli
+build__CliLilyd(Vec *args)
+{
+    Cli cli = NEW(Cli, args, "lilyd");
+    CliOption *idle_timeout = NEW(CliOption, "--idle-timeout");
+    CliOption *max_memory = NEW(CliOption, "--max-memory");
+
+    idle_timeout
+      ->$help(idle_timeout,
+              "Exit after <SECONDS> without request (0 to never exit)")
+      ->$value(idle_timeout,
+               NEW(CliValue, CLI_VALUE_KIND_SINGLE, "SECONDS", true));
+    max_memory
+      ->$help(max_memory, "Limit the memory of each compilation to <BYTES>")
+      ->$value(max_memory,
+               NEW(CliValue, CLI_VALUE_KIND_SINGLE, "BYTES", true));
+
+    cli.$version(&cli, VERSION)
+      ->$author(&cli, "ArthurPV")
+      ->$about(&cli, "The Lily compile server")
+      ->$single_value(&cli, "SOCKET", true)
+      ->$option(&cli, idle_timeout)
+      ->$option(&cli, max_memory);
+
+    return cli;
+}
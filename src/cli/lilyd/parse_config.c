@@ -0,0 +1,106 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2025 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/assert.h>
+#include <base/atoi.h>
+#include <base/cli/result.h>
+
+#include <cli/emit.h>
+#include <cli/lilyd/parse_config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+// NOTE: The following options, are builtin:
+/*
+#define H_OPTION 0
+#define HELP_OPTION 1
+#define V_OPTION 2
+#define VERSION_OPTION 3
+*/
+#define IDLE_TIMEOUT_OPTION 4
+#define MAX_MEMORY_OPTION 5
+
+// Default number of seconds without request before exiting.
+#define DEFAULT_IDLE_TIMEOUT 600
+
+LilydConfig
+run__LilydParseConfig(const Vec *results)
+{
+    const char *socket_path = NULL;
+    const char *idle_timeout = NULL;
+    const char *max_memory = NULL;
+    VecIter iter = NEW(VecIter, results);
+    CliResult *current = NULL;
+
+    while ((current = next__VecIter(&iter))) {
+        switch (current->kind) {
+            case CLI_RESULT_KIND_VALUE:
+                ASSERT(current->value);
+                ASSERT(current->value->kind == CLI_RESULT_VALUE_KIND_SINGLE);
+
+                socket_path = current->value->single;
+
+                break;
+            case CLI_RESULT_KIND_OPTION:
+                switch (current->option->id) {
+                    case IDLE_TIMEOUT_OPTION:
+                        ASSERT(current->option->value);
+                        ASSERT(current->option->value->kind ==
+                               CLI_RESULT_VALUE_KIND_SINGLE);
+
+                        idle_timeout = current->option->value->single;
+
+                        break;
+                    case MAX_MEMORY_OPTION:
+                        ASSERT(current->option->value);
+                        ASSERT(current->option->value->kind ==
+                               CLI_RESULT_VALUE_KIND_SINGLE);
+
+                        max_memory = current->option->value->single;
+
+                        break;
+                    default:
+                        UNREACHABLE("unknown option");
+                }
+
+                break;
+            default:
+                UNREACHABLE("not expected in this context");
+        }
+    }
+
+    Usize max_memory_bytes = max_memory ? atoi__Usize(max_memory, 10) : 0;
+
+    if (max_memory_bytes == 0 && max_memory) {
+        EMIT_ERROR("you cannot set the memory limit to 0");
+        exit(1);
+    }
+
+    return NEW(LilydConfig,
+               socket_path,
+               idle_timeout ? atoi__Usize(idle_timeout, 10)
+                            : DEFAULT_IDLE_TIMEOUT,
+               max_memory_bytes);
+}
@@ -22,24 +22,587 @@
  * SOFTWARE.
  */
 
+#include <base/jobserver.h>
 #include <base/new.h>
+#include <base/platform.h>
+#include <base/thread_pool.h>
 
+#include <cli/emit.h>
 #include <cli/lilyc/config.h>
 
 #include <command/lilyc/lilyc.h>
 
+#include <core/lily/compiler/ir/llvm.h>
 #include <core/lily/compiler/ir/llvm/crt.h>
 #include <core/lily/compiler/package.h>
 #include <core/lily/lily.h>
 #include <core/lily/package/default_path.h>
 #include <core/lily/package/package.h>
+#include <core/lily/package/path_cache.h>
 #include <core/lily/package/program.h>
 
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#ifdef LILY_LINUX_OS
+#include <base/dir.h>
+#include <base/fork.h>
+#include <base/fs_watcher.h>
+#include <base/hash/sip.h>
+#include <base/hash_map.h>
+
+#include <core/lily/compiler/output/cache.h>
+
+#include <dirent.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+// Time to wait (in milliseconds) after the last event before rebuilding, so a
+// burst of events (e.g. an editor which saves several files) is coalesced in
+// a single build.
+#define WATCH_DEBOUNCE_MS 50
+
+#define WATCH_MASK \
+    (IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO)
+
+typedef struct LilycWatchDir
+{
+    Int32 wd;
+    String *path;
+} LilycWatchDir;
+
+typedef struct LilycWatchFile
+{
+    String *path;
+    Usize hash; // Hash of the content of the file (see hash_file__LilycWatch)
+} LilycWatchFile;
+
+// NOTE: The watch process only keeps the state of the watcher between two
+// builds: the watched directories, the hash of each Lily source file, and the
+// resources loaded in advance (see watch__Lilyc). The packages are not kept,
+// because each build runs in a new child process.
+typedef struct LilycWatch
+{
+    FsWatcher watcher;
+    Vec *dirs;      // Vec<LilycWatchDir*>*
+    HashMap *files; // HashMap<LilycWatchFile*>*
+} LilycWatch;
+
+static const LilycConfig *watch_config = NULL; // const LilycConfig*? (&)
+
+/**
+ *
+ * @brief Construct LilycWatchDir type.
+ */
+static CONSTRUCTOR(LilycWatchDir *, LilycWatchDir, Int32 wd, String *path);
+
+/**
+ *
+ * @brief Free LilycWatchDir type.
+ */
+static DESTRUCTOR(LilycWatchDir, LilycWatchDir *self);
+
+/**
+ *
+ * @brief Construct LilycWatchFile type.
+ */
+static CONSTRUCTOR(LilycWatchFile *,
+                   LilycWatchFile,
+                   const char *path,
+                   Usize hash);
+
+/**
+ *
+ * @brief Free LilycWatchFile type.
+ */
+static DESTRUCTOR(LilycWatchFile, LilycWatchFile *self);
+
+/**
+ *
+ * @brief Construct LilycWatch type, and watch the directory of the root
+ * package with all its sub directories.
+ */
+static CONSTRUCTOR(LilycWatch, LilycWatch, const char *filename);
+
+/**
+ *
+ * @brief Check if the file is a Lily source file.
+ */
+static bool
+is_lily_file__LilycWatch(const char *filename);
+
+/**
+ *
+ * @brief Check if the directory must be watched, i.e. if it's neither a hidden
+ * directory (e.g. `.git`) nor the output directory of the compiler.
+ */
+static bool
+is_watched_dir__LilycWatch(const char *dirname);
+
+/**
+ *
+ * @brief Hash the content of the file.
+ * @return false if the file can't be read (e.g. it has been removed).
+ */
+static bool
+hash_file__LilycWatch(const char *path, Usize *hash);
+
+/**
+ *
+ * @brief Update the hash of the Lily source file.
+ * @return true if the file has been created, modified or removed since the
+ * last update.
+ */
+static bool
+update_file__LilycWatch(LilycWatch *self, const char *path);
+
+/**
+ *
+ * @brief Forget all the Lily source files of the directory (e.g. when the
+ * directory is removed or moved out of the watched directories).
+ * @return true if a Lily source file has been forgotten.
+ */
+static bool
+remove_files__LilycWatch(LilycWatch *self, const char *dir);
+
+/**
+ *
+ * @brief Watch the directory and its sub directories (see
+ * is_watched_dir__LilycWatch), and hash their Lily source files.
+ * @return true if a Lily source file has been found or modified.
+ */
+static bool
+add_dir__LilycWatch(LilycWatch *self, const char *path);
+
+/**
+ *
+ * @brief Get the watched directory of the watch descriptor.
+ * @return LilycWatchDir*? (&)
+ */
+static LilycWatchDir *
+get_dir__LilycWatch(const LilycWatch *self, Int32 wd);
+
+/**
+ *
+ * @brief Forget the watched directory of the watch descriptor (i.e. when the
+ * directory has been removed).
+ */
+static void
+remove_dir__LilycWatch(LilycWatch *self, Int32 wd);
+
+/**
+ *
+ * @brief Read all the pending events of the watcher. The directories created
+ * (or moved) in a watched directory are watched in turn.
+ * @return true if the content of a Lily source file has changed.
+ */
+static bool
+read_events__LilycWatch(LilycWatch *self);
+
+/**
+ *
+ * @brief Build the package in the child process.
+ */
+static void
+build__LilycWatch();
+
+/**
+ *
+ * @brief Build the package, then rebuild it each time the content of a Lily
+ * source file changes.
+ * @note This is a fork-per-build watcher: each build is a complete run of
+ * run__Lilyc in a new child process, because an error in the build exits the
+ * process, and a build doesn't reset the global state of the compiler. So no
+ * package is kept between two builds, and the files are scanned again from
+ * the start (relex__LilyScanner is not used). Only the resources shared by all
+ * the builds (the program resources and the LLVM target machines) are loaded
+ * once in the watch process, before the first fork. The packages whose object
+ * and interfaces of the dependencies are unchanged reuse their object from the
+ * cache, and skip their parser and their analysis when no dependent needs them
+ * (see lookup_objs__LilyCompilerPackage).
+ */
+static void
+watch__Lilyc(const LilycConfig *config);
+
+CONSTRUCTOR(LilycWatchDir *, LilycWatchDir, Int32 wd, String *path)
+{
+    LilycWatchDir *self = lily_malloc(sizeof(LilycWatchDir));
+
+    self->wd = wd;
+    self->path = path;
+
+    return self;
+}
+
+DESTRUCTOR(LilycWatchDir, LilycWatchDir *self)
+{
+    FREE(String, self->path);
+    lily_free(self);
+}
+
+CONSTRUCTOR(LilycWatchFile *, LilycWatchFile, const char *path, Usize hash)
+{
+    LilycWatchFile *self = lily_malloc(sizeof(LilycWatchFile));
+
+    self->path = from__String((char *)path);
+    self->hash = hash;
+
+    return self;
+}
+
+DESTRUCTOR(LilycWatchFile, LilycWatchFile *self)
+{
+    FREE(String, self->path);
+    lily_free(self);
+}
+
+CONSTRUCTOR(LilycWatch, LilycWatch, const char *filename)
+{
+    char *default_path = generate_default_path((char *)filename);
+    LilycWatch self = { .watcher = NEW(FsWatcher, IN_NONBLOCK),
+                        .dirs = NEW(Vec),
+                        .files = NEW(HashMap) };
+
+    Usize default_path_len = strlen(default_path);
+
+    // NOTE: The paths of the sub directories are joined with a separator.
+    if (default_path_len > 1 && default_path[default_path_len - 1] == '/') {
+        default_path[default_path_len - 1] = '\0';
+    }
+
+    add_dir__LilycWatch(&self, default_path[0] ? default_path : ".");
+
+    if (self.dirs->len == 0) {
+        EMIT_ERROR("cannot watch the directory of the package");
+        exit(1);
+    }
+
+    lily_free(default_path);
+
+    return self;
+}
+
+bool
+is_lily_file__LilycWatch(const char *filename)
+{
+    Usize len = strlen(filename);
+
+    return len > 5 && !strcmp(filename + len - 5, ".lily");
+}
+
+bool
+is_watched_dir__LilycWatch(const char *dirname)
+{
+    // NOTE: DIR_CACHE_NAME ends with a separator.
+    const Usize output_dir_len = sizeof(DIR_CACHE_NAME) - 2;
+
+    return dirname[0] != '.' &&
+           (strlen(dirname) != output_dir_len ||
+            strncmp(dirname, DIR_CACHE_NAME, output_dir_len));
+}
+
+bool
+hash_file__LilycWatch(const char *path, Usize *hash)
+{
+    FILE *file = fopen(path, "rb");
+
+    if (!file) {
+        return false;
+    }
+
+    fseek(file, 0, SEEK_END);
+
+    long len = ftell(file);
+
+    if (len < 0) {
+        fclose(file);
+
+        return false;
+    }
+
+    char *content = lily_malloc(len + 1);
+    bool is_read = fseek(file, 0, SEEK_SET) == 0 &&
+                   fread(content, 1, len, file) == (Usize)len;
+
+    if (is_read) {
+        *hash = hash_sip(content, len, SIP_K0, SIP_K1);
+    }
+
+    lily_free(content);
+    fclose(file);
+
+    return is_read;
+}
+
+bool
+update_file__LilycWatch(LilycWatch *self, const char *path)
+{
+    LilycWatchFile *file = get__HashMap(self->files, (char *)path);
+    Usize hash = 0;
+
+    if (!hash_file__LilycWatch(path, &hash)) {
+        if (file) {
+            remove__HashMap(self->files, file->path->buffer);
+            FREE(LilycWatchFile, file);
+
+            return true;
+        }
+
+        return false;
+    } else if (!file) {
+        file = NEW(LilycWatchFile, path, hash);
+
+        insert__HashMap(self->files, file->path->buffer, file);
+
+        return true;
+    } else if (file->hash != hash) {
+        file->hash = hash;
+
+        return true;
+    }
+
+    return false;
+}
+
+bool
+remove_files__LilycWatch(LilycWatch *self, const char *dir)
+{
+    Vec *removed_files = NEW(Vec); // Vec<LilycWatchFile* (&)>*
+    Usize dir_len = strlen(dir);
+    HashMapIter iter = NEW(HashMapIter, self->files);
+    LilycWatchFile *current = NULL;
+
+    while ((current = next__HashMapIter(&iter))) {
+        if (!strncmp(current->path->buffer, dir, dir_len) &&
+            current->path->buffer[dir_len] == '/') {
+            push__Vec(removed_files, current);
+        }
+    }
+
+    bool has_removed_files = removed_files->len > 0;
+
+    for (Usize i = 0; i < removed_files->len; ++i) {
+        LilycWatchFile *file = get__Vec(removed_files, i);
+
+        remove__HashMap(self->files, file->path->buffer);
+        FREE(LilycWatchFile, file);
+    }
+
+    FREE(Vec, removed_files);
+
+    return has_removed_files;
+}
+
+bool
+add_dir__LilycWatch(LilycWatch *self, const char *path)
+{
+    Int32 wd = add__FsWatcher(&self->watcher, path, WATCH_MASK);
+
+    // NOTE: The directory may have been removed since it has been found.
+    if (wd == -1) {
+        return false;
+    }
+
+    // NOTE: A directory keeps its watch descriptor when it's moved, so only
+    // its path is updated.
+    LilycWatchDir *watch_dir = get_dir__LilycWatch(self, wd);
+
+    if (watch_dir) {
+        FREE(String, watch_dir->path);
+        watch_dir->path = from__String((char *)path);
+    } else {
+        push__Vec(self->dirs,
+                  NEW(LilycWatchDir, wd, from__String((char *)path)));
+    }
+
+    DIR *dir = opendir(path);
+
+    if (!dir) {
+        return false;
+    }
+
+    bool has_changed = false;
+    struct dirent *dp;
+
+    while ((dp = readdir(dir))) {
+        if (!strcmp(dp->d_name, ".") || !strcmp(dp->d_name, "..")) {
+            continue;
+        }
+
+        String *current_path = format__String("{s}/{s}", path, dp->d_name);
+
+        if (is__Dir(current_path->buffer)) {
+            if (!is_watched_dir__LilycWatch(dp->d_name)) {
+                FREE(String, current_path);
+
+                continue;
+            }
+
+            has_changed =
+              add_dir__LilycWatch(self, current_path->buffer) || has_changed;
+        } else if (is_lily_file__LilycWatch(dp->d_name)) {
+            has_changed =
+              update_file__LilycWatch(self, current_path->buffer) ||
+              has_changed;
+        }
+
+        FREE(String, current_path);
+    }
+
+    closedir(dir);
+
+    return has_changed;
+}
+
+LilycWatchDir *
+get_dir__LilycWatch(const LilycWatch *self, Int32 wd)
+{
+    for (Usize i = 0; i < self->dirs->len; ++i) {
+        LilycWatchDir *dir = get__Vec(self->dirs, i);
+
+        if (dir->wd == wd) {
+            return dir;
+        }
+    }
+
+    return NULL;
+}
+
+void
+remove_dir__LilycWatch(LilycWatch *self, Int32 wd)
+{
+    for (Usize i = 0; i < self->dirs->len; ++i) {
+        LilycWatchDir *dir = get__Vec(self->dirs, i);
+
+        if (dir->wd == wd) {
+            FREE(LilycWatchDir, remove__Vec(self->dirs, i));
+
+            return;
+        }
+    }
+}
+
+bool
+read_events__LilycWatch(LilycWatch *self)
+{
+    char buffer[4096]
+      __attribute__((aligned(__alignof__(struct inotify_event))));
+    bool has_changed = false;
+    ssize_t len = 0;
+
+    // NOTE: The file descriptor of the watcher is non-blocking (IN_NONBLOCK).
+    while ((len = read(get_fd__FsWatcher(&self->watcher),
+                       buffer,
+                       sizeof(buffer))) > 0) {
+        for (char *current = buffer; current < buffer + len;) {
+            const struct inotify_event *event =
+              (const struct inotify_event *)current;
+            LilycWatchDir *dir = get_dir__LilycWatch(self, event->wd);
+
+            current += sizeof(struct inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                // NOTE: Some events are lost, so the package is rebuilt.
+                has_changed = true;
+
+                continue;
+            } else if (event->mask & IN_IGNORED) {
+                // NOTE: The watch descriptor is removed with its directory.
+                remove_dir__LilycWatch(self, event->wd);
+
+                continue;
+            } else if (!dir || event->len == 0) {
+                continue;
+            }
+
+            String *path =
+              format__String("{S}/{s}", dir->path, (char *)event->name);
+
+            if (event->mask & IN_ISDIR) {
+                if (!is_watched_dir__LilycWatch(event->name)) {
+                    FREE(String, path);
+
+                    continue;
+                }
+
+                if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                    has_changed =
+                      add_dir__LilycWatch(self, path->buffer) || has_changed;
+                } else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                    has_changed =
+                      remove_files__LilycWatch(self, path->buffer) ||
+                      has_changed;
+                }
+            } else if (is_lily_file__LilycWatch(event->name)) {
+                has_changed =
+                  update_file__LilycWatch(self, path->buffer) || has_changed;
+            }
+
+            FREE(String, path);
+        }
+    }
+
+    return has_changed;
+}
+
+void
+build__LilycWatch()
+{
+    LilycConfig config = *watch_config;
+
+    config.watch = false;
+
+    run__Lilyc(&config);
+}
+
+void
+watch__Lilyc(const LilycConfig *config)
+{
+    LilycWatch self = NEW(LilycWatch, config->filename);
+    struct pollfd poll_fd = { .fd = get_fd__FsWatcher(&self.watcher),
+                              .events = POLLIN };
+
+    watch_config = config;
+
+    // Load the resources which are identical for all the builds (see
+    // run__Lilyd).
+    set_default_jobs__ThreadPool(config->jobs);
+    preload__LilyProgram();
+    warm__LilyIrLlvm(get_default_jobs__ThreadPool());
+
+    while (true) {
+        use__Fork(run__Fork(), &build__LilycWatch, NULL, NULL, NULL);
+
+        printf("\x1b[1mwatching for changes...\x1b[0m\n");
+        fflush(stdout);
+
+        do {
+            poll(&poll_fd, 1, -1);
+        } while (!read_events__LilycWatch(&self));
+
+        while (poll(&poll_fd, 1, WATCH_DEBOUNCE_MS) > 0) {
+            read_events__LilycWatch(&self);
+        }
+    }
+}
+#endif
 
 void
 run__Lilyc(const LilycConfig *config)
 {
+#ifdef LILY_LINUX_OS
+    if (config->watch) {
+        watch__Lilyc(config);
+
+        return;
+    }
+#endif
+
+    init__Jobserver(getenv("MAKEFLAGS"));
+    set_default_jobs__ThreadPool(config->jobs);
+
     if (config->run_scanner) {
         run_scanner__LilyCompilerPackage(config);
 
@@ -124,6 +687,10 @@ run__Lilyc(const LilycConfig *config)
     FREE(LilyProgram, &program);
 
 exit:
+    clear__LilyPackagePathCache();
+    destroy_warm__LilyIrLlvm();
+    close__Jobserver();
+
 #if defined(LILY_LINUX_OS) || defined(LILY_BSD_OS)
     // Free allocated variables to `src/core/lily/compiler/ir/llvm/crt.c`.
     destroy_crt__LilyIrLlvmLinker();
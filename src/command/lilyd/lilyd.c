@@ -0,0 +1,527 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2025 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <base/assert.h>
+#include <base/cli/result.h>
+#include <base/fork.h>
+#include <base/new.h>
+#include <base/platform.h>
+#include <base/string.h>
+#include <base/thread_pool.h>
+
+#include <cli/emit.h>
+#include <cli/lilyc/lilyc.h>
+#include <cli/lilyc/parse_config.h>
+
+#include <command/lilyc/lilyc.h>
+#include <command/lilyd/lilyd.h>
+
+#include <core/lily/compiler/ir/llvm.h>
+#include <core/lily/package/program.h>
+
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// The request is composed of a header, which contains the length of the
+// payload and passes the standard output and the standard error of the client
+// (SCM_RIGHTS), and a payload, which contains the current directory of the
+// client followed by the arguments of lilyc (separated by '\0'). The response
+// is the exit status of the compilation (Int32).
+#define REQUEST_FDS_COUNT 2
+#define REQUEST_PAYLOAD_MAX_LEN 1048576
+
+typedef struct LilydRequest
+{
+    char *payload;
+    Usize payload_len;
+    int fds[REQUEST_FDS_COUNT]; // stdout, stderr
+    Usize max_memory;
+} LilydRequest;
+
+// Request compiled by the current process (see compile__LilydRequest).
+static LilydRequest *current_request = NULL; // LilydRequest*? (&)
+
+/**
+ *
+ * @brief Write all the buffer on the file descriptor.
+ * @return false if the file descriptor is closed.
+ */
+static bool
+write_all__Lilyd(int fd, const void *buffer, Usize len);
+
+/**
+ *
+ * @brief Read the whole buffer from the file descriptor.
+ * @return false if the file descriptor is closed before the end.
+ */
+static bool
+read_all__Lilyd(int fd, void *buffer, Usize len);
+
+/**
+ *
+ * @brief Check if a server answers on the UNIX socket.
+ */
+static bool
+is_running__Lilyd(const struct sockaddr_un *address);
+
+/**
+ *
+ * @brief Open the UNIX socket.
+ * @return The file descriptor of the socket, or -1 on error.
+ */
+static int
+open_socket__Lilyd(const char *socket_path, bool is_server);
+
+/**
+ *
+ * @brief Receive the request of the client.
+ * @return false if the request is malformed.
+ */
+static bool
+receive__LilydRequest(LilydRequest *self, int client_fd);
+
+/**
+ *
+ * @brief Check if the arguments of lilyc contain the watch option, which is
+ * not supported by the server (the compilation would never end).
+ */
+static bool
+has_watch__LilydRequest(const LilydRequest *self);
+
+/**
+ *
+ * @brief Compile the request (in the forked process).
+ */
+static void
+compile__LilydRequest();
+
+/**
+ *
+ * @brief Handle the connection of a client (in the forked process): receive
+ * its request, compile it in a new process, and send back the exit status.
+ */
+static void
+handle_client__Lilyd(int client_fd, const LilydConfig *config);
+
+/**
+ *
+ * @brief Free LilydRequest type.
+ */
+static DESTRUCTOR(LilydRequest, const LilydRequest *self);
+
+bool
+write_all__Lilyd(int fd, const void *buffer, Usize len)
+{
+    const char *current = buffer;
+
+    while (len > 0) {
+        ssize_t n = write(fd, current, len);
+
+        if (n == -1 && errno == EINTR) {
+            continue;
+        } else if (n <= 0) {
+            return false;
+        }
+
+        current += n;
+        len -= n;
+    }
+
+    return true;
+}
+
+bool
+read_all__Lilyd(int fd, void *buffer, Usize len)
+{
+    char *current = buffer;
+
+    while (len > 0) {
+        ssize_t n = read(fd, current, len);
+
+        if (n == -1 && errno == EINTR) {
+            continue;
+        } else if (n <= 0) {
+            return false;
+        }
+
+        current += n;
+        len -= n;
+    }
+
+    return true;
+}
+
+bool
+is_running__Lilyd(const struct sockaddr_un *address)
+{
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if (fd == -1) {
+        return false;
+    }
+
+    bool res =
+      connect(fd, (const struct sockaddr *)address, sizeof(*address)) == 0;
+
+    close(fd);
+
+    return res;
+}
+
+int
+open_socket__Lilyd(const char *socket_path, bool is_server)
+{
+    struct sockaddr_un address = { .sun_family = AF_UNIX };
+
+    if (strlen(socket_path) >= sizeof(address.sun_path)) {
+        EMIT_ERROR("the path of the socket is too long");
+        return -1;
+    }
+
+    strcpy(address.sun_path, socket_path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if (fd == -1) {
+        return -1;
+    }
+
+    if (is_server) {
+        struct stat socket_stat;
+
+        // NOTE: Only the socket of a previous server which doesn't answer
+        // anymore is removed (never another server, nor another kind of
+        // file).
+        if (lstat(socket_path, &socket_stat) == 0) {
+            if (!S_ISSOCK(socket_stat.st_mode)) {
+                EMIT_ERROR("the path of the socket is already used by a file");
+                close(fd);
+                return -1;
+            } else if (is_running__Lilyd(&address)) {
+                EMIT_ERROR("a server is already running on the socket");
+                close(fd);
+                return -1;
+            }
+
+            unlink(socket_path);
+        }
+
+        if (bind(fd, (struct sockaddr *)&address, sizeof(address)) == -1 ||
+            listen(fd, SOMAXCONN) == -1) {
+            close(fd);
+            return -1;
+        }
+    } else if (connect(fd, (struct sockaddr *)&address, sizeof(address)) ==
+               -1) {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+bool
+receive__LilydRequest(LilydRequest *self, int client_fd)
+{
+    char control[CMSG_SPACE(sizeof(int) * REQUEST_FDS_COUNT)];
+    struct iovec iov = { .iov_base = &self->payload_len,
+                         .iov_len = sizeof(Usize) };
+    struct msghdr message = { .msg_iov = &iov,
+                              .msg_iovlen = 1,
+                              .msg_control = control,
+                              .msg_controllen = sizeof(control) };
+
+    if (recvmsg(client_fd, &message, 0) != sizeof(Usize)) {
+        return false;
+    }
+
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&message);
+
+    if (!cmsg || cmsg->cmsg_level != SOL_SOCKET ||
+        cmsg->cmsg_type != SCM_RIGHTS ||
+        cmsg->cmsg_len != CMSG_LEN(sizeof(int) * REQUEST_FDS_COUNT)) {
+        return false;
+    }
+
+    memcpy(self->fds, CMSG_DATA(cmsg), sizeof(int) * REQUEST_FDS_COUNT);
+
+    // NOTE: The payload ends with '\0'.
+    if (self->payload_len == 0 || self->payload_len > REQUEST_PAYLOAD_MAX_LEN) {
+        return false;
+    }
+
+    self->payload = lily_malloc(self->payload_len);
+
+    return read_all__Lilyd(client_fd, self->payload, self->payload_len) &&
+           self->payload[self->payload_len - 1] == '\0';
+}
+
+bool
+has_watch__LilydRequest(const LilydRequest *self)
+{
+    // NOTE: The payload starts with the current directory of the client.
+    for (const char *current = self->payload + strlen(self->payload) + 1;
+         current < self->payload + self->payload_len;
+         current += strlen(current) + 1) {
+        if (!strcmp(current, "-w") || !strcmp(current, "--watch")) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void
+compile__LilydRequest()
+{
+    ASSERT(current_request);
+
+    if (current_request->max_memory > 0) {
+        struct rlimit limit = { .rlim_cur = current_request->max_memory,
+                                .rlim_max = current_request->max_memory };
+
+        setrlimit(RLIMIT_AS, &limit);
+    }
+
+    dup2(current_request->fds[0], STDOUT_FILENO);
+    dup2(current_request->fds[1], STDERR_FILENO);
+
+    // 1. Get the current directory of the client.
+    const char *cwd = current_request->payload;
+
+    if (chdir(cwd) == -1) {
+        EMIT_ERROR("cannot change the current directory");
+        exit(1);
+    }
+
+    // 2. Get the arguments of lilyc.
+    Vec *args = NEW(Vec); // Vec<char* (&)>*
+
+    for (char *current = current_request->payload + strlen(cwd) + 1;
+         current < current_request->payload + current_request->payload_len;
+         current += strlen(current) + 1) {
+        push__Vec(args, current);
+    }
+
+    Cli cli = build__CliLilyc(args);
+    Vec *res = cli.$parse(&cli);
+    LilycConfig config = run__LilycParseConfig(res);
+
+    FREE(Cli, &cli);
+    FREE_BUFFER_ITEMS(res->buffer, res->len, CliResult);
+    FREE(Vec, res);
+
+    // NOTE: The request is already received by the server.
+    config.daemon = NULL;
+
+    run__Lilyc(&config);
+
+    FREE(Vec, args);
+    fflush(NULL);
+}
+
+void
+handle_client__Lilyd(int client_fd, const LilydConfig *config)
+{
+    LilydRequest request = { .payload = NULL,
+                             .payload_len = 0,
+                             .fds = { -1, -1 },
+                             .max_memory = config->max_memory };
+    Int32 status = 1;
+
+    // NOTE: The server ignores SIGCHLD, but this process must wait for the
+    // compilation.
+    signal(SIGCHLD, SIG_DFL);
+
+    bool is_received = receive__LilydRequest(&request, client_fd);
+
+    // NOTE: The watch mode never ends, so the client would wait forever.
+    if (is_received && has_watch__LilydRequest(&request)) {
+        dup2(request.fds[0], STDOUT_FILENO);
+        EMIT_ERROR("you cannot use `-w` or `--watch` option with the compile "
+                   "server");
+        fflush(stdout);
+    } else if (is_received) {
+        int exit_status = 0;
+        int kill_signal = 0;
+
+        current_request = &request;
+
+        use__Fork(run__Fork(),
+                  &compile__LilydRequest,
+                  &exit_status,
+                  &kill_signal,
+                  NULL);
+
+        status = kill_signal ? 128 + kill_signal : exit_status;
+    }
+
+    write_all__Lilyd(client_fd, &status, sizeof(Int32));
+
+    FREE(LilydRequest, &request);
+    close(client_fd);
+}
+
+DESTRUCTOR(LilydRequest, const LilydRequest *self)
+{
+    if (self->payload) {
+        lily_free(self->payload);
+    }
+
+    for (Usize i = 0; i < REQUEST_FDS_COUNT; ++i) {
+        if (self->fds[i] != -1) {
+            close(self->fds[i]);
+        }
+    }
+}
+
+void
+run__Lilyd(const LilydConfig *config)
+{
+    int server_fd = open_socket__Lilyd(config->socket_path, true);
+
+    if (server_fd == -1) {
+        EMIT_ERROR("cannot open the socket of the server");
+        exit(1);
+    }
+
+    // Load the resources which are identical for all the compilations, and
+    // create the target machines of the first packages of each compilation.
+    preload__LilyProgram();
+    warm__LilyIrLlvm(get_default_jobs__ThreadPool());
+
+    // NOTE: The processes of the clients are reaped automatically.
+    signal(SIGCHLD, SIG_IGN);
+
+    struct pollfd poll_fd = { .fd = server_fd, .events = POLLIN };
+    int timeout = config->idle_timeout > 0 ? config->idle_timeout * 1000 : -1;
+
+    while (true) {
+        int n = poll(&poll_fd, 1, timeout);
+
+        if (n == -1 && errno == EINTR) {
+            continue;
+        } else if (n <= 0) {
+            break;
+        }
+
+        int client_fd = accept(server_fd, NULL, NULL);
+
+        if (client_fd == -1) {
+            continue;
+        }
+
+        // NOTE: The buffers are flushed, so they aren't written again by the
+        // forked process.
+        fflush(NULL);
+
+        switch (run__Fork()) {
+            case -1:
+                EMIT_ERROR("failed to fork the server");
+                break;
+            case 0:
+                close(server_fd);
+                handle_client__Lilyd(client_fd, config);
+                _exit(0);
+            default:
+                break;
+        }
+
+        close(client_fd);
+    }
+
+    close(server_fd);
+    unlink(config->socket_path);
+    destroy_warm__LilyIrLlvm();
+}
+
+int
+send_request__Lilyd(const char *socket_path, const Vec *args)
+{
+    int fd = open_socket__Lilyd(socket_path, false);
+
+    if (fd == -1) {
+        EMIT_ERROR("cannot connect to the compile server");
+        return 1;
+    }
+
+    // 1. Build the payload.
+    char *cwd = getcwd(NULL, 0);
+    String *payload = from__String(cwd);
+
+    push__String(payload, '\0');
+
+    for (Usize i = 0; i < args->len; ++i) {
+        push_str__String(payload, get__Vec(args, i));
+        push__String(payload, '\0');
+    }
+
+    free(cwd);
+
+    // 2. Send the header with the standard output and the standard error.
+    int fds[REQUEST_FDS_COUNT] = { STDOUT_FILENO, STDERR_FILENO };
+    char control[CMSG_SPACE(sizeof(fds))] = { 0 };
+    Usize payload_len = payload->len;
+    struct iovec iov = { .iov_base = &payload_len, .iov_len = sizeof(Usize) };
+    struct msghdr message = { .msg_iov = &iov,
+                              .msg_iovlen = 1,
+                              .msg_control = control,
+                              .msg_controllen = sizeof(control) };
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&message);
+
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+    memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+    // NOTE: The outputs of the client must be written before the outputs of
+    // the compilation.
+    fflush(NULL);
+
+    Int32 status = 1;
+
+    // 3. Send the payload, and wait for the exit status of the compilation.
+    if (sendmsg(fd, &message, 0) != sizeof(Usize) ||
+        !write_all__Lilyd(fd, payload->buffer, payload->len) ||
+        !read_all__Lilyd(fd, &status, sizeof(Int32))) {
+        EMIT_ERROR("the compile server has closed the connection");
+        status = 1;
+    }
+
+    FREE(String, payload);
+    close(fd);
+
+    return status;
+}
@@ -26,6 +26,7 @@
 #include <base/new.h>
 
 #include <core/cc/ci/builtin.h>
+#include <core/cc/ci/perfect_hash/builtin.h>
 #include <core/shared/search.h>
 
 #include <stdio.h>
@@ -54,6 +55,8 @@
 #define CI_BUILTIN_FUNCTION_VA_ARG 3
 #define CI_BUILTIN_FUNCTION_VA_COPY 4
 
+// NOTE: After modifying this table, you must run `make perfect_hash` to
+// regenerate `include/core/cc/ci/perfect_hash/builtin.h`.
 static SizedStr builtin_function_names[CI_BUILTIN_FUNCTION_COUNT] = {
     SIZED_STR_FROM_RAW("__builtin_memcpy"),
     SIZED_STR_FROM_RAW("__builtin_va_start"),
@@ -72,6 +75,8 @@ static Int32 builtin_function_ids[CI_BUILTIN_FUNCTION_COUNT] = {
 
 #define CI_BUILTIN_TYPE_VA_LIST 0
 
+// NOTE: After modifying this table, you must run `make perfect_hash` to
+// regenerate `include/core/cc/ci/perfect_hash/builtin.h`.
 static SizedStr builtin_type_names[CI_BUILTIN_TYPE_COUNT] = {
     SIZED_STR_FROM_RAW("__builtin_va_list")
 };
@@ -80,6 +85,12 @@ static Int32 builtin_type_ids[CI_BUILTIN_TYPE_COUNT] = {
     CI_BUILTIN_TYPE_VA_LIST
 };
 
+static_assert(BUILTIN_FUNCTION_NAMES_PERFECT_HASH_KEYS_LEN ==
+                CI_BUILTIN_FUNCTION_COUNT,
+              "the perfect hash of builtin_function_names is out of date");
+static_assert(BUILTIN_TYPE_NAMES_PERFECT_HASH_KEYS_LEN == CI_BUILTIN_TYPE_COUNT,
+              "the perfect hash of builtin_type_names is out of date");
+
 static Usize builtin_type_sizes[CI_BUILTIN_TYPE_COUNT] = { sizeof(
   __builtin_va_list) };
 
@@ -130,19 +141,23 @@ load__CIBuiltinFunction()
 bool
 is__CIBuiltinFunction(String *name)
 {
-    return get_id__Search(name,
-                          builtin_function_names,
-                          builtin_function_ids,
-                          CI_BUILTIN_FUNCTION_COUNT) != -1;
+    return get_id_with_perfect_hash__Search(
+             name,
+             builtin_function_names,
+             builtin_function_ids,
+             CI_BUILTIN_FUNCTION_COUNT,
+             &builtin_function_names_perfect_hash) != -1;
 }
 
 Usize
 get_id__CIBuiltinFunction(String *name)
 {
-    Int32 id = get_id__Search(name,
-                              builtin_function_names,
-                              builtin_function_ids,
-                              CI_BUILTIN_FUNCTION_COUNT);
+    Int32 id =
+      get_id_with_perfect_hash__Search(name,
+                                       builtin_function_names,
+                                       builtin_function_ids,
+                                       CI_BUILTIN_FUNCTION_COUNT,
+                                       &builtin_function_names_perfect_hash);
 
     ASSERT(id != -1);
 
@@ -170,17 +185,23 @@ load__CIBuiltinType()
 bool
 is__CIBuiltinType(String *name)
 {
-    return get_id__Search(name,
-                          builtin_type_names,
-                          builtin_type_ids,
-                          CI_BUILTIN_TYPE_COUNT) != -1;
+    return get_id_with_perfect_hash__Search(
+             name,
+             builtin_type_names,
+             builtin_type_ids,
+             CI_BUILTIN_TYPE_COUNT,
+             &builtin_type_names_perfect_hash) != -1;
 }
 
 Usize
 get_id__CIBuiltinType(String *name)
 {
-    Int32 id = get_id__Search(
-      name, builtin_type_names, builtin_type_ids, CI_BUILTIN_TYPE_COUNT);
+    Int32 id =
+      get_id_with_perfect_hash__Search(name,
+                                       builtin_type_names,
+                                       builtin_type_ids,
+                                       CI_BUILTIN_TYPE_COUNT,
+                                       &builtin_type_names_perfect_hash);
 
     ASSERT(id != -1);
 
@@ -31,6 +31,7 @@
 #include <core/cc/ci/include.h>
 #include <core/cc/ci/infer.h>
 #include <core/cc/ci/parser.h>
+#include <core/cc/ci/perfect_hash/parser.h>
 #include <core/cc/ci/resolver/expr.h>
 #include <core/cc/ci/result.h>
 #include <core/shared/diagnostic.h>
@@ -636,6 +637,8 @@ static bool eat_semicolon = true;
 #define SET_EAT_SEMICOLON() eat_semicolon = true;
 #define UNSET_EAT_SEMICOLON() eat_semicolon = false;
 
+// NOTE: After modifying this table, you must run `make perfect_hash` to
+// regenerate `include/core/cc/ci/perfect_hash/parser.h`.
 static const SizedStr ci_standard_attributes[CI_N_STANDARD_ATTRIBUTE] = {
     SIZED_STR_FROM_RAW("_Noreturn"),
     SIZED_STR_FROM_RAW("___Noreturn__"),
@@ -675,6 +678,10 @@ static const enum CIAttributeStandardKind
       CI_ATTRIBUTE_STANDARD_KIND_REPRODUCIBLE
   };
 
+static_assert(CI_STANDARD_ATTRIBUTES_PERFECT_HASH_KEYS_LEN ==
+                CI_N_STANDARD_ATTRIBUTE,
+              "the perfect hash of ci_standard_attributes is out of date");
+
 #define BUILTIN_NULLPTR_T_S "nullptr_t"
 
 CONSTRUCTOR(CIParser, CIParser, CIResultFile *file)
@@ -4701,10 +4708,12 @@ parse_attribute__CIParser(CIParser *self)
             const String *attribute_identifier =
               GET_PTR_RC(String, self->current_token->identifier);
             const enum CIAttributeStandardKind attr_id =
-              get_id__Search(attribute_identifier,
-                             ci_standard_attributes,
-                             (const Int32 *)ci_standard_attribute_ids,
-                             CI_N_STANDARD_ATTRIBUTE);
+              get_id_with_perfect_hash__Search(
+                attribute_identifier,
+                ci_standard_attributes,
+                (const Int32 *)ci_standard_attribute_ids,
+                CI_N_STANDARD_ATTRIBUTE,
+                &ci_standard_attributes_perfect_hash);
             CIAttribute *res = NULL;
 
             next_token__CIParser(self);
@@ -29,6 +29,7 @@
 #include <base/print.h>
 
 #include <core/cc/ci/ci.h>
+#include <core/cc/ci/perfect_hash/scanner.h>
 #include <core/cc/ci/result.h>
 #include <core/cc/ci/scanner.h>
 #include <core/shared/diagnostic.h>
@@ -757,7 +758,8 @@ static const CIFeature tokens_feature[CI_TOKEN_KIND_MAX] = {
                                 .until = CI_STANDARD_NONE },
 };
 
-// NOTE: This table must be sorted in ascending order.
+// NOTE: After modifying this table, you must run `make perfect_hash` to
+// regenerate `include/core/cc/ci/perfect_hash/scanner.h`.
 static const SizedStr ci_keywords[CI_N_KEYWORD] = {
     SIZED_STR_FROM_RAW("_Alignas"),
     SIZED_STR_FROM_RAW("_Alignof"),
@@ -893,7 +895,8 @@ static const enum CITokenKind ci_keyword_ids[CI_N_KEYWORD] = {
     CI_TOKEN_KIND_KEYWORD_WHILE
 };
 
-// NOTE: This table must be sorted in ascending order.
+// NOTE: After modifying this table, you must run `make perfect_hash` to
+// regenerate `include/core/cc/ci/perfect_hash/scanner.h`.
 static const SizedStr ci_attributes[CI_N_ATTRIBUTE] = {
     SIZED_STR_FROM_RAW("_Noreturn"),    SIZED_STR_FROM_RAW("deprecated"),
     SIZED_STR_FROM_RAW("fallthrough"),  SIZED_STR_FROM_RAW("maybe_unused"),
@@ -909,7 +912,8 @@ static const enum CITokenKind ci_attribute_ids[CI_N_ATTRIBUTE] = {
     CI_TOKEN_KIND_ATTRIBUTE_REPRODUCIBLE, CI_TOKEN_KIND_ATTRIBUTE_UNSEQUENCED,
 };
 
-// NOTE: This table must be sorted in ascending order.
+// NOTE: After modifying this table, you must run `make perfect_hash` to
+// regenerate `include/core/cc/ci/perfect_hash/scanner.h`.
 static const SizedStr ci_builtin_macros[CI_N_BUILTIN_MACRO] = {
     SIZED_STR_FROM_RAW("__has_feature"),
 };
@@ -920,7 +924,8 @@ static const enum CITokenKind ci_builtin_macro_ids[CI_N_BUILTIN_MACRO] = {
     CI_TOKEN_KIND_BUILTIN_MACRO___HAS_FEATURE
 };
 
-// NOTE: This table must be sorted in ascending order.
+// NOTE: After modifying this table, you must run `make perfect_hash` to
+// regenerate `include/core/cc/ci/perfect_hash/scanner.h`.
 static const SizedStr
   ci_standard_predefined_macros[CI_N_STANDARD_PREDEFINED_MACRO] = {
       SIZED_STR_FROM_RAW("__DATE__"),
@@ -945,7 +950,8 @@ static const enum CITokenKind
       CI_TOKEN_KIND_STANDARD_PREDEFINED_MACRO___TIME__,
   };
 
-// NOTE: This table must be sorted in ascending order.
+// NOTE: After modifying this table, you must run `make perfect_hash` to
+// regenerate `include/core/cc/ci/perfect_hash/scanner.h`.
 static const SizedStr ci_preprocessors[CI_N_PREPROCESSOR] = {
     SIZED_STR_FROM_RAW("define"),  SIZED_STR_FROM_RAW("elif"),
     SIZED_STR_FROM_RAW("elifdef"), SIZED_STR_FROM_RAW("elifndef"),
@@ -969,6 +975,19 @@ static const enum CITokenKind ci_preprocessor_ids[CI_N_PREPROCESSOR] = {
     CI_TOKEN_KIND_PREPROCESSOR_UNDEF,   CI_TOKEN_KIND_PREPROCESSOR_WARNING,
 };
 
+static_assert(CI_KEYWORDS_PERFECT_HASH_KEYS_LEN == CI_N_KEYWORD,
+              "the perfect hash of ci_keywords is out of date");
+static_assert(CI_ATTRIBUTES_PERFECT_HASH_KEYS_LEN == CI_N_ATTRIBUTE,
+              "the perfect hash of ci_attributes is out of date");
+static_assert(CI_BUILTIN_MACROS_PERFECT_HASH_KEYS_LEN == CI_N_BUILTIN_MACRO,
+              "the perfect hash of ci_builtin_macros is out of date");
+static_assert(CI_STANDARD_PREDEFINED_MACROS_PERFECT_HASH_KEYS_LEN ==
+                CI_N_STANDARD_PREDEFINED_MACRO,
+              "the perfect hash of ci_standard_predefined_macros is out of "
+              "date");
+static_assert(CI_PREPROCESSORS_PERFECT_HASH_KEYS_LEN == CI_N_PREPROCESSOR,
+              "the perfect hash of ci_preprocessors is out of date");
+
 #define IS_ZERO '0'
 
 #define IS_DIGIT_WITHOUT_ZERO \
@@ -1275,8 +1294,11 @@ next_char_by_token__CIScanner(CIScanner *self, const CIToken *token)
 enum CITokenKind
 get_attribute__CIScanner(const String *id)
 {
-    Int32 res = get_keyword__Scanner(
-      id, ci_attributes, (const Int32 *)ci_attribute_ids, CI_N_ATTRIBUTE);
+    Int32 res = get_keyword__Scanner(id,
+                                     ci_attributes,
+                                     (const Int32 *)ci_attribute_ids,
+                                     CI_N_ATTRIBUTE,
+                                     &ci_attributes_perfect_hash);
 
     if (res == -1) {
         return CI_TOKEN_KIND_IDENTIFIER;
@@ -1291,7 +1313,8 @@ get_builtin_macro__CIScanner(const String *id)
     Int32 res = get_keyword__Scanner(id,
                                      ci_builtin_macros,
                                      (const Int32 *)ci_builtin_macro_ids,
-                                     CI_N_BUILTIN_MACRO);
+                                     CI_N_BUILTIN_MACRO,
+                                     &ci_builtin_macros_perfect_hash);
 
     if (res == -1) {
         return CI_TOKEN_KIND_IDENTIFIER;
@@ -1307,7 +1330,8 @@ get_standard_predefined_macro__CIScanner(const String *id)
       get_keyword__Scanner(id,
                            ci_standard_predefined_macros,
                            (const Int32 *)ci_standard_predefined_macro_ids,
-                           CI_N_STANDARD_PREDEFINED_MACRO);
+                           CI_N_STANDARD_PREDEFINED_MACRO,
+                           &ci_standard_predefined_macros_perfect_hash);
 
     if (res == -1) {
         return CI_TOKEN_KIND_IDENTIFIER;
@@ -1322,7 +1346,8 @@ get_preprocessor__CIScanner(const String *id)
     Int32 res = get_keyword__Scanner(id,
                                      ci_preprocessors,
                                      (const Int32 *)ci_preprocessor_ids,
-                                     CI_N_PREPROCESSOR);
+                                     CI_N_PREPROCESSOR,
+                                     &ci_preprocessors_perfect_hash);
 
     if (res == -1) {
         return CI_TOKEN_KIND_IDENTIFIER;
@@ -1334,8 +1359,11 @@ get_preprocessor__CIScanner(const String *id)
 enum CITokenKind
 get_keyword__CIScanner(const String *id)
 {
-    Int32 res = get_keyword__Scanner(
-      id, ci_keywords, (const Int32 *)ci_keyword_ids, CI_N_KEYWORD);
+    Int32 res = get_keyword__Scanner(id,
+                                     ci_keywords,
+                                     (const Int32 *)ci_keyword_ids,
+                                     CI_N_KEYWORD,
+                                     &ci_keywords_perfect_hash);
 
     if (res == -1) {
         return CI_TOKEN_KIND_IDENTIFIER;
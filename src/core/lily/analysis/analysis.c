@@ -28,6 +28,7 @@
 
 #include <core/lily/analysis/analysis.h>
 #include <core/lily/analysis/checked/compiler_generic.h>
+#include <core/lily/analysis/checked/data_type_table.h>
 #include <core/lily/analysis/checked/history.h>
 #include <core/lily/analysis/checked/limits.h>
 #include <core/lily/analysis/checked/parent.h>
@@ -139,6 +140,16 @@ check_data_type__LilyAnalysis(LilyAnalysis *self,
                               Vec *deps,
                               enum LilyCheckedSafetyMode safety_mode);
 
+/// @brief Check the data type without interning it (see
+/// check_data_type__LilyAnalysis).
+static LilyCheckedDataType *
+check_uninterned_data_type__LilyAnalysis(
+  LilyAnalysis *self,
+  LilyAstDataType *data_type,
+  LilyCheckedScope *scope,
+  Vec *deps,
+  enum LilyCheckedSafetyMode safety_mode);
+
 static LilyCheckedExpr *
 check_identifier_expr__LilyAnalysis(LilyAnalysis *self,
                                     LilyAstExpr *expr,
@@ -726,6 +737,17 @@ check_fun_params__LilyAnalysis(LilyAnalysis *self,
                                const Vec *params,
                                LilyCheckedScope *scope);
 
+/// @brief Check if the function is the main function of the package.
+static bool
+is_main_fun__LilyAnalysis(const LilyAnalysis *self,
+                          const LilyCheckedDecl *fun);
+
+/// Return true if the function is only checked when it's called (see
+/// has_lazy_fun_body__LilyPackage).
+static bool
+is_checked_on_demand__LilyAnalysis(const LilyAnalysis *self,
+                                   const LilyCheckedDecl *fun);
+
 static void
 check_fun_signature__LilyAnalysis(LilyAnalysis *self, LilyCheckedDecl *fun);
 
@@ -2475,6 +2497,22 @@ check_data_type__LilyAnalysis(LilyAnalysis *self,
                               LilyCheckedScope *scope,
                               Vec *deps,
                               enum LilyCheckedSafetyMode safety_mode)
+{
+    // NOTE: The resolved data types are interned in the table of the program,
+    // so the structurally equal data types share the same payload.
+    return intern__LilyCheckedDataTypeTable(
+      self->package->program->resources.data_types,
+      check_uninterned_data_type__LilyAnalysis(
+        self, data_type, scope, deps, safety_mode));
+}
+
+LilyCheckedDataType *
+check_uninterned_data_type__LilyAnalysis(
+  LilyAnalysis *self,
+  LilyAstDataType *data_type,
+  LilyCheckedScope *scope,
+  Vec *deps,
+  enum LilyCheckedSafetyMode safety_mode)
 {
     // Check if the generic params is required in alias declaration
     if (alias_decl) {
@@ -3602,8 +3640,11 @@ typecheck_binary_expr__LilyAnalysis(LilyAnalysis *self,
     char *binary_kind_string = to_string__LilyCheckedExprBinaryKind(kind);
     bool defined_data_type_is_null = defined_data_type ? 0 : 1;
 
-    Vec *operators = collect_all_operators__LilyCheckedOperatorRegister(
-      &self->package->operator_register, binary_kind_string, 3);
+    Vec *operators = collect_binary_operators__LilyCheckedOperatorRegister(
+      &self->package->operator_register,
+      binary_kind_string,
+      left->data_type,
+      right->data_type);
 
     typecheck_binary__LilyCheckedOperatorRegister(operators,
                                                   &expr->location,
@@ -5541,8 +5582,6 @@ check_fun_call_expr__LilyAnalysis(LilyAnalysis *self,
                           NULL,
                           (LilyCheckedAccessScope){ .id = 0 }));
 
-        FREE(LilyCheckedScopeResponse, response);
-
         return unknown_call;
     } else {
         // Get the signature of the function without
@@ -5737,8 +5776,6 @@ check_fun_call_expr__LilyAnalysis(LilyAnalysis *self,
             }
         }
 
-        FREE(LilyCheckedScopeResponse, response);
-
         return fun_call;
     }
 }
@@ -6679,12 +6716,16 @@ check_literal_expr__LilyAnalysis(LilyAnalysis *self,
                         // Float32.
 
                         literal_data_type =
-                          clone__LilyCheckedDataType(defined_data_type);
+                          NEW(LilyCheckedDataType,
+                              defined_data_type->kind,
+                              NULL);
 
                         break;
                     case LILY_CHECKED_DATA_TYPE_KIND_CDOUBLE:
                         literal_data_type =
-                          clone__LilyCheckedDataType(defined_data_type);
+                          NEW(LilyCheckedDataType,
+                              defined_data_type->kind,
+                              NULL);
 
                         break;
                     default:
@@ -6735,7 +6776,9 @@ check_literal_expr__LilyAnalysis(LilyAnalysis *self,
                               LilyCheckedExpr, unknown, &expr->location, expr);
                         } else {
                             literal_data_type =
-                              clone__LilyCheckedDataType(defined_data_type);
+                              NEW(LilyCheckedDataType,
+                                  defined_data_type->kind,
+                                  NULL);
                         }
 
                         break;
@@ -6758,21 +6801,27 @@ check_literal_expr__LilyAnalysis(LilyAnalysis *self,
                               LilyCheckedExpr, unknown, &expr->location, expr);
                         } else {
                             literal_data_type =
-                              clone__LilyCheckedDataType(defined_data_type);
+                              NEW(LilyCheckedDataType,
+                                  defined_data_type->kind,
+                                  NULL);
                         }
 
                         break;
                     case LILY_CHECKED_DATA_TYPE_KIND_CINT:
                     case LILY_CHECKED_DATA_TYPE_KIND_CLONG:
                         literal_data_type =
-                          clone__LilyCheckedDataType(defined_data_type);
+                          NEW(LilyCheckedDataType,
+                              defined_data_type->kind,
+                              NULL);
 
                         break;
                     case LILY_CHECKED_DATA_TYPE_KIND_INT64:
                     case LILY_CHECKED_DATA_TYPE_KIND_ISIZE:
                     case LILY_CHECKED_DATA_TYPE_KIND_CLONGLONG:
                         literal_data_type =
-                          clone__LilyCheckedDataType(defined_data_type);
+                          NEW(LilyCheckedDataType,
+                              defined_data_type->kind,
+                              NULL);
 
                         break;
                     case LILY_CHECKED_DATA_TYPE_KIND_UINT8:
@@ -6793,7 +6842,9 @@ check_literal_expr__LilyAnalysis(LilyAnalysis *self,
                               LilyCheckedExpr, unknown, &expr->location, expr);
                         } else {
                             literal_data_type =
-                              clone__LilyCheckedDataType(defined_data_type);
+                              NEW(LilyCheckedDataType,
+                                  defined_data_type->kind,
+                                  NULL);
                         }
 
                         break;
@@ -6816,7 +6867,9 @@ check_literal_expr__LilyAnalysis(LilyAnalysis *self,
                               LilyCheckedExpr, unknown, &expr->location, expr);
                         } else {
                             literal_data_type =
-                              clone__LilyCheckedDataType(defined_data_type);
+                              NEW(LilyCheckedDataType,
+                                  defined_data_type->kind,
+                                  NULL);
                         }
 
                         break;
@@ -6840,7 +6893,9 @@ check_literal_expr__LilyAnalysis(LilyAnalysis *self,
                               LilyCheckedExpr, unknown, &expr->location, expr);
                         } else {
                             literal_data_type =
-                              clone__LilyCheckedDataType(defined_data_type);
+                              NEW(LilyCheckedDataType,
+                                  defined_data_type->kind,
+                                  NULL);
                         }
 
                         break;
@@ -6864,7 +6919,9 @@ check_literal_expr__LilyAnalysis(LilyAnalysis *self,
                               LilyCheckedExpr, unknown, &expr->location, expr);
                         } else {
                             literal_data_type =
-                              clone__LilyCheckedDataType(defined_data_type);
+                              NEW(LilyCheckedDataType,
+                                  defined_data_type->kind,
+                                  NULL);
                         }
 
                         break;
@@ -6913,7 +6970,9 @@ check_literal_expr__LilyAnalysis(LilyAnalysis *self,
                               LilyCheckedExpr, unknown, &expr->location, expr);
                         } else {
                             literal_data_type =
-                              clone__LilyCheckedDataType(defined_data_type);
+                              NEW(LilyCheckedDataType,
+                                  defined_data_type->kind,
+                                  NULL);
                         }
 
                         break;
@@ -6936,7 +6995,9 @@ check_literal_expr__LilyAnalysis(LilyAnalysis *self,
                               LilyCheckedExpr, unknown, &expr->location, expr);
                         } else {
                             literal_data_type =
-                              clone__LilyCheckedDataType(defined_data_type);
+                              NEW(LilyCheckedDataType,
+                                  defined_data_type->kind,
+                                  NULL);
                         }
 
                         break;
@@ -6964,7 +7025,9 @@ check_literal_expr__LilyAnalysis(LilyAnalysis *self,
                               LilyCheckedExpr, unknown, &expr->location, expr);
                         } else {
                             literal_data_type =
-                              clone__LilyCheckedDataType(defined_data_type);
+                              NEW(LilyCheckedDataType,
+                                  defined_data_type->kind,
+                                  NULL);
                         }
 
                         break;
@@ -6972,7 +7035,9 @@ check_literal_expr__LilyAnalysis(LilyAnalysis *self,
                     case LILY_CHECKED_DATA_TYPE_KIND_ISIZE:
                     case LILY_CHECKED_DATA_TYPE_KIND_CLONGLONG:
                         literal_data_type =
-                          clone__LilyCheckedDataType(defined_data_type);
+                          NEW(LilyCheckedDataType,
+                              defined_data_type->kind,
+                              NULL);
 
                         break;
 #endif
@@ -6994,7 +7059,9 @@ check_literal_expr__LilyAnalysis(LilyAnalysis *self,
                               LilyCheckedExpr, unknown, &expr->location, expr);
                         } else {
                             literal_data_type =
-                              clone__LilyCheckedDataType(defined_data_type);
+                              NEW(LilyCheckedDataType,
+                                  defined_data_type->kind,
+                                  NULL);
                         }
 
                         break;
@@ -7017,7 +7084,9 @@ check_literal_expr__LilyAnalysis(LilyAnalysis *self,
                               LilyCheckedExpr, unknown, &expr->location, expr);
                         } else {
                             literal_data_type =
-                              clone__LilyCheckedDataType(defined_data_type);
+                              NEW(LilyCheckedDataType,
+                                  defined_data_type->kind,
+                                  NULL);
                         }
 
                         break;
@@ -7040,7 +7109,9 @@ check_literal_expr__LilyAnalysis(LilyAnalysis *self,
                               LilyCheckedExpr, unknown, &expr->location, expr);
                         } else {
                             literal_data_type =
-                              clone__LilyCheckedDataType(defined_data_type);
+                              NEW(LilyCheckedDataType,
+                                  defined_data_type->kind,
+                                  NULL);
                         }
 
                         break;
@@ -7064,7 +7135,9 @@ check_literal_expr__LilyAnalysis(LilyAnalysis *self,
                               LilyCheckedExpr, unknown, &expr->location, expr);
                         } else {
                             literal_data_type =
-                              clone__LilyCheckedDataType(defined_data_type);
+                              NEW(LilyCheckedDataType,
+                                  defined_data_type->kind,
+                                  NULL);
                         }
 
                         break;
@@ -8645,12 +8718,16 @@ check_literal_pattern__LilyAnalysis(LilyAnalysis *self,
                         // Float32.
 
                         literal_data_type =
-                          clone__LilyCheckedDataType(defined_data_type);
+                          NEW(LilyCheckedDataType,
+                              defined_data_type->kind,
+                              NULL);
 
                         break;
                     case LILY_CHECKED_DATA_TYPE_KIND_CDOUBLE:
                         literal_data_type =
-                          clone__LilyCheckedDataType(defined_data_type);
+                          NEW(LilyCheckedDataType,
+                              defined_data_type->kind,
+                              NULL);
 
                         break;
                     default:
@@ -8705,7 +8782,9 @@ check_literal_pattern__LilyAnalysis(LilyAnalysis *self,
                                                pattern);
                         } else {
                             literal_data_type =
-                              clone__LilyCheckedDataType(defined_data_type);
+                              NEW(LilyCheckedDataType,
+                                  defined_data_type->kind,
+                                  NULL);
                         }
 
                         break;
@@ -8730,21 +8809,27 @@ check_literal_pattern__LilyAnalysis(LilyAnalysis *self,
                                                pattern);
                         } else {
                             literal_data_type =
-                              clone__LilyCheckedDataType(defined_data_type);
+                              NEW(LilyCheckedDataType,
+                                  defined_data_type->kind,
+                                  NULL);
                         }
 
                         break;
                     case LILY_CHECKED_DATA_TYPE_KIND_CINT:
                     case LILY_CHECKED_DATA_TYPE_KIND_CLONG:
                         literal_data_type =
-                          clone__LilyCheckedDataType(defined_data_type);
+                          NEW(LilyCheckedDataType,
+                              defined_data_type->kind,
+                              NULL);
 
                         break;
                     case LILY_CHECKED_DATA_TYPE_KIND_INT64:
                     case LILY_CHECKED_DATA_TYPE_KIND_ISIZE:
                     case LILY_CHECKED_DATA_TYPE_KIND_CLONGLONG:
                         literal_data_type =
-                          clone__LilyCheckedDataType(defined_data_type);
+                          NEW(LilyCheckedDataType,
+                              defined_data_type->kind,
+                              NULL);
 
                         break;
                     case LILY_CHECKED_DATA_TYPE_KIND_UINT8:
@@ -8767,7 +8852,9 @@ check_literal_pattern__LilyAnalysis(LilyAnalysis *self,
                                                pattern);
                         } else {
                             literal_data_type =
-                              clone__LilyCheckedDataType(defined_data_type);
+                              NEW(LilyCheckedDataType,
+                                  defined_data_type->kind,
+                                  NULL);
                         }
 
                         break;
@@ -8792,7 +8879,9 @@ check_literal_pattern__LilyAnalysis(LilyAnalysis *self,
                                                pattern);
                         } else {
                             literal_data_type =
-                              clone__LilyCheckedDataType(defined_data_type);
+                              NEW(LilyCheckedDataType,
+                                  defined_data_type->kind,
+                                  NULL);
                         }
 
                         break;
@@ -8818,7 +8907,9 @@ check_literal_pattern__LilyAnalysis(LilyAnalysis *self,
                                                pattern);
                         } else {
                             literal_data_type =
-                              clone__LilyCheckedDataType(defined_data_type);
+                              NEW(LilyCheckedDataType,
+                                  defined_data_type->kind,
+                                  NULL);
                         }
 
                         break;
@@ -8844,7 +8935,9 @@ check_literal_pattern__LilyAnalysis(LilyAnalysis *self,
                                                pattern);
                         } else {
                             literal_data_type =
-                              clone__LilyCheckedDataType(defined_data_type);
+                              NEW(LilyCheckedDataType,
+                                  defined_data_type->kind,
+                                  NULL);
                         }
 
                         break;
@@ -8898,7 +8991,9 @@ check_literal_pattern__LilyAnalysis(LilyAnalysis *self,
                                                pattern);
                         } else {
                             literal_data_type =
-                              clone__LilyCheckedDataType(defined_data_type);
+                              NEW(LilyCheckedDataType,
+                                  defined_data_type->kind,
+                                  NULL);
                         }
 
                         break;
@@ -8923,7 +9018,9 @@ check_literal_pattern__LilyAnalysis(LilyAnalysis *self,
                                                pattern);
                         } else {
                             literal_data_type =
-                              clone__LilyCheckedDataType(defined_data_type);
+                              NEW(LilyCheckedDataType,
+                                  defined_data_type->kind,
+                                  NULL);
                         }
 
                         break;
@@ -8953,7 +9050,9 @@ check_literal_pattern__LilyAnalysis(LilyAnalysis *self,
                                                pattern);
                         } else {
                             literal_data_type =
-                              clone__LilyCheckedDataType(defined_data_type);
+                              NEW(LilyCheckedDataType,
+                                  defined_data_type->kind,
+                                  NULL);
                         }
 
                         break;
@@ -8961,7 +9060,9 @@ check_literal_pattern__LilyAnalysis(LilyAnalysis *self,
                     case LILY_CHECKED_DATA_TYPE_KIND_ISIZE:
                     case LILY_CHECKED_DATA_TYPE_KIND_CLONGLONG:
                         literal_data_type =
-                          clone__LilyCheckedDataType(defined_data_type);
+                          NEW(LilyCheckedDataType,
+                              defined_data_type->kind,
+                              NULL);
 
                         break;
 #endif
@@ -8985,7 +9086,9 @@ check_literal_pattern__LilyAnalysis(LilyAnalysis *self,
                                                pattern);
                         } else {
                             literal_data_type =
-                              clone__LilyCheckedDataType(defined_data_type);
+                              NEW(LilyCheckedDataType,
+                                  defined_data_type->kind,
+                                  NULL);
                         }
 
                         break;
@@ -9010,7 +9113,9 @@ check_literal_pattern__LilyAnalysis(LilyAnalysis *self,
                                                pattern);
                         } else {
                             literal_data_type =
-                              clone__LilyCheckedDataType(defined_data_type);
+                              NEW(LilyCheckedDataType,
+                                  defined_data_type->kind,
+                                  NULL);
                         }
 
                         break;
@@ -9035,7 +9140,9 @@ check_literal_pattern__LilyAnalysis(LilyAnalysis *self,
                                                pattern);
                         } else {
                             literal_data_type =
-                              clone__LilyCheckedDataType(defined_data_type);
+                              NEW(LilyCheckedDataType,
+                                  defined_data_type->kind,
+                                  NULL);
                         }
 
                         break;
@@ -9061,7 +9168,9 @@ check_literal_pattern__LilyAnalysis(LilyAnalysis *self,
                                                pattern);
                         } else {
                             literal_data_type =
-                              clone__LilyCheckedDataType(defined_data_type);
+                              NEW(LilyCheckedDataType,
+                                  defined_data_type->kind,
+                                  NULL);
                         }
 
                         break;
@@ -11030,13 +11139,30 @@ check_fun_params__LilyAnalysis(LilyAnalysis *self,
     return checked_params;
 }
 
+bool
+is_main_fun__LilyAnalysis(const LilyAnalysis *self, const LilyCheckedDecl *fun)
+{
+    return !strcmp(fun->fun.name->buffer, "main") &&
+           !fun->fun.scope->parent->scope->parent &&
+           self->package->status == LILY_PACKAGE_STATUS_MAIN;
+}
+
+bool
+is_checked_on_demand__LilyAnalysis(const LilyAnalysis *self,
+                                   const LilyCheckedDecl *fun)
+{
+    if (fun->fun.is_operator || is_main_fun__LilyAnalysis(self, fun)) {
+        return false;
+    }
+
+    return has_lazy_fun_body__LilyPackage(self->package);
+}
+
 void
 check_fun_signature__LilyAnalysis(LilyAnalysis *self, LilyCheckedDecl *fun)
 {
     // 1. Verify if it's the main function
-    if (!strcmp(fun->fun.name->buffer, "main") &&
-        !fun->fun.scope->parent->scope->parent &&
-        self->package->status == LILY_PACKAGE_STATUS_MAIN) {
+    if (is_main_fun__LilyAnalysis(self, fun)) {
         fun->fun.is_main = true;
         self->package->main_is_found = true;
     }
@@ -11259,6 +11385,8 @@ check_fun__LilyAnalysis(LilyAnalysis *self, LilyCheckedDecl *fun)
     }
 
     // 5. Check body.
+    parse_lazy_fun_body__LilyParser((LilyAstDeclFun *)&fun->ast_decl->fun);
+
     CHECK_FUN_BODY(fun->ast_decl->fun.body,
                    fun->fun.scope,
                    fun->fun.body,
@@ -11804,7 +11932,11 @@ check_decls__LilyAnalysis(LilyAnalysis *self,
 
         switch (decl->kind) {
             case LILY_CHECKED_DECL_KIND_FUN:
-                check_fun__LilyAnalysis(self, decl);
+                // NOTE: The functions checked on demand are checked when they
+                // are called (see check_fun_call_expr__LilyAnalysis).
+                if (!is_checked_on_demand__LilyAnalysis(self, decl)) {
+                    check_fun__LilyAnalysis(self, decl);
+                }
 
                 break;
             case LILY_CHECKED_DECL_KIND_CONSTANT:
@@ -11942,6 +12074,31 @@ run__LilyAnalysis(LilyAnalysis *self)
 #endif
 }
 
+void
+check_lazy_fun__LilyAnalysis(LilyAnalysis *self, LilyCheckedDecl *fun)
+{
+    ASSERT(fun->kind == LILY_CHECKED_DECL_KIND_FUN);
+
+    if (fun->fun.is_checked) {
+        return;
+    }
+
+    LilyCheckedHistory *prev_history = history;
+
+    history = NEW(LilyCheckedHistory);
+
+    add__LilyCheckedHistory(history, fun);
+    check_fun__LilyAnalysis(self, fun);
+
+    FREE(LilyCheckedHistory, &history);
+
+    history = prev_history;
+
+    if (self->package->count_error > 0) {
+        exit(1);
+    }
+}
+
 DESTRUCTOR(LilyAnalysis, const LilyAnalysis *self)
 {
     FREE(String, self->module.name);
@@ -133,6 +133,57 @@ generate_generic_param_from_resolved_data_type__LilyCheckedDataType(
 static void
 remove_choice__LilyCheckedDataType(LilyCheckedDataType *self, Usize id);
 
+// Free the payload of an internable LilyCheckedDataType type (see
+// is_internable__LilyCheckedDataType).
+static void
+free_internable_payload__LilyCheckedDataType(LilyCheckedDataType *self);
+
+#define PRIMITIVE_DATA_TYPE(k)                           \
+    [LILY_CHECKED_DATA_TYPE_KIND_##k] = {                \
+        .kind = LILY_CHECKED_DATA_TYPE_KIND_##k,         \
+        .location = NULL,                                \
+        .ref_count = 0,                                  \
+        .interned = LILY_CHECKED_PRIMITIVE_DATA_TYPE(k), \
+        .is_static = false,                              \
+        .hash = LILY_CHECKED_DATA_TYPE_KIND_##k,         \
+        .has_exact_eq = true,                            \
+        .is_lock = true                                  \
+    }
+
+LilyCheckedDataType
+  lily_checked_primitive_data_types[LILY_CHECKED_DATA_TYPE_KIND_UNKNOWN] = {
+      PRIMITIVE_DATA_TYPE(ANY),
+      PRIMITIVE_DATA_TYPE(BOOL),
+      PRIMITIVE_DATA_TYPE(BYTE),
+      PRIMITIVE_DATA_TYPE(CHAR),
+      PRIMITIVE_DATA_TYPE(CSHORT),
+      PRIMITIVE_DATA_TYPE(CUSHORT),
+      PRIMITIVE_DATA_TYPE(CINT),
+      PRIMITIVE_DATA_TYPE(CUINT),
+      PRIMITIVE_DATA_TYPE(CLONG),
+      PRIMITIVE_DATA_TYPE(CULONG),
+      PRIMITIVE_DATA_TYPE(CLONGLONG),
+      PRIMITIVE_DATA_TYPE(CULONGLONG),
+      PRIMITIVE_DATA_TYPE(CFLOAT),
+      PRIMITIVE_DATA_TYPE(CDOUBLE),
+      PRIMITIVE_DATA_TYPE(CSTR),
+      PRIMITIVE_DATA_TYPE(CVOID),
+      PRIMITIVE_DATA_TYPE(FLOAT32),
+      PRIMITIVE_DATA_TYPE(FLOAT64),
+      PRIMITIVE_DATA_TYPE(INT16),
+      PRIMITIVE_DATA_TYPE(INT32),
+      PRIMITIVE_DATA_TYPE(INT64),
+      PRIMITIVE_DATA_TYPE(INT8),
+      PRIMITIVE_DATA_TYPE(ISIZE),
+      PRIMITIVE_DATA_TYPE(NEVER),
+      PRIMITIVE_DATA_TYPE(UINT16),
+      PRIMITIVE_DATA_TYPE(UINT32),
+      PRIMITIVE_DATA_TYPE(UINT64),
+      PRIMITIVE_DATA_TYPE(UINT8),
+      PRIMITIVE_DATA_TYPE(UNIT),
+      PRIMITIVE_DATA_TYPE(USIZE)
+  };
+
 #define GUARANTEE_COMPILER_DEFINED_DATA_TYPE(dt, min_choices, max_choices) \
     for (Usize i = 0; i < max_choices->len;) {                             \
         LilyCheckedDataType *data_type = get__Vec(max_choices, i);         \
@@ -498,10 +549,23 @@ CONSTRUCTOR(LilyCheckedDataType *,
     self->location = location;
     self->is_lock = true;
     self->ref_count = 0;
+    self->interned = NULL;
+    self->is_static = false;
 
     return self;
 }
 
+LilyCheckedDataType *
+get_primitive__LilyCheckedDataType(enum LilyCheckedDataTypeKind kind)
+{
+    if (kind >= LILY_CHECKED_DATA_TYPE_KIND_UNKNOWN ||
+        !lily_checked_primitive_data_types[kind].interned) {
+        return NULL;
+    }
+
+    return &lily_checked_primitive_data_types[kind];
+}
+
 VARIANT_CONSTRUCTOR(LilyCheckedDataType *,
                     LilyCheckedDataType,
                     array,
@@ -513,6 +577,8 @@ VARIANT_CONSTRUCTOR(LilyCheckedDataType *,
     self->kind = LILY_CHECKED_DATA_TYPE_KIND_ARRAY;
     self->location = location;
     self->ref_count = 0;
+    self->interned = NULL;
+    self->is_static = false;
     self->is_lock = true;
     self->array = array;
 
@@ -530,6 +596,8 @@ VARIANT_CONSTRUCTOR(LilyCheckedDataType *,
     self->kind = LILY_CHECKED_DATA_TYPE_KIND_BYTES;
     self->location = location;
     self->ref_count = 0;
+    self->interned = NULL;
+    self->is_static = false;
     self->is_lock = true;
     self->bytes = bytes;
 
@@ -547,6 +615,8 @@ VARIANT_CONSTRUCTOR(LilyCheckedDataType *,
     self->kind = LILY_CHECKED_DATA_TYPE_KIND_CUSTOM;
     self->location = location;
     self->ref_count = 0;
+    self->interned = NULL;
+    self->is_static = false;
     self->is_lock = true;
     self->custom = custom;
 
@@ -564,6 +634,8 @@ VARIANT_CONSTRUCTOR(LilyCheckedDataType *,
     self->kind = LILY_CHECKED_DATA_TYPE_KIND_LAMBDA;
     self->location = location;
     self->ref_count = 0;
+    self->interned = NULL;
+    self->is_static = false;
     self->is_lock = true;
     self->lambda = lambda;
 
@@ -581,6 +653,8 @@ VARIANT_CONSTRUCTOR(LilyCheckedDataType *,
     self->kind = LILY_CHECKED_DATA_TYPE_KIND_LIST;
     self->location = location;
     self->ref_count = 0;
+    self->interned = NULL;
+    self->is_static = false;
     self->is_lock = true;
     self->list = list;
 
@@ -598,6 +672,8 @@ VARIANT_CONSTRUCTOR(LilyCheckedDataType *,
     self->kind = LILY_CHECKED_DATA_TYPE_KIND_MUT;
     self->location = location;
     self->ref_count = 0;
+    self->interned = NULL;
+    self->is_static = false;
     self->is_lock = true;
     self->mut = mut;
 
@@ -615,6 +691,8 @@ VARIANT_CONSTRUCTOR(LilyCheckedDataType *,
     self->kind = LILY_CHECKED_DATA_TYPE_KIND_OPTIONAL;
     self->location = location;
     self->ref_count = 0;
+    self->interned = NULL;
+    self->is_static = false;
     self->is_lock = true;
     self->optional = optional;
 
@@ -632,6 +710,8 @@ VARIANT_CONSTRUCTOR(LilyCheckedDataType *,
     self->kind = LILY_CHECKED_DATA_TYPE_KIND_PTR;
     self->location = location;
     self->ref_count = 0;
+    self->interned = NULL;
+    self->is_static = false;
     self->is_lock = true;
     self->ptr = ptr;
 
@@ -649,6 +729,8 @@ VARIANT_CONSTRUCTOR(LilyCheckedDataType *,
     self->kind = LILY_CHECKED_DATA_TYPE_KIND_PTR_MUT;
     self->location = location;
     self->ref_count = 0;
+    self->interned = NULL;
+    self->is_static = false;
     self->is_lock = true;
     self->ptr_mut = ptr_mut;
 
@@ -666,6 +748,8 @@ VARIANT_CONSTRUCTOR(LilyCheckedDataType *,
     self->kind = LILY_CHECKED_DATA_TYPE_KIND_REF;
     self->location = location;
     self->ref_count = 0;
+    self->interned = NULL;
+    self->is_static = false;
     self->is_lock = true;
     self->ref = ref;
 
@@ -683,6 +767,8 @@ VARIANT_CONSTRUCTOR(LilyCheckedDataType *,
     self->kind = LILY_CHECKED_DATA_TYPE_KIND_REF_MUT;
     self->location = location;
     self->ref_count = 0;
+    self->interned = NULL;
+    self->is_static = false;
     self->is_lock = true;
     self->ref_mut = ref_mut;
 
@@ -700,6 +786,8 @@ VARIANT_CONSTRUCTOR(LilyCheckedDataType *,
     self->kind = LILY_CHECKED_DATA_TYPE_KIND_RESULT;
     self->location = location;
     self->ref_count = 0;
+    self->interned = NULL;
+    self->is_static = false;
     self->is_lock = true;
     self->result = result;
 
@@ -717,6 +805,8 @@ VARIANT_CONSTRUCTOR(LilyCheckedDataType *,
     self->kind = LILY_CHECKED_DATA_TYPE_KIND_STR;
     self->location = location;
     self->ref_count = 0;
+    self->interned = NULL;
+    self->is_static = false;
     self->is_lock = true;
     self->str = str;
 
@@ -734,6 +824,8 @@ VARIANT_CONSTRUCTOR(LilyCheckedDataType *,
     self->kind = LILY_CHECKED_DATA_TYPE_KIND_TRACE;
     self->location = location;
     self->ref_count = 0;
+    self->interned = NULL;
+    self->is_static = false;
     self->is_lock = true;
     self->trace = trace;
 
@@ -751,6 +843,8 @@ VARIANT_CONSTRUCTOR(LilyCheckedDataType *,
     self->kind = LILY_CHECKED_DATA_TYPE_KIND_TRACE_MUT;
     self->location = location;
     self->ref_count = 0;
+    self->interned = NULL;
+    self->is_static = false;
     self->is_lock = true;
     self->trace_mut = trace_mut;
 
@@ -768,6 +862,8 @@ VARIANT_CONSTRUCTOR(LilyCheckedDataType *,
     self->kind = LILY_CHECKED_DATA_TYPE_KIND_TUPLE;
     self->location = location;
     self->ref_count = 0;
+    self->interned = NULL;
+    self->is_static = false;
     self->is_lock = true;
     self->tuple = tuple;
 
@@ -786,6 +882,8 @@ VARIANT_CONSTRUCTOR(
     self->kind = LILY_CHECKED_DATA_TYPE_KIND_CONDITIONAL_COMPILER_CHOICE;
     self->location = location;
     self->ref_count = 0;
+    self->interned = NULL;
+    self->is_static = false;
     self->is_lock = false;
     self->conditional_compiler_choice = conditional_compiler_choice;
 
@@ -803,6 +901,8 @@ VARIANT_CONSTRUCTOR(LilyCheckedDataType *,
     self->kind = LILY_CHECKED_DATA_TYPE_KIND_COMPILER_CHOICE;
     self->location = location;
     self->ref_count = 0;
+    self->interned = NULL;
+    self->is_static = false;
     self->is_lock = false;
     self->compiler_choice = compiler_choice;
 
@@ -820,6 +920,8 @@ VARIANT_CONSTRUCTOR(LilyCheckedDataType *,
     self->kind = LILY_CHECKED_DATA_TYPE_KIND_COMPILER_GENERIC;
     self->location = location;
     self->ref_count = 0;
+    self->interned = NULL;
+    self->is_static = false;
     self->is_lock = true;
     self->compiler_generic = compiler_generic;
 
@@ -829,6 +931,13 @@ VARIANT_CONSTRUCTOR(LilyCheckedDataType *,
 bool
 eq__LilyCheckedDataType(LilyCheckedDataType *self, LilyCheckedDataType *other)
 {
+    if (self == other) {
+        return true;
+    } else if (self->interned && other->interned &&
+               self->interned->has_exact_eq && other->interned->has_exact_eq) {
+        return self->interned == other->interned;
+    }
+
     if ((self->kind != other->kind &&
          self->kind !=
            LILY_CHECKED_DATA_TYPE_KIND_CONDITIONAL_COMPILER_CHOICE) &&
@@ -1238,6 +1347,12 @@ get_return_data_type_of_conditional_compiler_choice(
 LilyCheckedDataType *
 clone__LilyCheckedDataType(LilyCheckedDataType *self)
 {
+    // NOTE: An interned data type is immutable (except its location and its
+    // reference count), so it's shared instead of being cloned.
+    if (self->interned) {
+        return ref__LilyCheckedDataType(self);
+    }
+
     switch (self->kind) {
         case LILY_CHECKED_DATA_TYPE_KIND_ANY:
         case LILY_CHECKED_DATA_TYPE_KIND_BOOL:
@@ -1650,6 +1765,16 @@ update_data_type__LilyCheckedDataType(LilyCheckedDataType *self,
             break;
     }
 
+    // NOTE: The length of the string and bytes data types is not updated (see
+    // below).
+    if (other->interned && other->kind != LILY_CHECKED_DATA_TYPE_KIND_STR &&
+        other->kind != LILY_CHECKED_DATA_TYPE_KIND_BYTES &&
+        self->kind != LILY_CHECKED_DATA_TYPE_KIND_ARRAY) {
+        set_interned__LilyCheckedDataType(self, other->interned);
+
+        return;
+    }
+
     switch (other->kind) {
         case LILY_CHECKED_DATA_TYPE_KIND_ANY:
         case LILY_CHECKED_DATA_TYPE_KIND_BOOL:
@@ -2816,6 +2941,122 @@ add_choice__LilyCheckedDataType(Vec *choices, LilyCheckedDataType *choice)
     push__Vec(choices, choice);
 }
 
+bool
+is_internable__LilyCheckedDataType(const LilyCheckedDataType *self)
+{
+    if (self->interned) {
+        return true;
+    }
+
+    switch (self->kind) {
+        case LILY_CHECKED_DATA_TYPE_KIND_ANY:
+        case LILY_CHECKED_DATA_TYPE_KIND_BOOL:
+        case LILY_CHECKED_DATA_TYPE_KIND_BYTE:
+        case LILY_CHECKED_DATA_TYPE_KIND_BYTES:
+        case LILY_CHECKED_DATA_TYPE_KIND_CHAR:
+        case LILY_CHECKED_DATA_TYPE_KIND_CSHORT:
+        case LILY_CHECKED_DATA_TYPE_KIND_CUSHORT:
+        case LILY_CHECKED_DATA_TYPE_KIND_CINT:
+        case LILY_CHECKED_DATA_TYPE_KIND_CUINT:
+        case LILY_CHECKED_DATA_TYPE_KIND_CLONG:
+        case LILY_CHECKED_DATA_TYPE_KIND_CULONG:
+        case LILY_CHECKED_DATA_TYPE_KIND_CLONGLONG:
+        case LILY_CHECKED_DATA_TYPE_KIND_CULONGLONG:
+        case LILY_CHECKED_DATA_TYPE_KIND_CFLOAT:
+        case LILY_CHECKED_DATA_TYPE_KIND_CDOUBLE:
+        case LILY_CHECKED_DATA_TYPE_KIND_CSTR:
+        case LILY_CHECKED_DATA_TYPE_KIND_CVOID:
+        case LILY_CHECKED_DATA_TYPE_KIND_FLOAT32:
+        case LILY_CHECKED_DATA_TYPE_KIND_FLOAT64:
+        case LILY_CHECKED_DATA_TYPE_KIND_INT16:
+        case LILY_CHECKED_DATA_TYPE_KIND_INT32:
+        case LILY_CHECKED_DATA_TYPE_KIND_INT64:
+        case LILY_CHECKED_DATA_TYPE_KIND_INT8:
+        case LILY_CHECKED_DATA_TYPE_KIND_ISIZE:
+        case LILY_CHECKED_DATA_TYPE_KIND_NEVER:
+        case LILY_CHECKED_DATA_TYPE_KIND_STR:
+        case LILY_CHECKED_DATA_TYPE_KIND_UINT16:
+        case LILY_CHECKED_DATA_TYPE_KIND_UINT32:
+        case LILY_CHECKED_DATA_TYPE_KIND_UINT64:
+        case LILY_CHECKED_DATA_TYPE_KIND_UINT8:
+        case LILY_CHECKED_DATA_TYPE_KIND_UNIT:
+        case LILY_CHECKED_DATA_TYPE_KIND_USIZE:
+            return true;
+        case LILY_CHECKED_DATA_TYPE_KIND_ARRAY:
+            return self->array.kind !=
+                     LILY_CHECKED_DATA_TYPE_ARRAY_KIND_UNKNOWN &&
+                   is_internable__LilyCheckedDataType(self->array.data_type);
+        case LILY_CHECKED_DATA_TYPE_KIND_LAMBDA:
+            if (self->lambda.params) {
+                for (Usize i = 0; i < self->lambda.params->len; ++i) {
+                    if (!is_internable__LilyCheckedDataType(
+                          get__Vec(self->lambda.params, i))) {
+                        return false;
+                    }
+                }
+            }
+
+            return is_internable__LilyCheckedDataType(
+              self->lambda.return_type);
+        case LILY_CHECKED_DATA_TYPE_KIND_LIST:
+            return is_internable__LilyCheckedDataType(self->list);
+        case LILY_CHECKED_DATA_TYPE_KIND_MUT:
+            return is_internable__LilyCheckedDataType(self->mut);
+        case LILY_CHECKED_DATA_TYPE_KIND_OPTIONAL:
+            return is_internable__LilyCheckedDataType(self->optional);
+        case LILY_CHECKED_DATA_TYPE_KIND_PTR:
+            return is_internable__LilyCheckedDataType(self->ptr);
+        case LILY_CHECKED_DATA_TYPE_KIND_PTR_MUT:
+            return is_internable__LilyCheckedDataType(self->ptr_mut);
+        case LILY_CHECKED_DATA_TYPE_KIND_REF:
+            return is_internable__LilyCheckedDataType(self->ref);
+        case LILY_CHECKED_DATA_TYPE_KIND_REF_MUT:
+            return is_internable__LilyCheckedDataType(self->ref_mut);
+        case LILY_CHECKED_DATA_TYPE_KIND_TRACE:
+            return is_internable__LilyCheckedDataType(self->trace);
+        case LILY_CHECKED_DATA_TYPE_KIND_TRACE_MUT:
+            return is_internable__LilyCheckedDataType(self->trace_mut);
+        case LILY_CHECKED_DATA_TYPE_KIND_TUPLE:
+            for (Usize i = 0; i < self->tuple->len; ++i) {
+                if (!is_internable__LilyCheckedDataType(
+                      get__Vec(self->tuple, i))) {
+                    return false;
+                }
+            }
+
+            return true;
+        // NOTE: The custom data types are updated after their analysis (e.g.
+        // `is_recursive`), and the result data types share their payload.
+        case LILY_CHECKED_DATA_TYPE_KIND_CUSTOM:
+        case LILY_CHECKED_DATA_TYPE_KIND_RESULT:
+        case LILY_CHECKED_DATA_TYPE_KIND_UNKNOWN:
+        case LILY_CHECKED_DATA_TYPE_KIND_CONDITIONAL_COMPILER_CHOICE:
+        case LILY_CHECKED_DATA_TYPE_KIND_COMPILER_CHOICE:
+        case LILY_CHECKED_DATA_TYPE_KIND_COMPILER_GENERIC:
+            return false;
+        default:
+            UNREACHABLE("unknown variant");
+    }
+}
+
+void
+set_interned__LilyCheckedDataType(LilyCheckedDataType *self,
+                                  LilyCheckedDataType *interned)
+{
+    ASSERT(interned->interned == interned);
+
+    const Location *location = self->location;
+    Usize ref_count = self->ref_count;
+
+    if (!self->interned) {
+        free_internable_payload__LilyCheckedDataType(self);
+    }
+
+    *self = *interned;
+    self->location = location;
+    self->ref_count = ref_count;
+}
+
 bool
 can_update__LilyCheckedDataType(LilyCheckedDataType *self)
 {
@@ -3181,6 +3422,53 @@ IMPL_FOR_DEBUG(debug, LilyCheckedDataType, const LilyCheckedDataType *self)
 }
 #endif
 
+void
+free_internable_payload__LilyCheckedDataType(LilyCheckedDataType *self)
+{
+    switch (self->kind) {
+        case LILY_CHECKED_DATA_TYPE_KIND_ARRAY:
+            FREE(LilyCheckedDataTypeArray, &self->array);
+            break;
+        case LILY_CHECKED_DATA_TYPE_KIND_LAMBDA:
+            FREE(LilyCheckedDataTypeLambda, &self->lambda);
+            break;
+        case LILY_CHECKED_DATA_TYPE_KIND_LIST:
+            FREE(LilyCheckedDataType, self->list);
+            break;
+        case LILY_CHECKED_DATA_TYPE_KIND_MUT:
+            FREE(LilyCheckedDataType, self->mut);
+            break;
+        case LILY_CHECKED_DATA_TYPE_KIND_OPTIONAL:
+            FREE(LilyCheckedDataType, self->optional);
+            break;
+        case LILY_CHECKED_DATA_TYPE_KIND_PTR:
+            FREE(LilyCheckedDataType, self->ptr);
+            break;
+        case LILY_CHECKED_DATA_TYPE_KIND_PTR_MUT:
+            FREE(LilyCheckedDataType, self->ptr_mut);
+            break;
+        case LILY_CHECKED_DATA_TYPE_KIND_REF:
+            FREE(LilyCheckedDataType, self->ref);
+            break;
+        case LILY_CHECKED_DATA_TYPE_KIND_REF_MUT:
+            FREE(LilyCheckedDataType, self->ref_mut);
+            break;
+        case LILY_CHECKED_DATA_TYPE_KIND_TRACE:
+            FREE(LilyCheckedDataType, self->trace);
+            break;
+        case LILY_CHECKED_DATA_TYPE_KIND_TRACE_MUT:
+            FREE(LilyCheckedDataType, self->trace_mut);
+            break;
+        case LILY_CHECKED_DATA_TYPE_KIND_TUPLE:
+            FREE_BUFFER_ITEMS(
+              self->tuple->buffer, self->tuple->len, LilyCheckedDataType);
+            FREE(Vec, self->tuple);
+            break;
+        default:
+            break;
+    }
+}
+
 VARIANT_DESTRUCTOR(LilyCheckedDataType, array, LilyCheckedDataType *self)
 {
     FREE(LilyCheckedDataTypeArray, &self->array);
@@ -3286,6 +3574,26 @@ VARIANT_DESTRUCTOR(LilyCheckedDataType,
 
 DESTRUCTOR(LilyCheckedDataType, LilyCheckedDataType *self)
 {
+    if (self->is_static) {
+        return;
+    }
+
+    // NOTE: The nodes of the table are freed with the table, and the payload
+    // of an interned data type is borrowed.
+    if (self->interned) {
+        if (self->interned == self) {
+            return;
+        } else if (self->ref_count > 0) {
+            --self->ref_count;
+
+            return;
+        }
+
+        lily_free(self);
+
+        return;
+    }
+
     if (self->ref_count > 0) {
         --self->ref_count;
 
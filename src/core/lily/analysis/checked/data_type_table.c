@@ -0,0 +1,555 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2025 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/alloc.h>
+#include <base/assert.h>
+#include <base/new.h>
+
+#include <core/lily/analysis/checked/data_type_table.h>
+
+#include <string.h>
+
+/**
+ *
+ * @brief Combine the hash with the value.
+ */
+static inline Uint64
+combine_hash__LilyCheckedDataTypeTable(Uint64 hash, Uint64 value);
+
+/**
+ *
+ * @brief Hash the node (its children are nodes of the table).
+ */
+static Uint64
+hash_node__LilyCheckedDataTypeTable(const LilyCheckedDataType *node);
+
+/**
+ *
+ * @brief Check if the both nodes have the same structure (their children are
+ * nodes of the table).
+ */
+static bool
+is_same_node__LilyCheckedDataTypeTable(const LilyCheckedDataType *node,
+                                       const LilyCheckedDataType *other);
+
+/**
+ *
+ * @brief Check if the equality of the node is exact (see `has_exact_eq` in
+ * LilyCheckedDataType).
+ */
+static bool
+has_exact_eq__LilyCheckedDataTypeTable(const LilyCheckedDataType *node);
+
+/**
+ *
+ * @brief Free the containers of the node (not its children, which are nodes of
+ * the table).
+ */
+static void
+free_node_payload__LilyCheckedDataTypeTable(LilyCheckedDataType *node);
+
+/**
+ *
+ * @brief Insert the node in the table, and grow the table if it's needed.
+ */
+static void
+insert__LilyCheckedDataTypeTable(LilyCheckedDataTypeTable *self,
+                                 LilyCheckedDataType *node);
+
+/**
+ *
+ * @brief Get the node of the data type, or insert it if it doesn't exist.
+ * @note The table must be locked.
+ * @return LilyCheckedDataType* (&)
+ */
+static LilyCheckedDataType *
+get_node__LilyCheckedDataTypeTable(LilyCheckedDataTypeTable *self,
+                                   LilyCheckedDataType *data_type);
+
+CONSTRUCTOR(LilyCheckedDataTypeTable *, LilyCheckedDataTypeTable)
+{
+    LilyCheckedDataTypeTable *self =
+      lily_malloc(sizeof(LilyCheckedDataTypeTable));
+
+    self->nodes = lily_calloc(LILY_CHECKED_DATA_TYPE_TABLE_DEFAULT_CAPACITY,
+                              sizeof(LilyCheckedDataType *));
+    self->capacity = LILY_CHECKED_DATA_TYPE_TABLE_DEFAULT_CAPACITY;
+    self->len = 0;
+
+    pthread_mutex_init(&self->mutex, NULL);
+
+    return self;
+}
+
+Uint64
+combine_hash__LilyCheckedDataTypeTable(Uint64 hash, Uint64 value)
+{
+    return hash ^ (value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2));
+}
+
+Uint64
+hash_node__LilyCheckedDataTypeTable(const LilyCheckedDataType *node)
+{
+    Uint64 hash = combine_hash__LilyCheckedDataTypeTable(0, node->kind);
+
+    switch (node->kind) {
+        case LILY_CHECKED_DATA_TYPE_KIND_ARRAY:
+            hash =
+              combine_hash__LilyCheckedDataTypeTable(hash, node->array.kind);
+
+            if (node->array.kind == LILY_CHECKED_DATA_TYPE_ARRAY_KIND_SIZED) {
+                hash = combine_hash__LilyCheckedDataTypeTable(
+                  hash, node->array.sized);
+            }
+
+            return combine_hash__LilyCheckedDataTypeTable(
+              hash, node->array.data_type->hash);
+        case LILY_CHECKED_DATA_TYPE_KIND_BYTES:
+            return combine_hash__LilyCheckedDataTypeTable(
+              hash, node->bytes.is_undef ? -1 : node->bytes.len);
+        case LILY_CHECKED_DATA_TYPE_KIND_STR:
+            return combine_hash__LilyCheckedDataTypeTable(
+              hash, node->str.is_undef ? -1 : node->str.len);
+        case LILY_CHECKED_DATA_TYPE_KIND_LAMBDA:
+            if (node->lambda.params) {
+                hash = combine_hash__LilyCheckedDataTypeTable(
+                  hash, node->lambda.params->len);
+
+                for (Usize i = 0; i < node->lambda.params->len; ++i) {
+                    hash = combine_hash__LilyCheckedDataTypeTable(
+                      hash,
+                      CAST(LilyCheckedDataType *,
+                           get__Vec(node->lambda.params, i))
+                        ->hash);
+                }
+            }
+
+            return combine_hash__LilyCheckedDataTypeTable(
+              hash, node->lambda.return_type->hash);
+        case LILY_CHECKED_DATA_TYPE_KIND_LIST:
+            return combine_hash__LilyCheckedDataTypeTable(hash,
+                                                          node->list->hash);
+        case LILY_CHECKED_DATA_TYPE_KIND_MUT:
+            return combine_hash__LilyCheckedDataTypeTable(hash,
+                                                          node->mut->hash);
+        case LILY_CHECKED_DATA_TYPE_KIND_OPTIONAL:
+            return combine_hash__LilyCheckedDataTypeTable(
+              hash, node->optional->hash);
+        case LILY_CHECKED_DATA_TYPE_KIND_PTR:
+            return combine_hash__LilyCheckedDataTypeTable(hash,
+                                                          node->ptr->hash);
+        case LILY_CHECKED_DATA_TYPE_KIND_PTR_MUT:
+            return combine_hash__LilyCheckedDataTypeTable(
+              hash, node->ptr_mut->hash);
+        case LILY_CHECKED_DATA_TYPE_KIND_REF:
+            return combine_hash__LilyCheckedDataTypeTable(hash,
+                                                          node->ref->hash);
+        case LILY_CHECKED_DATA_TYPE_KIND_REF_MUT:
+            return combine_hash__LilyCheckedDataTypeTable(
+              hash, node->ref_mut->hash);
+        case LILY_CHECKED_DATA_TYPE_KIND_TRACE:
+            return combine_hash__LilyCheckedDataTypeTable(hash,
+                                                          node->trace->hash);
+        case LILY_CHECKED_DATA_TYPE_KIND_TRACE_MUT:
+            return combine_hash__LilyCheckedDataTypeTable(
+              hash, node->trace_mut->hash);
+        case LILY_CHECKED_DATA_TYPE_KIND_TUPLE:
+            hash =
+              combine_hash__LilyCheckedDataTypeTable(hash, node->tuple->len);
+
+            for (Usize i = 0; i < node->tuple->len; ++i) {
+                hash = combine_hash__LilyCheckedDataTypeTable(
+                  hash,
+                  CAST(LilyCheckedDataType *, get__Vec(node->tuple, i))->hash);
+            }
+
+            return hash;
+        default:
+            return hash;
+    }
+}
+
+bool
+is_same_node__LilyCheckedDataTypeTable(const LilyCheckedDataType *node,
+                                       const LilyCheckedDataType *other)
+{
+    if (node->kind != other->kind) {
+        return false;
+    }
+
+    switch (node->kind) {
+        case LILY_CHECKED_DATA_TYPE_KIND_ARRAY:
+            return node->array.kind == other->array.kind &&
+                   (node->array.kind !=
+                      LILY_CHECKED_DATA_TYPE_ARRAY_KIND_SIZED ||
+                    node->array.sized == other->array.sized) &&
+                   node->array.data_type == other->array.data_type;
+        case LILY_CHECKED_DATA_TYPE_KIND_BYTES:
+            return node->bytes.is_undef == other->bytes.is_undef &&
+                   (node->bytes.is_undef ||
+                    node->bytes.len == other->bytes.len);
+        case LILY_CHECKED_DATA_TYPE_KIND_STR:
+            return node->str.is_undef == other->str.is_undef &&
+                   (node->str.is_undef || node->str.len == other->str.len);
+        case LILY_CHECKED_DATA_TYPE_KIND_LAMBDA:
+            if (!node->lambda.params || !other->lambda.params) {
+                if (node->lambda.params != other->lambda.params) {
+                    return false;
+                }
+            } else if (node->lambda.params->len ==
+                       other->lambda.params->len) {
+                for (Usize i = 0; i < node->lambda.params->len; ++i) {
+                    if (get__Vec(node->lambda.params, i) !=
+                        get__Vec(other->lambda.params, i)) {
+                        return false;
+                    }
+                }
+            } else {
+                return false;
+            }
+
+            return node->lambda.return_type == other->lambda.return_type;
+        case LILY_CHECKED_DATA_TYPE_KIND_LIST:
+            return node->list == other->list;
+        case LILY_CHECKED_DATA_TYPE_KIND_MUT:
+            return node->mut == other->mut;
+        case LILY_CHECKED_DATA_TYPE_KIND_OPTIONAL:
+            return node->optional == other->optional;
+        case LILY_CHECKED_DATA_TYPE_KIND_PTR:
+            return node->ptr == other->ptr;
+        case LILY_CHECKED_DATA_TYPE_KIND_PTR_MUT:
+            return node->ptr_mut == other->ptr_mut;
+        case LILY_CHECKED_DATA_TYPE_KIND_REF:
+            return node->ref == other->ref;
+        case LILY_CHECKED_DATA_TYPE_KIND_REF_MUT:
+            return node->ref_mut == other->ref_mut;
+        case LILY_CHECKED_DATA_TYPE_KIND_TRACE:
+            return node->trace == other->trace;
+        case LILY_CHECKED_DATA_TYPE_KIND_TRACE_MUT:
+            return node->trace_mut == other->trace_mut;
+        case LILY_CHECKED_DATA_TYPE_KIND_TUPLE:
+            if (node->tuple->len != other->tuple->len) {
+                return false;
+            }
+
+            for (Usize i = 0; i < node->tuple->len; ++i) {
+                if (get__Vec(node->tuple, i) != get__Vec(other->tuple, i)) {
+                    return false;
+                }
+            }
+
+            return true;
+        default:
+            return true;
+    }
+}
+
+bool
+has_exact_eq__LilyCheckedDataTypeTable(const LilyCheckedDataType *node)
+{
+    switch (node->kind) {
+        // NOTE: `mut T` is equal to `T`, `?T` can be equal to `T`, and the
+        // length of the string and bytes data types is not compared (see
+        // eq__LilyCheckedDataType).
+        case LILY_CHECKED_DATA_TYPE_KIND_BYTES:
+        case LILY_CHECKED_DATA_TYPE_KIND_MUT:
+        case LILY_CHECKED_DATA_TYPE_KIND_OPTIONAL:
+        case LILY_CHECKED_DATA_TYPE_KIND_STR:
+            return false;
+        case LILY_CHECKED_DATA_TYPE_KIND_ARRAY:
+            return node->array.data_type->has_exact_eq;
+        case LILY_CHECKED_DATA_TYPE_KIND_LAMBDA:
+            if (node->lambda.params) {
+                for (Usize i = 0; i < node->lambda.params->len; ++i) {
+                    if (!CAST(LilyCheckedDataType *,
+                              get__Vec(node->lambda.params, i))
+                           ->has_exact_eq) {
+                        return false;
+                    }
+                }
+            }
+
+            return node->lambda.return_type->has_exact_eq;
+        case LILY_CHECKED_DATA_TYPE_KIND_LIST:
+            return node->list->has_exact_eq;
+        case LILY_CHECKED_DATA_TYPE_KIND_PTR:
+            return node->ptr->has_exact_eq;
+        case LILY_CHECKED_DATA_TYPE_KIND_PTR_MUT:
+            return node->ptr_mut->has_exact_eq;
+        case LILY_CHECKED_DATA_TYPE_KIND_REF:
+            return node->ref->has_exact_eq;
+        case LILY_CHECKED_DATA_TYPE_KIND_REF_MUT:
+            return node->ref_mut->has_exact_eq;
+        case LILY_CHECKED_DATA_TYPE_KIND_TRACE:
+            return node->trace->has_exact_eq;
+        case LILY_CHECKED_DATA_TYPE_KIND_TRACE_MUT:
+            return node->trace_mut->has_exact_eq;
+        case LILY_CHECKED_DATA_TYPE_KIND_TUPLE:
+            for (Usize i = 0; i < node->tuple->len; ++i) {
+                if (!CAST(LilyCheckedDataType *, get__Vec(node->tuple, i))
+                       ->has_exact_eq) {
+                    return false;
+                }
+            }
+
+            return true;
+        default:
+            return true;
+    }
+}
+
+void
+free_node_payload__LilyCheckedDataTypeTable(LilyCheckedDataType *node)
+{
+    switch (node->kind) {
+        case LILY_CHECKED_DATA_TYPE_KIND_LAMBDA:
+            if (node->lambda.params) {
+                FREE(Vec, node->lambda.params);
+            }
+
+            break;
+        case LILY_CHECKED_DATA_TYPE_KIND_TUPLE:
+            FREE(Vec, node->tuple);
+
+            break;
+        default:
+            break;
+    }
+}
+
+void
+insert__LilyCheckedDataTypeTable(LilyCheckedDataTypeTable *self,
+                                 LilyCheckedDataType *node)
+{
+    // NOTE: The load factor of the table is kept under 3/4.
+    if ((self->len + 1) * 4 > self->capacity * 3) {
+        LilyCheckedDataType **nodes = self->nodes;
+        Usize capacity = self->capacity;
+
+        self->capacity *= 2;
+        self->nodes =
+          lily_calloc(self->capacity, sizeof(LilyCheckedDataType *));
+        self->len = 0;
+
+        for (Usize i = 0; i < capacity; ++i) {
+            if (nodes[i]) {
+                insert__LilyCheckedDataTypeTable(self, nodes[i]);
+            }
+        }
+
+        lily_free(nodes);
+    }
+
+    Usize mask = self->capacity - 1;
+    Usize i = node->hash & mask;
+
+    while (self->nodes[i]) {
+        i = (i + 1) & mask;
+    }
+
+    self->nodes[i] = node;
+    ++self->len;
+}
+
+LilyCheckedDataType *
+get_node__LilyCheckedDataTypeTable(LilyCheckedDataTypeTable *self,
+                                   LilyCheckedDataType *data_type)
+{
+    if (data_type->interned) {
+        return data_type->interned;
+    }
+
+    // The primitive data types are shared by all the tables (see
+    // lily_checked_primitive_data_types).
+    LilyCheckedDataType *primitive =
+      get_primitive__LilyCheckedDataType(data_type->kind);
+
+    if (primitive) {
+        return primitive;
+    }
+
+    // The children of the node are first replaced by their node.
+    LilyCheckedDataType node = { .kind = data_type->kind,
+                                 .location = NULL,
+                                 .ref_count = 0,
+                                 .interned = NULL,
+                                 .is_lock = true };
+
+    switch (data_type->kind) {
+        case LILY_CHECKED_DATA_TYPE_KIND_ARRAY:
+            node.array = data_type->array;
+            node.array.data_type = get_node__LilyCheckedDataTypeTable(
+              self, data_type->array.data_type);
+
+            break;
+        case LILY_CHECKED_DATA_TYPE_KIND_BYTES:
+            node.bytes = data_type->bytes;
+
+            break;
+        case LILY_CHECKED_DATA_TYPE_KIND_STR:
+            node.str = data_type->str;
+
+            break;
+        case LILY_CHECKED_DATA_TYPE_KIND_LAMBDA: {
+            Vec *params = NULL; // Vec<LilyCheckedDataType* (&)>*?
+
+            if (data_type->lambda.params) {
+                params = NEW(Vec);
+
+                for (Usize i = 0; i < data_type->lambda.params->len; ++i) {
+                    push__Vec(params,
+                              get_node__LilyCheckedDataTypeTable(
+                                self, get__Vec(data_type->lambda.params, i)));
+                }
+            }
+
+            node.lambda = NEW(LilyCheckedDataTypeLambda,
+                              params,
+                              get_node__LilyCheckedDataTypeTable(
+                                self, data_type->lambda.return_type));
+
+            break;
+        }
+        case LILY_CHECKED_DATA_TYPE_KIND_LIST:
+            node.list =
+              get_node__LilyCheckedDataTypeTable(self, data_type->list);
+
+            break;
+        case LILY_CHECKED_DATA_TYPE_KIND_MUT:
+            node.mut = get_node__LilyCheckedDataTypeTable(self, data_type->mut);
+
+            break;
+        case LILY_CHECKED_DATA_TYPE_KIND_OPTIONAL:
+            node.optional =
+              get_node__LilyCheckedDataTypeTable(self, data_type->optional);
+
+            break;
+        case LILY_CHECKED_DATA_TYPE_KIND_PTR:
+            node.ptr = get_node__LilyCheckedDataTypeTable(self, data_type->ptr);
+
+            break;
+        case LILY_CHECKED_DATA_TYPE_KIND_PTR_MUT:
+            node.ptr_mut =
+              get_node__LilyCheckedDataTypeTable(self, data_type->ptr_mut);
+
+            break;
+        case LILY_CHECKED_DATA_TYPE_KIND_REF:
+            node.ref = get_node__LilyCheckedDataTypeTable(self, data_type->ref);
+
+            break;
+        case LILY_CHECKED_DATA_TYPE_KIND_REF_MUT:
+            node.ref_mut =
+              get_node__LilyCheckedDataTypeTable(self, data_type->ref_mut);
+
+            break;
+        case LILY_CHECKED_DATA_TYPE_KIND_TRACE:
+            node.trace =
+              get_node__LilyCheckedDataTypeTable(self, data_type->trace);
+
+            break;
+        case LILY_CHECKED_DATA_TYPE_KIND_TRACE_MUT:
+            node.trace_mut =
+              get_node__LilyCheckedDataTypeTable(self, data_type->trace_mut);
+
+            break;
+        case LILY_CHECKED_DATA_TYPE_KIND_TUPLE: {
+            Vec *tuple = NEW(Vec); // Vec<LilyCheckedDataType* (&)>*
+
+            for (Usize i = 0; i < data_type->tuple->len; ++i) {
+                push__Vec(tuple,
+                          get_node__LilyCheckedDataTypeTable(
+                            self, get__Vec(data_type->tuple, i)));
+            }
+
+            node.tuple = tuple;
+
+            break;
+        }
+        default:
+            break;
+    }
+
+    node.hash = hash_node__LilyCheckedDataTypeTable(&node);
+
+    // Look for a node with the same structure.
+    {
+        Usize mask = self->capacity - 1;
+
+        for (Usize i = node.hash & mask; self->nodes[i]; i = (i + 1) & mask) {
+            LilyCheckedDataType *current = self->nodes[i];
+
+            if (current->hash == node.hash &&
+                is_same_node__LilyCheckedDataTypeTable(current, &node)) {
+                free_node_payload__LilyCheckedDataTypeTable(&node);
+
+                return current;
+            }
+        }
+    }
+
+    LilyCheckedDataType *res = lily_malloc(sizeof(LilyCheckedDataType));
+
+    *res = node;
+    res->interned = res;
+    res->has_exact_eq = has_exact_eq__LilyCheckedDataTypeTable(res);
+
+    insert__LilyCheckedDataTypeTable(self, res);
+
+    return res;
+}
+
+LilyCheckedDataType *
+intern__LilyCheckedDataTypeTable(LilyCheckedDataTypeTable *self,
+                                 LilyCheckedDataType *data_type)
+{
+    if (data_type->interned ||
+        !is_internable__LilyCheckedDataType(data_type)) {
+        return data_type;
+    }
+
+    pthread_mutex_lock(&self->mutex);
+
+    LilyCheckedDataType *node =
+      get_node__LilyCheckedDataTypeTable(self, data_type);
+
+    pthread_mutex_unlock(&self->mutex);
+
+    set_interned__LilyCheckedDataType(data_type, node);
+
+    return data_type;
+}
+
+DESTRUCTOR(LilyCheckedDataTypeTable, LilyCheckedDataTypeTable *self)
+{
+    for (Usize i = 0; i < self->capacity; ++i) {
+        if (self->nodes[i]) {
+            free_node_payload__LilyCheckedDataTypeTable(self->nodes[i]);
+            lily_free(self->nodes[i]);
+        }
+    }
+
+    lily_free(self->nodes);
+    pthread_mutex_destroy(&self->mutex);
+    lily_free(self);
+}
@@ -22,10 +22,20 @@
  * SOFTWARE.
  */
 
+#include <base/hash_map.h>
+
 #include <core/lily/analysis/checked/operator.h>
 
+#include <pthread.h>
 #include <string.h>
 
+/**
+ *
+ * @brief Index the default operators by name.
+ */
+static void
+index_default_operators__LilyCheckedOperator();
+
 CONSTRUCTOR(LilyCheckedOperator *,
             LilyCheckedOperator,
             String *name,
@@ -37,7 +47,7 @@ CONSTRUCTOR(LilyCheckedOperator *,
     self->name = name;
     self->signature = signature;
     self->is_default = is_default;
-    self->ref_count = 0;
+    atomic_init(&self->ref_count, 0);
 
     return self;
 }
@@ -78,1401 +88,258 @@ valid_operator__LilyCheckedOperator(String *name)
 // assignment operators are not. This is because the compiler checks whether all
 // assigned types are mutable.
 
-#define BASIC_ARITHMETIC_BINARY_OPERATOR(op_name)                              \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BYTE, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BYTE, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BYTE, NULL)), \
-          true);                                                               \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CSHORT, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CSHORT, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CSHORT, NULL)),   \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CUSHORT, NULL),   \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CUSHORT, NULL),   \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CUSHORT, NULL)),  \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CINT, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CINT, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CINT, NULL)), \
-          true);                                                               \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CUINT, NULL),     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CUINT, NULL),     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CUINT, NULL)),    \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CLONG, NULL),     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CLONG, NULL),     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CLONG, NULL)),    \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CULONG, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CULONG, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CULONG, NULL)),   \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CLONGLONG, NULL), \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CLONGLONG, NULL), \
-        NEW(                                                                   \
-          LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CLONGLONG, NULL)),  \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(                                                                   \
-          LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CULONGLONG, NULL),  \
-        NEW(                                                                   \
-          LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CULONGLONG, NULL),  \
-        NEW(                                                                   \
-          LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CULONGLONG, NULL)), \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CFLOAT, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CFLOAT, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CFLOAT, NULL)),   \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CDOUBLE, NULL),   \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CDOUBLE, NULL),   \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CDOUBLE, NULL)),  \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_FLOAT32, NULL),   \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_FLOAT32, NULL),   \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_FLOAT32, NULL)),  \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_FLOAT64, NULL),   \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_FLOAT64, NULL),   \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_FLOAT64, NULL)),  \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT16, NULL),     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT16, NULL),     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT16, NULL)),    \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT32, NULL),     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT32, NULL),     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT32, NULL)),    \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT64, NULL),     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT64, NULL),     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT64, NULL)),    \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT8, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT8, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT8, NULL)), \
-          true);                                                               \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ISIZE, NULL),     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ISIZE, NULL),     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ISIZE, NULL)),    \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT16, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT16, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT16, NULL)),   \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT32, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT32, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT32, NULL)),   \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT64, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT64, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT64, NULL)),   \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT8, NULL),     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT8, NULL),     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT8, NULL)),    \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_USIZE, NULL),     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_USIZE, NULL),     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_USIZE, NULL)),    \
-      true);
-
-#define BASIC_BITWISE_BINARY_OPERATOR(op_name)                                 \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BOOL, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BOOL, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BOOL, NULL)), \
-          true);                                                               \
-                                                                               \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BYTE, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BYTE, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BYTE, NULL)), \
-          true);                                                               \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CSHORT, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CSHORT, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CSHORT, NULL)),   \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CUSHORT, NULL),   \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CUSHORT, NULL),   \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CUSHORT, NULL)),  \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CINT, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CINT, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CINT, NULL)), \
-          true);                                                               \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CUINT, NULL),     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CUINT, NULL),     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CUINT, NULL)),    \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CLONG, NULL),     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CLONG, NULL),     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CLONG, NULL)),    \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CULONG, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CULONG, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CULONG, NULL)),   \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CLONGLONG, NULL), \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CLONGLONG, NULL), \
-        NEW(                                                                   \
-          LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CLONGLONG, NULL)),  \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(                                                                   \
-          LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CULONGLONG, NULL),  \
-        NEW(                                                                   \
-          LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CULONGLONG, NULL),  \
-        NEW(                                                                   \
-          LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CULONGLONG, NULL)), \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CFLOAT, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CFLOAT, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CFLOAT, NULL)),   \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CDOUBLE, NULL),   \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CDOUBLE, NULL),   \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CDOUBLE, NULL)),  \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT16, NULL),     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT16, NULL),     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT16, NULL)),    \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT32, NULL),     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT32, NULL),     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT32, NULL)),    \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT64, NULL),     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT64, NULL),     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT64, NULL)),    \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT8, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT8, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT8, NULL)), \
-          true);                                                               \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ISIZE, NULL),     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ISIZE, NULL),     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ISIZE, NULL)),    \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT16, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT16, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT16, NULL)),   \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT32, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT32, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT32, NULL)),   \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT64, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT64, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT64, NULL)),   \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT8, NULL),     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT8, NULL),     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT8, NULL)),    \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_USIZE, NULL),     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_USIZE, NULL),     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_USIZE, NULL)),    \
-      true);
-
-#define BASIC_ASSIGN_BINARY_OPERATOR(op_name)                                  \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BOOL, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BOOL, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)), \
-          true);                                                               \
-                                                                               \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BYTE, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BYTE, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)), \
-          true);                                                               \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CSHORT, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CSHORT, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)),     \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CUSHORT, NULL),   \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CUSHORT, NULL),   \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)),     \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CINT, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CINT, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)), \
-          true);                                                               \
-                                                                               \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CUINT, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CUINT, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)), \
-          true);                                                               \
-                                                                               \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CLONG, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CLONG, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)), \
-          true);                                                               \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CULONG, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CULONG, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)),     \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CLONGLONG, NULL), \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CLONGLONG, NULL), \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)),     \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(                                                                   \
-          LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CULONGLONG, NULL),  \
-        NEW(                                                                   \
-          LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CULONGLONG, NULL),  \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)),     \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CFLOAT, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CFLOAT, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)),     \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CDOUBLE, NULL),   \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CDOUBLE, NULL),   \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)),     \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_FLOAT32, NULL),   \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_FLOAT32, NULL),   \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)),     \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_FLOAT64, NULL),   \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_FLOAT64, NULL),   \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)),     \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT16, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT16, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)), \
-          true);                                                               \
-                                                                               \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT32, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT32, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)), \
-          true);                                                               \
-                                                                               \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT64, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT64, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)), \
-          true);                                                               \
-                                                                               \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT8, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT8, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)), \
-          true);                                                               \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT16, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT16, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)),     \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT32, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT32, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)),     \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT64, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT64, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)),     \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT8, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT8, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)), \
-          true);
-
-#define BASIC_BITWISE_ASSIGN_BINARY_OPERATOR(op_name)                          \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CSHORT, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CSHORT, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)),     \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CUSHORT, NULL),   \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CUSHORT, NULL),   \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)),     \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CINT, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CINT, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)), \
-          true);                                                               \
-                                                                               \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CUINT, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CUINT, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)), \
-          true);                                                               \
-                                                                               \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CLONG, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CLONG, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)), \
-          true);                                                               \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CULONG, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CULONG, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)),     \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CLONGLONG, NULL), \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CLONGLONG, NULL), \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)),     \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(                                                                   \
-          LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CULONGLONG, NULL),  \
-        NEW(                                                                   \
-          LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CULONGLONG, NULL),  \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)),     \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CFLOAT, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CFLOAT, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)),     \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CDOUBLE, NULL),   \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CDOUBLE, NULL),   \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)),     \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_FLOAT32, NULL),   \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_FLOAT32, NULL),   \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)),     \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_FLOAT64, NULL),   \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_FLOAT64, NULL),   \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)),     \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT8, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT8, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)), \
-          true);                                                               \
-                                                                               \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT16, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT16, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)), \
-          true);                                                               \
-                                                                               \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT32, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT32, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)), \
-          true);                                                               \
-                                                                               \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT64, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT64, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)), \
-          true);                                                               \
-                                                                               \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ISIZE, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ISIZE, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)), \
-          true);                                                               \
-                                                                               \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT8, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT8, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)), \
-          true);                                                               \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT16, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT16, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)),     \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT32, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT32, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)),     \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT64, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT64, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)),     \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT64, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT64, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)),     \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_USIZE, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_USIZE, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL)), \
-          true);
-
-#define BASIC_LOGICAL_BINARY_OPERATOR(op_name)                                 \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BOOL, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BOOL, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BOOL, NULL)), \
-          true);
-
-#define BASIC_COMPARISON_BINARY_OPERATOR(op_name)                              \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BOOL, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BOOL, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BOOL, NULL)), \
-          true);                                                               \
-                                                                               \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BYTE, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BYTE, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BOOL, NULL)), \
-          true);                                                               \
-                                                                               \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CHAR, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CHAR, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BOOL, NULL)), \
-          true);                                                               \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CSHORT, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CSHORT, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BOOL, NULL)),     \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CUSHORT, NULL),   \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CUSHORT, NULL),   \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BOOL, NULL)),     \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CINT, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CINT, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BOOL, NULL)), \
-          true);                                                               \
-                                                                               \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CUINT, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CUINT, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BOOL, NULL)), \
-          true);                                                               \
-                                                                               \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CLONG, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CLONG, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BOOL, NULL)), \
-          true);                                                               \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CULONG, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CULONG, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BOOL, NULL)),     \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CLONGLONG, NULL), \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CLONGLONG, NULL), \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BOOL, NULL)),     \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(                                                                   \
-          LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CULONGLONG, NULL),  \
-        NEW(                                                                   \
-          LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CULONGLONG, NULL),  \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BOOL, NULL)),     \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CFLOAT, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CFLOAT, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BOOL, NULL)),     \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CDOUBLE, NULL),   \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CDOUBLE, NULL),   \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BOOL, NULL)),     \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_FLOAT32, NULL),   \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_FLOAT32, NULL),   \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BOOL, NULL)),     \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_FLOAT64, NULL),   \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_FLOAT64, NULL),   \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BOOL, NULL)),     \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT16, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT16, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BOOL, NULL)), \
-          true);                                                               \
-                                                                               \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT32, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT32, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BOOL, NULL)), \
-          true);                                                               \
-                                                                               \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT64, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT64, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BOOL, NULL)), \
-          true);                                                               \
-                                                                               \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT8, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT8, NULL),  \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BOOL, NULL)), \
-          true);                                                               \
-                                                                               \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ISIZE, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ISIZE, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BOOL, NULL)), \
-          true);                                                               \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT16, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT16, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BOOL, NULL)),     \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT32, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT32, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BOOL, NULL)),     \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] = NEW(                                            \
-      LilyCheckedOperator,                                                     \
-      from__String(op_name),                                                   \
-      init__Vec(                                                               \
-        3,                                                                     \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT64, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT64, NULL),    \
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BOOL, NULL)),     \
-      true);                                                                   \
-                                                                               \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT8, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT8, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BOOL, NULL)), \
-          true);                                                               \
-                                                                               \
-    default_operators[idx++] =                                                 \
-      NEW(LilyCheckedOperator,                                                 \
-          from__String(op_name),                                               \
-          init__Vec(                                                           \
-            3,                                                                 \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_USIZE, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_USIZE, NULL), \
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BOOL, NULL)), \
-          true);
+#define DEFAULT_OPERATOR(op_name, signature_len, ...)           \
+    {                                                           \
+        .name = &STRING_FROM_RAW(op_name),                      \
+        .signature = &VEC_FROM_RAW(signature_len, __VA_ARGS__), \
+        .is_default = true, .ref_count = 0                      \
+    }
 
-LilyCheckedOperator **
-load_default_operators__LilyCheckedOperator()
+#define DEFAULT_UNARY_OPERATOR(op_name, operand_kind, return_kind)   \
+    DEFAULT_OPERATOR(op_name,                                        \
+                     2,                                              \
+                     LILY_CHECKED_PRIMITIVE_DATA_TYPE(operand_kind), \
+                     LILY_CHECKED_PRIMITIVE_DATA_TYPE(return_kind))
+
+#define DEFAULT_BINARY_OPERATOR(op_name, operand_kind, return_kind)  \
+    DEFAULT_OPERATOR(op_name,                                        \
+                     3,                                              \
+                     LILY_CHECKED_PRIMITIVE_DATA_TYPE(operand_kind), \
+                     LILY_CHECKED_PRIMITIVE_DATA_TYPE(operand_kind), \
+                     LILY_CHECKED_PRIMITIVE_DATA_TYPE(return_kind))
+
+#define BASIC_ARITHMETIC_BINARY_OPERATOR(op_name)             \
+    DEFAULT_BINARY_OPERATOR(op_name, BYTE, BYTE),             \
+    DEFAULT_BINARY_OPERATOR(op_name, CSHORT, CSHORT),         \
+    DEFAULT_BINARY_OPERATOR(op_name, CUSHORT, CUSHORT),       \
+    DEFAULT_BINARY_OPERATOR(op_name, CINT, CINT),             \
+    DEFAULT_BINARY_OPERATOR(op_name, CUINT, CUINT),           \
+    DEFAULT_BINARY_OPERATOR(op_name, CLONG, CLONG),           \
+    DEFAULT_BINARY_OPERATOR(op_name, CULONG, CULONG),         \
+    DEFAULT_BINARY_OPERATOR(op_name, CLONGLONG, CLONGLONG),   \
+    DEFAULT_BINARY_OPERATOR(op_name, CULONGLONG, CULONGLONG), \
+    DEFAULT_BINARY_OPERATOR(op_name, CFLOAT, CFLOAT),         \
+    DEFAULT_BINARY_OPERATOR(op_name, CDOUBLE, CDOUBLE),       \
+    DEFAULT_BINARY_OPERATOR(op_name, FLOAT32, FLOAT32),       \
+    DEFAULT_BINARY_OPERATOR(op_name, FLOAT64, FLOAT64),       \
+    DEFAULT_BINARY_OPERATOR(op_name, INT16, INT16),           \
+    DEFAULT_BINARY_OPERATOR(op_name, INT32, INT32),           \
+    DEFAULT_BINARY_OPERATOR(op_name, INT64, INT64),           \
+    DEFAULT_BINARY_OPERATOR(op_name, INT8, INT8),             \
+    DEFAULT_BINARY_OPERATOR(op_name, ISIZE, ISIZE),           \
+    DEFAULT_BINARY_OPERATOR(op_name, UINT16, UINT16),         \
+    DEFAULT_BINARY_OPERATOR(op_name, UINT32, UINT32),         \
+    DEFAULT_BINARY_OPERATOR(op_name, UINT64, UINT64),         \
+    DEFAULT_BINARY_OPERATOR(op_name, UINT8, UINT8),           \
+    DEFAULT_BINARY_OPERATOR(op_name, USIZE, USIZE)
+
+#define BASIC_BITWISE_BINARY_OPERATOR(op_name)                \
+    DEFAULT_BINARY_OPERATOR(op_name, BOOL, BOOL),             \
+    DEFAULT_BINARY_OPERATOR(op_name, BYTE, BYTE),             \
+    DEFAULT_BINARY_OPERATOR(op_name, CSHORT, CSHORT),         \
+    DEFAULT_BINARY_OPERATOR(op_name, CUSHORT, CUSHORT),       \
+    DEFAULT_BINARY_OPERATOR(op_name, CINT, CINT),             \
+    DEFAULT_BINARY_OPERATOR(op_name, CUINT, CUINT),           \
+    DEFAULT_BINARY_OPERATOR(op_name, CLONG, CLONG),           \
+    DEFAULT_BINARY_OPERATOR(op_name, CULONG, CULONG),         \
+    DEFAULT_BINARY_OPERATOR(op_name, CLONGLONG, CLONGLONG),   \
+    DEFAULT_BINARY_OPERATOR(op_name, CULONGLONG, CULONGLONG), \
+    DEFAULT_BINARY_OPERATOR(op_name, CFLOAT, CFLOAT),         \
+    DEFAULT_BINARY_OPERATOR(op_name, CDOUBLE, CDOUBLE),       \
+    DEFAULT_BINARY_OPERATOR(op_name, INT16, INT16),           \
+    DEFAULT_BINARY_OPERATOR(op_name, INT32, INT32),           \
+    DEFAULT_BINARY_OPERATOR(op_name, INT64, INT64),           \
+    DEFAULT_BINARY_OPERATOR(op_name, INT8, INT8),             \
+    DEFAULT_BINARY_OPERATOR(op_name, ISIZE, ISIZE),           \
+    DEFAULT_BINARY_OPERATOR(op_name, UINT16, UINT16),         \
+    DEFAULT_BINARY_OPERATOR(op_name, UINT32, UINT32),         \
+    DEFAULT_BINARY_OPERATOR(op_name, UINT64, UINT64),         \
+    DEFAULT_BINARY_OPERATOR(op_name, UINT8, UINT8),           \
+    DEFAULT_BINARY_OPERATOR(op_name, USIZE, USIZE)
+
+#define BASIC_ASSIGN_BINARY_OPERATOR(op_name)           \
+    DEFAULT_BINARY_OPERATOR(op_name, BOOL, UNIT),       \
+    DEFAULT_BINARY_OPERATOR(op_name, BYTE, UNIT),       \
+    DEFAULT_BINARY_OPERATOR(op_name, CSHORT, UNIT),     \
+    DEFAULT_BINARY_OPERATOR(op_name, CUSHORT, UNIT),    \
+    DEFAULT_BINARY_OPERATOR(op_name, CINT, UNIT),       \
+    DEFAULT_BINARY_OPERATOR(op_name, CUINT, UNIT),      \
+    DEFAULT_BINARY_OPERATOR(op_name, CLONG, UNIT),      \
+    DEFAULT_BINARY_OPERATOR(op_name, CULONG, UNIT),     \
+    DEFAULT_BINARY_OPERATOR(op_name, CLONGLONG, UNIT),  \
+    DEFAULT_BINARY_OPERATOR(op_name, CULONGLONG, UNIT), \
+    DEFAULT_BINARY_OPERATOR(op_name, CFLOAT, UNIT),     \
+    DEFAULT_BINARY_OPERATOR(op_name, CDOUBLE, UNIT),    \
+    DEFAULT_BINARY_OPERATOR(op_name, FLOAT32, UNIT),    \
+    DEFAULT_BINARY_OPERATOR(op_name, FLOAT64, UNIT),    \
+    DEFAULT_BINARY_OPERATOR(op_name, INT16, UNIT),      \
+    DEFAULT_BINARY_OPERATOR(op_name, INT32, UNIT),      \
+    DEFAULT_BINARY_OPERATOR(op_name, INT64, UNIT),      \
+    DEFAULT_BINARY_OPERATOR(op_name, INT8, UNIT),       \
+    DEFAULT_BINARY_OPERATOR(op_name, UINT16, UNIT),     \
+    DEFAULT_BINARY_OPERATOR(op_name, UINT32, UNIT),     \
+    DEFAULT_BINARY_OPERATOR(op_name, UINT64, UNIT),     \
+    DEFAULT_BINARY_OPERATOR(op_name, UINT8, UNIT)
+
+#define BASIC_BITWISE_ASSIGN_BINARY_OPERATOR(op_name)   \
+    DEFAULT_BINARY_OPERATOR(op_name, CSHORT, UNIT),     \
+    DEFAULT_BINARY_OPERATOR(op_name, CUSHORT, UNIT),    \
+    DEFAULT_BINARY_OPERATOR(op_name, CINT, UNIT),       \
+    DEFAULT_BINARY_OPERATOR(op_name, CUINT, UNIT),      \
+    DEFAULT_BINARY_OPERATOR(op_name, CLONG, UNIT),      \
+    DEFAULT_BINARY_OPERATOR(op_name, CULONG, UNIT),     \
+    DEFAULT_BINARY_OPERATOR(op_name, CLONGLONG, UNIT),  \
+    DEFAULT_BINARY_OPERATOR(op_name, CULONGLONG, UNIT), \
+    DEFAULT_BINARY_OPERATOR(op_name, CFLOAT, UNIT),     \
+    DEFAULT_BINARY_OPERATOR(op_name, CDOUBLE, UNIT),    \
+    DEFAULT_BINARY_OPERATOR(op_name, FLOAT32, UNIT),    \
+    DEFAULT_BINARY_OPERATOR(op_name, FLOAT64, UNIT),    \
+    DEFAULT_BINARY_OPERATOR(op_name, INT8, UNIT),       \
+    DEFAULT_BINARY_OPERATOR(op_name, INT16, UNIT),      \
+    DEFAULT_BINARY_OPERATOR(op_name, INT32, UNIT),      \
+    DEFAULT_BINARY_OPERATOR(op_name, INT64, UNIT),      \
+    DEFAULT_BINARY_OPERATOR(op_name, ISIZE, UNIT),      \
+    DEFAULT_BINARY_OPERATOR(op_name, UINT8, UNIT),      \
+    DEFAULT_BINARY_OPERATOR(op_name, UINT16, UNIT),     \
+    DEFAULT_BINARY_OPERATOR(op_name, UINT32, UNIT),     \
+    DEFAULT_BINARY_OPERATOR(op_name, UINT64, UNIT),     \
+    DEFAULT_BINARY_OPERATOR(op_name, UINT64, UNIT),     \
+    DEFAULT_BINARY_OPERATOR(op_name, USIZE, UNIT)
+
+#define BASIC_LOGICAL_BINARY_OPERATOR(op_name)   \
+    DEFAULT_BINARY_OPERATOR(op_name, BOOL, BOOL)
+
+#define BASIC_COMPARISON_BINARY_OPERATOR(op_name)       \
+    DEFAULT_BINARY_OPERATOR(op_name, BOOL, BOOL),       \
+    DEFAULT_BINARY_OPERATOR(op_name, BYTE, BOOL),       \
+    DEFAULT_BINARY_OPERATOR(op_name, CHAR, BOOL),       \
+    DEFAULT_BINARY_OPERATOR(op_name, CSHORT, BOOL),     \
+    DEFAULT_BINARY_OPERATOR(op_name, CUSHORT, BOOL),    \
+    DEFAULT_BINARY_OPERATOR(op_name, CINT, BOOL),       \
+    DEFAULT_BINARY_OPERATOR(op_name, CUINT, BOOL),      \
+    DEFAULT_BINARY_OPERATOR(op_name, CLONG, BOOL),      \
+    DEFAULT_BINARY_OPERATOR(op_name, CULONG, BOOL),     \
+    DEFAULT_BINARY_OPERATOR(op_name, CLONGLONG, BOOL),  \
+    DEFAULT_BINARY_OPERATOR(op_name, CULONGLONG, BOOL), \
+    DEFAULT_BINARY_OPERATOR(op_name, CFLOAT, BOOL),     \
+    DEFAULT_BINARY_OPERATOR(op_name, CDOUBLE, BOOL),    \
+    DEFAULT_BINARY_OPERATOR(op_name, FLOAT32, BOOL),    \
+    DEFAULT_BINARY_OPERATOR(op_name, FLOAT64, BOOL),    \
+    DEFAULT_BINARY_OPERATOR(op_name, INT16, BOOL),      \
+    DEFAULT_BINARY_OPERATOR(op_name, INT32, BOOL),      \
+    DEFAULT_BINARY_OPERATOR(op_name, INT64, BOOL),      \
+    DEFAULT_BINARY_OPERATOR(op_name, INT8, BOOL),       \
+    DEFAULT_BINARY_OPERATOR(op_name, ISIZE, BOOL),      \
+    DEFAULT_BINARY_OPERATOR(op_name, UINT16, BOOL),     \
+    DEFAULT_BINARY_OPERATOR(op_name, UINT32, BOOL),     \
+    DEFAULT_BINARY_OPERATOR(op_name, UINT64, BOOL),     \
+    DEFAULT_BINARY_OPERATOR(op_name, UINT8, BOOL),      \
+    DEFAULT_BINARY_OPERATOR(op_name, USIZE, BOOL)
+
+#define ANY_DATA_TYPE LILY_CHECKED_PRIMITIVE_DATA_TYPE(ANY)
+
+static LilyCheckedDataType ptr_any =
+  LILY_CHECKED_STATIC_DATA_TYPE(PTR, ptr, ANY_DATA_TYPE);
+static LilyCheckedDataType ptr_mut_any =
+  LILY_CHECKED_STATIC_DATA_TYPE(PTR_MUT, ptr_mut, ANY_DATA_TYPE);
+static LilyCheckedDataType ref_any =
+  LILY_CHECKED_STATIC_DATA_TYPE(REF, ref, ANY_DATA_TYPE);
+static LilyCheckedDataType ref_mut_any =
+  LILY_CHECKED_STATIC_DATA_TYPE(REF_MUT, ref_mut, ANY_DATA_TYPE);
+static LilyCheckedDataType trace_any =
+  LILY_CHECKED_STATIC_DATA_TYPE(TRACE, trace, ANY_DATA_TYPE);
+static LilyCheckedDataType trace_mut_any =
+  LILY_CHECKED_STATIC_DATA_TYPE(TRACE_MUT, trace_mut, ANY_DATA_TYPE);
+
+// NOTE: The default operators are built at compile time, so they're shared by
+// all the programs, and they're never counted nor freed.
+static LilyCheckedOperator default_operators[] = {
+    BASIC_ARITHMETIC_BINARY_OPERATOR("+"),
+    BASIC_LOGICAL_BINARY_OPERATOR("and"),
+    BASIC_ASSIGN_BINARY_OPERATOR("+="),
+    BASIC_BITWISE_ASSIGN_BINARY_OPERATOR("&="),
+    BASIC_BITWISE_ASSIGN_BINARY_OPERATOR("<<="),
+    BASIC_BITWISE_ASSIGN_BINARY_OPERATOR("|="),
+    BASIC_BITWISE_ASSIGN_BINARY_OPERATOR(">>="),
+    BASIC_ASSIGN_BINARY_OPERATOR("/="),
+    BASIC_ASSIGN_BINARY_OPERATOR("**="),
+    BASIC_ASSIGN_BINARY_OPERATOR("%="),
+    BASIC_ASSIGN_BINARY_OPERATOR("*="),
+    BASIC_ASSIGN_BINARY_OPERATOR("-="),
+    BASIC_BITWISE_ASSIGN_BINARY_OPERATOR("xor="),
+    BASIC_BITWISE_BINARY_OPERATOR("&"),
+    BASIC_BITWISE_BINARY_OPERATOR("|"),
+    BASIC_ARITHMETIC_BINARY_OPERATOR("/"),
+    BASIC_COMPARISON_BINARY_OPERATOR("=="),
+    BASIC_ARITHMETIC_BINARY_OPERATOR("**"),
+    BASIC_COMPARISON_BINARY_OPERATOR(">="),
+    BASIC_COMPARISON_BINARY_OPERATOR(">"),
+    BASIC_BITWISE_BINARY_OPERATOR("<<"),
+    BASIC_COMPARISON_BINARY_OPERATOR("<="),
+    BASIC_COMPARISON_BINARY_OPERATOR("<"),
+    BASIC_ARITHMETIC_BINARY_OPERATOR("%"),
+    BASIC_ARITHMETIC_BINARY_OPERATOR("*"),
+    BASIC_COMPARISON_BINARY_OPERATOR("not="),
+    BASIC_LOGICAL_BINARY_OPERATOR("or"),
+    BASIC_BITWISE_BINARY_OPERATOR(">>"),
+    BASIC_ARITHMETIC_BINARY_OPERATOR("-"),
+    BASIC_BITWISE_BINARY_OPERATOR("xor"),
+    DEFAULT_OPERATOR(".*", 2, &ptr_any, ANY_DATA_TYPE),
+    DEFAULT_OPERATOR(".*", 2, &ref_any, ANY_DATA_TYPE),
+    DEFAULT_UNARY_OPERATOR("-", INT16, INT16),
+    DEFAULT_UNARY_OPERATOR("-", INT32, INT32),
+    DEFAULT_UNARY_OPERATOR("-", INT64, INT64),
+    DEFAULT_UNARY_OPERATOR("-", INT8, INT8),
+    DEFAULT_UNARY_OPERATOR("-", ISIZE, ISIZE),
+    DEFAULT_UNARY_OPERATOR("-", FLOAT32, FLOAT32),
+    DEFAULT_UNARY_OPERATOR("-", FLOAT64, FLOAT64),
+    DEFAULT_UNARY_OPERATOR("not", BOOL, BOOL),
+    DEFAULT_OPERATOR("ref", 2, ANY_DATA_TYPE, &ptr_any),
+    DEFAULT_OPERATOR("ref", 2, ANY_DATA_TYPE, &ref_any),
+    DEFAULT_OPERATOR("ref mut", 2, ANY_DATA_TYPE, &ptr_mut_any),
+    DEFAULT_OPERATOR("ref mut", 2, ANY_DATA_TYPE, &ref_mut_any),
+    DEFAULT_OPERATOR("trace", 2, ANY_DATA_TYPE, &trace_any),
+    DEFAULT_OPERATOR("trace mut", 2, ANY_DATA_TYPE, &trace_mut_any)
+};
+
+static_assert(sizeof(default_operators) / sizeof(*default_operators) ==
+                DEFAULT_OPERATORS_COUNT,
+              "DEFAULT_OPERATORS_COUNT is out of date");
+
+// NOTE: The default operators are indexed by name the first time they're looked
+// up (by any thread), and the index is kept until the end of the process.
+static HashMap *default_operators_index =
+  NULL; // HashMap<Vec<LilyCheckedOperator* (&)>*>*
+static pthread_once_t default_operators_index_once = PTHREAD_ONCE_INIT;
+
+void
+index_default_operators__LilyCheckedOperator()
 {
-    LilyCheckedOperator **default_operators =
-      lily_malloc(sizeof(PTR_SIZE) * DEFAULT_OPERATORS_COUNT);
-    Usize idx = 0;
-
-    BASIC_ARITHMETIC_BINARY_OPERATOR("+");
-    BASIC_LOGICAL_BINARY_OPERATOR("and");
-    BASIC_ASSIGN_BINARY_OPERATOR("+=");
-    BASIC_BITWISE_ASSIGN_BINARY_OPERATOR("&=");
-    BASIC_BITWISE_ASSIGN_BINARY_OPERATOR("<<=");
-    BASIC_BITWISE_ASSIGN_BINARY_OPERATOR("|=");
-    BASIC_BITWISE_ASSIGN_BINARY_OPERATOR(">>=");
-    BASIC_ASSIGN_BINARY_OPERATOR("/=");
-    BASIC_ASSIGN_BINARY_OPERATOR("**=");
-    BASIC_ASSIGN_BINARY_OPERATOR("%=");
-    BASIC_ASSIGN_BINARY_OPERATOR("*=");
-    BASIC_ASSIGN_BINARY_OPERATOR("-=");
-    BASIC_BITWISE_ASSIGN_BINARY_OPERATOR("xor=");
-    BASIC_BITWISE_BINARY_OPERATOR("&");
-    BASIC_BITWISE_BINARY_OPERATOR("|");
-    BASIC_ARITHMETIC_BINARY_OPERATOR("/");
-    BASIC_COMPARISON_BINARY_OPERATOR("==");
-    BASIC_ARITHMETIC_BINARY_OPERATOR("**");
-    BASIC_COMPARISON_BINARY_OPERATOR(">=");
-    BASIC_COMPARISON_BINARY_OPERATOR(">");
-    BASIC_BITWISE_BINARY_OPERATOR("<<");
-    BASIC_COMPARISON_BINARY_OPERATOR("<=");
-    BASIC_COMPARISON_BINARY_OPERATOR("<");
-    BASIC_ARITHMETIC_BINARY_OPERATOR("%");
-    BASIC_ARITHMETIC_BINARY_OPERATOR("*");
-    BASIC_COMPARISON_BINARY_OPERATOR("not=");
-    BASIC_LOGICAL_BINARY_OPERATOR("or");
-    BASIC_BITWISE_BINARY_OPERATOR(">>");
-    BASIC_ARITHMETIC_BINARY_OPERATOR("-");
-    BASIC_BITWISE_BINARY_OPERATOR("xor");
-
-    default_operators[idx++] =
-      NEW(LilyCheckedOperator,
-          from__String(".*"),
-          init__Vec(
-            2,
-            NEW_VARIANT(
-              LilyCheckedDataType,
-              ptr,
-              NULL,
-              NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ANY, NULL)),
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ANY, NULL)),
-          true);
-
-    default_operators[idx++] =
-      NEW(LilyCheckedOperator,
-          from__String(".*"),
-          init__Vec(
-            2,
-            NEW_VARIANT(
-              LilyCheckedDataType,
-              ref,
-              NULL,
-              NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ANY, NULL)),
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ANY, NULL)),
-          true);
-
-    default_operators[idx++] =
-      NEW(LilyCheckedOperator,
-          from__String("-"),
-          init__Vec(
-            2,
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT16, NULL),
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT16, NULL)),
-          true);
-
-    default_operators[idx++] =
-      NEW(LilyCheckedOperator,
-          from__String("-"),
-          init__Vec(
-            2,
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT32, NULL),
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT32, NULL)),
-          true);
+    default_operators_index = NEW(HashMap);
 
-    default_operators[idx++] =
-      NEW(LilyCheckedOperator,
-          from__String("-"),
-          init__Vec(
-            2,
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT64, NULL),
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT64, NULL)),
-          true);
+    for (Usize i = 0; i < DEFAULT_OPERATORS_COUNT; ++i) {
+        LilyCheckedOperator *operator= &default_operators[i];
+        Vec *operators =
+          get__HashMap(default_operators_index, operator->name->buffer);
 
-    default_operators[idx++] =
-      NEW(LilyCheckedOperator,
-          from__String("-"),
-          init__Vec(
-            2,
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT8, NULL),
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT8, NULL)),
-          true);
+        if (!operators) {
+            operators = NEW(Vec);
 
-    default_operators[idx++] =
-      NEW(LilyCheckedOperator,
-          from__String("-"),
-          init__Vec(
-            2,
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ISIZE, NULL),
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ISIZE, NULL)),
-          true);
+            insert__HashMap(
+              default_operators_index, operator->name->buffer, operators);
+        }
 
-    default_operators[idx++] = NEW(
-      LilyCheckedOperator,
-      from__String("-"),
-      init__Vec(
-        2,
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_FLOAT32, NULL),
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_FLOAT32, NULL)),
-      true);
-
-    default_operators[idx++] = NEW(
-      LilyCheckedOperator,
-      from__String("-"),
-      init__Vec(
-        2,
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_FLOAT64, NULL),
-        NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_FLOAT64, NULL)),
-      true);
-
-    default_operators[idx++] =
-      NEW(LilyCheckedOperator,
-          from__String("not"),
-          init__Vec(
-            2,
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BOOL, NULL),
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_BOOL, NULL)),
-          true);
-
-    default_operators[idx++] =
-      NEW(LilyCheckedOperator,
-          from__String("ref"),
-          init__Vec(
-            2,
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ANY, NULL),
-            NEW_VARIANT(
-              LilyCheckedDataType,
-              ptr,
-              NULL,
-              NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ANY, NULL))),
-          true);
-
-    default_operators[idx++] =
-      NEW(LilyCheckedOperator,
-          from__String("ref"),
-          init__Vec(
-            2,
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ANY, NULL),
-            NEW_VARIANT(
-              LilyCheckedDataType,
-              ref,
-              NULL,
-              NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ANY, NULL))),
-          true);
-
-    default_operators[idx++] =
-      NEW(LilyCheckedOperator,
-          from__String("ref mut"),
-          init__Vec(
-            2,
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ANY, NULL),
-            NEW_VARIANT(
-              LilyCheckedDataType,
-              ptr_mut,
-              NULL,
-              NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ANY, NULL))),
-          true);
-
-    default_operators[idx++] =
-      NEW(LilyCheckedOperator,
-          from__String("ref mut"),
-          init__Vec(
-            2,
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ANY, NULL),
-            NEW_VARIANT(
-              LilyCheckedDataType,
-              ref_mut,
-              NULL,
-              NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ANY, NULL))),
-          true);
-
-    default_operators[idx++] =
-      NEW(LilyCheckedOperator,
-          from__String("trace"),
-          init__Vec(
-            2,
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ANY, NULL),
-            NEW_VARIANT(
-              LilyCheckedDataType,
-              trace,
-              NULL,
-              NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ANY, NULL))),
-          true);
+        push__Vec(operators, operator);
+    }
+}
 
-    default_operators[idx++] =
-      NEW(LilyCheckedOperator,
-          from__String("trace mut"),
-          init__Vec(
-            2,
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ANY, NULL),
-            NEW_VARIANT(
-              LilyCheckedDataType,
-              trace_mut,
-              NULL,
-              NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ANY, NULL))),
-          true);
+const Vec *
+get_default_operators__LilyCheckedOperator(char *name)
+{
+    pthread_once(&default_operators_index_once,
+                 &index_default_operators__LilyCheckedOperator);
 
-    return default_operators;
+    return get__HashMap(default_operators_index, name);
 }
 
 #ifdef ENV_DEBUG
@@ -1491,17 +358,18 @@ IMPL_FOR_DEBUG(to_string, LilyCheckedOperator, const LilyCheckedOperator *self)
 
 DESTRUCTOR(LilyCheckedOperator, LilyCheckedOperator *self)
 {
-    if (self->ref_count > 0) {
-        --self->ref_count;
-
+    // NOTE: The default operators are built at compile time.
+    if (self->is_default) {
         return;
     }
 
-    if (self->is_default) {
-        FREE(String, self->name);
-        FREE_BUFFER_ITEMS(
-          self->signature->buffer, self->signature->len, LilyCheckedDataType);
-        FREE(Vec, self->signature);
+    Usize ref_count = atomic_load(&self->ref_count);
+
+    while (ref_count > 0) {
+        if (atomic_compare_exchange_weak(
+              &self->ref_count, &ref_count, ref_count - 1)) {
+            return;
+        }
     }
 
     lily_free(self);
@@ -31,6 +31,55 @@
 #include <stdlib.h>
 #include <string.h>
 
+/**
+ *
+ * @brief Get the entry of the operators with the given name.
+ * @return LilyCheckedOperatorRegisterEntry* (&)?
+ */
+static inline LilyCheckedOperatorRegisterEntry *
+get_entry__LilyCheckedOperatorRegister(const LilyCheckedOperatorRegister *self,
+                                       char *name);
+
+/**
+ *
+ * @brief Insert the entry of the operators with the given name (seeded with the
+ * default operators with this name).
+ * @return LilyCheckedOperatorRegisterEntry* (&)
+ */
+static LilyCheckedOperatorRegisterEntry *
+insert_entry__LilyCheckedOperatorRegister(LilyCheckedOperatorRegister *self,
+                                          char *name);
+
+/**
+ *
+ * @brief Get all the operators with the given name.
+ * @return const Vec*? (&) // const Vec<LilyCheckedOperator* (&)>*?
+ */
+static const Vec *
+get_operators__LilyCheckedOperatorRegister(
+  const LilyCheckedOperatorRegister *self,
+  char *name);
+
+/**
+ *
+ * @brief Search operator in the register.
+ * @note The lock of the register must be held.
+ */
+static LilyCheckedOperator *
+find_operator__LilyCheckedOperatorRegister(
+  const LilyCheckedOperatorRegister *self,
+  char *name,
+  Vec *signature);
+
+/**
+ *
+ * @brief Push the operator to the register, and index it.
+ * @note The lock of the register must be held.
+ */
+static void
+push_operator__LilyCheckedOperatorRegister(LilyCheckedOperatorRegister *self,
+                                           LilyCheckedOperator *operator);
+
 static void
 binary_update_data_type_according_operator_collection__LilyCheckedOperatorRegister(
   Vec *operators,
@@ -45,52 +94,187 @@ binary_update_return_data_type_according_operator_collection__LilyCheckedOperato
   LilyCheckedDataType *right,
   LilyCheckedDataType **return_data_type);
 
+CONSTRUCTOR(LilyCheckedOperatorResolution *,
+            LilyCheckedOperatorResolution,
+            const LilyCheckedDataType *left,
+            const LilyCheckedDataType *right,
+            Vec *operators)
+{
+    LilyCheckedOperatorResolution *self =
+      lily_malloc(sizeof(LilyCheckedOperatorResolution));
+
+    self->left = left;
+    self->right = right;
+    self->operators = operators;
+
+    return self;
+}
+
+DESTRUCTOR(LilyCheckedOperatorResolution, LilyCheckedOperatorResolution *self)
+{
+    FREE(Vec, self->operators);
+    lily_free(self);
+}
+
+CONSTRUCTOR(LilyCheckedOperatorRegisterEntry *,
+            LilyCheckedOperatorRegisterEntry,
+            const Vec *default_operators)
+{
+    LilyCheckedOperatorRegisterEntry *self =
+      lily_malloc(sizeof(LilyCheckedOperatorRegisterEntry));
+
+    self->operators = NEW(Vec);
+    self->resolutions = NEW(Vec);
+
+    if (default_operators) {
+        append__Vec(self->operators, default_operators);
+    }
+
+    return self;
+}
+
+DESTRUCTOR(LilyCheckedOperatorRegisterEntry,
+           LilyCheckedOperatorRegisterEntry *self)
+{
+    FREE(Vec, self->operators);
+    FREE_BUFFER_ITEMS(self->resolutions->buffer,
+                      self->resolutions->len,
+                      LilyCheckedOperatorResolution);
+    FREE(Vec, self->resolutions);
+    lily_free(self);
+}
+
+LilyCheckedOperatorRegisterEntry *
+get_entry__LilyCheckedOperatorRegister(const LilyCheckedOperatorRegister *self,
+                                       char *name)
+{
+    return get__HashMap(self->index, name);
+}
+
+LilyCheckedOperatorRegisterEntry *
+insert_entry__LilyCheckedOperatorRegister(LilyCheckedOperatorRegister *self,
+                                          char *name)
+{
+    const Vec *default_operators = get_default_operators__LilyCheckedOperator(
+      name); // const Vec<LilyCheckedOperator* (&)>*?
+    LilyCheckedOperatorRegisterEntry *entry =
+      NEW(LilyCheckedOperatorRegisterEntry, default_operators);
+
+    // NOTE: The name of the default operators is never freed, so it's used as
+    // key when it's possible.
+    if (default_operators) {
+        LilyCheckedOperator *default_operator = get__Vec(default_operators, 0);
+
+        name = default_operator->name->buffer;
+    }
+
+    insert__HashMap(self->index, name, entry);
+
+    return entry;
+}
+
+const Vec *
+get_operators__LilyCheckedOperatorRegister(
+  const LilyCheckedOperatorRegister *self,
+  char *name)
+{
+    LilyCheckedOperatorRegisterEntry *entry =
+      get_entry__LilyCheckedOperatorRegister(self, name);
+
+    return entry ? entry->operators
+                 : get_default_operators__LilyCheckedOperator(name);
+}
+
+void
+push_operator__LilyCheckedOperatorRegister(LilyCheckedOperatorRegister *self,
+                                           LilyCheckedOperator *operator)
+{
+    LilyCheckedOperatorRegisterEntry *entry =
+      get_entry__LilyCheckedOperatorRegister(self, operator->name->buffer);
+
+    if (!entry) {
+        entry = insert_entry__LilyCheckedOperatorRegister(
+          self, operator->name->buffer);
+    } else if (entry->resolutions->len > 0) {
+        // The cached resolutions of this name are out of date.
+        FREE_BUFFER_ITEMS(entry->resolutions->buffer,
+                          entry->resolutions->len,
+                          LilyCheckedOperatorResolution);
+        entry->resolutions->len = 0;
+    }
+
+    push__Vec(self->operators, operator);
+    push__Vec(entry->operators, operator);
+}
+
 int
 add_operator__LilyCheckedOperatorRegister(LilyCheckedOperatorRegister *self,
                                           LilyCheckedOperator *operator)
 {
+    pthread_mutex_lock(&self->mutex);
+
     // Look for duplicate operator
     LilyCheckedOperator *duplicate_op =
-      search_operator__LilyCheckedOperatorRegister(
+      find_operator__LilyCheckedOperatorRegister(
         self, operator->name->buffer, operator->signature);
 
-    if (duplicate_op) {
-        return 1;
+    if (!duplicate_op) {
+        push_operator__LilyCheckedOperatorRegister(self, operator);
     }
 
-    push__Vec(self->operators, operator);
+    pthread_mutex_unlock(&self->mutex);
 
-    return 0;
+    return duplicate_op ? 1 : 0;
 }
 
 LilyCheckedOperator *
-search_operator__LilyCheckedOperatorRegister(
+search_operator__LilyCheckedOperatorRegister(LilyCheckedOperatorRegister *self,
+                                             char *name,
+                                             Vec *signature)
+{
+    pthread_mutex_lock(&self->mutex);
+
+    LilyCheckedOperator *operator=
+      find_operator__LilyCheckedOperatorRegister(self, name, signature);
+
+    pthread_mutex_unlock(&self->mutex);
+
+    return operator;
+}
+
+LilyCheckedOperator *
+find_operator__LilyCheckedOperatorRegister(
   const LilyCheckedOperatorRegister *self,
   char *name,
   Vec *signature)
 {
-    for (Usize i = 0; i < self->operators->len; ++i) {
-        LilyCheckedOperator *operator= get__Vec(self->operators, i);
+    const Vec *operators = get_operators__LilyCheckedOperatorRegister(
+      self, name); // const Vec<LilyCheckedOperator* (&)>*?
 
-        if (!strcmp(name, operator->name->buffer)) {
-            if (signature->len != operator->signature->len) {
-                continue;
-            }
+    if (!operators) {
+        return NULL;
+    }
+
+    for (Usize i = 0; i < operators->len; ++i) {
+        LilyCheckedOperator *operator= get__Vec(operators, i);
 
-            bool is_match = true;
+        if (signature->len != operator->signature->len) {
+            continue;
+        }
 
-            for (Usize j = 0; j < operator->signature->len; ++j) {
-                if (!eq__LilyCheckedDataType(get__Vec(operator->signature, j),
-                                             get__Vec(signature, j))) {
-                    is_match = false;
-                    break;
-                }
-            }
+        bool is_match = true;
 
-            if (is_match) {
-                return operator;
+        for (Usize j = 0; j < operator->signature->len; ++j) {
+            if (!eq__LilyCheckedDataType(get__Vec(operator->signature, j),
+                                         get__Vec(signature, j))) {
+                is_match = false;
+                break;
             }
         }
+
+        if (is_match) {
+            return operator;
+        }
     }
 
     return NULL;
@@ -98,21 +282,104 @@ search_operator__LilyCheckedOperatorRegister(
 
 Vec *
 collect_all_operators__LilyCheckedOperatorRegister(
-  const LilyCheckedOperatorRegister *self,
+  LilyCheckedOperatorRegister *self,
   char *name,
   Usize signature_len)
 {
     Vec *operators = NEW(Vec); // Vec<LilyCheckedOperator* (&)>*
 
-    for (Usize i = 0; i < self->operators->len; ++i) {
-        LilyCheckedOperator *operator= get__Vec(self->operators, i);
+    pthread_mutex_lock(&self->mutex);
+
+    const Vec *named_operators = get_operators__LilyCheckedOperatorRegister(
+      self, name); // const Vec<LilyCheckedOperator* (&)>*?
 
-        if (!strcmp(name, operator->name->buffer) &&
-            signature_len == operator->signature->len) {
-            push__Vec(operators, operator);
+    if (named_operators) {
+        for (Usize i = 0; i < named_operators->len; ++i) {
+            LilyCheckedOperator *operator= get__Vec(named_operators, i);
+
+            if (signature_len == operator->signature->len) {
+                push__Vec(operators, operator);
+            }
         }
     }
 
+    pthread_mutex_unlock(&self->mutex);
+
+    return operators;
+}
+
+Vec *
+collect_binary_operators__LilyCheckedOperatorRegister(
+  LilyCheckedOperatorRegister *self,
+  char *name,
+  LilyCheckedDataType *left,
+  LilyCheckedDataType *right)
+{
+    // NOTE: The interned data types are immutable, so the operators matched
+    // by their nodes are always the same (until an operator with the same
+    // name is added).
+    if (!left->interned || !right->interned) {
+        return collect_all_operators__LilyCheckedOperatorRegister(
+          self, name, 3);
+    }
+
+    pthread_mutex_lock(&self->mutex);
+
+    LilyCheckedOperatorRegisterEntry *entry =
+      get_entry__LilyCheckedOperatorRegister(self, name);
+
+    if (!entry) {
+        if (!get_default_operators__LilyCheckedOperator(name)) {
+            pthread_mutex_unlock(&self->mutex);
+
+            return NEW(Vec);
+        }
+
+        // NOTE: The entry is created to cache the resolutions of the default
+        // operators.
+        entry = insert_entry__LilyCheckedOperatorRegister(self, name);
+    }
+
+    for (Usize i = 0; i < entry->resolutions->len; ++i) {
+        LilyCheckedOperatorResolution *resolution =
+          get__Vec(entry->resolutions, i);
+
+        if (resolution->left == left->interned &&
+            resolution->right == right->interned) {
+            Vec *operators = NEW(Vec); // Vec<LilyCheckedOperator* (&)>*
+
+            append__Vec(operators, resolution->operators);
+
+            pthread_mutex_unlock(&self->mutex);
+
+            return operators;
+        }
+    }
+
+    Vec *resolved_operators = NEW(Vec); // Vec<LilyCheckedOperator* (&)>*
+
+    for (Usize i = 0; i < entry->operators->len; ++i) {
+        LilyCheckedOperator *operator= get__Vec(entry->operators, i);
+
+        if (operator->signature->len == 3 &&
+            eq__LilyCheckedDataType(get__Vec(operator->signature, 0), left) &&
+            eq__LilyCheckedDataType(get__Vec(operator->signature, 1), right)) {
+            push__Vec(resolved_operators, operator);
+        }
+    }
+
+    push__Vec(entry->resolutions,
+              NEW(LilyCheckedOperatorResolution,
+                  left->interned,
+                  right->interned,
+                  resolved_operators));
+
+    Vec *operators = NEW(Vec); // Vec<LilyCheckedOperator* (&)>*
+
+    append__Vec(operators, resolved_operators);
+
+    pthread_mutex_unlock(&self->mutex);
+
     return operators;
 }
 
@@ -376,9 +643,12 @@ typecheck_binary__LilyCheckedOperatorRegister(
       operators, expr_location, left, right, defined_data_type);
 }
 
-DESTRUCTOR(LilyCheckedOperatorRegister, const LilyCheckedOperatorRegister *self)
+DESTRUCTOR(LilyCheckedOperatorRegister, LilyCheckedOperatorRegister *self)
 {
+    FREE_HASHMAP_VALUES(self->index, LilyCheckedOperatorRegisterEntry);
+    FREE(HashMap, self->index);
     FREE_BUFFER_ITEMS(
       self->operators->buffer, self->operators->len, LilyCheckedOperator);
     FREE(Vec, self->operators);
+    pthread_mutex_destroy(&self->mutex);
 }
@@ -96,45 +96,92 @@ static LilyCheckedScopeResponse
 search_trait_in_current_scope__LilyCheckedScope(LilyCheckedScope *self,
                                                 const String *name);
 
-#define HASH_MAP_CHECK_IF_EXISTS(container, item)          \
-    if (container) {                                       \
-        if (get__HashMap(container, item->name->buffer)) { \
-            return 1;                                      \
-        }                                                  \
-    }
-
-#define VEC_CHECK_IF_EXISTS(container, item, container_name)           \
-    if (container) {                                                   \
-        for (Usize i = 0; i < container->len; ++i) {                   \
-            if (!strcmp(CAST(container_name *, get__Vec(container, i)) \
-                          ->name->buffer,                              \
-                        item->name->buffer)) {                         \
-                return 1;                                              \
-            }                                                          \
-        }                                                              \
-    }
-
-#define HASH_MAP_ADD_TO_SCOPE(container, item)            \
-    HASH_MAP_CHECK_IF_EXISTS(container, item);            \
-                                                          \
-    if (!container) {                                     \
-        container = NEW(HashMap);                         \
-    }                                                     \
-                                                          \
-    insert__HashMap(container, item->name->buffer, item); \
-                                                          \
-    return 0;
+/**
+ *
+ * @brief Add the container to the symbol of its name.
+ * @param conflicts The kinds of symbol which can't share the name of the
+ * container (the kind of the container is always in conflict with itself).
+ * @return Return the status 0 for success otherwise 1 for failure.
+ */
+static int
+add_symbol__LilyCheckedScope(LilyCheckedScope *self,
+                             enum LilyCheckedScopeSymbolKind kind,
+                             Uint32 conflicts,
+                             String *name,
+                             void *container);
+
+/**
+ *
+ * @brief Get the container of the given kind from the symbol of the name.
+ * @return void*? (&)
+ */
+static void *
+get_symbol__LilyCheckedScope(const LilyCheckedScope *self,
+                             const String *name,
+                             enum LilyCheckedScopeSymbolKind kind);
 
-#define VEC_ADD_TO_SCOPE(container, item, container_name) \
-    VEC_CHECK_IF_EXISTS(container, item, container_name); \
-                                                          \
-    if (!container) {                                     \
-        container = NEW(Vec);                             \
-    }                                                     \
-                                                          \
-    push__Vec(container, item);                           \
-                                                          \
-    return 0;
+/**
+ *
+ * @brief Search an identifier (or the catch name) only in the current scope.
+ */
+static LilyCheckedScopeResponse
+search_identifier_in_current_scope__LilyCheckedScope(LilyCheckedScope *self,
+                                                     const String *name);
+
+#define SYMBOL_KIND_BIT(k) LILY_CHECKED_SCOPE_SYMBOL_KIND_BIT(k)
+
+#define CUSTOM_TYPE_SYMBOL_KINDS                                \
+    (SYMBOL_KIND_BIT(ALIAS) | SYMBOL_KIND_BIT(CLASS) |          \
+     SYMBOL_KIND_BIT(ENUM) | SYMBOL_KIND_BIT(ENUM_OBJECT) |     \
+     SYMBOL_KIND_BIT(RECORD) | SYMBOL_KIND_BIT(RECORD_OBJECT) | \
+     SYMBOL_KIND_BIT(TRAIT))
+
+// NOTE: The kinds of symbol which can be found by
+// `search_identifier_in_current_scope__LilyCheckedScope`.
+#define IDENTIFIER_SYMBOL_KINDS                                              \
+    (SYMBOL_KIND_BIT(CAPTURED_VARIABLE) | SYMBOL_KIND_BIT(CONSTANT) |        \
+     SYMBOL_KIND_BIT(ENUM) | SYMBOL_KIND_BIT(ERROR) | SYMBOL_KIND_BIT(FUN) | \
+     SYMBOL_KIND_BIT(MODULE) | SYMBOL_KIND_BIT(PARAM) |                      \
+     SYMBOL_KIND_BIT(VARIABLE))
+
+#define ADD_SYMBOL_TO_SCOPE(k, conflicts, item)                               \
+    return add_symbol__LilyCheckedScope(                                      \
+      self, LILY_CHECKED_SCOPE_SYMBOL_KIND_##k, conflicts, item->name, item);
+
+#define GET_SYMBOL_FROM_SCOPE(scope, name, k) \
+    get_symbol__LilyCheckedScope(             \
+      scope, name, LILY_CHECKED_SCOPE_SYMBOL_KIND_##k)
+
+// NOTE: The order of the searches gives the priority of an identifier when
+// several declarations of the same scope share its name.
+static LilyCheckedScopeResponse (*const identifier_searches[])(
+  LilyCheckedScope *,
+  const String *) = {
+    &search_variable_in_current_scope__LilyCheckedScope,
+    &search_param_in_current_scope__LilyCheckedScope,
+    &search_fun_in_current_scope__LilyCheckedScope,
+    &search_module_in_current_scope__LilyCheckedScope,
+    &search_constant_in_current_scope__LilyCheckedScope,
+    &search_field__LilyCheckedScope,
+    &search_variant__LilyCheckedScope,
+    &search_enum_in_current_scope__LilyCheckedScope,
+    &search_error_in_current_scope__LilyCheckedScope,
+    &search_captured_variable_in_current_scope__LilyCheckedScope
+};
+
+// NOTE: Same as `identifier_searches` but for a custom type.
+static LilyCheckedScopeResponse (*const custom_type_searches[])(
+  LilyCheckedScope *,
+  const String *) = {
+    &search_record_in_current_scope__LilyCheckedScope,
+    &search_enum_in_current_scope__LilyCheckedScope,
+    &search_generic_in_current_scope__LilyCheckedScope,
+    &search_class_in_current_scope__LilyCheckedScope,
+    &search_record_object_in_current_scope__LilyCheckedScope,
+    &search_enum_object_in_current_scope__LilyCheckedScope,
+    &search_trait_in_current_scope__LilyCheckedScope,
+    &search_alias_in_current_scope__LilyCheckedScope
+};
 
 CONSTRUCTOR(LilyCheckedScopeCatch *,
             LilyCheckedScopeCatch,
@@ -170,6 +217,142 @@ IMPL_FOR_DEBUG(to_string,
 }
 #endif
 
+CONSTRUCTOR(LilyCheckedScopeSymbol *, LilyCheckedScopeSymbol, String *name)
+{
+    LilyCheckedScopeSymbol *self = lily_malloc(sizeof(LilyCheckedScopeSymbol));
+
+    self->name = name;
+    self->kinds = 0;
+
+    for (Usize i = 0; i < LILY_CHECKED_SCOPE_SYMBOL_KIND_COUNT; ++i) {
+        self->containers[i] = NULL;
+    }
+
+    return self;
+}
+
+#ifdef ENV_DEBUG
+String *
+IMPL_FOR_DEBUG(to_string,
+               LilyCheckedScopeSymbol,
+               const LilyCheckedScopeSymbol *self)
+{
+#define DEBUG_CONTAINER(k, type)                                 \
+    case LILY_CHECKED_SCOPE_SYMBOL_KIND_##k: {                   \
+        char *s = to_string__Debug__##type(self->containers[i]); \
+                                                                 \
+        PUSH_STR_AND_FREE(res, s);                               \
+                                                                 \
+        break;                                                   \
+    }
+
+    String *res = format__String(
+      "LilyCheckedScopeSymbol{{ name = {S}, containers = {{", self->name);
+
+    for (Usize i = 0; i < LILY_CHECKED_SCOPE_SYMBOL_KIND_COUNT; ++i) {
+        if (!self->containers[i]) {
+            continue;
+        }
+
+        push_str__String(res, " ");
+
+        switch (i) {
+            DEBUG_CONTAINER(ALIAS, LilyCheckedScopeContainerAlias);
+            DEBUG_CONTAINER(CAPTURED_VARIABLE,
+                            LilyCheckedScopeContainerCapturedVariable);
+            DEBUG_CONTAINER(CLASS, LilyCheckedScopeContainerClass);
+            DEBUG_CONTAINER(CONSTANT, LilyCheckedScopeContainerConstant);
+            DEBUG_CONTAINER(ENUM, LilyCheckedScopeContainerEnum);
+            DEBUG_CONTAINER(ENUM_OBJECT, LilyCheckedScopeContainerEnumObject);
+            DEBUG_CONTAINER(ERROR, LilyCheckedScopeContainerError);
+            case LILY_CHECKED_SCOPE_SYMBOL_KIND_FUN: {
+                String *s = to_string__Debug__LilyCheckedScopeContainerFun(
+                  self->containers[i]);
+
+                APPEND_AND_FREE(res, s);
+
+                break;
+            }
+            DEBUG_CONTAINER(GENERIC, LilyCheckedScopeContainerGeneric);
+            DEBUG_CONTAINER(LABEL, LilyCheckedScopeContainerLabel);
+            DEBUG_CONTAINER(MODULE, LilyCheckedScopeContainerModule);
+            DEBUG_CONTAINER(PARAM, LilyCheckedScopeContainerVariable);
+            DEBUG_CONTAINER(RECORD, LilyCheckedScopeContainerRecord);
+            DEBUG_CONTAINER(RECORD_OBJECT,
+                            LilyCheckedScopeContainerRecordObject);
+            DEBUG_CONTAINER(TRAIT, LilyCheckedScopeContainerTrait);
+            DEBUG_CONTAINER(VARIABLE, LilyCheckedScopeContainerVariable);
+            default:
+                UNREACHABLE("unknown variant");
+        }
+    }
+
+    push_str__String(res, " } }");
+
+    return res;
+
+#undef DEBUG_CONTAINER
+}
+#endif
+
+DESTRUCTOR(LilyCheckedScopeSymbol, LilyCheckedScopeSymbol *self)
+{
+#define FREE_CONTAINER(k, type)              \
+    case LILY_CHECKED_SCOPE_SYMBOL_KIND_##k: \
+        FREE(type, self->containers[i]);     \
+                                             \
+        break;
+
+    for (Usize i = 0; i < LILY_CHECKED_SCOPE_SYMBOL_KIND_COUNT; ++i) {
+        if (!self->containers[i]) {
+            continue;
+        }
+
+        switch (i) {
+            FREE_CONTAINER(ALIAS, LilyCheckedScopeContainerAlias);
+            FREE_CONTAINER(CAPTURED_VARIABLE,
+                           LilyCheckedScopeContainerCapturedVariable);
+            FREE_CONTAINER(CLASS, LilyCheckedScopeContainerClass);
+            FREE_CONTAINER(CONSTANT, LilyCheckedScopeContainerConstant);
+            FREE_CONTAINER(ENUM, LilyCheckedScopeContainerEnum);
+            FREE_CONTAINER(ENUM_OBJECT, LilyCheckedScopeContainerEnumObject);
+            FREE_CONTAINER(ERROR, LilyCheckedScopeContainerError);
+            FREE_CONTAINER(FUN, LilyCheckedScopeContainerFun);
+            FREE_CONTAINER(GENERIC, LilyCheckedScopeContainerGeneric);
+            FREE_CONTAINER(LABEL, LilyCheckedScopeContainerLabel);
+            FREE_CONTAINER(MODULE, LilyCheckedScopeContainerModule);
+            FREE_CONTAINER(PARAM, LilyCheckedScopeContainerVariable);
+            FREE_CONTAINER(RECORD, LilyCheckedScopeContainerRecord);
+            FREE_CONTAINER(RECORD_OBJECT,
+                           LilyCheckedScopeContainerRecordObject);
+            FREE_CONTAINER(TRAIT, LilyCheckedScopeContainerTrait);
+            FREE_CONTAINER(VARIABLE, LilyCheckedScopeContainerVariable);
+            default:
+                UNREACHABLE("unknown variant");
+        }
+    }
+
+    lily_free(self);
+
+#undef FREE_CONTAINER
+}
+
+CONSTRUCTOR(LilyCheckedScopeResolution *,
+            LilyCheckedScopeResolution,
+            const String *name,
+            LilyCheckedScope *scope,
+            Usize version)
+{
+    LilyCheckedScopeResolution *self =
+      lily_malloc(sizeof(LilyCheckedScopeResolution));
+
+    self->name = from__String(name->buffer);
+    self->scope = scope;
+    self->version = version;
+
+    return self;
+}
+
 CONSTRUCTOR(LilyCheckedScope *,
             LilyCheckedScope,
             LilyCheckedParent *parent,
@@ -181,23 +364,15 @@ CONSTRUCTOR(LilyCheckedScope *,
     // TODO: add support for lambda
     self->raises = NULL;
     self->catch = NULL;
-    self->captured_variables = NULL;
-    self->modules = NULL;
-    self->constants = NULL;
-    self->enums = NULL;
-    self->records = NULL;
-    self->aliases = NULL;
-    self->errors = NULL;
-    self->enums_object = NULL;
-    self->records_object = NULL;
-    self->classes = NULL;
-    self->traits = NULL;
-    self->funs = NULL;
-    self->labels = NULL;
-    self->variables = NULL;
-    self->params = NULL;
-    self->generics = NULL;
-    self->methods = NULL;
+    self->symbols = NULL;
+    self->resolutions = NULL;
+    self->root = parent ? parent->scope->root : self;
+    self->version = 0;
+
+    if (!parent) {
+        pthread_mutex_init(&self->mutex, NULL);
+    }
+
     self->parent = parent;
     self->decls = decls;
     self->has_return = false;
@@ -205,76 +380,104 @@ CONSTRUCTOR(LilyCheckedScope *,
     return self;
 }
 
+int
+add_symbol__LilyCheckedScope(LilyCheckedScope *self,
+                             enum LilyCheckedScopeSymbolKind kind,
+                             Uint32 conflicts,
+                             String *name,
+                             void *container)
+{
+    Uint32 kind_bit = (Uint32)1 << kind;
+
+    if (!self->symbols) {
+        self->symbols = NEW(HashMap);
+    }
+
+    LilyCheckedScopeSymbol *symbol = get__HashMap(self->symbols, name->buffer);
+
+    if (!symbol) {
+        symbol = NEW(LilyCheckedScopeSymbol, name);
+
+        insert__HashMap(self->symbols, name->buffer, symbol);
+    } else if (symbol->kinds & (conflicts | kind_bit)) {
+        return 1;
+    }
+
+    symbol->kinds |= kind_bit;
+    symbol->containers[kind] = container;
+
+    // NOTE: Invalidate all the resolutions of the tree of scopes.
+    pthread_mutex_lock(&self->root->mutex);
+    ++self->root->version;
+    pthread_mutex_unlock(&self->root->mutex);
+
+    return 0;
+}
+
+void *
+get_symbol__LilyCheckedScope(const LilyCheckedScope *self,
+                             const String *name,
+                             enum LilyCheckedScopeSymbolKind kind)
+{
+    if (!self->symbols) {
+        return NULL;
+    }
+
+    LilyCheckedScopeSymbol *symbol = get__HashMap(self->symbols, name->buffer);
+
+    return symbol ? symbol->containers[kind] : NULL;
+}
+
 int
 add_captured_variable__LilyCheckedScope(
   LilyCheckedScope *self,
   LilyCheckedScopeContainerCapturedVariable *captured_variable)
 {
-    HASH_MAP_ADD_TO_SCOPE(self->captured_variables, captured_variable);
+    ADD_SYMBOL_TO_SCOPE(CAPTURED_VARIABLE, 0, captured_variable);
 }
 
 int
 add_module__LilyCheckedScope(LilyCheckedScope *self,
                              LilyCheckedScopeContainerModule *module)
 {
-    HASH_MAP_CHECK_IF_EXISTS(self->constants, module);
-    VEC_CHECK_IF_EXISTS(self->funs, module, LilyCheckedScopeContainerFun);
-    HASH_MAP_ADD_TO_SCOPE(self->modules, module);
+    ADD_SYMBOL_TO_SCOPE(
+      MODULE, SYMBOL_KIND_BIT(CONSTANT) | SYMBOL_KIND_BIT(FUN), module);
 }
 
 int
 add_constant__LilyCheckedScope(LilyCheckedScope *self,
                                LilyCheckedScopeContainerConstant *constant)
 {
-    VEC_CHECK_IF_EXISTS(self->funs, constant, LilyCheckedScopeContainerFun);
-    HASH_MAP_CHECK_IF_EXISTS(self->modules, constant);
-    HASH_MAP_ADD_TO_SCOPE(self->constants, constant);
+    ADD_SYMBOL_TO_SCOPE(
+      CONSTANT, SYMBOL_KIND_BIT(FUN) | SYMBOL_KIND_BIT(MODULE), constant);
 }
 
 int
 add_enum__LilyCheckedScope(LilyCheckedScope *self,
                            LilyCheckedScopeContainerEnum *enum_)
 {
-    HASH_MAP_CHECK_IF_EXISTS(self->records, enum_);
-    HASH_MAP_CHECK_IF_EXISTS(self->aliases, enum_);
-    HASH_MAP_CHECK_IF_EXISTS(self->records_object, enum_);
-    HASH_MAP_CHECK_IF_EXISTS(self->enums_object, enum_);
-    HASH_MAP_CHECK_IF_EXISTS(self->classes, enum_);
-    HASH_MAP_CHECK_IF_EXISTS(self->traits, enum_);
-    HASH_MAP_ADD_TO_SCOPE(self->enums, enum_);
+    ADD_SYMBOL_TO_SCOPE(ENUM, CUSTOM_TYPE_SYMBOL_KINDS, enum_);
 }
 
 int
 add_record__LilyCheckedScope(LilyCheckedScope *self,
                              LilyCheckedScopeContainerRecord *record)
 {
-    HASH_MAP_CHECK_IF_EXISTS(self->enums, record);
-    HASH_MAP_CHECK_IF_EXISTS(self->aliases, record);
-    HASH_MAP_CHECK_IF_EXISTS(self->records_object, record);
-    HASH_MAP_CHECK_IF_EXISTS(self->enums_object, record);
-    HASH_MAP_CHECK_IF_EXISTS(self->classes, record);
-    HASH_MAP_CHECK_IF_EXISTS(self->traits, record);
-    HASH_MAP_ADD_TO_SCOPE(self->records, record);
+    ADD_SYMBOL_TO_SCOPE(RECORD, CUSTOM_TYPE_SYMBOL_KINDS, record);
 }
 
 int
 add_alias__LilyCheckedScope(LilyCheckedScope *self,
                             LilyCheckedScopeContainerAlias *alias)
 {
-    HASH_MAP_CHECK_IF_EXISTS(self->enums, alias);
-    HASH_MAP_CHECK_IF_EXISTS(self->records, alias);
-    HASH_MAP_CHECK_IF_EXISTS(self->records_object, alias);
-    HASH_MAP_CHECK_IF_EXISTS(self->enums_object, alias);
-    HASH_MAP_CHECK_IF_EXISTS(self->classes, alias);
-    HASH_MAP_CHECK_IF_EXISTS(self->traits, alias);
-    HASH_MAP_ADD_TO_SCOPE(self->aliases, alias);
+    ADD_SYMBOL_TO_SCOPE(ALIAS, CUSTOM_TYPE_SYMBOL_KINDS, alias);
 }
 
 int
 add_error__LilyCheckedScope(LilyCheckedScope *self,
                             LilyCheckedScopeContainerError *error)
 {
-    HASH_MAP_ADD_TO_SCOPE(self->errors, error);
+    ADD_SYMBOL_TO_SCOPE(ERROR, 0, error);
 }
 
 int
@@ -282,13 +485,7 @@ add_enum_object__LilyCheckedScope(
   LilyCheckedScope *self,
   LilyCheckedScopeContainerEnumObject *enum_object)
 {
-    HASH_MAP_CHECK_IF_EXISTS(self->enums, enum_object);
-    HASH_MAP_CHECK_IF_EXISTS(self->records, enum_object);
-    HASH_MAP_CHECK_IF_EXISTS(self->records_object, enum_object);
-    HASH_MAP_CHECK_IF_EXISTS(self->aliases, enum_object);
-    HASH_MAP_CHECK_IF_EXISTS(self->classes, enum_object);
-    HASH_MAP_CHECK_IF_EXISTS(self->traits, enum_object);
-    HASH_MAP_ADD_TO_SCOPE(self->enums_object, enum_object);
+    ADD_SYMBOL_TO_SCOPE(ENUM_OBJECT, CUSTOM_TYPE_SYMBOL_KINDS, enum_object);
 }
 
 int
@@ -296,95 +493,64 @@ add_record_object__LilyCheckedScope(
   LilyCheckedScope *self,
   LilyCheckedScopeContainerRecordObject *record_object)
 {
-    HASH_MAP_CHECK_IF_EXISTS(self->enums, record_object);
-    HASH_MAP_CHECK_IF_EXISTS(self->records, record_object);
-    HASH_MAP_CHECK_IF_EXISTS(self->aliases, record_object);
-    HASH_MAP_CHECK_IF_EXISTS(self->enums_object, record_object);
-    HASH_MAP_CHECK_IF_EXISTS(self->classes, record_object);
-    HASH_MAP_CHECK_IF_EXISTS(self->traits, record_object);
-    HASH_MAP_ADD_TO_SCOPE(self->records_object, record_object);
+    ADD_SYMBOL_TO_SCOPE(RECORD_OBJECT, CUSTOM_TYPE_SYMBOL_KINDS, record_object);
 }
 
 int
 add_class__LilyCheckedScope(LilyCheckedScope *self,
                             LilyCheckedScopeContainerClass *class)
 {
-    HASH_MAP_CHECK_IF_EXISTS(self->enums, class);
-    HASH_MAP_CHECK_IF_EXISTS(self->records, class);
-    HASH_MAP_CHECK_IF_EXISTS(self->records_object, class);
-    HASH_MAP_CHECK_IF_EXISTS(self->enums_object, class);
-    HASH_MAP_CHECK_IF_EXISTS(self->aliases, class);
-    HASH_MAP_CHECK_IF_EXISTS(self->traits, class);
-    HASH_MAP_ADD_TO_SCOPE(self->classes, class);
+    ADD_SYMBOL_TO_SCOPE(CLASS, CUSTOM_TYPE_SYMBOL_KINDS, class);
 }
 
 int
 add_trait__LilyCheckedScope(LilyCheckedScope *self,
                             LilyCheckedScopeContainerTrait *trait)
 {
-    HASH_MAP_CHECK_IF_EXISTS(self->enums, trait);
-    HASH_MAP_CHECK_IF_EXISTS(self->records, trait);
-    HASH_MAP_CHECK_IF_EXISTS(self->records_object, trait);
-    HASH_MAP_CHECK_IF_EXISTS(self->enums_object, trait);
-    HASH_MAP_CHECK_IF_EXISTS(self->classes, trait);
-    HASH_MAP_CHECK_IF_EXISTS(self->aliases, trait);
-    HASH_MAP_ADD_TO_SCOPE(self->traits, trait);
+    ADD_SYMBOL_TO_SCOPE(TRAIT, CUSTOM_TYPE_SYMBOL_KINDS, trait);
 }
 
 int
 add_fun__LilyCheckedScope(LilyCheckedScope *self,
                           LilyCheckedScopeContainerFun *fun)
 {
-    HASH_MAP_CHECK_IF_EXISTS(self->variables, fun);
-    HASH_MAP_CHECK_IF_EXISTS(self->modules, fun);
-    VEC_ADD_TO_SCOPE(self->funs, fun, LilyCheckedScopeContainerFun);
+    ADD_SYMBOL_TO_SCOPE(
+      FUN, SYMBOL_KIND_BIT(VARIABLE) | SYMBOL_KIND_BIT(MODULE), fun);
 }
 
 int
 add_label__LilyCheckedScope(LilyCheckedScope *self,
                             LilyCheckedScopeContainerLabel *label)
 {
-    HASH_MAP_CHECK_IF_EXISTS(self->variables, label);
-    HASH_MAP_ADD_TO_SCOPE(self->labels, label);
+    ADD_SYMBOL_TO_SCOPE(LABEL, SYMBOL_KIND_BIT(VARIABLE), label);
 }
 
 int
 add_variable__LilyCheckedScope(LilyCheckedScope *self,
                                LilyCheckedScopeContainerVariable *variable)
 {
-    HASH_MAP_CHECK_IF_EXISTS(self->labels, variable);
-    HASH_MAP_ADD_TO_SCOPE(self->variables, variable);
+    ADD_SYMBOL_TO_SCOPE(VARIABLE, SYMBOL_KIND_BIT(LABEL), variable);
 }
 
 int
 add_param__LilyCheckedScope(LilyCheckedScope *self,
                             LilyCheckedScopeContainerVariable *param)
 {
-    HASH_MAP_ADD_TO_SCOPE(self->params, param);
+    ADD_SYMBOL_TO_SCOPE(PARAM, 0, param);
 }
 
 int
 add_generic__LilyCheckedScope(LilyCheckedScope *self,
                               LilyCheckedScopeContainerGeneric *generic)
 {
-    HASH_MAP_ADD_TO_SCOPE(self->generics, generic);
+    ADD_SYMBOL_TO_SCOPE(GENERIC, 0, generic);
 }
 
 LilyCheckedScopeContainerFun *
 get_fun_in_current_scope__LilyCheckedScope(LilyCheckedScope *self,
                                            const String *name)
 {
-    if (self->funs) {
-        for (Usize i = 0; i < self->funs->len; ++i) {
-            LilyCheckedScopeContainerFun *fun = get__Vec(self->funs, i);
-
-            if (!strcmp(fun->name->buffer, name->buffer)) {
-                return fun;
-            }
-        }
-    }
-
-    return NULL;
+    return GET_SYMBOL_FROM_SCOPE(self, name, FUN);
 }
 
 const LilyCheckedScopeDecls *
@@ -417,11 +583,11 @@ search_captured_variable_in_current_scope__LilyCheckedScope(
   LilyCheckedScope *self,
   const String *name)
 {
-    if (self->captured_variables) {
+    if (self->symbols) {
         switch (self->decls.kind) {
             case LILY_CHECKED_SCOPE_DECLS_KIND_STMT: {
                 LilyCheckedScopeContainerCapturedVariable *captured_variable =
-                  get__HashMap(self->captured_variables, name->buffer);
+                  GET_SYMBOL_FROM_SCOPE(self, name, CAPTURED_VARIABLE);
 
                 if (captured_variable) {
                     LilyCheckedCapturedVariable *cv =
@@ -456,11 +622,11 @@ LilyCheckedScopeResponse
 search_module_in_current_scope__LilyCheckedScope(LilyCheckedScope *self,
                                                  const String *name)
 {
-    if (self->modules) {
+    if (self->symbols) {
         switch (self->decls.kind) {
             case LILY_CHECKED_SCOPE_DECLS_KIND_MODULE: {
                 LilyCheckedScopeContainerModule *module =
-                  get__HashMap(self->modules, name->buffer);
+                  GET_SYMBOL_FROM_SCOPE(self, name, MODULE);
 
                 if (module) {
                     LilyCheckedDecl *m =
@@ -489,11 +655,11 @@ LilyCheckedScopeResponse
 search_variable_in_current_scope__LilyCheckedScope(LilyCheckedScope *self,
                                                    const String *name)
 {
-    if (self->variables) {
+    if (self->symbols) {
         switch (self->decls.kind) {
             case LILY_CHECKED_SCOPE_DECLS_KIND_SCOPE: {
                 LilyCheckedScopeContainerVariable *variable =
-                  get__HashMap(self->variables, name->buffer);
+                  GET_SYMBOL_FROM_SCOPE(self, name, VARIABLE);
 
                 if (variable) {
                     LilyCheckedBodyFunItem *item =
@@ -523,13 +689,13 @@ LilyCheckedScopeResponse
 search_param_in_current_scope__LilyCheckedScope(LilyCheckedScope *self,
                                                 const String *name)
 {
-    if (self->params) {
+    if (self->symbols) {
         switch (self->decls.kind) {
             case LILY_CHECKED_SCOPE_DECLS_KIND_DECL:
                 if (self->decls.decl->kind == LILY_CHECKED_DECL_KIND_FUN ||
                     self->decls.decl->kind == LILY_CHECKED_DECL_KIND_METHOD) {
                     LilyCheckedScopeContainerVariable *variable =
-                      get__HashMap(self->params, name->buffer);
+                      GET_SYMBOL_FROM_SCOPE(self, name, PARAM);
 
                     if (variable) {
                         LilyCheckedDeclFunParam *param =
@@ -560,33 +726,32 @@ LilyCheckedScopeResponse
 search_fun_in_current_scope__LilyCheckedScope(LilyCheckedScope *self,
                                               const String *name)
 {
-    if (self->funs) {
+    if (self->symbols) {
         switch (self->decls.kind) {
-            case LILY_CHECKED_SCOPE_DECLS_KIND_MODULE:
-                for (Usize i = 0; i < self->funs->len; ++i) {
-                    LilyCheckedScopeContainerFun *fun = get__Vec(self->funs, i);
-
-                    if (!strcmp(fun->name->buffer, name->buffer)) {
-                        Vec *f = NEW(Vec);
-
-                        for (Usize j = 0; j < fun->ids->len; ++j) {
-                            push__Vec(f,
-                                      get__Vec(self->decls.module->decls,
-                                               (Usize)(Uptr)(Usize *)get__Vec(
-                                                 fun->ids, j)));
-                        }
-
-                        return NEW_VARIANT(
-                          LilyCheckedScopeResponse,
-                          fun,
-                          NULL,
-                          NEW_VARIANT(
-                            LilyCheckedScopeContainer, fun, self->id, fun),
-                          f);
+            case LILY_CHECKED_SCOPE_DECLS_KIND_MODULE: {
+                LilyCheckedScopeContainerFun *fun =
+                  GET_SYMBOL_FROM_SCOPE(self, name, FUN);
+
+                if (fun) {
+                    // Resolve the overloads pushed since the last search.
+                    for (Usize i = fun->decls->len; i < fun->ids->len; ++i) {
+                        push__Vec(fun->decls,
+                                  get__Vec(self->decls.module->decls,
+                                           (Usize)(Uptr)(Usize *)get__Vec(
+                                             fun->ids, i)));
                     }
+
+                    return NEW_VARIANT(
+                      LilyCheckedScopeResponse,
+                      fun,
+                      NULL,
+                      NEW_VARIANT(
+                        LilyCheckedScopeContainer, fun, self->id, fun),
+                      fun->decls);
                 }
 
                 return NEW(LilyCheckedScopeResponse);
+            }
             default:
                 return NEW(LilyCheckedScopeResponse);
         }
@@ -599,11 +764,11 @@ LilyCheckedScopeResponse
 search_constant_in_current_scope__LilyCheckedScope(LilyCheckedScope *self,
                                                    const String *name)
 {
-    if (self->constants) {
+    if (self->symbols) {
         switch (self->decls.kind) {
             case LILY_CHECKED_SCOPE_DECLS_KIND_MODULE: {
                 LilyCheckedScopeContainerConstant *constant =
-                  get__HashMap(self->constants, name->buffer);
+                  GET_SYMBOL_FROM_SCOPE(self, name, CONSTANT);
 
                 if (constant) {
                     LilyCheckedDecl *c =
@@ -633,11 +798,11 @@ LilyCheckedScopeResponse
 search_error_in_current_scope__LilyCheckedScope(LilyCheckedScope *self,
                                                 const String *name)
 {
-    if (self->errors) {
+    if (self->symbols) {
         switch (self->decls.kind) {
             case LILY_CHECKED_SCOPE_DECLS_KIND_MODULE: {
                 LilyCheckedScopeContainerError *error =
-                  get__HashMap(self->errors, name->buffer);
+                  GET_SYMBOL_FROM_SCOPE(self, name, ERROR);
 
                 if (error) {
                     LilyCheckedDecl *e =
@@ -667,11 +832,11 @@ LilyCheckedScopeResponse
 search_alias_in_current_scope__LilyCheckedScope(LilyCheckedScope *self,
                                                 const String *name)
 {
-    if (self->aliases) {
+    if (self->symbols) {
         switch (self->decls.kind) {
             case LILY_CHECKED_SCOPE_DECLS_KIND_MODULE: {
                 LilyCheckedScopeContainerAlias *alias =
-                  get__HashMap(self->aliases, name->buffer);
+                  GET_SYMBOL_FROM_SCOPE(self, name, ALIAS);
 
                 if (alias) {
                     LilyCheckedDecl *a =
@@ -701,11 +866,11 @@ LilyCheckedScopeResponse
 search_record_in_current_scope__LilyCheckedScope(LilyCheckedScope *self,
                                                  const String *name)
 {
-    if (self->records) {
+    if (self->symbols) {
         switch (self->decls.kind) {
             case LILY_CHECKED_SCOPE_DECLS_KIND_MODULE: {
                 LilyCheckedScopeContainerRecord *record =
-                  get__HashMap(self->records, name->buffer);
+                  GET_SYMBOL_FROM_SCOPE(self, name, RECORD);
 
                 if (record) {
                     LilyCheckedDecl *r =
@@ -735,11 +900,11 @@ LilyCheckedScopeResponse
 search_enum_in_current_scope__LilyCheckedScope(LilyCheckedScope *self,
                                                const String *name)
 {
-    if (self->enums) {
+    if (self->symbols) {
         switch (self->decls.kind) {
             case LILY_CHECKED_SCOPE_DECLS_KIND_MODULE: {
                 LilyCheckedScopeContainerEnum *enum_ =
-                  get__HashMap(self->enums, name->buffer);
+                  GET_SYMBOL_FROM_SCOPE(self, name, ENUM);
 
                 if (enum_) {
                     LilyCheckedDecl *e =
@@ -769,11 +934,11 @@ LilyCheckedScopeResponse
 search_generic_in_current_scope__LilyCheckedScope(LilyCheckedScope *self,
                                                   const String *name)
 {
-    if (self->generics) {
+    if (self->symbols) {
         switch (self->decls.kind) {
             case LILY_CHECKED_SCOPE_DECLS_KIND_DECL: {
                 LilyCheckedScopeContainerGeneric *generic =
-                  get__HashMap(self->generics, name->buffer);
+                  GET_SYMBOL_FROM_SCOPE(self, name, GENERIC);
 
                 if (generic) {
                     LilyCheckedGenericParam *g = NULL;
@@ -934,11 +1099,11 @@ LilyCheckedScopeResponse
 search_class_in_current_scope__LilyCheckedScope(LilyCheckedScope *self,
                                                 const String *name)
 {
-    if (self->classes) {
+    if (self->symbols) {
         switch (self->decls.kind) {
             case LILY_CHECKED_SCOPE_DECLS_KIND_MODULE: {
                 LilyCheckedScopeContainerClass *class =
-                  get__HashMap(self->classes, name->buffer);
+                  GET_SYMBOL_FROM_SCOPE(self, name, CLASS);
 
                 if (class) {
                     LilyCheckedDecl *c =
@@ -968,11 +1133,11 @@ LilyCheckedScopeResponse
 search_record_object_in_current_scope__LilyCheckedScope(LilyCheckedScope *self,
                                                         const String *name)
 {
-    if (self->records_object) {
+    if (self->symbols) {
         switch (self->decls.kind) {
             case LILY_CHECKED_SCOPE_DECLS_KIND_MODULE: {
                 LilyCheckedScopeContainerRecordObject *record_object =
-                  get__HashMap(self->records_object, name->buffer);
+                  GET_SYMBOL_FROM_SCOPE(self, name, RECORD_OBJECT);
 
                 if (record_object) {
                     LilyCheckedDecl *r =
@@ -1003,11 +1168,11 @@ LilyCheckedScopeResponse
 search_enum_object_in_current_scope__LilyCheckedScope(LilyCheckedScope *self,
                                                       const String *name)
 {
-    if (self->enums_object) {
+    if (self->symbols) {
         switch (self->decls.kind) {
             case LILY_CHECKED_SCOPE_DECLS_KIND_MODULE: {
                 LilyCheckedScopeContainerEnumObject *enum_object =
-                  get__HashMap(self->enums_object, name->buffer);
+                  GET_SYMBOL_FROM_SCOPE(self, name, ENUM_OBJECT);
 
                 if (enum_object) {
                     LilyCheckedDecl *e =
@@ -1038,11 +1203,11 @@ LilyCheckedScopeResponse
 search_trait_in_current_scope__LilyCheckedScope(LilyCheckedScope *self,
                                                 const String *name)
 {
-    if (self->traits) {
+    if (self->symbols) {
         switch (self->decls.kind) {
             case LILY_CHECKED_SCOPE_DECLS_KIND_MODULE: {
                 LilyCheckedScopeContainerTrait *trait =
-                  get__HashMap(self->traits, name->buffer);
+                  GET_SYMBOL_FROM_SCOPE(self, name, TRAIT);
 
                 if (trait) {
                     LilyCheckedDecl *t =
@@ -1282,14 +1447,14 @@ search_trait__LilyCheckedScope(LilyCheckedScope *self, const String *name)
 LilyCheckedScopeResponse
 search_field__LilyCheckedScope(LilyCheckedScope *self, const String *name)
 {
-    if (self->variables) {
+    if (self->symbols) {
         switch (self->decls.kind) {
             case LILY_CHECKED_SCOPE_DECLS_KIND_DECL:
                 if (self->decls.decl->kind == LILY_CHECKED_DECL_KIND_TYPE) {
                     switch (self->decls.decl->type.kind) {
                         case LILY_CHECKED_DECL_TYPE_KIND_RECORD: {
                             LilyCheckedScopeContainerVariable *variable =
-                              get__HashMap(self->variables, name->buffer);
+                              GET_SYMBOL_FROM_SCOPE(self, name, VARIABLE);
 
                             if (variable) {
                                 LilyCheckedField *field =
@@ -1317,7 +1482,7 @@ search_field__LilyCheckedScope(LilyCheckedScope *self, const String *name)
                     switch (self->decls.decl->object.kind) {
                         case LILY_CHECKED_DECL_OBJECT_KIND_RECORD: {
                             LilyCheckedScopeContainerVariable *variable =
-                              get__HashMap(self->variables, name->buffer);
+                              GET_SYMBOL_FROM_SCOPE(self, name, VARIABLE);
 
                             if (variable) {
                                 LilyCheckedBodyRecordObjectItem *field =
@@ -1358,14 +1523,14 @@ search_field__LilyCheckedScope(LilyCheckedScope *self, const String *name)
 LilyCheckedScopeResponse
 search_variant__LilyCheckedScope(LilyCheckedScope *self, const String *name)
 {
-    if (self->variables) {
+    if (self->symbols) {
         switch (self->decls.kind) {
             case LILY_CHECKED_SCOPE_DECLS_KIND_DECL:
                 if (self->decls.decl->kind == LILY_CHECKED_DECL_KIND_TYPE) {
                     switch (self->decls.decl->type.kind) {
                         case LILY_CHECKED_DECL_TYPE_KIND_ENUM: {
                             LilyCheckedScopeContainerVariable *variable =
-                              get__HashMap(self->variables, name->buffer);
+                              GET_SYMBOL_FROM_SCOPE(self, name, VARIABLE);
 
                             if (variable) {
                                 LilyCheckedVariant *enum_variant = get__Vec(
@@ -1393,7 +1558,7 @@ search_variant__LilyCheckedScope(LilyCheckedScope *self, const String *name)
                     switch (self->decls.decl->object.kind) {
                         case LILY_CHECKED_DECL_OBJECT_KIND_ENUM: {
                             LilyCheckedScopeContainerVariable *variable =
-                              get__HashMap(self->variables, name->buffer);
+                              GET_SYMBOL_FROM_SCOPE(self, name, VARIABLE);
 
                             if (variable) {
                                 LilyCheckedBodyEnumObjectItem *variant =
@@ -1432,127 +1597,114 @@ search_variant__LilyCheckedScope(LilyCheckedScope *self, const String *name)
 }
 
 LilyCheckedScopeResponse
-search_identifier__LilyCheckedScope(LilyCheckedScope *self, const String *name)
+search_identifier_in_current_scope__LilyCheckedScope(LilyCheckedScope *self,
+                                                     const String *name)
 {
-    LilyCheckedScopeResponse variable =
-      search_variable_in_current_scope__LilyCheckedScope(self, name);
-    LilyCheckedScopeResponse param =
-      search_param_in_current_scope__LilyCheckedScope(self, name);
-    LilyCheckedScopeResponse fun =
-      search_fun_in_current_scope__LilyCheckedScope(self, name);
-    LilyCheckedScopeResponse module =
-      search_module_in_current_scope__LilyCheckedScope(self, name);
-    LilyCheckedScopeResponse constant =
-      search_constant_in_current_scope__LilyCheckedScope(self, name);
-    LilyCheckedScopeResponse field = search_field__LilyCheckedScope(self, name);
-    LilyCheckedScopeResponse variant =
-      search_variant__LilyCheckedScope(self, name);
-    LilyCheckedScopeResponse enum_ =
-      search_enum_in_current_scope__LilyCheckedScope(self, name);
-    LilyCheckedScopeResponse error =
-      search_error_in_current_scope__LilyCheckedScope(self, name);
-    LilyCheckedScopeResponse captured_variable =
-      search_captured_variable_in_current_scope__LilyCheckedScope(self, name);
-
-    // [variable, param, fun, module, constant, field, variant, enum, error,
-    // captured_variable]
-#define RESPONSES_IDENTIFIER_LEN 10
-    LilyCheckedScopeResponse *responses[RESPONSES_IDENTIFIER_LEN] =
-      (LilyCheckedScopeResponse *[RESPONSES_IDENTIFIER_LEN]){
-          &variable, &param,   &fun,   &module, &constant,
-          &field,    &variant, &enum_, &error,  &captured_variable
-      };
-    int index_with_largest_id = -1;
-
-    for (Usize i = 0; i < RESPONSES_IDENTIFIER_LEN; ++i) {
-        LilyCheckedScopeResponse *response = responses[i];
-
-        switch (response->kind) {
-            case LILY_CHECKED_SCOPE_RESPONSE_KIND_NOT_FOUND:
-                continue;
-            default:
-                if (index_with_largest_id == -1) {
-                    index_with_largest_id = i;
-                } else {
-                    if (response->scope_container.scope_id >
-                        responses[index_with_largest_id]
-                          ->scope_container.scope_id) {
-                        index_with_largest_id = i;
-                    }
-                }
+    LilyCheckedScopeSymbol *symbol =
+      self->symbols ? get__HashMap(self->symbols, name->buffer) : NULL;
+
+    if (symbol && symbol->kinds & IDENTIFIER_SYMBOL_KINDS) {
+        for (Usize i = 0; i < LEN(identifier_searches, *identifier_searches);
+             ++i) {
+            LilyCheckedScopeResponse response =
+              identifier_searches[i](self, name);
+
+            switch (response.kind) {
+                case LILY_CHECKED_SCOPE_RESPONSE_KIND_NOT_FOUND:
+                    continue;
+                default:
+                    return response;
+            }
         }
     }
 
-    if (self->catch && index_with_largest_id == -1) {
-        if (!strcmp(name->buffer, self->catch->name->buffer)) {
-            return NEW_VARIANT(LilyCheckedScopeResponse,
-                               catch_variable,
-                               self->catch->location,
-                               self->catch->raises);
+    if (self->catch && !strcmp(name->buffer, self->catch->name->buffer)) {
+        return NEW_VARIANT(LilyCheckedScopeResponse,
+                           catch_variable,
+                           self->catch->location,
+                           self->catch->raises);
+    }
+
+    return NEW(LilyCheckedScopeResponse);
+}
+
+LilyCheckedScopeResponse
+search_identifier__LilyCheckedScope(LilyCheckedScope *self, const String *name)
+{
+    pthread_mutex_lock(&self->root->mutex);
+
+    LilyCheckedScopeResolution *resolution =
+      self->resolutions ? get__HashMap(self->resolutions, name->buffer) : NULL;
+
+    if (resolution && resolution->version == self->root->version) {
+        LilyCheckedScope *scope = resolution->scope;
+
+        pthread_mutex_unlock(&self->root->mutex);
+
+        return scope ? search_identifier_in_current_scope__LilyCheckedScope(
+                         scope, name)
+                     : NEW(LilyCheckedScopeResponse);
+    }
+
+    LilyCheckedScope *current = self;
+    LilyCheckedScopeResponse response = NEW(LilyCheckedScopeResponse);
+
+    while (current) {
+        response =
+          search_identifier_in_current_scope__LilyCheckedScope(current, name);
+
+        if (response.kind != LILY_CHECKED_SCOPE_RESPONSE_KIND_NOT_FOUND) {
+            break;
         }
+
+        current = current->parent ? current->parent->scope : NULL;
     }
 
-    if (self->parent && index_with_largest_id == -1) {
-        return search_identifier__LilyCheckedScope(self->parent->scope, name);
+    if (resolution) {
+        resolution->scope = current;
+        resolution->version = self->root->version;
+    } else {
+        if (!self->resolutions) {
+            self->resolutions = NEW(HashMap);
+        }
+
+        resolution = NEW(
+          LilyCheckedScopeResolution, name, current, self->root->version);
+
+        insert__HashMap(
+          self->resolutions, resolution->name->buffer, resolution);
     }
 
-    return index_with_largest_id == -1 ? NEW(LilyCheckedScopeResponse)
-                                       : *responses[index_with_largest_id];
+    pthread_mutex_unlock(&self->root->mutex);
+
+    return response;
 }
 
 LilyCheckedScopeResponse
 search_custom_type__LilyCheckedScope(LilyCheckedScope *self, const String *name)
 {
-    LilyCheckedScopeResponse record =
-      search_record_in_current_scope__LilyCheckedScope(self, name);
-    LilyCheckedScopeResponse enum_ =
-      search_enum_in_current_scope__LilyCheckedScope(self, name);
-    LilyCheckedScopeResponse generic =
-      search_generic_in_current_scope__LilyCheckedScope(self, name);
-    LilyCheckedScopeResponse class = search_class__LilyCheckedScope(self, name);
-    LilyCheckedScopeResponse record_object =
-      search_record_object_in_current_scope__LilyCheckedScope(self, name);
-    LilyCheckedScopeResponse enum_object =
-      search_enum_object_in_current_scope__LilyCheckedScope(self, name);
-    LilyCheckedScopeResponse trait =
-      search_trait_in_current_scope__LilyCheckedScope(self, name);
-    LilyCheckedScopeResponse alias =
-      search_alias_in_current_scope__LilyCheckedScope(self, name);
+    LilyCheckedScopeSymbol *symbol =
+      self->symbols ? get__HashMap(self->symbols, name->buffer) : NULL;
 
-    // [record, enum, generic, class, record_object, enum_object, trait, alias]
-#define RESPONSES_CUSTOM_TYPE_LEN 8
-    LilyCheckedScopeResponse *responses[RESPONSES_CUSTOM_TYPE_LEN] =
-      (LilyCheckedScopeResponse *[RESPONSES_CUSTOM_TYPE_LEN]){
-          &record,        &enum_,       &generic, &class,
-          &record_object, &enum_object, &trait,   &alias
-      };
-    int index_with_largest_id = -1;
-
-    for (Usize i = 0; i < RESPONSES_CUSTOM_TYPE_LEN; ++i) {
-        LilyCheckedScopeResponse *response = responses[i];
-
-        switch (response->kind) {
-            case LILY_CHECKED_SCOPE_RESPONSE_KIND_NOT_FOUND:
-                continue;
-            default:
-                if (index_with_largest_id == -1) {
-                    index_with_largest_id = i;
-                } else {
-                    if (response->scope_container.scope_id >
-                        responses[index_with_largest_id]
-                          ->scope_container.scope_id) {
-                        index_with_largest_id = i;
-                    }
-                }
-        }
-    }
+    if (symbol && symbol->kinds & (CUSTOM_TYPE_SYMBOL_KINDS |
+                                   SYMBOL_KIND_BIT(GENERIC))) {
+        for (Usize i = 0; i < LEN(custom_type_searches, *custom_type_searches);
+             ++i) {
+            LilyCheckedScopeResponse response =
+              custom_type_searches[i](self, name);
 
-    if (self->parent && index_with_largest_id == -1) {
-        return search_custom_type__LilyCheckedScope(self->parent->scope, name);
+            switch (response.kind) {
+                case LILY_CHECKED_SCOPE_RESPONSE_KIND_NOT_FOUND:
+                    continue;
+                default:
+                    return response;
+            }
+        }
     }
 
-    return index_with_largest_id == -1 ? NEW(LilyCheckedScopeResponse)
-                                       : *responses[index_with_largest_id];
+    return self->parent
+             ? search_custom_type__LilyCheckedScope(self->parent->scope, name)
+             : NEW(LilyCheckedScopeResponse);
 }
 
 LilyCheckedScope *
@@ -1677,11 +1829,11 @@ get_variable_from_id__LilyCheckedScope(LilyCheckedScope *self,
 {
     LilyCheckedScope *scope = get_scope_from_id__LilyCheckedScope(self, id);
 
-    if (self->variables) {
+    if (self->symbols) {
         switch (scope->decls.kind) {
             case LILY_CHECKED_SCOPE_DECLS_KIND_SCOPE: {
                 LilyCheckedScopeContainerVariable *variable =
-                  get__HashMap(self->variables, name->buffer);
+                  GET_SYMBOL_FROM_SCOPE(self, name, VARIABLE);
 
                 if (variable) {
                     return get__Vec(scope->decls.scope, variable->id);
@@ -1772,6 +1924,11 @@ set_catch_name__LilyCheckedScope(LilyCheckedScope *self,
     ASSERT(!self->catch);
 
     self->catch = NEW(LilyCheckedScopeCatch, catch_name, location, raises);
+
+    // NOTE: The catch name can shadow an identifier of the parent scopes.
+    pthread_mutex_lock(&self->root->mutex);
+    ++self->root->version;
+    pthread_mutex_unlock(&self->root->mutex);
 }
 
 #ifdef ENV_DEBUG
@@ -1797,145 +1954,10 @@ IMPL_FOR_DEBUG(to_string, LilyCheckedScope, const LilyCheckedScope *self)
         push_str__String(res, "NULL");
     }
 
-    push_str__String(res, ", captured_variables =");
-
-    if (self->captured_variables) {
-        DEBUG_HASH_MAP_STR(self->captured_variables,
-                           res,
-                           LilyCheckedScopeContainerCapturedVariable);
-    } else {
-        push_str__String(res, " NULL");
-    }
-
-    push_str__String(res, ", modules =");
-
-    if (self->modules) {
-        DEBUG_HASH_MAP_STR(self->modules, res, LilyCheckedScopeContainerModule);
-    } else {
-        push_str__String(res, " NULL");
-    }
-
-    push_str__String(res, ", constants =");
-
-    if (self->constants) {
-        DEBUG_HASH_MAP_STR(
-          self->constants, res, LilyCheckedScopeContainerConstant);
-    } else {
-        push_str__String(res, " NULL");
-    }
-
-    push_str__String(res, ", enums =");
-
-    if (self->enums) {
-        DEBUG_HASH_MAP_STR(self->enums, res, LilyCheckedScopeContainerEnum);
-    } else {
-        push_str__String(res, " NULL");
-    }
-
-    push_str__String(res, ", records =");
-
-    if (self->records) {
-        DEBUG_HASH_MAP_STR(self->records, res, LilyCheckedScopeContainerRecord);
-    } else {
-        push_str__String(res, " NULL");
-    }
-
-    push_str__String(res, ", aliases =");
-
-    if (self->aliases) {
-        DEBUG_HASH_MAP_STR(self->aliases, res, LilyCheckedScopeContainerAlias);
-    } else {
-        push_str__String(res, " NULL");
-    }
-
-    push_str__String(res, ", errors =");
-
-    if (self->errors) {
-        DEBUG_HASH_MAP_STR(self->errors, res, LilyCheckedScopeContainerError);
-    } else {
-        push_str__String(res, " NULL");
-    }
-
-    push_str__String(res, ", enums_object =");
-
-    if (self->enums_object) {
-        DEBUG_HASH_MAP_STR(
-          self->enums_object, res, LilyCheckedScopeContainerEnumObject);
-    } else {
-        push_str__String(res, " NULL");
-    }
-
-    push_str__String(res, ", records_object =");
-
-    if (self->records_object) {
-        DEBUG_HASH_MAP_STR(
-          self->records_object, res, LilyCheckedScopeContainerRecordObject);
-    } else {
-        push_str__String(res, " NULL");
-    }
-
-    push_str__String(res, ", classes =");
-
-    if (self->classes) {
-        DEBUG_HASH_MAP_STR(self->classes, res, LilyCheckedScopeContainerClass);
-    } else {
-        push_str__String(res, " NULL");
-    }
-
-    push_str__String(res, ", traits =");
-
-    if (self->traits) {
-        DEBUG_HASH_MAP_STR(self->traits, res, LilyCheckedScopeContainerTrait);
-    } else {
-        push_str__String(res, " NULL");
-    }
-
-    push_str__String(res, ", funs =");
+    push_str__String(res, ", symbols =");
 
-    if (self->funs) {
-        DEBUG_VEC_STRING(self->funs, res, LilyCheckedScopeContainerFun);
-    } else {
-        push_str__String(res, " NULL");
-    }
-
-    push_str__String(res, ", labels =");
-
-    if (self->labels) {
-        DEBUG_HASH_MAP_STR(self->labels, res, LilyCheckedScopeContainerLabel);
-    } else {
-        push_str__String(res, " NULL");
-    }
-
-    push_str__String(res, ", variables =");
-
-    if (self->variables) {
-        DEBUG_HASH_MAP_STR(
-          self->variables, res, LilyCheckedScopeContainerVariable);
-    } else {
-        push_str__String(res, " NULL");
-    }
-
-    push_str__String(res, ", params =");
-
-    if (self->params) {
-        DEBUG_HASH_MAP_STR(
-          self->params, res, LilyCheckedScopeContainerVariable);
-    } else {
-        push_str__String(res, " NULL");
-    }
-
-    push_str__String(res, ", generics =");
-
-    if (self->params) {
-        DEBUG_HASH_MAP_STR(self->params, res, LilyCheckedScopeContainerGeneric);
-    } else {
-        push_str__String(res, " NULL");
-    }
-
-    push_str__String(res, ", methods =");
-
-    if (self->methods) {
-        DEBUG_VEC_STRING(self->methods, res, LilyCheckedScopeContainerMethod);
+    if (self->symbols) {
+        DEBUG_HASH_MAP_STRING(self->symbols, res, LilyCheckedScopeSymbol);
     } else {
         push_str__String(res, " NULL");
     }
@@ -1967,99 +1989,20 @@ DESTRUCTOR(LilyCheckedScope, LilyCheckedScope *self)
         FREE(LilyCheckedScopeCatch, self->catch);
     }
 
-    if (self->captured_variables) {
-        FREE_HASHMAP_VALUES(self->captured_variables,
-                            LilyCheckedScopeContainerCapturedVariable);
-        FREE(HashMap, self->captured_variables);
-    }
-
-    if (self->modules) {
-        FREE_HASHMAP_VALUES(self->modules, LilyCheckedScopeContainerModule);
-        FREE(HashMap, self->modules);
-    }
-
-    if (self->constants) {
-        FREE_HASHMAP_VALUES(self->constants, LilyCheckedScopeContainerConstant);
-        FREE(HashMap, self->constants);
-    }
-
-    if (self->enums) {
-        FREE_HASHMAP_VALUES(self->enums, LilyCheckedScopeContainerEnum);
-        FREE(HashMap, self->enums);
-    }
-
-    if (self->records) {
-        FREE_HASHMAP_VALUES(self->records, LilyCheckedScopeContainerRecord);
-        FREE(HashMap, self->records);
-    }
-
-    if (self->aliases) {
-        FREE_HASHMAP_VALUES(self->aliases, LilyCheckedScopeContainerAlias);
-        FREE(HashMap, self->aliases);
-    }
-
-    if (self->errors) {
-        FREE_HASHMAP_VALUES(self->errors, LilyCheckedScopeContainerError);
-        FREE(HashMap, self->errors);
-    }
-
-    if (self->enums_object) {
-        FREE_HASHMAP_VALUES(self->enums_object,
-                            LilyCheckedScopeContainerEnumObject);
-        FREE(HashMap, self->enums_object);
-    }
-
-    if (self->records_object) {
-        FREE_HASHMAP_VALUES(self->records_object,
-                            LilyCheckedScopeContainerRecordObject);
-        FREE(HashMap, self->records_object);
+    if (self->symbols) {
+        FREE_HASHMAP_VALUES(self->symbols, LilyCheckedScopeSymbol);
+        FREE(HashMap, self->symbols);
     }
 
-    if (self->classes) {
-        FREE_HASHMAP_VALUES(self->classes, LilyCheckedScopeContainerClass);
-        FREE(HashMap, self->classes);
-    }
-
-    if (self->traits) {
-        FREE_HASHMAP_VALUES(self->traits, LilyCheckedScopeContainerTrait);
-        FREE(HashMap, self->traits);
-    }
-
-    if (self->labels) {
-        FREE_HASHMAP_VALUES(self->labels, LilyCheckedScopeContainerLabel);
-        FREE(HashMap, self->labels);
-    }
-
-    if (self->funs) {
-        FREE_BUFFER_ITEMS(
-          self->funs->buffer, self->funs->len, LilyCheckedScopeContainerFun);
-        FREE(Vec, self->funs);
-    }
-
-    if (self->variables) {
-        FREE_HASHMAP_VALUES(self->variables, LilyCheckedScopeContainerVariable);
-        FREE(HashMap, self->variables);
-    }
-
-    if (self->params) {
-        FREE_HASHMAP_VALUES(self->params, LilyCheckedScopeContainerVariable);
-        FREE(HashMap, self->params);
-    }
-
-    if (self->generics) {
-        FREE_HASHMAP_VALUES(self->generics, LilyCheckedScopeContainerGeneric);
-        FREE(HashMap, self->generics);
-    }
-
-    if (self->methods) {
-        FREE_BUFFER_ITEMS(self->methods->buffer,
-                          self->methods->len,
-                          LilyCheckedScopeContainerMethod);
-        FREE(Vec, self->methods);
+    if (self->resolutions) {
+        FREE_HASHMAP_VALUES(self->resolutions, LilyCheckedScopeResolution);
+        FREE(HashMap, self->resolutions);
     }
 
     if (self->parent) {
         FREE(LilyCheckedParent, self->parent);
+    } else {
+        pthread_mutex_destroy(&self->mutex);
     }
 
     lily_free(self);
@@ -332,6 +332,7 @@ CONSTRUCTOR(LilyCheckedScopeContainerFun *,
 
     self->name = name;
     self->ids = ids;
+    self->decls = NEW(Vec);
 
     return self;
 }
@@ -368,6 +369,7 @@ IMPL_FOR_DEBUG(to_string,
 DESTRUCTOR(LilyCheckedScopeContainerFun, LilyCheckedScopeContainerFun *self)
 {
     FREE(Vec, self->ids);
+    FREE(Vec, self->decls);
     lily_free(self);
 }
 
@@ -26,6 +26,7 @@
 #include <base/assert.h>
 #include <base/new.h>
 #include <base/platform.h>
+#include <base/vec.h>
 
 #include <cli/emit.h>
 
@@ -36,6 +37,7 @@
 #include <llvm-c/Support.h>
 #include <llvm-c/TargetMachine.h>
 
+#include <pthread.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -54,10 +56,32 @@ get_cpu_features();
 static inline void
 lily_fatal_error(const char *reason);
 
-/// Init all LLVM features.
+/// Init all LLVM features, and detect the host.
 static void
 LilyLLVMInit();
 
+/// Create a target machine for the host.
+static LLVMTargetMachineRef
+create_machine__LilyIrLlvm(bool is_pic);
+
+/// Take a target machine created by warm__LilyIrLlvm, or create a new one.
+static LLVMTargetMachineRef
+take_machine__LilyIrLlvm(bool is_pic);
+
+// NOTE: The LLVM modules are created from several threads (sub packages
+// precompiled in parallel), but LLVM must only be initialized once.
+static pthread_once_t llvm_init_once = PTHREAD_ONCE_INIT;
+
+// NOTE: The host is only detected once (see LilyLLVMInit), then it's shared by
+// all the modules.
+static char *host_triple = NULL;         // char*?
+static char *host_cpu = NULL;            // char*?
+static char *host_cpu_features = NULL;   // char*?
+static LLVMTargetRef host_target = NULL; // LLVMTargetRef?
+
+static Vec *warm_machines = NULL; // Vec<LLVMTargetMachineRef>*?
+static pthread_mutex_t warm_machines_mutex = PTHREAD_MUTEX_INITIALIZER;
+
 char *
 get_triple()
 {
@@ -82,58 +106,64 @@ lily_fatal_error(const char *reason)
     printf("Lily(Fatal): LLVM error: %s\n", reason);
 }
 
-CONSTRUCTOR(LilyIrLlvm, LilyIrLlvm, const char *module_name)
+LLVMTargetMachineRef
+create_machine__LilyIrLlvm(bool is_pic)
 {
-    // TODO: Check whether we need to initialize LLVM for each LLVM module
-    LilyLLVMInit();
+    return LLVMCreateTargetMachine(host_target,
+                                   host_triple,
+                                   host_cpu,
+                                   host_cpu_features,
+                                   LLVMCodeGenLevelDefault,
+                                   is_pic ? LLVMRelocPIC : LLVMRelocDefault,
+                                   LLVMCodeModelDefault);
+}
 
-    char *triple = get_triple();
-    char *cpu = get_cpu();
-    char *cpu_features = get_cpu_features();
+LLVMTargetMachineRef
+take_machine__LilyIrLlvm(bool is_pic)
+{
+    LLVMTargetMachineRef machine = NULL;
 
-    LLVMContextRef context = LLVMContextCreate();
-    LLVMModuleRef module =
-      LLVMModuleCreateWithNameInContext(module_name, context);
-    LLVMTargetRef target = NULL;
-    char *target_error_msg = NULL;
+    // NOTE: The warm target machines use the default relocation model.
+    if (!is_pic) {
+        pthread_mutex_lock(&warm_machines_mutex);
 
-    if (LLVMGetTargetFromTriple(triple, &target, &target_error_msg) != 0) {
-        EMIT_ERROR(target_error_msg);
-        LLVMDisposeMessage(target_error_msg);
-        exit(1);
+        if (warm_machines && warm_machines->len > 0) {
+            machine = pop__Vec(warm_machines);
+        }
+
+        pthread_mutex_unlock(&warm_machines_mutex);
     }
 
-    // LLVMTargetRef target = LLVMGetFirstTarget();
+    return machine ? machine : create_machine__LilyIrLlvm(is_pic);
+}
+
+CONSTRUCTOR(LilyIrLlvm, LilyIrLlvm, const char *module_name, bool is_pic)
+{
+    init__LilyIrLlvm();
 
-    LLVMSetTarget(module, triple);
+    LLVMContextRef context = LLVMContextCreate();
+    LLVMModuleRef module =
+      LLVMModuleCreateWithNameInContext(module_name, context);
 
-    LLVMTargetMachineRef machine =
-      LLVMCreateTargetMachine(target,
-                              triple,
-                              cpu,
-                              cpu_features,
-                              LLVMCodeGenLevelDefault,
-                              LLVMRelocDefault,
-                              LLVMCodeModelDefault);
+    LLVMSetTarget(module, host_triple);
 
+    LLVMTargetMachineRef machine = take_machine__LilyIrLlvm(is_pic);
     LLVMTargetDataRef target_data =
       LLVMCreateTargetData(LLVMGetDataLayoutStr(module));
 
     LLVMSetModuleDataLayout(module, target_data);
 
-    lily_free(triple);
-
     return (LilyIrLlvm){ .context = context,
                          .module = module,
-                         .builder = LLVMCreateBuilder(),
+                         .builder = LLVMCreateBuilderInContext(context),
                          .di_builder = LLVMCreateDIBuilder(module),
-                         .target = target,
+                         .target = host_target,
                          .target_data = target_data,
                          .machine = machine,
-                         .cpu = cpu,
-                         .features = cpu_features,
-                         .cpu_len = strlen(cpu),
-                         .features_len = strlen(cpu_features) };
+                         .cpu = host_cpu,
+                         .features = host_cpu_features,
+                         .cpu_len = strlen(host_cpu),
+                         .features_len = strlen(host_cpu_features) };
 }
 
 LLVMMetadataRef
@@ -147,6 +177,50 @@ get_current_scope__LilyIrLlvm(LLVMValueRef inst)
     return LLVMDILocationGetScope(debug_loc);
 }
 
+void
+init__LilyIrLlvm()
+{
+    pthread_once(&llvm_init_once, &LilyLLVMInit);
+}
+
+void
+warm__LilyIrLlvm(Usize machines)
+{
+    init__LilyIrLlvm();
+
+    pthread_mutex_lock(&warm_machines_mutex);
+
+    if (!warm_machines) {
+        warm_machines = NEW(Vec);
+    }
+
+    for (Usize i = 0; i < machines; ++i) {
+        LLVMTargetMachineRef machine = create_machine__LilyIrLlvm(false);
+
+        LilyLLVMWarmMachine(machine, host_cpu, host_cpu_features);
+        push__Vec(warm_machines, machine);
+    }
+
+    pthread_mutex_unlock(&warm_machines_mutex);
+}
+
+void
+destroy_warm__LilyIrLlvm()
+{
+    pthread_mutex_lock(&warm_machines_mutex);
+
+    if (warm_machines) {
+        for (Usize i = 0; i < warm_machines->len; ++i) {
+            LLVMDisposeTargetMachine(get__Vec(warm_machines, i));
+        }
+
+        FREE(Vec, warm_machines);
+        warm_machines = NULL;
+    }
+
+    pthread_mutex_unlock(&warm_machines_mutex);
+}
+
 void
 LilyLLVMInit()
 {
@@ -163,6 +237,19 @@ LilyLLVMInit()
     LLVMInstallFatalErrorHandler(lily_fatal_error);
 
     LLVMLoadLibraryPermanently(NULL);
+
+    host_triple = get_triple();
+    host_cpu = get_cpu();
+    host_cpu_features = get_cpu_features();
+
+    char *target_error_msg = NULL;
+
+    if (LLVMGetTargetFromTriple(host_triple, &host_target, &target_error_msg) !=
+        0) {
+        EMIT_ERROR(target_error_msg);
+        LLVMDisposeMessage(target_error_msg);
+        exit(1);
+    }
 }
 
 DESTRUCTOR(LilyIrLlvm, const LilyIrLlvm *self)
@@ -173,6 +260,4 @@ DESTRUCTOR(LilyIrLlvm, const LilyIrLlvm *self)
     LLVMDisposeTargetData(self->target_data);
     LLVMDisposeTargetMachine(self->machine);
     LLVMContextDispose(self->context);
-    lily_free(self->cpu);
-    lily_free(self->features);
 }
@@ -24,7 +24,11 @@
 
 #include <core/lily/compiler/ir/llvm.h>
 
+#include <llvm/IR/Function.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
 #include <llvm/Support/ErrorHandling.h>
+#include <llvm/Target/TargetMachine.h>
 
 using namespace llvm;
 
@@ -33,3 +37,25 @@ LilyLLVMRemoveFatalErrorHandler()
 {
     return remove_fatal_error_handler();
 }
+
+void
+LilyLLVMWarmMachine(LLVMTargetMachineRef machine,
+                    const char *cpu,
+                    const char *features)
+{
+    auto &target_machine = *reinterpret_cast<TargetMachine *>(machine);
+    LLVMContext context;
+    Module module("lily.warm", context);
+    Function *fun =
+      Function::Create(FunctionType::get(Type::getVoidTy(context), false),
+                       GlobalValue::ExternalLinkage,
+                       "lily.warm",
+                       module);
+
+    fun->addFnAttr("target-cpu", cpu);
+    fun->addFnAttr("target-features", features);
+
+    // NOTE: The subtarget (and its target lowering) is created on the first
+    // call, then it's reused by the functions with the same attributes.
+    target_machine.getSubtargetImpl(*fun);
+}
@@ -118,8 +118,19 @@ compile_lib__LilyIrLlvmAr(LilyLibrary *self)
 #error "unknown OS"
 #endif
 
-        // NOTE: Do not free `static_lib_output_path`
-        push__Vec(linker_args, static_lib_output_path);
+        // NOTE: The objects are linked instead of the static library, because
+        // the linker only extracts the members of an archive which resolve an
+        // undefined symbol.
+        push__Vec(linker_args, strdup(self->package->compiler.output_path));
+
+        {
+            Vec *objs = NEW(Vec); // Vec<char*>*
+
+            add_object_files__LilyCompilerIrLlvmUtils(self->package, objs);
+            append__Vec(linker_args, objs);
+
+            FREE(Vec, objs);
+        }
 
         // Link all lib dependencies
         {
@@ -162,6 +173,8 @@ compile_lib__LilyIrLlvmAr(LilyLibrary *self)
 
         FREE(Vec, linker_args);
 
+        lily_free(static_lib_output_path);
+
         self->output_path = dynamic_lib_output_path;
     } else {
         self->output_path = static_lib_output_path;
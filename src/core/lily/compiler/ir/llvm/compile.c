@@ -22,8 +22,8 @@
  * SOFTWARE.
  */
 
-#include <base/hash/sip.h>
-#include <base/platform.h>
+#include <base/alloc.h>
+#include <base/format.h>
 
 #include <core/lily/compiler/ir/llvm/compile.h>
 #include <core/lily/compiler/ir/llvm/dump.h>
@@ -35,43 +35,18 @@
 #include <llvm-c/Analysis.h>
 #include <llvm-c/Core.h>
 
-#ifdef LILY_WINDOWS_OS
-#define OBJ_EXT ".obj"
-#else
-#define OBJ_EXT ".o"
-#endif
+#include <stdio.h>
 
 void
 compile__LilyCompilerIrLlvm(LilyPackage *package)
 {
     ASSERT(package->kind == LILY_PACKAGE_KIND_COMPILER);
+    ASSERT(package->compiler.output_path);
 
-#ifdef PLATFORM_64
-    char *path = format("{s}{S}{zu}{zu}{s}",
-                        DIR_CACHE_OBJ,
-                        package->name,
-                        hash_sip(package->global_name->buffer,
-                                 package->global_name->len,
-                                 0x0123456789abcdefULL,
-                                 0xfedcba9876543210ULL),
-                        hash_sip(package->file.name,
-                                 strlen(package->file.name),
-                                 0x0123456789abcdefULL,
-                                 0xfedcba9876543210ULL),
-                        OBJ_EXT);
-#else
-    char *path = format("{s}{S}{zu}{zu}{s}",
-                        DIR_CACHE_OBJ,
-                        package->name,
-                        hash_sip(package->global_name->buffer,
-                                 package->global_name->len,
-                                 0x01234567,
-                                 0x89abcdef),
-                        hash_sip(package->file.name strlen(package->file.name),
-                                 0x01234567,
-                                 0x89abcdef),
-                        OBJ_EXT);
-#endif
+    // NOTE: The object is emitted in a temporary file, then renamed, so that an
+    // interrupted compilation never leaves a truncated object in the cache.
+    const char *path = package->compiler.output_path;
+    char *tmp_path = format("{s}.tmp", path);
 
     char *error_msg = NULL;
     enum LilyOptLevel lily_opt_level = LILY_OPT_LEVEL_O0;
@@ -118,7 +93,7 @@ compile__LilyCompilerIrLlvm(LilyPackage *package)
 
     if (LilyLLVMEmit(&package->compiler.ir.llvm,
                      &error_msg,
-                     path,
+                     tmp_path,
                      true,
                      false,
                      false,
@@ -128,11 +103,16 @@ compile__LilyCompilerIrLlvm(LilyPackage *package)
         exit(1);
     }
 
+    if (rename(tmp_path, path)) {
+        EMIT_ERROR("failed to write the object in the cache");
+        exit(1);
+    }
+
+    lily_free(tmp_path);
+
 #ifdef ENV_DEBUG
     printf("====Optimized LLVM IR(%s)====\n", package->global_name->buffer);
 
     dump__LilyIrLlvm(&package->compiler.ir.llvm);
 #endif
-
-    package->compiler.output_path = path;
 }
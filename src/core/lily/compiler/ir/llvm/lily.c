@@ -1649,21 +1649,24 @@ LilyLLVMGetType(const LilyIrLlvm *Self, const LilyMirDt *DT)
             ASSERT(ElementType);
 
             if (DT->array.len.is_undef) {
-                return LLVMStructType(
+                return LLVMStructTypeInContext(
+                  Self->context,
                   (LLVMTypeRef[]){ ptr__LilyIrLlvm(Self, ElementType),
                                    intptr__LilyIrLlvm(Self) },
                   2,
                   false);
             }
 
-            return LLVMStructType(
+            return LLVMStructTypeInContext(
+              Self->context,
               (LLVMTypeRef[]){ LLVMArrayType(ElementType, DT->array.len.len),
                                intptr__LilyIrLlvm(Self) },
               2,
               false);
         }
         case LILY_MIR_DT_KIND_BYTES:
-            return LLVMStructType(
+            return LLVMStructTypeInContext(
+              Self->context,
               (LLVMTypeRef[]){ ptr__LilyIrLlvm(Self, i8__LilyIrLlvm(Self)),
                                intptr__LilyIrLlvm(Self) },
               2,
@@ -1676,7 +1679,8 @@ LilyLLVMGetType(const LilyIrLlvm *Self, const LilyMirDt *DT)
 
             ASSERT(ok && err);
 
-            return LLVMStructType(
+            return LLVMStructTypeInContext(
+              Self->context,
               (LLVMTypeRef[]){ i8__LilyIrLlvm(Self), ok, err }, 3, false);
         }
         case LILY_MIR_DT_KIND_I1:
@@ -1717,7 +1721,8 @@ LilyLLVMGetType(const LilyIrLlvm *Self, const LilyMirDt *DT)
             return ptr__LilyIrLlvm(Self, ptr_type);
         }
         case LILY_MIR_DT_KIND_STR:
-            return LLVMStructType(
+            return LLVMStructTypeInContext(
+              Self->context,
               (LLVMTypeRef[]){ ptr__LilyIrLlvm(Self, i8__LilyIrLlvm(Self)),
                                intptr__LilyIrLlvm(Self) },
               2,
@@ -1734,7 +1739,8 @@ LilyLLVMGetType(const LilyIrLlvm *Self, const LilyMirDt *DT)
                 ElementTypes[i] = ElementType;
             }
 
-            return LLVMStructType(ElementTypes, DT->struct_->len, false);
+            return LLVMStructTypeInContext(
+              Self->context, ElementTypes, DT->struct_->len, false);
         }
         case LILY_MIR_DT_KIND_STRUCT_NAME: {
             LLVMTypeRef res =
@@ -1755,7 +1761,8 @@ LilyLLVMGetType(const LilyIrLlvm *Self, const LilyMirDt *DT)
 
             ASSERT(trace_type);
 
-            return LLVMStructType(
+            return LLVMStructTypeInContext(
+              Self->context,
               (LLVMTypeRef[]){ trace_type, intptr__LilyIrLlvm(Self) },
               2,
               false);
@@ -1772,7 +1779,8 @@ LilyLLVMGetType(const LilyIrLlvm *Self, const LilyMirDt *DT)
                 ElementTypes[i] = ElementType;
             }
 
-            return LLVMStructType(ElementTypes, DT->tuple->len, false);
+            return LLVMStructTypeInContext(
+              Self->context, ElementTypes, DT->tuple->len, false);
         }
         case LILY_MIR_DT_KIND_UNIT:
             return void__LilyIrLlvm(Self);
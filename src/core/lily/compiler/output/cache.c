@@ -22,9 +22,338 @@
  * SOFTWARE.
  */
 
+#include <base/assert.h>
 #include <base/dir.h>
+#include <base/format.h>
+#include <base/hash/sip.h>
+#include <base/new.h>
+
+#include <cli/version.h>
 
 #include <core/lily/compiler/output/cache.h>
+#include <core/lily/package/package.h>
+
+#include <pthread.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#if defined(LILY_APPLE_OS)
+#include <mach-o/dyld.h>
+#elif defined(LILY_WINDOWS_OS)
+#include <windows.h>
+#endif
+
+static Usize build_id = 0;
+static pthread_once_t build_id_once = PTHREAD_ONCE_INIT;
+
+/**
+ *
+ * @brief Initialize the build id of the compiler (see
+ * get_build_id__LilyCompilerOutputCache).
+ */
+static void
+init_build_id__LilyCompilerOutputCache();
+
+/**
+ *
+ * @brief Get the build id of the compiler, i.e. the hash of the path, the size
+ * and the modification time of its executable, so the objects of another build
+ * of the compiler with the same version are not reused. Like the default
+ * compiler check of ccache, the content of the executable is not hashed, to
+ * not read it on each build.
+ * @return Return 0 if the executable of the compiler is not found.
+ */
+static Usize
+get_build_id__LilyCompilerOutputCache();
+
+/**
+ *
+ * @brief Check if the tokens can raise an error, i.e. if they contain a call
+ * (whose raises are collected by the caller) or a macro expansion.
+ * @param tokens const Vec<LilyToken* (&)>*?
+ */
+static bool
+tokens_can_raise__LilyCompilerOutputCache(const Vec *tokens);
+
+/**
+ *
+ * @brief Check if the tokens of each item can raise an error.
+ * @param tokens_list const Vec<Vec<LilyToken* (&)>*?>*?
+ */
+static bool
+tokens_list_can_raise__LilyCompilerOutputCache(const Vec *tokens_list);
+
+/**
+ *
+ * @brief Check if the item of the body of a function can raise an error.
+ */
+static bool
+body_item_can_raise__LilyCompilerOutputCache(
+  const LilyPreparserFunBodyItem *item);
+
+/**
+ *
+ * @brief Check if one of the items of the body can raise an error.
+ * @param body const Vec<LilyPreparserFunBodyItem*>*?
+ */
+static bool
+body_can_raise__LilyCompilerOutputCache(const Vec *body);
+
+/**
+ *
+ * @brief Check if the body of the function is outside of the interface of the
+ * package, i.e. the dependents of the package don't depend on it.
+ * @note The body of a generic function is checked again in the dependents
+ * (for each instantiation), the return data type and the parameters without
+ * data type are inferred from the body, the comptime conditions can evaluate
+ * the body and the raises of the function (collected from its `raise`
+ * statements and from the functions it calls) are collected in its callers.
+ */
+static bool
+body_is_outside_interface__LilyCompilerOutputCache(const LilyPreparserFun *fun,
+                                                   const File *file);
+
+bool
+tokens_can_raise__LilyCompilerOutputCache(const Vec *tokens)
+{
+    if (!tokens) {
+        return false;
+    }
+
+    for (Usize i = 0; i < tokens->len; ++i) {
+        const LilyToken *token = get__Vec(tokens, i);
+
+        switch (token->kind) {
+            case LILY_TOKEN_KIND_IDENTIFIER_MACRO:
+            case LILY_TOKEN_KIND_KEYWORD_RAISE:
+                return true;
+            case LILY_TOKEN_KIND_L_PAREN:
+                if (i == 0) {
+                    break;
+                }
+
+                // NOTE: A parenthesis which follows a callee (e.g. `f(`,
+                // `f[T](`, `f()(`).
+                switch (CAST(LilyToken *, get__Vec(tokens, i - 1))->kind) {
+                    case LILY_TOKEN_KIND_IDENTIFIER_DOLLAR:
+                    case LILY_TOKEN_KIND_IDENTIFIER_NORMAL:
+                    case LILY_TOKEN_KIND_IDENTIFIER_STRING:
+                    case LILY_TOKEN_KIND_KEYWORD_self:
+                    case LILY_TOKEN_KIND_KEYWORD_SELF:
+                    case LILY_TOKEN_KIND_R_HOOK:
+                    case LILY_TOKEN_KIND_R_PAREN:
+                        return true;
+                    default:
+                        break;
+                }
+
+                break;
+            default:
+                break;
+        }
+    }
+
+    return false;
+}
+
+bool
+tokens_list_can_raise__LilyCompilerOutputCache(const Vec *tokens_list)
+{
+    if (!tokens_list) {
+        return false;
+    }
+
+    for (Usize i = 0; i < tokens_list->len; ++i) {
+        if (tokens_can_raise__LilyCompilerOutputCache(
+              get__Vec(tokens_list, i))) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool
+body_item_can_raise__LilyCompilerOutputCache(
+  const LilyPreparserFunBodyItem *item)
+{
+    switch (item->kind) {
+        case LILY_PREPARSER_FUN_BODY_ITEM_KIND_EXPRS:
+            return tokens_can_raise__LilyCompilerOutputCache(
+              item->exprs.tokens);
+        // NOTE: The body of a lambda and the expanded macro are not visited.
+        case LILY_PREPARSER_FUN_BODY_ITEM_KIND_LAMBDA:
+        case LILY_PREPARSER_FUN_BODY_ITEM_KIND_MACRO_EXPAND:
+        case LILY_PREPARSER_FUN_BODY_ITEM_KIND_STMT_RAISE:
+            return true;
+        case LILY_PREPARSER_FUN_BODY_ITEM_KIND_STMT_ASM:
+            return tokens_list_can_raise__LilyCompilerOutputCache(
+              item->stmt_asm.params);
+        case LILY_PREPARSER_FUN_BODY_ITEM_KIND_STMT_AWAIT:
+            return tokens_can_raise__LilyCompilerOutputCache(
+              item->stmt_await.expr);
+        case LILY_PREPARSER_FUN_BODY_ITEM_KIND_STMT_BLOCK:
+            return body_can_raise__LilyCompilerOutputCache(
+              item->stmt_block.block);
+        case LILY_PREPARSER_FUN_BODY_ITEM_KIND_STMT_BREAK:
+        case LILY_PREPARSER_FUN_BODY_ITEM_KIND_STMT_NEXT:
+            return false;
+        case LILY_PREPARSER_FUN_BODY_ITEM_KIND_STMT_DEFER:
+            return body_item_can_raise__LilyCompilerOutputCache(
+              item->stmt_defer.item);
+        case LILY_PREPARSER_FUN_BODY_ITEM_KIND_STMT_DROP:
+            return tokens_can_raise__LilyCompilerOutputCache(
+              item->stmt_drop.expr);
+        case LILY_PREPARSER_FUN_BODY_ITEM_KIND_STMT_FOR:
+            return tokens_can_raise__LilyCompilerOutputCache(
+                     item->stmt_for.expr) ||
+                   body_can_raise__LilyCompilerOutputCache(
+                     item->stmt_for.block);
+        case LILY_PREPARSER_FUN_BODY_ITEM_KIND_STMT_IF:
+            if (tokens_can_raise__LilyCompilerOutputCache(
+                  item->stmt_if.if_expr) ||
+                body_can_raise__LilyCompilerOutputCache(
+                  item->stmt_if.if_block) ||
+                tokens_list_can_raise__LilyCompilerOutputCache(
+                  item->stmt_if.elif_exprs) ||
+                body_can_raise__LilyCompilerOutputCache(
+                  item->stmt_if.else_block)) {
+                return true;
+            }
+
+            if (item->stmt_if.elif_blocks) {
+                for (Usize i = 0; i < item->stmt_if.elif_blocks->len; ++i) {
+                    if (body_can_raise__LilyCompilerOutputCache(
+                          get__Vec(item->stmt_if.elif_blocks, i))) {
+                        return true;
+                    }
+                }
+            }
+
+            return false;
+        case LILY_PREPARSER_FUN_BODY_ITEM_KIND_STMT_MATCH:
+            return tokens_can_raise__LilyCompilerOutputCache(
+                     item->stmt_match.expr) ||
+                   tokens_list_can_raise__LilyCompilerOutputCache(
+                     item->stmt_match.pattern_conds) ||
+                   body_can_raise__LilyCompilerOutputCache(
+                     item->stmt_match.blocks);
+        case LILY_PREPARSER_FUN_BODY_ITEM_KIND_STMT_RETURN:
+            return tokens_can_raise__LilyCompilerOutputCache(
+              item->stmt_return.expr);
+        case LILY_PREPARSER_FUN_BODY_ITEM_KIND_STMT_TRY:
+            return body_can_raise__LilyCompilerOutputCache(
+                     item->stmt_try.block) ||
+                   body_can_raise__LilyCompilerOutputCache(
+                     item->stmt_try.catch_block);
+        case LILY_PREPARSER_FUN_BODY_ITEM_KIND_STMT_UNSAFE:
+            return body_can_raise__LilyCompilerOutputCache(
+              item->stmt_unsafe.block);
+        case LILY_PREPARSER_FUN_BODY_ITEM_KIND_STMT_VARIABLE:
+            return tokens_can_raise__LilyCompilerOutputCache(
+              item->stmt_var.expr);
+        case LILY_PREPARSER_FUN_BODY_ITEM_KIND_STMT_WHILE:
+            return tokens_can_raise__LilyCompilerOutputCache(
+                     item->stmt_while.expr) ||
+                   body_can_raise__LilyCompilerOutputCache(
+                     item->stmt_while.block);
+        default:
+            UNREACHABLE("unknown variant");
+    }
+}
+
+bool
+body_can_raise__LilyCompilerOutputCache(const Vec *body)
+{
+    if (!body) {
+        return false;
+    }
+
+    for (Usize i = 0; i < body->len; ++i) {
+        if (body_item_can_raise__LilyCompilerOutputCache(get__Vec(body, i))) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool
+body_is_outside_interface__LilyCompilerOutputCache(const LilyPreparserFun *fun,
+                                                   const File *file)
+{
+    if ((fun->generic_params && fun->generic_params->len > 0) ||
+        !fun->return_data_type || fun->req_is_comptime ||
+        fun->when_is_comptime || fun->body->len == 0) {
+        return false;
+    }
+
+    if (fun->params) {
+        for (Usize i = 0; i < fun->params->len; ++i) {
+            // NOTE: The parameter has only a name.
+            if (CAST(Vec *, get__Vec(fun->params, i))->len < 2) {
+                return false;
+            }
+        }
+    }
+
+    const Location *first_location =
+      &CAST(LilyPreparserFunBodyItem *, get__Vec(fun->body, 0))->location;
+    const Location *last_location =
+      &CAST(LilyPreparserFunBodyItem *, last__Vec(fun->body))->location;
+
+    if (strcmp(first_location->filename, file->name) ||
+        last_location->end_position >= file->len) {
+        return false;
+    }
+
+    return !body_can_raise__LilyCompilerOutputCache(fun->body);
+}
+
+void
+init_build_id__LilyCompilerOutputCache()
+{
+    char path[4096];
+    bool path_is_found = false;
+
+#if defined(LILY_LINUX_OS)
+    strcpy(path, "/proc/self/exe");
+    path_is_found = true;
+#elif defined(LILY_FREE_BSD_OS) || defined(LILY_DRAGONFLY_OS)
+    strcpy(path, "/proc/curproc/file");
+    path_is_found = true;
+#elif defined(LILY_APPLE_OS)
+    Uint32 path_len = sizeof(path);
+
+    path_is_found = !_NSGetExecutablePath(path, &path_len);
+#elif defined(LILY_WINDOWS_OS)
+    DWORD path_len = GetModuleFileNameA(NULL, path, sizeof(path));
+
+    path_is_found = path_len > 0 && path_len < sizeof(path);
+#endif
+
+    struct stat path_stat;
+
+    if (!path_is_found || stat(path, &path_stat)) {
+        return;
+    }
+
+    Usize fields[] = {
+        hash_sip(path, strlen(path), SIP_K0, SIP_K1),
+        path_stat.st_size,
+        path_stat.st_mtime,
+    };
+
+    build_id = hash_sip(fields, sizeof(fields), SIP_K0, SIP_K1);
+}
+
+Usize
+get_build_id__LilyCompilerOutputCache()
+{
+    pthread_once(&build_id_once, &init_build_id__LilyCompilerOutputCache);
+
+    return build_id;
+}
 
 void
 create_cache__LilyCompilerOutputCache()
@@ -49,3 +378,106 @@ create_cache__LilyCompilerOutputCache()
                     DIR_MODE_RWXU | DIR_MODE_RWXG | DIR_MODE_RWXO);
     }
 }
+
+Usize
+get_key__LilyCompilerOutputCache(const LilyPackage *package)
+{
+    ASSERT(package->kind == LILY_PACKAGE_KIND_COMPILER);
+
+    const LilyPackageCompilerConfig *config = package->compiler.config;
+    Usize fields[] = {
+        hash_sip(package->file.content, package->file.len, SIP_K0, SIP_K1),
+        hash_sip(package->global_name->buffer,
+                 package->global_name->len,
+                 SIP_K0,
+                 SIP_K1),
+        hash_sip(VERSION, strlen(VERSION), SIP_K0, SIP_K1),
+        get_build_id__LilyCompilerOutputCache(),
+        package->status,
+        config->arch_target,
+        config->os_target,
+        config->o0 | config->o1 << 1 | config->o2 << 2 | config->o3 << 3 |
+          config->oz << 4,
+        // NOTE: The objects of a dynamic library are position-independent.
+        package->program->kind == LILY_PROGRAM_KIND_DYNAMIC_LIB,
+    };
+
+    return hash_sip(fields, sizeof(fields), SIP_K0, SIP_K1);
+}
+
+Usize
+get_interface_key__LilyCompilerOutputCache(const LilyPackage *package)
+{
+    ASSERT(package->kind == LILY_PACKAGE_KIND_COMPILER);
+
+    const File *file = &package->file;
+    const Vec *decls = package->preparser_info.decls;
+    char *interface = lily_malloc(file->len + 1);
+    Usize interface_len = 0;
+    Usize position = 0; // Position in the content of the file
+
+    // NOTE: Only the declarations at the top level of the package are
+    // visited, the bodies of the methods stay in the interface.
+    for (Usize i = 0; i < decls->len; ++i) {
+        const LilyPreparserDecl *decl = get__Vec(decls, i);
+
+        if (decl->kind != LILY_PREPARSER_DECL_KIND_FUN ||
+            !body_is_outside_interface__LilyCompilerOutputCache(&decl->fun,
+                                                                file)) {
+            continue;
+        }
+
+        Usize body_start =
+          CAST(LilyPreparserFunBodyItem *, get__Vec(decl->fun.body, 0))
+            ->location.start_position;
+        Usize body_end =
+          CAST(LilyPreparserFunBodyItem *, last__Vec(decl->fun.body))
+            ->location.end_position +
+          1;
+
+        if (body_start < position) {
+            continue;
+        }
+
+        memcpy(interface + interface_len,
+               file->content + position,
+               body_start - position);
+        interface_len += body_start - position;
+        position = body_end;
+    }
+
+    memcpy(interface + interface_len,
+           file->content + position,
+           file->len - position);
+    interface_len += file->len - position;
+
+    Usize fields[] = {
+        hash_sip(interface, interface_len, SIP_K0, SIP_K1),
+        hash_sip(package->global_name->buffer,
+                 package->global_name->len,
+                 SIP_K0,
+                 SIP_K1),
+    };
+
+    lily_free(interface);
+
+    return hash_sip(fields, sizeof(fields), SIP_K0, SIP_K1);
+}
+
+Usize
+add_dependency_key__LilyCompilerOutputCache(Usize key, Usize dependency_key)
+{
+    // NOTE: The sum makes the key independent of the order of the
+    // dependencies.
+    return key + hash_sip(&dependency_key, sizeof(Usize), SIP_K0, SIP_K1);
+}
+
+char *
+get_obj_path__LilyCompilerOutputCache(const LilyPackage *package, Usize key)
+{
+    return format("{s}{S}-{zu:x}{s}",
+                  DIR_CACHE_OBJ,
+                  package->name,
+                  key,
+                  DIR_CACHE_OBJ_EXT);
+}
@@ -0,0 +1,299 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2025 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/alloc.h>
+#include <base/file.h>
+#include <base/new.h>
+
+#include <core/lily/compiler/output/timings.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// NOTE: Increment this version if the format of the timings file is changed.
+#define LILY_COMPILER_OUTPUT_TIMINGS_VERSION 1
+
+/// @brief Parse the timings file (see LilyCompilerOutputTimings).
+/// @return false if the timings file is malformed.
+static bool
+parse__LilyCompilerOutputTimings(LilyCompilerOutputTimings *self,
+                                 const char *content);
+
+/// @brief Parse an unsigned integer followed by a space.
+/// @return false if the integer is malformed.
+static bool
+parse_uint__LilyCompilerOutputTimings(const char **content, Uint64 *res);
+
+/// @brief Calculate the average cost of a byte of source from the recorded
+/// timings.
+static void
+calculate_ns_per_byte__LilyCompilerOutputTimings(
+  LilyCompilerOutputTimings *self);
+
+CONSTRUCTOR(LilyCompilerOutputTimingsPackage *,
+            LilyCompilerOutputTimingsPackage,
+            String *global_name,
+            Usize size,
+            const Uint64 *durations)
+{
+    LilyCompilerOutputTimingsPackage *self =
+      lily_malloc(sizeof(LilyCompilerOutputTimingsPackage));
+
+    self->global_name = global_name;
+    self->size = size;
+
+    memcpy(self->durations, durations, sizeof(self->durations));
+
+    return self;
+}
+
+Uint64
+get_total__LilyCompilerOutputTimingsPackage(
+  const LilyCompilerOutputTimingsPackage *self)
+{
+    Uint64 total = 0;
+
+    for (Usize i = 0; i < LILY_COMPILER_OUTPUT_TIMINGS_PHASE_COUNT; ++i) {
+        total += self->durations[i];
+    }
+
+    return total;
+}
+
+DESTRUCTOR(LilyCompilerOutputTimingsPackage,
+           LilyCompilerOutputTimingsPackage *self)
+{
+    FREE(String, self->global_name);
+    lily_free(self);
+}
+
+bool
+parse_uint__LilyCompilerOutputTimings(const char **content, Uint64 *res)
+{
+    char *end = NULL;
+
+    *res = strtoull(*content, &end, 10);
+
+    if (end == *content || *end != ' ') {
+        return false;
+    }
+
+    *content = end + 1;
+
+    return true;
+}
+
+bool
+parse__LilyCompilerOutputTimings(LilyCompilerOutputTimings *self,
+                                 const char *content)
+{
+    char *end = NULL;
+    Uint64 version = strtoull(content, &end, 10);
+
+    if (version != LILY_COMPILER_OUTPUT_TIMINGS_VERSION || *end != '\n') {
+        return false;
+    }
+
+    content = end + 1;
+
+    while (*content) {
+        Uint64 size = 0;
+        Uint64 durations[LILY_COMPILER_OUTPUT_TIMINGS_PHASE_COUNT] = { 0 };
+
+        if (!parse_uint__LilyCompilerOutputTimings(&content, &size)) {
+            return false;
+        }
+
+        for (Usize i = 0; i < LILY_COMPILER_OUTPUT_TIMINGS_PHASE_COUNT; ++i) {
+            if (!parse_uint__LilyCompilerOutputTimings(&content,
+                                                       &durations[i])) {
+                return false;
+            }
+        }
+
+        const char *line_end = strchr(content, '\n');
+
+        if (!line_end || line_end == content) {
+            return false;
+        }
+
+        String *global_name = NEW(String);
+
+        for (; content != line_end; ++content) {
+            push__String(global_name, *content);
+        }
+
+        LilyCompilerOutputTimingsPackage *package = NEW(
+          LilyCompilerOutputTimingsPackage, global_name, size, durations);
+
+        if (insert__HashMap(
+              self->packages, package->global_name->buffer, package)) {
+            FREE(LilyCompilerOutputTimingsPackage, package);
+
+            return false;
+        }
+
+        ++content;
+    }
+
+    return true;
+}
+
+void
+calculate_ns_per_byte__LilyCompilerOutputTimings(
+  LilyCompilerOutputTimings *self)
+{
+    HashMapIter iter = NEW(HashMapIter, self->packages);
+    LilyCompilerOutputTimingsPackage *current = NULL;
+    Uint64 total = 0;
+    Uint64 size = 0;
+
+    while ((current = next__HashMapIter(&iter))) {
+        total += get_total__LilyCompilerOutputTimingsPackage(current);
+        size += current->size;
+    }
+
+    self->ns_per_byte = size > 0 && total > 0
+                          ? total / size
+                          : LILY_COMPILER_OUTPUT_TIMINGS_DEFAULT_NS_PER_BYTE;
+
+    if (self->ns_per_byte == 0) {
+        self->ns_per_byte = 1;
+    }
+}
+
+LilyCompilerOutputTimings
+load__LilyCompilerOutputTimings()
+{
+    LilyCompilerOutputTimings self = {
+        .packages = NEW(HashMap),
+        .ns_per_byte = LILY_COMPILER_OUTPUT_TIMINGS_DEFAULT_NS_PER_BYTE
+    };
+
+    if (!exists__File(LILY_COMPILER_OUTPUT_TIMINGS_PATH)) {
+        return self;
+    }
+
+    char *content = read_file__File(LILY_COMPILER_OUTPUT_TIMINGS_PATH);
+
+    // NOTE: The timings are only a hint for the scheduler, so if they are
+    // malformed, we just start from scratch.
+    if (!parse__LilyCompilerOutputTimings(&self, content)) {
+        FREE_HASHMAP_VALUES(self.packages, LilyCompilerOutputTimingsPackage);
+        FREE(HashMap, self.packages);
+
+        self.packages = NEW(HashMap);
+    }
+
+    lily_free(content);
+
+    calculate_ns_per_byte__LilyCompilerOutputTimings(&self);
+
+    return self;
+}
+
+Uint64
+estimate__LilyCompilerOutputTimings(const LilyCompilerOutputTimings *self,
+                                    const String *global_name,
+                                    Usize size)
+{
+    LilyCompilerOutputTimingsPackage *package =
+      get__HashMap(self->packages, global_name->buffer);
+
+    if (package && package->size > 0) {
+        // NOTE: The recorded duration is scaled according to the new size of
+        // the source.
+        return get_total__LilyCompilerOutputTimingsPackage(package) * size /
+               package->size;
+    }
+
+    return size * self->ns_per_byte;
+}
+
+void
+set__LilyCompilerOutputTimings(LilyCompilerOutputTimings *self,
+                               const String *global_name,
+                               Usize size,
+                               const Uint64 *durations)
+{
+    LilyCompilerOutputTimingsPackage *package =
+      get__HashMap(self->packages, global_name->buffer);
+
+    if (package) {
+        package->size = size;
+
+        memcpy(package->durations, durations, sizeof(package->durations));
+
+        return;
+    }
+
+    package = NEW(LilyCompilerOutputTimingsPackage,
+                  clone__String((String *)global_name),
+                  size,
+                  durations);
+
+    insert__HashMap(self->packages, package->global_name->buffer, package);
+}
+
+void
+save__LilyCompilerOutputTimings(const LilyCompilerOutputTimings *self)
+{
+    HashMapIter iter = NEW(HashMapIter, self->packages);
+    LilyCompilerOutputTimingsPackage *current = NULL;
+    String *content = NEW(String);
+    char buffer[32];
+
+    snprintf(buffer,
+             sizeof(buffer),
+             "%d\n",
+             LILY_COMPILER_OUTPUT_TIMINGS_VERSION);
+    push_str__String(content, buffer);
+
+    while ((current = next__HashMapIter(&iter))) {
+        snprintf(buffer, sizeof(buffer), "%zu ", (size_t)current->size);
+        push_str__String(content, buffer);
+
+        for (Usize i = 0; i < LILY_COMPILER_OUTPUT_TIMINGS_PHASE_COUNT; ++i) {
+            snprintf(
+              buffer, sizeof(buffer), "%" PRIu64 " ", current->durations[i]);
+            push_str__String(content, buffer);
+        }
+
+        push_str__String(content, current->global_name->buffer);
+        push__String(content, '\n');
+    }
+
+    write_file__File(
+      LILY_COMPILER_OUTPUT_TIMINGS_PATH, content->buffer, content->len);
+
+    FREE(String, content);
+}
+
+DESTRUCTOR(LilyCompilerOutputTimings, const LilyCompilerOutputTimings *self)
+{
+    FREE_HASHMAP_VALUES(self->packages, LilyCompilerOutputTimingsPackage);
+    FREE(HashMap, self->packages);
+}
@@ -34,19 +34,28 @@
 #include <core/lily/compiler/ir/llvm/generator.h>
 #include <core/lily/compiler/output/cache.h>
 #include <core/lily/compiler/output/obj.h>
+#include <core/lily/compiler/output/timings.h>
 #include <core/lily/lily.h>
 #include <core/lily/mir/generator.h>
 #include <core/lily/package/default_path.h>
 #include <core/lily/package/package.h>
+#include <core/lily/package/path_cache.h>
+#include <core/lily/package/scheduler.h>
 
 #include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
-// TODO: add support for Windows.
-static threadlocal pthread_t *package_threads;
-static pthread_mutex_t package_thread_mutex;
+// NOTE: The packages are analyzed, lowered to MIR and compiled in parallel. The
+// analysis of a package only writes its own checked declarations and scopes;
+// the structures it shares with the other analyses are locked on their own:
+// - the table of the interned data types (see data_type_table.h)
+// - the operator register and its cached resolutions (see operator_register.h)
+// - the resolutions of the scopes (see scope.h)
+// The default operators, the builtins and the syss are built at compile time,
+// and are only read.
 
 #define LOG_VERBOSE_SUCCESSFUL_COMPILATION(package)        \
     if (package->compiler.config->verbose) {               \
@@ -56,10 +65,39 @@ static pthread_mutex_t package_thread_mutex;
 /**
  *
  * @brief Run parser, analysis, mir, ir and compile output object (...).
- * @param self LilyCompilerThreadWrapper*
+ * @note This function is called by the scheduler, once all the dependencies of
+ * the package are done.
  */
-static void *
-run_threads__LilyCompilerPackage(void *self);
+static void
+run_package__LilyCompilerPackage(LilyPackageDependencyTree *tree);
+
+/**
+ *
+ * @brief Calculate the key of the object of each package, and look for the
+ * objects in the cache.
+ * @note The key of a package includes the keys of the interfaces of its
+ * dependencies, so a package is recompiled when the interface of one of its
+ * dependencies changes (the key of an interface also includes the keys of the
+ * interfaces of its own dependencies). A package whose
+ * object is in the cache still runs its parser and its analysis, if one of its
+ * dependents must be recompiled (the checked declarations can't be loaded from
+ * the cache).
+ */
+static void
+lookup_objs__LilyCompilerPackage(const LilyPackageScheduler *scheduler);
+
+/**
+ *
+ * @brief Estimate the cost of the package from the timings of the previous
+ * builds (or from the size of its source).
+ * @param timings const LilyCompilerOutputTimings* (&)
+ */
+static Uint64
+estimate_cost__LilyCompilerPackage(const LilyPackage *package, void *timings);
+
+/// @brief Get the current time (in nanoseconds).
+static Uint64
+get_time__LilyCompilerPackage();
 
 DESTRUCTOR(LilyCompilerAdapter, const LilyCompilerAdapter *self)
 {
@@ -97,13 +135,9 @@ build__LilyCompilerPackage(const LilyPackageCompilerConfig *config,
     self->compiler.config = config;
 
     LOG_VERBOSE(self, "running");
-    LOG_VERBOSE(self, "running scanner");
 
-    run__LilyScanner(&self->scanner, self->compiler.config->dump_scanner);
-
-    LOG_VERBOSE(self, "running preparser");
-
-    run__LilyPreparser(&self->preparser, &self->preparser_info);
+    run_scanner_and_preparser__LilyPackage(
+      self, self->compiler.config->dump_scanner);
 
 #ifdef RUN_UNTIL_PREPARSER
     FREE(LilyScanner, &self->scanner);
@@ -118,7 +152,7 @@ build__LilyCompilerPackage(const LilyPackageCompilerConfig *config,
 #endif
 
     SET_ROOT_PACKAGE_NAME(self);
-    COMPILER_SET_ROOT_PACKAGE_IR(self->compiler.config, self);
+    COMPILER_SET_ROOT_PACKAGE_IR(self->compiler.config, self, program);
     COMPILER_SET_ROOT_PACKAGE_PROGRAM(self, program, lib);
     COMPILER_SET_ROOT_PACKAGE_USE_SWITCH(self);
     LOAD_ROOT_PACKAGE_RESOURCES(self, program);
@@ -139,33 +173,49 @@ build__LilyCompilerPackage(const LilyPackageCompilerConfig *config,
     // Create `out.lily` cache
     create_cache__LilyCompilerOutputCache();
 
-    LOG_VERBOSE(self, "creation of threads");
-
-    package_threads =
-      lily_malloc(sizeof(pthread_t) * self->precompiler.dependency_trees->len);
+    LOG_VERBOSE(self, "running scheduler");
+
+    {
+        LilyCompilerOutputTimings timings = load__LilyCompilerOutputTimings();
+        LilyPackageScheduler scheduler =
+          NEW(LilyPackageScheduler,
+              self->precompiler.dependency_trees,
+              &run_package__LilyCompilerPackage);
+
+        lookup_objs__LilyCompilerPackage(&scheduler);
+        set_costs__LilyPackageScheduler(
+          &scheduler, &estimate_cost__LilyCompilerPackage, &timings);
+        run__LilyPackageScheduler(&scheduler);
+
+        for (Usize i = 0; i < scheduler.nodes->len; ++i) {
+            LilyPackage *package =
+              CAST(LilyPackageSchedulerNode *, get__Vec(scheduler.nodes, i))
+                ->tree->package;
+
+            // NOTE: The timings of a package which has skipped some phases
+            // would underestimate its next compilation.
+            if (package->compiler.obj_is_cached) {
+                continue;
+            }
+
+            set__LilyCompilerOutputTimings(&timings,
+                                           package->global_name,
+                                           package->file.len,
+                                           package->compiler.durations);
+        }
 
-    ASSERT(!pthread_mutex_init(&package_thread_mutex, NULL));
+        save__LilyCompilerOutputTimings(&timings);
 
-    for (Usize i = 0; i < self->precompiler.dependency_trees->len; ++i) {
-        ASSERT(
-          !pthread_create(&package_threads[i],
-                          NULL,
-                          &run_threads__LilyCompilerPackage,
-                          get__Vec(self->precompiler.dependency_trees, i)));
+        FREE(LilyPackageScheduler, &scheduler);
+        FREE(LilyCompilerOutputTimings, &timings);
     }
 
-    for (Usize i = 0; i < self->precompiler.dependency_trees->len; ++i) {
-        pthread_join(package_threads[i], NULL);
-    }
-
-    lily_free(package_threads);
-    pthread_mutex_destroy(&package_thread_mutex);
-
     return self;
 }
 
 LilyLibrary *
-build_lib__LilyCompilerPackage(const LilycConfig *config,
+build_lib__LilyCompilerPackage(const LilyPackageCompilerConfig *config,
+                               const char *filename,
                                enum LilyVisibility visibility,
                                enum LilyPackageStatus status,
                                const char *default_path,
@@ -174,12 +224,10 @@ build_lib__LilyCompilerPackage(const LilycConfig *config,
                                String *url,
                                String *path)
 {
-    LilyPackageCompilerConfig compiler_config =
-      from_CompileConfig__LilyPackageCompilerConfig(config);
     LilyLibrary *lib = NEW(LilyLibrary, version, url, path, NULL);
 
-    return build__LilyCompilerPackage(&compiler_config,
-                                      config->filename,
+    return build__LilyCompilerPackage(config,
+                                      filename,
                                       visibility,
                                       status,
                                       default_path,
@@ -188,76 +236,153 @@ build_lib__LilyCompilerPackage(const LilycConfig *config,
       ->compiler.lib;
 }
 
-static void *
-run_threads__LilyCompilerPackage(void *self)
+void
+lookup_objs__LilyCompilerPackage(const LilyPackageScheduler *scheduler)
 {
-    pthread_mutex_lock(&package_thread_mutex);
+    Vec *order = get_order__LilyPackageScheduler(scheduler);
+
+    // 1. Calculate the keys, from the start of the DAG (the key of a package is
+    // complete when all of its dependencies are visited).
+    for (Usize i = 0; i < order->len; ++i) {
+        LilyPackage *package =
+          CAST(LilyPackageSchedulerNode *, get__Vec(order, i))->tree->package;
+
+        package->compiler.obj_key = get_key__LilyCompilerOutputCache(package);
+        package->compiler.interface_key =
+          get_interface_key__LilyCompilerOutputCache(package);
+    }
 
-    LilyPackageDependencyTree *tree = self;
+    for (Usize i = 0; i < order->len; ++i) {
+        LilyPackageSchedulerNode *node = get__Vec(order, i);
+        LilyPackage *package = node->tree->package;
+        const LilyPackageCompilerConfig *config = package->compiler.config;
+
+        for (Usize j = 0; j < node->dependents->len; ++j) {
+            LilyPackage *dependent =
+              CAST(LilyPackageSchedulerNode *, get__Vec(node->dependents, j))
+                ->tree->package;
+
+            dependent->compiler.obj_key =
+              add_dependency_key__LilyCompilerOutputCache(
+                dependent->compiler.obj_key, package->compiler.interface_key);
+            dependent->compiler.interface_key =
+              add_dependency_key__LilyCompilerOutputCache(
+                dependent->compiler.interface_key,
+                package->compiler.interface_key);
+        }
 
-    if (tree->dependencies) {
-        for (Usize i = 0; i < tree->dependencies->len; ++i) {
-            LilyPackageDependencyTree *dep = get__Vec(tree->dependencies, i);
+        ASSERT(!package->compiler.output_path);
 
-            while (!dep->is_done)
-                ;
+        package->compiler.output_path = get_obj_path__LilyCompilerOutputCache(
+          package, package->compiler.obj_key);
+        // NOTE: The dumps need to run all the phases.
+        package->compiler.obj_is_cached =
+          !config->dump_parser && !config->dump_analysis &&
+          !config->dump_mir && !config->dump_ir &&
+          get_kind__LilyPackagePathCache(package->compiler.output_path) ==
+            LILY_PACKAGE_PATH_KIND_FILE;
+    }
+
+    // 2. Find the packages which need their parser and their analysis, from
+    // the end of the DAG.
+    for (Usize i = order->len; i-- > 0;) {
+        LilyPackageSchedulerNode *node = get__Vec(order, i);
+        LilyPackage *package = node->tree->package;
+        bool frontend_is_needed = !package->compiler.obj_is_cached;
+
+        for (Usize j = 0; j < node->dependents->len; ++j) {
+            frontend_is_needed |=
+              CAST(LilyPackageSchedulerNode *, get__Vec(node->dependents, j))
+                ->tree->package->compiler.frontend_is_needed;
         }
+
+        package->compiler.frontend_is_needed = frontend_is_needed;
+    }
+
+    FREE(Vec, order);
+}
+
+Uint64
+estimate_cost__LilyCompilerPackage(const LilyPackage *package, void *timings)
+{
+    if (!package->compiler.frontend_is_needed) {
+        return 0;
+    }
+
+    return estimate__LilyCompilerOutputTimings(
+      timings, package->global_name, package->file.len);
+}
+
+Uint64
+get_time__LilyCompilerPackage()
+{
+    struct timespec ts;
+
+    timespec_get(&ts, TIME_UTC);
+
+    return (Uint64)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void
+run_package__LilyCompilerPackage(LilyPackageDependencyTree *tree)
+{
+    Uint64 *durations = tree->package->compiler.durations;
+    Uint64 start = get_time__LilyCompilerPackage();
+    Uint64 end = 0;
+
+    if (!tree->package->compiler.frontend_is_needed) {
+        LOG_VERBOSE(tree->package, "object is up to date");
+
+        return;
     }
 
     LOG_VERBOSE(tree->package, "running parser");
 
     run__LilyParser(&tree->package->parser, false);
+    release_tokens__LilyPackage(tree->package);
+
+    end = get_time__LilyCompilerPackage();
+    durations[LILY_COMPILER_OUTPUT_TIMINGS_PHASE_PARSER] = end - start;
+    start = end;
 
     LOG_VERBOSE(tree->package, "running analysis");
 
     run__LilyAnalysis(&tree->package->analysis);
 
+    end = get_time__LilyCompilerPackage();
+    durations[LILY_COMPILER_OUTPUT_TIMINGS_PHASE_ANALYSIS] = end - start;
+    start = end;
+
+    if (tree->package->compiler.obj_is_cached) {
+        LOG_VERBOSE(tree->package, "object is up to date");
+
+        return;
+    }
+
     LOG_VERBOSE(tree->package, "running mir");
 
     run__LilyMir(tree->package);
 
+    end = get_time__LilyCompilerPackage();
+    durations[LILY_COMPILER_OUTPUT_TIMINGS_PHASE_MIR] = end - start;
+    start = end;
+
     LOG_VERBOSE(tree->package, "running ir");
 
     run__LilyIr(tree->package);
 
+    end = get_time__LilyCompilerPackage();
+    durations[LILY_COMPILER_OUTPUT_TIMINGS_PHASE_IR] = end - start;
+    start = end;
+
     LOG_VERBOSE(tree->package, "running compile output object");
 
     compile__LilyCompilerOutputObj(tree, &compile__LilyCompilerIrLlvm);
 
-    LOG_VERBOSE(tree->package, "running package done");
-
-    tree->is_done = true;
-
-    pthread_mutex_unlock(&package_thread_mutex);
-
-    // Run children of the tree
-    if (tree->children->len > 0) {
-        LOG_VERBOSE(tree->package, "running children package");
+    durations[LILY_COMPILER_OUTPUT_TIMINGS_PHASE_OBJ] =
+      get_time__LilyCompilerPackage() - start;
 
-        package_threads = lily_malloc(sizeof(pthread_t) * tree->children->len);
-        pthread_mutex_t children_thread_lock;
-
-        ASSERT(!pthread_mutex_init(&children_thread_lock, NULL));
-        pthread_mutex_lock(&children_thread_lock);
-
-        for (Usize i = 0; i < tree->children->len; ++i) {
-            ASSERT(!pthread_create(&package_threads[i],
-                                   NULL,
-                                   &run_threads__LilyCompilerPackage,
-                                   get__Vec(tree->children, i)));
-        }
-
-        for (Usize i = 0; i < tree->children->len; ++i) {
-            pthread_join(package_threads[i], NULL);
-        }
-
-        pthread_mutex_unlock(&children_thread_lock);
-
-        lily_free(package_threads);
-        pthread_mutex_destroy(&children_thread_lock);
-    }
-
-    return NULL;
+    LOG_VERBOSE(tree->package, "running package done");
 }
 
 LilyPackage *
@@ -295,8 +420,19 @@ compile_lib__LilyCompilerPackage(const LilycConfig *config,
                                  const char *default_path,
                                  const LilyProgram *program)
 {
-    LilyLibrary *lib = build_lib__LilyCompilerPackage(
-      config, visibility, status, default_path, program, NULL, NULL, NULL);
+    // NOTE: The config must outlive the build, because the archive of the
+    // library is written by `compile_lib__LilyLinker`.
+    LilyPackageCompilerConfig compiler_config =
+      from_CompileConfig__LilyPackageCompilerConfig(config);
+    LilyLibrary *lib = build_lib__LilyCompilerPackage(&compiler_config,
+                                                      config->filename,
+                                                      visibility,
+                                                      status,
+                                                      default_path,
+                                                      program,
+                                                      NULL,
+                                                      NULL,
+                                                      NULL);
 
     ASSERT(lib->package->status == LILY_PACKAGE_STATUS_LIB_MAIN &&
            lib->package->is_lib);
@@ -336,7 +472,7 @@ run_preparser__LilyCompilerPackage(const LilycConfig *config)
     LilyScanner scanner = NEW(
       LilyScanner, NEW(Source, NEW(Cursor, file.content), &file), &count_error);
     LilyPreparser preparser =
-      NEW(LilyPreparser, &file, scanner.tokens, NULL, true);
+      NEW(LilyPreparser, &file, &scanner.tokens, NULL, true);
     LilyPreparserInfo preparser_info = NEW(LilyPreparserInfo, NULL);
 
     run__LilyScanner(&scanner, config->dump_scanner);
@@ -387,7 +523,7 @@ run_precompiler__LilyCompilerPackage(const LilycConfig *config)
     run__LilyPreparser(&self->preparser, &self->preparser_info);
 
     SET_ROOT_PACKAGE_NAME(self);
-    COMPILER_SET_ROOT_PACKAGE_IR(self->compiler.config, self);
+    COMPILER_SET_ROOT_PACKAGE_IR(self->compiler.config, self, (&program));
     COMPILER_SET_ROOT_PACKAGE_PROGRAM(self, (&program), lib);
     LOAD_ROOT_PACKAGE_RESOURCES(self, (&program));
 
@@ -28,358 +28,204 @@
 
 #include <string.h>
 
-LilyBuiltinFun *
-load_builtins__LilyBuiltin()
-{
-    LilyBuiltinFun *builtins =
-      lily_malloc(sizeof(LilyBuiltinFun) * BUILTINS_COUNT);
-
-    builtins[0] = (LilyBuiltinFun){
-        .name = "max",
-        .real_name = from__String("__max__$Int8"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT8, NULL),
-        .params = init__Vec(
-          2,
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT8, NULL),
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT8, NULL))
-    };
-
-    builtins[1] = (LilyBuiltinFun){
-        .name = "max",
-        .real_name = from__String("__max__$Int16"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT16, NULL),
-        .params = init__Vec(
-          2,
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT16, NULL),
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT16, NULL))
-    };
-
-    builtins[2] = (LilyBuiltinFun){
-        .name = "max",
-        .real_name = from__String("__max__$Int32"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT32, NULL),
-        .params = init__Vec(
-          2,
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT32, NULL),
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT32, NULL))
-    };
-
-    builtins[3] = (LilyBuiltinFun){
-        .name = "max",
-        .real_name = from__String("__max__$Int64"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT64, NULL),
-        .params = init__Vec(
-          2,
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT64, NULL),
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT64, NULL))
-    };
-
-    builtins[4] = (LilyBuiltinFun){
-        .name = "max",
-        .real_name = from__String("__max__$Isize"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ISIZE, NULL),
-        .params = init__Vec(
-          2,
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ISIZE, NULL),
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ISIZE, NULL))
-    };
-
-    builtins[5] = (LilyBuiltinFun){
-        .name = "max",
-        .real_name = from__String("__max__$Uint8"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT8, NULL),
-        .params = init__Vec(
-          2,
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT8, NULL),
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT8, NULL))
-    };
-
-    builtins[6] = (LilyBuiltinFun){
-        .name = "max",
-        .real_name = from__String("__max__$Uint16"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT16, NULL),
-        .params = init__Vec(
-          2,
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT16, NULL),
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT16, NULL))
-    };
-
-    builtins[7] = (LilyBuiltinFun){
-        .name = "max",
-        .real_name = from__String("__max__$Uint32"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT32, NULL),
-        .params = init__Vec(
-          2,
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT32, NULL),
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT32, NULL))
-    };
-
-    builtins[8] = (LilyBuiltinFun){
-        .name = "max",
-        .real_name = from__String("__max__$Uint64"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT64, NULL),
-        .params = init__Vec(
-          2,
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT64, NULL),
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT64, NULL))
-    };
-
-    builtins[9] = (LilyBuiltinFun){
-        .name = "max",
-        .real_name = from__String("__max__$Usize"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_USIZE, NULL),
-        .params = init__Vec(
-          2,
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_USIZE, NULL),
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_USIZE, NULL))
-    };
-
-    builtins[10] = (LilyBuiltinFun){
-        .name = "max",
-        .real_name = from__String("__max__$Float32"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_FLOAT32, NULL),
-        .params = init__Vec(
-          2,
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_FLOAT32, NULL),
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_FLOAT32, NULL))
-    };
-
-    builtins[11] = (LilyBuiltinFun){
-        .name = "max",
-        .real_name = from__String("__max__$Float64"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_FLOAT64, NULL),
-        .params = init__Vec(
-          2,
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_FLOAT64, NULL),
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_FLOAT64, NULL))
-    };
-
-    builtins[12] = (LilyBuiltinFun){
-        .name = "min",
-        .real_name = from__String("__min__$Int8"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT8, NULL),
-        .params = init__Vec(
-          2,
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT8, NULL),
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT8, NULL))
-    };
-
-    builtins[13] = (LilyBuiltinFun){
-        .name = "min",
-        .real_name = from__String("__min__$Int16"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT16, NULL),
-        .params = init__Vec(
-          2,
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT16, NULL),
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT16, NULL))
-    };
-
-    builtins[14] = (LilyBuiltinFun){
-        .name = "min",
-        .real_name = from__String("__min__$Int32"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT32, NULL),
-        .params = init__Vec(
-          2,
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT32, NULL),
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT32, NULL))
-    };
-
-    builtins[15] = (LilyBuiltinFun){
-        .name = "min",
-        .real_name = from__String("__min__$Int64"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT64, NULL),
-        .params = init__Vec(
-          2,
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT64, NULL),
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT64, NULL))
-    };
+#define PRIMITIVE(k) LILY_CHECKED_PRIMITIVE_DATA_TYPE(k)
 
-    builtins[16] = (LilyBuiltinFun){
-        .name = "min",
-        .real_name = from__String("__min__$Isize"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ISIZE, NULL),
-        .params = init__Vec(
-          2,
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ISIZE, NULL),
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ISIZE, NULL))
-    };
-
-    builtins[17] = (LilyBuiltinFun){
-        .name = "min",
-        .real_name = from__String("__min__$Uint8"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT8, NULL),
-        .params = init__Vec(
-          2,
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT8, NULL),
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT8, NULL))
-    };
-
-    builtins[18] = (LilyBuiltinFun){
-        .name = "min",
-        .real_name = from__String("__min__$Uint16"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT16, NULL),
-        .params = init__Vec(
-          2,
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT16, NULL),
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT16, NULL))
-    };
-
-    builtins[19] = (LilyBuiltinFun){
-        .name = "min",
-        .real_name = from__String("__min__$Uint32"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT32, NULL),
-        .params = init__Vec(
-          2,
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT32, NULL),
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT32, NULL))
-    };
-
-    builtins[20] = (LilyBuiltinFun){
-        .name = "min",
-        .real_name = from__String("__min__$Uint64"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT64, NULL),
-        .params = init__Vec(
-          2,
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT64, NULL),
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT64, NULL))
-    };
-
-    builtins[21] = (LilyBuiltinFun){
-        .name = "min",
-        .real_name = from__String("__min__$Usize"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_USIZE, NULL),
-        .params = init__Vec(
-          2,
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_USIZE, NULL),
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_USIZE, NULL))
-    };
-
-    builtins[22] = (LilyBuiltinFun){
-        .name = "min",
-        .real_name = from__String("__min__$Float32"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_FLOAT32, NULL),
-        .params = init__Vec(
-          2,
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_FLOAT32, NULL),
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_FLOAT32, NULL))
-    };
-
-    builtins[23] = (LilyBuiltinFun){
-        .name = "min",
-        .real_name = from__String("__min__$Float64"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_FLOAT64, NULL),
-        .params = init__Vec(
-          2,
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_FLOAT64, NULL),
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_FLOAT64, NULL))
-    };
-
-    builtins[24] = (LilyBuiltinFun){
-        .name = "len",
-        .real_name = from__String("__len__$CStr"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_USIZE, NULL),
-        .params = init__Vec(
-          1, NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CSTR, NULL))
-    };
-
-    builtins[25] = (LilyBuiltinFun){
-        .name = "align",
-        .real_name = from__String("__align__$Alloc"),
-        .return_data_type = NEW_VARIANT(
-          LilyCheckedDataType,
-          ptr,
-          NULL,
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ANY, NULL)),
-        .params = init__Vec(
-          2,
-          NEW_VARIANT(
-            LilyCheckedDataType,
-            ptr,
-            NULL,
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ANY, NULL)),
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_USIZE, NULL))
-    };
-
-    builtins[26] = (LilyBuiltinFun){
-        .name = "alloc",
-        .real_name = from__String("__alloc__$Alloc"),
-        .return_data_type = NEW_VARIANT(
-          LilyCheckedDataType,
-          ptr,
-          NULL,
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ANY, NULL)),
-        .params = init__Vec(
-          2,
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_USIZE, NULL),
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_USIZE, NULL))
-    };
-
-    builtins[27] = (LilyBuiltinFun){
-        .name = "resize",
-        .real_name = from__String("__resize__$Alloc"),
-        .return_data_type = NEW_VARIANT(
-          LilyCheckedDataType,
-          ptr,
-          NULL,
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ANY, NULL)),
-        .params = init__Vec(
-          4,
-          NEW_VARIANT(
-            LilyCheckedDataType,
-            ptr,
-            NULL,
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ANY, NULL)),
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_USIZE, NULL),
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_USIZE, NULL),
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_USIZE, NULL))
-    };
+#define BUILTIN(n, rn, rt, params_len, ...)                                   \
+    {                                                                         \
+        .name = n, .real_name = &STRING_FROM_RAW(rn), .return_data_type = rt, \
+        .params = &VEC_FROM_RAW(params_len, __VA_ARGS__)                      \
+    }
 
-    builtins[28] = (LilyBuiltinFun){
-        .name = "free",
-        .real_name = from__String("__free__$Alloc"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UNIT, NULL),
-        .params = init__Vec(
-          3,
-          NEW_VARIANT(
-            LilyCheckedDataType,
-            ptr,
-            NULL,
-            NEW_VARIANT(
-              LilyCheckedDataType,
-              ptr,
-              NULL,
-              NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ANY, NULL))),
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_USIZE, NULL),
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_USIZE, NULL))
-    };
+static LilyCheckedDataType ptr_any =
+  LILY_CHECKED_STATIC_DATA_TYPE(PTR, ptr, PRIMITIVE(ANY));
+static LilyCheckedDataType ptr_ptr_any =
+  LILY_CHECKED_STATIC_DATA_TYPE(PTR, ptr, &ptr_any);
+
+// NOTE: The builtins are built at compile time, so they're shared by all the
+// programs, and they're never freed. The index of a builtin is given by its
+// `builtin__*` macro (see `include/core/lily/functions/builtin.h`).
+static LilyBuiltinFun lily_builtins[] = {
+    BUILTIN("max",
+            "__max__$Int8",
+            PRIMITIVE(INT8),
+            2,
+            PRIMITIVE(INT8),
+            PRIMITIVE(INT8)),
+    BUILTIN("max",
+            "__max__$Int16",
+            PRIMITIVE(INT16),
+            2,
+            PRIMITIVE(INT16),
+            PRIMITIVE(INT16)),
+    BUILTIN("max",
+            "__max__$Int32",
+            PRIMITIVE(INT32),
+            2,
+            PRIMITIVE(INT32),
+            PRIMITIVE(INT32)),
+    BUILTIN("max",
+            "__max__$Int64",
+            PRIMITIVE(INT64),
+            2,
+            PRIMITIVE(INT64),
+            PRIMITIVE(INT64)),
+    BUILTIN("max",
+            "__max__$Isize",
+            PRIMITIVE(ISIZE),
+            2,
+            PRIMITIVE(ISIZE),
+            PRIMITIVE(ISIZE)),
+    BUILTIN("max",
+            "__max__$Uint8",
+            PRIMITIVE(UINT8),
+            2,
+            PRIMITIVE(UINT8),
+            PRIMITIVE(UINT8)),
+    BUILTIN("max",
+            "__max__$Uint16",
+            PRIMITIVE(UINT16),
+            2,
+            PRIMITIVE(UINT16),
+            PRIMITIVE(UINT16)),
+    BUILTIN("max",
+            "__max__$Uint32",
+            PRIMITIVE(UINT32),
+            2,
+            PRIMITIVE(UINT32),
+            PRIMITIVE(UINT32)),
+    BUILTIN("max",
+            "__max__$Uint64",
+            PRIMITIVE(UINT64),
+            2,
+            PRIMITIVE(UINT64),
+            PRIMITIVE(UINT64)),
+    BUILTIN("max",
+            "__max__$Usize",
+            PRIMITIVE(USIZE),
+            2,
+            PRIMITIVE(USIZE),
+            PRIMITIVE(USIZE)),
+    BUILTIN("max",
+            "__max__$Float32",
+            PRIMITIVE(FLOAT32),
+            2,
+            PRIMITIVE(FLOAT32),
+            PRIMITIVE(FLOAT32)),
+    BUILTIN("max",
+            "__max__$Float64",
+            PRIMITIVE(FLOAT64),
+            2,
+            PRIMITIVE(FLOAT64),
+            PRIMITIVE(FLOAT64)),
+    BUILTIN("min",
+            "__min__$Int8",
+            PRIMITIVE(INT8),
+            2,
+            PRIMITIVE(INT8),
+            PRIMITIVE(INT8)),
+    BUILTIN("min",
+            "__min__$Int16",
+            PRIMITIVE(INT16),
+            2,
+            PRIMITIVE(INT16),
+            PRIMITIVE(INT16)),
+    BUILTIN("min",
+            "__min__$Int32",
+            PRIMITIVE(INT32),
+            2,
+            PRIMITIVE(INT32),
+            PRIMITIVE(INT32)),
+    BUILTIN("min",
+            "__min__$Int64",
+            PRIMITIVE(INT64),
+            2,
+            PRIMITIVE(INT64),
+            PRIMITIVE(INT64)),
+    BUILTIN("min",
+            "__min__$Isize",
+            PRIMITIVE(ISIZE),
+            2,
+            PRIMITIVE(ISIZE),
+            PRIMITIVE(ISIZE)),
+    BUILTIN("min",
+            "__min__$Uint8",
+            PRIMITIVE(UINT8),
+            2,
+            PRIMITIVE(UINT8),
+            PRIMITIVE(UINT8)),
+    BUILTIN("min",
+            "__min__$Uint16",
+            PRIMITIVE(UINT16),
+            2,
+            PRIMITIVE(UINT16),
+            PRIMITIVE(UINT16)),
+    BUILTIN("min",
+            "__min__$Uint32",
+            PRIMITIVE(UINT32),
+            2,
+            PRIMITIVE(UINT32),
+            PRIMITIVE(UINT32)),
+    BUILTIN("min",
+            "__min__$Uint64",
+            PRIMITIVE(UINT64),
+            2,
+            PRIMITIVE(UINT64),
+            PRIMITIVE(UINT64)),
+    BUILTIN("min",
+            "__min__$Usize",
+            PRIMITIVE(USIZE),
+            2,
+            PRIMITIVE(USIZE),
+            PRIMITIVE(USIZE)),
+    BUILTIN("min",
+            "__min__$Float32",
+            PRIMITIVE(FLOAT32),
+            2,
+            PRIMITIVE(FLOAT32),
+            PRIMITIVE(FLOAT32)),
+    BUILTIN("min",
+            "__min__$Float64",
+            PRIMITIVE(FLOAT64),
+            2,
+            PRIMITIVE(FLOAT64),
+            PRIMITIVE(FLOAT64)),
+    BUILTIN("len", "__len__$CStr", PRIMITIVE(USIZE), 1, PRIMITIVE(CSTR)),
+    BUILTIN("align",
+            "__align__$Alloc",
+            &ptr_any,
+            2,
+            &ptr_any,
+            PRIMITIVE(USIZE)),
+    BUILTIN("alloc",
+            "__alloc__$Alloc",
+            &ptr_any,
+            2,
+            PRIMITIVE(USIZE),
+            PRIMITIVE(USIZE)),
+    BUILTIN("resize",
+            "__resize__$Alloc",
+            &ptr_any,
+            4,
+            &ptr_any,
+            PRIMITIVE(USIZE),
+            PRIMITIVE(USIZE),
+            PRIMITIVE(USIZE)),
+    BUILTIN("free",
+            "__free__$Alloc",
+            PRIMITIVE(UNIT),
+            3,
+            &ptr_ptr_any,
+            PRIMITIVE(USIZE),
+            PRIMITIVE(USIZE))
+};
+
+static_assert(sizeof(lily_builtins) / sizeof(*lily_builtins) == BUILTINS_COUNT,
+              "BUILTINS_COUNT is out of date");
 
-    return builtins;
+LilyBuiltinFun *
+get_builtins__LilyBuiltin()
+{
+    return lily_builtins;
 }
 
 bool
@@ -467,12 +313,3 @@ IMPL_FOR_DEBUG(to_string, LilyBuiltinFun, const LilyBuiltinFun *self)
     return res;
 }
 #endif
-
-DESTRUCTOR(LilyBuiltinFun, const LilyBuiltinFun *self)
-{
-    FREE(String, self->real_name);
-    FREE(LilyCheckedDataType, self->return_data_type);
-    FREE_BUFFER_ITEMS(
-      self->params->buffer, self->params->len, LilyCheckedDataType);
-    FREE(Vec, self->params);
-}
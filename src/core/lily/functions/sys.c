@@ -30,151 +30,77 @@
 #include <stdlib.h>
 #include <string.h>
 
+#define PRIMITIVE(k) LILY_CHECKED_PRIMITIVE_DATA_TYPE(k)
+
+#define SYS(n, rn, rt, params_len, ...)                                       \
+    {                                                                         \
+        .name = n, .real_name = &STRING_FROM_RAW(rn), .return_data_type = rt, \
+        .params = &VEC_FROM_RAW(params_len, __VA_ARGS__)                      \
+    }
+
+static LilyCheckedDataType ptr_any =
+  LILY_CHECKED_STATIC_DATA_TYPE(PTR, ptr, PRIMITIVE(ANY));
+
+// NOTE: The sys functions are built at compile time, so they're shared by all
+// the programs, and they're never freed.
+static LilySysFun lily_syss[] = {
+    SYS("read",
+        "__sys__$read",
+        PRIMITIVE(USIZE),
+        3,
+        PRIMITIVE(INT32),
+        &ptr_any,
+        PRIMITIVE(USIZE)),
+    SYS("write",
+        "__sys__$write",
+        PRIMITIVE(USIZE),
+        3,
+        PRIMITIVE(INT32),
+        PRIMITIVE(CSTR),
+        PRIMITIVE(USIZE)),
+    SYS("open",
+        "__sys__$open",
+        PRIMITIVE(INT32),
+        3,
+        PRIMITIVE(CSTR),
+        PRIMITIVE(INT32),
+        PRIMITIVE(INT32)),
+    SYS("close", "__sys__$close", PRIMITIVE(INT32), 1, PRIMITIVE(INT32)),
+    SYS("stat_mode", "__sys__$stat_mode", PRIMITIVE(INT32), 1, PRIMITIVE(CSTR)),
+    SYS("stat_ino", "__sys__$stat_ino", PRIMITIVE(UINT32), 1, PRIMITIVE(CSTR)),
+    SYS("stat_dev", "__sys__$stat_dev", PRIMITIVE(UINT32), 1, PRIMITIVE(CSTR)),
+    SYS("stat_nlink",
+        "__sys__$stat_nlink",
+        PRIMITIVE(UINT32),
+        1,
+        PRIMITIVE(CSTR)),
+    SYS("stat_uid", "__sys__$stat_uid", PRIMITIVE(UINT64), 1, PRIMITIVE(CSTR)),
+    SYS("stat_gid", "__sys__$stat_gid", PRIMITIVE(UINT64), 1, PRIMITIVE(CSTR)),
+    SYS("stat_size", "__sys__$stat_size", PRIMITIVE(INT32), 1, PRIMITIVE(CSTR)),
+    SYS("stat_atime",
+        "__sys__$stat_atime",
+        PRIMITIVE(INT32),
+        1,
+        PRIMITIVE(CSTR)),
+    SYS("stat_mtime",
+        "__sys__$stat_mtime",
+        PRIMITIVE(INT32),
+        1,
+        PRIMITIVE(CSTR)),
+    SYS("stat_ctime",
+        "__sys__$stat_ctime",
+        PRIMITIVE(INT32),
+        1,
+        PRIMITIVE(CSTR))
+};
+
+static_assert(sizeof(lily_syss) / sizeof(*lily_syss) == SYSS_COUNT,
+              "SYSS_COUNT is out of date");
+
 LilySysFun *
-load_syss__LilySys()
+get_syss__LilySys()
 {
-    LilySysFun *syss = lily_malloc(sizeof(LilySysFun) * SYSS_COUNT);
-
-    syss[0] = (LilySysFun){
-        .name = "read",
-        .real_name = from__String("__sys__$read"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_USIZE, NULL),
-        .params = init__Vec(
-          3,
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT32, NULL),
-          NEW_VARIANT(
-            LilyCheckedDataType,
-            ptr,
-            NULL,
-            NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_ANY, NULL)),
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_USIZE, NULL)),
-    };
-
-    syss[1] = (LilySysFun){
-        .name = "write",
-        .real_name = from__String("__sys__$write"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_USIZE, NULL),
-        .params = init__Vec(
-          3,
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT32, NULL),
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CSTR, NULL),
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_USIZE, NULL))
-    };
-
-    syss[2] = (LilySysFun){
-        .name = "open",
-        .real_name = from__String("__sys__$open"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT32, NULL),
-        .params = init__Vec(
-          3,
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CSTR, NULL),
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT32, NULL),
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT32, NULL))
-    };
-
-    syss[3] = (LilySysFun){
-        .name = "close",
-        .real_name = from__String("__sys__$close"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT32, NULL),
-        .params = init__Vec(
-          1, NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT32, NULL))
-    };
-
-    syss[4] = (LilySysFun){
-        .name = "stat_mode",
-        .real_name = from__String("__sys__$stat_mode"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT32, NULL),
-        .params = init__Vec(
-          1, NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CSTR, NULL))
-    };
-
-    syss[5] = (LilySysFun){
-        .name = "stat_ino",
-        .real_name = from__String("__sys__$stat_ino"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT32, NULL),
-        .params = init__Vec(
-          1, NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CSTR, NULL))
-    };
-
-    syss[6] = (LilySysFun){
-        .name = "stat_dev",
-        .real_name = from__String("__sys__$stat_dev"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT32, NULL),
-        .params = init__Vec(
-          1, NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CSTR, NULL))
-    };
-
-    syss[7] = (LilySysFun){
-        .name = "stat_nlink",
-        .real_name = from__String("__sys__$stat_nlink"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT32, NULL),
-        .params = init__Vec(
-          1, NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CSTR, NULL))
-    };
-
-    syss[8] = (LilySysFun){
-        .name = "stat_uid",
-        .real_name = from__String("__sys__$stat_uid"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT64, NULL),
-        .params = init__Vec(
-          1, NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CSTR, NULL))
-    };
-
-    syss[9] = (LilySysFun){
-        .name = "stat_gid",
-        .real_name = from__String("__sys__$stat_gid"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_UINT64, NULL),
-        .params = init__Vec(
-          1, NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CSTR, NULL))
-    };
-
-    syss[10] = (LilySysFun){
-        .name = "stat_size",
-        .real_name = from__String("__sys__$stat_size"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT32, NULL),
-        .params = init__Vec(
-          1, NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CSTR, NULL))
-    };
-
-    syss[11] = (LilySysFun){
-        .name = "stat_atime",
-        .real_name = from__String("__sys__$stat_atime"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT32, NULL),
-        .params = init__Vec(
-          1, NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CSTR, NULL))
-    };
-
-    syss[12] = (LilySysFun){
-        .name = "stat_mtime",
-        .real_name = from__String("__sys__$stat_mtime"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT32, NULL),
-        .params = init__Vec(
-          1, NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CSTR, NULL))
-    };
-
-    syss[13] = (LilySysFun){
-        .name = "stat_ctime",
-        .real_name = from__String("__sys__$stat_ctime"),
-        .return_data_type =
-          NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_INT32, NULL),
-        .params = init__Vec(
-          1, NEW(LilyCheckedDataType, LILY_CHECKED_DATA_TYPE_KIND_CSTR, NULL))
-    };
-
-    return syss;
+    return lily_syss;
 }
 
 bool
@@ -242,12 +168,3 @@ IMPL_FOR_DEBUG(to_string, LilySysFun, const LilySysFun *self)
     return res;
 }
 #endif
-
-DESTRUCTOR(LilySysFun, const LilySysFun *self)
-{
-    FREE(String, self->real_name);
-    FREE(LilyCheckedDataType, self->return_data_type);
-    FREE_BUFFER_ITEMS(
-      self->params->buffer, self->params->len, LilyCheckedDataType);
-    FREE(Vec, self->params);
-}
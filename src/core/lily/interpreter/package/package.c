@@ -25,30 +25,29 @@
 #include <core/lily/interpreter/package/package.h>
 #include <core/lily/mir/generator.h>
 #include <core/lily/package/package.h>
+#include <core/lily/package/scheduler.h>
 
 #include <pthread.h>
 
-// TODO: add support for Windows.
-static threadlocal pthread_t *package_threads;
-static pthread_mutex_t package_thread_mutex;
+// NOTE: See `src/core/lily/compiler/package/package.c` for the structures
+// shared by the analyses of the packages.
 
 /**
  *
  * @brief Run parser, analysis, mir.
- * @param self LilyPackageDependencyTree*
+ * @note This function is called by the scheduler, once all the dependencies of
+ * the package are done.
  */
-static void *
-run_threads__LilyInterpreterPackage(void *self);
+static void
+run_package__LilyInterpreterPackage(LilyPackageDependencyTree *tree);
 
 DESTRUCTOR(LilyInterpreterAdapter, const LilyInterpreterAdapter *self)
 {
-    if (self->is_root) {
+    // NOTE: The library owns the root package, so it's not freed here (see
+    // `build_lib__LilyInterpreterPackage`).
+    if (self->is_root && !self->lib) {
         FREE(LilyInterpreterVM, &self->vm);
     }
-
-    if (self->lib) {
-        FREE(LilyLibrary, self->lib);
-    }
 }
 
 LilyPackage *
@@ -74,14 +73,9 @@ build__LilyInterpreterPackage(const LilyPackageInterpreterConfig *config,
     self->interpreter.config = config;
 
     LOG_VERBOSE(self, "running");
-    LOG_VERBOSE(self, "running scanner");
 
     // TODO: add dump_scanner to the config.
-    run__LilyScanner(&self->scanner, false);
-
-    LOG_VERBOSE(self, "running preparser");
-
-    run__LilyPreparser(&self->preparser, &self->preparser_info);
+    run_scanner_and_preparser__LilyPackage(self, false);
 
     SET_ROOT_PACKAGE_NAME(self);
     INTERPRETER_SET_ROOT_PACKAGE_PROGRAM(self, program);
@@ -94,27 +88,28 @@ build__LilyInterpreterPackage(const LilyPackageInterpreterConfig *config,
 
     run__LilyPrecompiler(&self->precompiler, self, false);
 
-    LOG_VERBOSE(self, "creation of threads");
+    LOG_VERBOSE(self, "running scheduler");
 
-    package_threads =
-      lily_malloc(sizeof(pthread_t) * self->precompiler.dependency_trees->len);
+    {
+        LilyPackageScheduler scheduler =
+          NEW(LilyPackageScheduler,
+              self->precompiler.dependency_trees,
+              &run_package__LilyInterpreterPackage);
 
-    ASSERT(!pthread_mutex_init(&package_thread_mutex, NULL));
-
-    for (Usize i = 0; i < self->precompiler.dependency_trees->len; ++i) {
-        ASSERT(
-          !pthread_create(&package_threads[i],
-                          NULL,
-                          &run_threads__LilyInterpreterPackage,
-                          get__Vec(self->precompiler.dependency_trees, i)));
+        run__LilyPackageScheduler(&scheduler);
+        FREE(LilyPackageScheduler, &scheduler);
     }
 
-    for (Usize i = 0; i < self->precompiler.dependency_trees->len; ++i) {
-        pthread_join(package_threads[i], NULL);
-    }
+    // NOTE: A library is not run, so it doesn't need a VM.
+    if (lib) {
+        finish_set__LilyLibrary(lib, self->name, LILY_AR_KIND_UNKNOWN);
+
+        self->is_lib = true;
+        lib->package = self;
+        self->interpreter.lib = lib;
 
-    lily_free(package_threads);
-    pthread_mutex_destroy(&package_thread_mutex);
+        return self;
+    }
 
     // TODO: set check overflow
     self->interpreter.vm = NEW(LilyInterpreterVM,
@@ -128,7 +123,8 @@ build__LilyInterpreterPackage(const LilyPackageInterpreterConfig *config,
 }
 
 LilyLibrary *
-build_lib__LilyInterpreterPackage(const LilyConfig *config,
+build_lib__LilyInterpreterPackage(const LilyPackageInterpreterConfig *config,
+                                  const char *filename,
                                   enum LilyVisibility visibility,
                                   enum LilyPackageStatus status,
                                   const char *default_path,
@@ -137,71 +133,16 @@ build_lib__LilyInterpreterPackage(const LilyConfig *config,
                                   String *url,
                                   String *path)
 {
-    return NULL;
-}
-
-static void *
-run_threads__LilyInterpreterPackage(void *self)
-{
-    pthread_mutex_lock(&package_thread_mutex);
-
-    LilyPackageDependencyTree *tree = self;
-
-    if (tree->dependencies) {
-        for (Usize i = 0; i < tree->dependencies->len; ++i) {
-            LilyPackageDependencyTree *dep = get__Vec(tree->dependencies, i);
-
-            while (!dep->is_done)
-                ;
-        }
-    }
-
-    LOG_VERBOSE(tree->package, "running parser");
-
-    run__LilyParser(&tree->package->parser, false);
-
-    LOG_VERBOSE(tree->package, "running analysis");
-
-    run__LilyAnalysis(&tree->package->analysis);
-
-    LOG_VERBOSE(tree->package, "running mir");
-
-    run__LilyMir(tree->package);
-
-    LOG_VERBOSE(tree->package, "running package done");
-
-    tree->is_done = true;
-
-    pthread_mutex_unlock(&package_thread_mutex);
-
-    // Run children of the tree
-    if (tree->children->len > 0) {
-        LOG_VERBOSE(tree->package, "running children package");
-
-        package_threads = lily_malloc(sizeof(pthread_t) * tree->children->len);
-        pthread_mutex_t children_thread_lock;
-
-        ASSERT(!pthread_mutex_init(&children_thread_lock, NULL));
-        pthread_mutex_lock(&children_thread_lock);
-
-        for (Usize i = 0; i < tree->children->len; ++i) {
-            ASSERT(!pthread_create(&package_threads[i],
-                                   NULL,
-                                   &run_threads__LilyInterpreterPackage,
-                                   get__Vec(tree->children, i)));
-        }
-
-        for (Usize i = 0; i < tree->children->len; ++i) {
-            pthread_join(package_threads[i], NULL);
-        }
-
-        pthread_mutex_unlock(&children_thread_lock);
-
-        lily_free(package_threads);
-        pthread_mutex_destroy(&children_thread_lock);
-    }
-
-    return NULL;
+    LilyLibrary *lib = NEW(LilyLibrary, version, url, path, NULL);
+
+    return build__LilyInterpreterPackage(config,
+                                         filename,
+                                         visibility,
+                                         status,
+                                         default_path,
+                                         program,
+                                         lib)
+      ->interpreter.lib;
 }
 
 void
@@ -233,3 +174,21 @@ run__LilyInterpreterPackage(const LilyConfig *config,
 
     FREE(LilyPackage, package);
 }
+
+static void
+run_package__LilyInterpreterPackage(LilyPackageDependencyTree *tree)
+{
+    LOG_VERBOSE(tree->package, "running parser");
+
+    run__LilyParser(&tree->package->parser, false);
+
+    LOG_VERBOSE(tree->package, "running analysis");
+
+    run__LilyAnalysis(&tree->package->analysis);
+
+    LOG_VERBOSE(tree->package, "running mir");
+
+    run__LilyMir(tree->package);
+
+    LOG_VERBOSE(tree->package, "running package done");
+}
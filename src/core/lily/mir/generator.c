@@ -139,6 +139,22 @@ run__LilyMir(LilyPackage *self)
             case LILY_CHECKED_DECL_KIND_METHOD:
                 break;
             case LILY_CHECKED_DECL_KIND_FUN:
+                // NOTE: The function is not checked, when the function is
+                // never called in lazy mode (see
+                // has_lazy_fun_body__LilyPackage).
+                if (!decl->fun.is_checked) {
+                    break;
+                }
+
+                // NOTE: The private functions are generated through the
+                // dependencies of the functions of the API, when the emission
+                // is driven by it (see has_api_driven_emission__LilyPackage).
+                if (has_api_driven_emission__LilyPackage(self) &&
+                    decl->fun.visibility != LILY_VISIBILITY_PUBLIC &&
+                    !decl->fun.is_operator && !decl->fun.is_main) {
+                    break;
+                }
+
                 generate_fun__LilyMir(&self->mir_module, decl);
 
                 break;
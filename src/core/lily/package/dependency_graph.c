@@ -0,0 +1,313 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2025 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/alloc.h>
+#include <base/assert.h>
+#include <base/new.h>
+
+#include <core/lily/package/dependency_graph.h>
+#include <core/lily/package/package.h>
+
+#define UNVISITED_INDEX ((Usize)-1)
+
+/// @brief Add the node of the package and the nodes of its sub packages.
+static void
+add_package__LilyPackageDependencyGraph(LilyPackageDependencyGraph *self,
+                                        LilyPackage *package);
+
+/// @brief Resolve the dependencies of the node (without duplicates).
+/// @param last_dependent Usize* - The id (+ 1) of the last node which has
+/// added the dependency (indexed by the id of the dependency).
+static void
+add_dependencies__LilyPackageDependencyGraph(
+  LilyPackageDependencyGraph *self,
+  LilyPackageDependencyGraphNode *node,
+  Usize *last_dependent);
+
+/// @brief Visit the node (Tarjan's algorithm). The strongly connected
+/// components are found after all of their dependencies, so the layer of a
+/// node is calculated when its component is found.
+/// @param stack Vec<LilyPackageDependencyGraphNode* (&)>*
+static void
+visit__LilyPackageDependencyGraph(LilyPackageDependencyGraph *self,
+                                  LilyPackageDependencyGraphNode *node,
+                                  Vec *stack,
+                                  Usize *index);
+
+/// @brief Add a cycle of the strongly connected component whose root is
+/// `start`, before the component is removed from the stack.
+static void
+add_cycle__LilyPackageDependencyGraph(LilyPackageDependencyGraph *self,
+                                      LilyPackageDependencyGraphNode *start);
+
+CONSTRUCTOR(LilyPackageDependencyGraphNode *,
+            LilyPackageDependencyGraphNode,
+            LilyPackage *package,
+            Usize id)
+{
+    LilyPackageDependencyGraphNode *self =
+      lily_malloc(sizeof(LilyPackageDependencyGraphNode));
+
+    self->package = package;
+    self->dependencies = NEW(Vec);
+    self->id = id;
+    self->layer = 0;
+    self->index = UNVISITED_INDEX;
+    self->low_link = 0;
+    self->is_on_stack = false;
+
+    return self;
+}
+
+DESTRUCTOR(LilyPackageDependencyGraphNode,
+           LilyPackageDependencyGraphNode *self)
+{
+    FREE(Vec, self->dependencies);
+    lily_free(self);
+}
+
+void
+add_package__LilyPackageDependencyGraph(LilyPackageDependencyGraph *self,
+                                        LilyPackage *package)
+{
+    LilyPackageDependencyGraphNode *node =
+      NEW(LilyPackageDependencyGraphNode, package, self->nodes->len);
+
+    ASSERT(!insert__HashMap(self->lookup, package->global_name->buffer, node));
+
+    push__Vec(self->nodes, node);
+
+    for (Usize i = 0; i < package->sub_packages->len; ++i) {
+        add_package__LilyPackageDependencyGraph(
+          self, get__Vec(package->sub_packages, i));
+    }
+}
+
+void
+add_dependencies__LilyPackageDependencyGraph(
+  LilyPackageDependencyGraph *self,
+  LilyPackageDependencyGraphNode *node,
+  Usize *last_dependent)
+{
+    const Vec *package_dependencies = node->package->package_dependencies;
+
+    for (Usize i = 0; i < package_dependencies->len; ++i) {
+        LilyPackageDependencyGraphNode *dependency =
+          get_node__LilyPackageDependencyGraph(
+            self, get__Vec(package_dependencies, i));
+
+        ASSERT(dependency);
+
+        if (last_dependent[dependency->id] != node->id + 1) {
+            last_dependent[dependency->id] = node->id + 1;
+            push__Vec(node->dependencies, dependency);
+        }
+    }
+}
+
+void
+visit__LilyPackageDependencyGraph(LilyPackageDependencyGraph *self,
+                                  LilyPackageDependencyGraphNode *node,
+                                  Vec *stack,
+                                  Usize *index)
+{
+    node->index = *index;
+    node->low_link = *index;
+    node->is_on_stack = true;
+    ++*index;
+
+    push__Vec(stack, node);
+
+    for (Usize i = 0; i < node->dependencies->len; ++i) {
+        LilyPackageDependencyGraphNode *dependency =
+          get__Vec(node->dependencies, i);
+
+        if (dependency->index == UNVISITED_INDEX) {
+            visit__LilyPackageDependencyGraph(self, dependency, stack, index);
+
+            if (dependency->low_link < node->low_link) {
+                node->low_link = dependency->low_link;
+            }
+        } else if (dependency->is_on_stack &&
+                   dependency->index < node->low_link) {
+            node->low_link = dependency->index;
+        }
+    }
+
+    if (node->low_link != node->index) {
+        return;
+    }
+
+    // NOTE: The node is the root of a strongly connected component, which is
+    // on the top of the stack.
+    if (last__Vec(stack) != node) {
+        add_cycle__LilyPackageDependencyGraph(self, node);
+    } else {
+        for (Usize i = 0; i < node->dependencies->len; ++i) {
+            LilyPackageDependencyGraphNode *dependency =
+              get__Vec(node->dependencies, i);
+
+            if (dependency == node) {
+                Vec *cycle = NEW(Vec);
+
+                push__Vec(cycle, node);
+                push__Vec(self->cycles, cycle);
+            } else if (dependency->layer + 1 > node->layer) {
+                node->layer = dependency->layer + 1;
+            }
+        }
+    }
+
+    LilyPackageDependencyGraphNode *top = NULL;
+
+    do {
+        top = pop__Vec(stack);
+        top->is_on_stack = false;
+    } while (top != node);
+}
+
+void
+add_cycle__LilyPackageDependencyGraph(LilyPackageDependencyGraph *self,
+                                      LilyPackageDependencyGraphNode *start)
+{
+    // NOTE: Search the shortest path from `start` to a node which depends on
+    // `start` (breadth-first search inside the component). The nodes of the
+    // component are the nodes on the stack visited after `start`.
+    LilyPackageDependencyGraphNode **previous =
+      lily_calloc(self->nodes->len, sizeof(LilyPackageDependencyGraphNode *));
+    Vec *queue = NEW(Vec); // Vec<LilyPackageDependencyGraphNode* (&)>*
+    LilyPackageDependencyGraphNode *last = NULL;
+
+    push__Vec(queue, start);
+
+    for (Usize i = 0; i < queue->len && !last; ++i) {
+        LilyPackageDependencyGraphNode *node = get__Vec(queue, i);
+
+        for (Usize j = 0; j < node->dependencies->len; ++j) {
+            LilyPackageDependencyGraphNode *dependency =
+              get__Vec(node->dependencies, j);
+
+            if (dependency == start) {
+                last = node;
+                break;
+            }
+
+            if (dependency->is_on_stack &&
+                dependency->index > start->index && !previous[dependency->id]) {
+                previous[dependency->id] = node;
+                push__Vec(queue, dependency);
+            }
+        }
+    }
+
+    ASSERT(last);
+
+    Vec *cycle = NEW(Vec); // Vec<LilyPackageDependencyGraphNode* (&)>*
+
+    for (LilyPackageDependencyGraphNode *node = last; node != start;
+         node = previous[node->id]) {
+        push__Vec(cycle, node);
+    }
+
+    push__Vec(cycle, start);
+    reverse__Vec(cycle);
+    push__Vec(self->cycles, cycle);
+
+    FREE(Vec, queue);
+    lily_free(previous);
+}
+
+CONSTRUCTOR(LilyPackageDependencyGraph,
+            LilyPackageDependencyGraph,
+            LilyPackage *root_package)
+{
+    LilyPackageDependencyGraph self = { .nodes = NEW(Vec),
+                                        .lookup = NEW(HashMap),
+                                        .cycles = NEW(Vec),
+                                        .layers = NEW(Vec) };
+
+    add_package__LilyPackageDependencyGraph(&self, root_package);
+
+    // 1. Resolve the dependencies.
+    {
+        Usize *last_dependent = lily_calloc(self.nodes->len, sizeof(Usize));
+
+        for (Usize i = 0; i < self.nodes->len; ++i) {
+            add_dependencies__LilyPackageDependencyGraph(
+              &self, get__Vec(self.nodes, i), last_dependent);
+        }
+
+        lily_free(last_dependent);
+    }
+
+    // 2. Find the cycles and calculate the layers.
+    {
+        Vec *stack = NEW(Vec); // Vec<LilyPackageDependencyGraphNode* (&)>*
+        Usize index = 0;
+
+        for (Usize i = 0; i < self.nodes->len; ++i) {
+            LilyPackageDependencyGraphNode *node = get__Vec(self.nodes, i);
+
+            if (node->index == UNVISITED_INDEX) {
+                visit__LilyPackageDependencyGraph(&self, node, stack, &index);
+            }
+        }
+
+        FREE(Vec, stack);
+    }
+
+    // 3. Group the nodes by layer (in the order of the nodes).
+    if (self.cycles->len == 0) {
+        for (Usize i = 0; i < self.nodes->len; ++i) {
+            LilyPackageDependencyGraphNode *node = get__Vec(self.nodes, i);
+
+            while (self.layers->len <= node->layer) {
+                push__Vec(self.layers, NEW(Vec));
+            }
+
+            push__Vec(get__Vec(self.layers, node->layer), node);
+        }
+    }
+
+    return self;
+}
+
+LilyPackageDependencyGraphNode *
+get_node__LilyPackageDependencyGraph(const LilyPackageDependencyGraph *self,
+                                     const LilyPackage *package)
+{
+    return get__HashMap(self->lookup, package->global_name->buffer);
+}
+
+DESTRUCTOR(LilyPackageDependencyGraph, const LilyPackageDependencyGraph *self)
+{
+    FREE_BUFFER_ITEMS(
+      self->nodes->buffer, self->nodes->len, LilyPackageDependencyGraphNode);
+    FREE(Vec, self->nodes);
+    FREE(HashMap, self->lookup);
+    FREE_BUFFER_ITEMS(self->cycles->buffer, self->cycles->len, Vec);
+    FREE(Vec, self->cycles);
+    FREE_BUFFER_ITEMS(self->layers->buffer, self->layers->len, Vec);
+    FREE(Vec, self->layers);
+}
@@ -29,14 +29,6 @@
 #include <core/lily/package/package.h>
 
 #include <stdio.h>
-#include <string.h>
-
-/// @return Vec<LilyPackageDependencyTree* (&)>*?
-static Vec *
-collect_dependencies__LilyPackageDependencyTree(
-  LilyPackageDependencyTree *self,
-  LilyPackage *package,
-  LilyPackageDependencyTree *previous);
 
 CONSTRUCTOR(LilyPackageDependencyTree *,
             LilyPackageDependencyTree,
@@ -54,119 +46,6 @@ CONSTRUCTOR(LilyPackageDependencyTree *,
     return self;
 }
 
-LilyPackageDependencyTree *
-determine_tree__LilyPackageDependencyTree(Vec *trees, LilyPackage *package)
-{
-    for (Usize i = 0; i < package->package_dependencies->len; ++i) {
-        LilyPackage *dependency = get__Vec(package->package_dependencies, i);
-
-        for (Usize j = 0; j < trees->len; ++j) {
-            LilyPackageDependencyTree *res =
-              is_added__LilyPackageDependencyTree(get__Vec(trees, j),
-                                                  dependency);
-
-            if (res) {
-                return res;
-            }
-        }
-    }
-
-    return NULL;
-}
-
-void
-add_package__LilyPackageDependencyTree(LilyPackageDependencyTree *self,
-                                       Vec *trees,
-                                       LilyPackage *package)
-{
-    if (!is_added__LilyPackageDependencyTree(self, package)) {
-        Vec *dependencies = NEW(Vec);
-
-        for (Usize i = 0; i < package->package_dependencies->len; ++i) {
-            LilyPackage *dependency_pkg =
-              get__Vec(package->package_dependencies, i);
-            LilyPackageDependencyTree *dependency = NULL;
-
-        add_dependency: {
-            for (Usize i = 0; i < trees->len && !dependency; ++i) {
-                dependency = is_added__LilyPackageDependencyTree(
-                  get__Vec(trees, i), dependency_pkg);
-            }
-
-            if (dependency) {
-                push__Vec(dependencies, dependency);
-            } else {
-                LilyPackageDependencyTree *tree =
-                  determine_tree__LilyPackageDependencyTree(trees,
-                                                            dependency_pkg);
-
-                if (tree) {
-                    add_package__LilyPackageDependencyTree(
-                      tree, trees, dependency_pkg);
-                    goto add_dependency;
-                } else {
-                    UNREACHABLE("tree is NULL");
-                }
-            }
-        }
-        }
-
-        push__Vec(self->children,
-                  NEW(LilyPackageDependencyTree, package, dependencies));
-    }
-}
-
-Vec *
-collect_dependencies__LilyPackageDependencyTree(
-  LilyPackageDependencyTree *self,
-  LilyPackage *package,
-  LilyPackageDependencyTree *previous)
-{
-    // 1. Check if package is found.
-    if (!strcmp(self->package->name->buffer, package->name->buffer)) {
-        Vec *dependencies = NEW(Vec);
-
-        append__Vec(dependencies, previous->dependencies);
-        push__Vec(dependencies, previous);
-
-        return dependencies;
-    }
-
-    // 2. Search package name.
-    for (Usize i = 0; i < self->children->len; i++) {
-        Vec *dependencies = collect_dependencies__LilyPackageDependencyTree(
-          get__Vec(self->children, i), package, self);
-
-        if (dependencies) {
-            return dependencies;
-        }
-    }
-
-    return NULL;
-}
-
-LilyPackageDependencyTree *
-is_added__LilyPackageDependencyTree(LilyPackageDependencyTree *self,
-                                    LilyPackage *package)
-{
-    // 1. Check if package is found.
-    if (!strcmp(self->package->name->buffer, package->name->buffer)) {
-        return self;
-    }
-
-    // 2. Search package name.
-    for (Usize i = 0; i < self->children->len; i++) {
-        LilyPackageDependencyTree *res = is_added__LilyPackageDependencyTree(
-          get__Vec(self->children, i), package);
-
-        if (res) {
-            return res;
-        }
-    }
-
-    return NULL;
-}
-
 #ifdef ENV_DEBUG
 String *
 IMPL_FOR_DEBUG(to_string,
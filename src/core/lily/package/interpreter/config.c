@@ -38,5 +38,6 @@ from_RunConfig__LilyPackageInterpreterConfig(const LilyConfig *lily_config)
                lily_config->run.args,
                lily_config->run.verbose,
                lily_config->run.max_heap,
-               lily_config->run.max_stack);
+               lily_config->run.max_stack,
+               lily_config->run.lazy);
 }
@@ -38,6 +38,12 @@ static CONSTRUCTOR(LilyPackage *,
                    const char *default_package_access,
                    LilyPackage *root);
 
+/// @brief Push the tokens of the macros (and of their params).
+/// @param kept Vec<LilyToken* (&)>*
+/// @param macros Vec<LilyPreparserMacro*>*
+static void
+push_macro_tokens__LilyPackage(Vec *kept, const Vec *macros);
+
 CONSTRUCTOR(LilyPackage *,
             LilyPackage,
             String *name,
@@ -87,6 +93,10 @@ CONSTRUCTOR(LilyPackage *,
     self->count_error = 0;
     self->count_warning = 0;
 
+    atomic_init(&self->count_macro_expansion, 0);
+    atomic_init(&self->count_memoized_macro_expansion, 0);
+    atomic_init(&self->macro_expansion_duration, 0);
+
     self->file = NEW(File, filename, content);
     self->scanner = NEW(LilyScanner,
                         NEW(Source, NEW(Cursor, content), &self->file),
@@ -94,13 +104,13 @@ CONSTRUCTOR(LilyPackage *,
 #if defined(RUN_UNTIL_PREPARSER) || defined(RUN_UNTIL_PRECOMPILER)
     self->preparser = NEW(LilyPreparser,
                           &self->file,
-                          self->scanner.tokens,
+                          &self->scanner.tokens,
                           default_package_access,
                           true);
 #else
     self->preparser = NEW(LilyPreparser,
                           &self->file,
-                          self->scanner.tokens,
+                          &self->scanner.tokens,
                           default_package_access,
                           false);
 #endif
@@ -124,13 +134,6 @@ CONSTRUCTOR(LilyPackage *,
           LilyAnalysis, self, root, &self->parser, root->analysis.use_switch);
         self->builtins = NULL;
         self->syss = NULL;
-
-        // Push default operators contains in program resources.
-        for (Usize i = 0; i < DEFAULT_OPERATORS_COUNT; ++i) {
-            push__Vec(self->operator_register.operators,
-                      ref__LilyCheckedOperator(
-                        self->program->resources.default_operators[i]));
-        }
     } else {
         self->parser = NEW(LilyParser, self, self, NULL);
         self->analysis = NEW(LilyAnalysis, self, self, &self->parser, false);
@@ -297,6 +300,99 @@ add_builtin_fun_to_builtin_usage__LilyPackage(LilyPackage *self,
     push__Vec(self->builtin_usage, fun_builtin);
 }
 
+bool
+has_lazy_fun_body__LilyPackage(const LilyPackage *self)
+{
+    switch (self->kind) {
+        case LILY_PACKAGE_KIND_INTERPRETER:
+            return self->interpreter.config && self->interpreter.config->lazy;
+        case LILY_PACKAGE_KIND_COMPILER:
+        case LILY_PACKAGE_KIND_JIT:
+            return false;
+        default:
+            UNREACHABLE("unknown variant");
+    }
+}
+
+bool
+has_api_driven_emission__LilyPackage(const LilyPackage *self)
+{
+    switch (self->kind) {
+        case LILY_PACKAGE_KIND_COMPILER:
+            // NOTE: All the functions of the root package (or a single file)
+            // are emitted.
+            return self->status == LILY_PACKAGE_STATUS_NORMAL ||
+                   self->status == LILY_PACKAGE_STATUS_SUB_MAIN;
+        case LILY_PACKAGE_KIND_INTERPRETER:
+        case LILY_PACKAGE_KIND_JIT:
+            return false;
+        default:
+            UNREACHABLE("unknown variant");
+    }
+}
+
+void
+run_scanner_and_preparser__LilyPackage(LilyPackage *self, bool dump_scanner)
+{
+    if (!dump_scanner && self->file.len >= LILY_PACKAGE_PIPELINE_MIN_FILE_LEN) {
+        LOG_VERBOSE(self, "running scanner and preparser (pipelined)");
+
+        run_pipelined__LilyPreparser(
+          &self->preparser, &self->preparser_info, &self->scanner);
+
+        return;
+    }
+
+    LOG_VERBOSE(self, "running scanner");
+
+    // NOTE: The preparser would only emit cascading errors on the tokens of a
+    // failed scan (the scanner only returns on errors in a task).
+    if (run__LilyScanner(&self->scanner, dump_scanner)) {
+        return;
+    }
+
+    LOG_VERBOSE(self, "running preparser");
+
+    run__LilyPreparser(&self->preparser, &self->preparser_info);
+}
+
+void
+push_macro_tokens__LilyPackage(Vec *kept, const Vec *macros)
+{
+    for (Usize i = 0; i < macros->len; ++i) {
+        const LilyPreparserMacro *macro = get__Vec(macros, i);
+
+        append__Vec(kept, macro->tokens);
+
+        if (macro->params) {
+            for (Usize j = 0; j < macro->params->len; ++j) {
+                append__Vec(kept, get__Vec(macro->params, j));
+            }
+        }
+    }
+}
+
+void
+release_tokens__LilyPackage(LilyPackage *self)
+{
+    // NOTE: The bodies of the functions parsed lazily keep using the tokens
+    // after the parser (see has_lazy_fun_body__LilyPackage).
+    if (!self->scanner.stream || has_lazy_fun_body__LilyPackage(self)) {
+        return;
+    }
+
+    Vec *kept = NEW(Vec); // Vec<LilyToken* (&)>*
+
+    push_macro_tokens__LilyPackage(kept, self->preparser_info.public_macros);
+    push_macro_tokens__LilyPackage(kept, self->preparser_info.private_macros);
+
+    LOG_VERBOSE(self, "releasing tokens");
+
+    release__LilyTokenStream(self->scanner.stream, kept);
+
+    FREE(Vec, kept);
+}
+
 DESTRUCTOR(LilyPackage, LilyPackage *self)
 {
     if (self->public_macros) {
@@ -0,0 +1,287 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2025 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/alloc.h>
+#include <base/dir.h>
+#include <base/dir_separator.h>
+#include <base/file.h>
+#include <base/hash_map.h>
+#include <base/new.h>
+#include <base/platform.h>
+#include <base/sys.h>
+
+#include <core/lily/package/path_cache.h>
+
+#include <pthread.h>
+#include <string.h>
+
+#ifndef LILY_WINDOWS_OS
+#include <dirent.h>
+#endif
+
+typedef struct LilyPackagePathCacheEntry
+{
+    char *name;
+    enum LilyPackagePathKind kind;
+    // NOTE: The kind of the entry is not given by `readdir` on some file
+    // systems (or for a symbolic link), so it's resolved with `stat` on the
+    // first lookup.
+    bool kind_is_known;
+} LilyPackagePathCacheEntry;
+
+typedef struct LilyPackagePathCacheDir
+{
+    char *path;
+    HashMap *entries; // HashMap<LilyPackagePathCacheEntry*>*
+} LilyPackagePathCacheDir;
+
+/**
+ *
+ * @brief Get the kind of the path with `stat`.
+ */
+static enum LilyPackagePathKind
+get_kind_with_stat__LilyPackagePathCache(const char *path);
+
+/**
+ *
+ * @brief Construct LilyPackagePathCacheEntry type.
+ */
+static CONSTRUCTOR(LilyPackagePathCacheEntry *,
+                   LilyPackagePathCacheEntry,
+                   const char *name,
+                   enum LilyPackagePathKind kind,
+                   bool kind_is_known);
+
+/**
+ *
+ * @brief Free LilyPackagePathCacheEntry type.
+ */
+static DESTRUCTOR(LilyPackagePathCacheEntry, LilyPackagePathCacheEntry *self);
+
+/**
+ *
+ * @brief Construct LilyPackagePathCacheDir type and read the listing of the
+ * directory.
+ * @param path The path is taken by the directory.
+ */
+static CONSTRUCTOR(LilyPackagePathCacheDir *,
+                   LilyPackagePathCacheDir,
+                   char *path);
+
+/**
+ *
+ * @brief Free LilyPackagePathCacheDir type.
+ */
+static DESTRUCTOR(LilyPackagePathCacheDir, LilyPackagePathCacheDir *self);
+
+static HashMap *dirs = NULL; // HashMap<LilyPackagePathCacheDir*>*?
+static pthread_mutex_t dirs_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+enum LilyPackagePathKind
+get_kind_with_stat__LilyPackagePathCache(const char *path)
+{
+    if (is__Dir(path)) {
+        return LILY_PACKAGE_PATH_KIND_DIR;
+    }
+
+    return exists__File(path) ? LILY_PACKAGE_PATH_KIND_FILE
+                              : LILY_PACKAGE_PATH_KIND_NONE;
+}
+
+CONSTRUCTOR(LilyPackagePathCacheEntry *,
+            LilyPackagePathCacheEntry,
+            const char *name,
+            enum LilyPackagePathKind kind,
+            bool kind_is_known)
+{
+    LilyPackagePathCacheEntry *self =
+      lily_malloc(sizeof(LilyPackagePathCacheEntry));
+    Usize name_len = strlen(name);
+
+    self->name = lily_malloc(name_len + 1);
+    self->kind = kind;
+    self->kind_is_known = kind_is_known;
+
+    memcpy(self->name, name, name_len + 1);
+
+    return self;
+}
+
+DESTRUCTOR(LilyPackagePathCacheEntry, LilyPackagePathCacheEntry *self)
+{
+    lily_free(self->name);
+    lily_free(self);
+}
+
+CONSTRUCTOR(LilyPackagePathCacheDir *, LilyPackagePathCacheDir, char *path)
+{
+    LilyPackagePathCacheDir *self =
+      lily_malloc(sizeof(LilyPackagePathCacheDir));
+
+    self->path = path;
+    self->entries = NEW(HashMap);
+
+#ifndef LILY_WINDOWS_OS
+    DIR *dir = opendir(path);
+
+    // NOTE: If the directory can't be read, all of its paths don't exist.
+    if (!dir) {
+        return self;
+    }
+
+    struct dirent *dp;
+
+    while ((dp = readdir(dir))) {
+        if (!strcmp(dp->d_name, ".") || !strcmp(dp->d_name, "..")) {
+            continue;
+        }
+
+        LilyPackagePathCacheEntry *entry = NULL;
+
+#ifdef DT_UNKNOWN
+        switch (dp->d_type) {
+            case DT_DIR:
+                entry = NEW(LilyPackagePathCacheEntry,
+                            dp->d_name,
+                            LILY_PACKAGE_PATH_KIND_DIR,
+                            true);
+
+                break;
+            case DT_REG:
+                entry = NEW(LilyPackagePathCacheEntry,
+                            dp->d_name,
+                            LILY_PACKAGE_PATH_KIND_FILE,
+                            true);
+
+                break;
+            default:
+                entry = NEW(LilyPackagePathCacheEntry,
+                            dp->d_name,
+                            LILY_PACKAGE_PATH_KIND_NONE,
+                            false);
+        }
+#else
+        entry = NEW(LilyPackagePathCacheEntry,
+                    dp->d_name,
+                    LILY_PACKAGE_PATH_KIND_NONE,
+                    false);
+#endif
+
+        insert__HashMap(self->entries, entry->name, entry);
+    }
+
+    closedir(dir);
+#endif
+
+    return self;
+}
+
+DESTRUCTOR(LilyPackagePathCacheDir, LilyPackagePathCacheDir *self)
+{
+    FREE_HASHMAP_VALUES(self->entries, LilyPackagePathCacheEntry);
+    FREE(HashMap, self->entries);
+    lily_free(self->path);
+    lily_free(self);
+}
+
+#ifdef LILY_WINDOWS_OS
+enum LilyPackagePathKind
+get_kind__LilyPackagePathCache(const char *path)
+{
+    // TODO: read the listing of the directory with FindFirstFile on Windows.
+    return get_kind_with_stat__LilyPackagePathCache(path);
+}
+#else
+enum LilyPackagePathKind
+get_kind__LilyPackagePathCache(const char *path)
+{
+    const char *separator = strrchr(path, DIR_SEPARATOR);
+    const char *name = separator ? separator + 1 : path;
+
+    if (!name[0] || !strcmp(name, ".") || !strcmp(name, "..")) {
+        return get_kind_with_stat__LilyPackagePathCache(path);
+    }
+
+    // NOTE: `/<name>` is in the root directory, and `<name>` is in the current
+    // directory.
+    Usize dir_path_len = !separator          ? 0
+                         : separator == path ? 1
+                                             : separator - path;
+    char *dir_path = lily_malloc(dir_path_len + 2);
+
+    if (dir_path_len == 0) {
+        memcpy(dir_path, ".", 2);
+    } else {
+        memcpy(dir_path, path, dir_path_len);
+        dir_path[dir_path_len] = '\0';
+    }
+
+    pthread_mutex_lock(&dirs_mutex);
+
+    if (!dirs) {
+        dirs = NEW(HashMap);
+    }
+
+    LilyPackagePathCacheDir *dir = get__HashMap(dirs, dir_path);
+
+    if (dir) {
+        lily_free(dir_path);
+    } else {
+        dir = NEW(LilyPackagePathCacheDir, dir_path);
+
+        insert__HashMap(dirs, dir->path, dir);
+    }
+
+    LilyPackagePathCacheEntry *entry = get__HashMap(dir->entries, (char *)name);
+    enum LilyPackagePathKind res = LILY_PACKAGE_PATH_KIND_NONE;
+
+    if (entry) {
+        if (!entry->kind_is_known) {
+            entry->kind = get_kind_with_stat__LilyPackagePathCache(path);
+            entry->kind_is_known = true;
+        }
+
+        res = entry->kind;
+    }
+
+    pthread_mutex_unlock(&dirs_mutex);
+
+    return res;
+}
+#endif
+
+void
+clear__LilyPackagePathCache()
+{
+    pthread_mutex_lock(&dirs_mutex);
+
+    if (dirs) {
+        FREE_HASHMAP_VALUES(dirs, LilyPackagePathCacheDir);
+        FREE(HashMap, dirs);
+
+        dirs = NULL;
+    }
+
+    pthread_mutex_unlock(&dirs_mutex);
+}
@@ -30,37 +30,40 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-CONSTRUCTOR(LilyProgram, LilyProgram, enum LilyProgramKind kind)
-{
-    return (LilyProgram){ .kind = kind,
-                          .resources = NEW(LilyProgramResources) };
-}
+// Resources loaded by preload__LilyProgram, and not yet taken by a program.
+static LilyProgramResources *preloaded_resources =
+  NULL; // LilyProgramResources*?
 
-DESTRUCTOR(LilyProgramResources, const LilyProgramResources *self)
+CONSTRUCTOR(LilyProgram, LilyProgram, enum LilyProgramKind kind)
 {
-    for (Usize i = 0; i < BUILTINS_COUNT; ++i) {
-        FREE(LilyBuiltinFun, &self->builtins[i]);
-    }
+    if (preloaded_resources) {
+        LilyProgram self = { .kind = kind, .resources = *preloaded_resources };
 
-    lily_free(self->builtins);
+        lily_free(preloaded_resources);
+        preloaded_resources = NULL;
 
-    for (Usize i = 0; i < SYSS_COUNT; ++i) {
-        FREE(LilySysFun, &self->syss[i]);
+        return self;
     }
 
-    lily_free(self->syss);
-
-    // FIXME: sometimes that's crash, caused by the add of the the
-    // multi-threading in the precompiler
-
-    for (Usize i = 0; i < DEFAULT_OPERATORS_COUNT; ++i) {
-        ASSERT(self->default_operators[i]->ref_count == 0);
+    return (LilyProgram){ .kind = kind,
+                          .resources = NEW(LilyProgramResources) };
+}
 
-        FREE(LilyCheckedOperator, self->default_operators[i]);
-    }
+void
+preload__LilyProgram()
+{
+    ASSERT(!preloaded_resources);
 
-    lily_free(self->default_operators);
+    preloaded_resources = lily_malloc(sizeof(LilyProgramResources));
+    *preloaded_resources = NEW(LilyProgramResources);
+}
 
+DESTRUCTOR(LilyProgramResources, const LilyProgramResources *self)
+{
     FREE_BUFFER_ITEMS(self->libs->buffer, self->libs->len, LilyLibrary);
     FREE(Vec, self->libs);
+
+    // NOTE: The interned data types of the libraries and the packages borrow
+    // the payload of the nodes of the table.
+    FREE(LilyCheckedDataTypeTable, self->data_types);
 }
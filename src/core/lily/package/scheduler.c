@@ -0,0 +1,338 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2025 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/alloc.h>
+#include <base/assert.h>
+#include <base/new.h>
+#include <base/thread_pool.h>
+
+#include <core/lily/package/package.h>
+#include <core/lily/package/scheduler.h>
+
+/// @brief Get the node of the tree, or create it if it doesn't exist yet.
+/// @return LilyPackageSchedulerNode* (&)
+static LilyPackageSchedulerNode *
+get_or_add_node__LilyPackageScheduler(LilyPackageScheduler *self,
+                                      LilyPackageDependencyTree *tree);
+
+/// @brief Add an edge from `dependency` to `dependent` (if it doesn't exist
+/// yet).
+static void
+add_edge__LilyPackageScheduler(LilyPackageSchedulerNode *dependency,
+                               LilyPackageSchedulerNode *dependent);
+
+/// @brief Add the tree, its dependencies and its children to the DAG.
+/// @param parent LilyPackageSchedulerNode*? (&)
+static void
+add_tree__LilyPackageScheduler(LilyPackageScheduler *self,
+                               LilyPackageDependencyTree *tree,
+                               LilyPackageSchedulerNode *parent);
+
+/// @brief Return true if the node `lhs` must run before the node `rhs`.
+static bool
+cmp__LilyPackageSchedulerNode(const void *lhs, const void *rhs);
+
+/// @brief Run the ready nodes until all the nodes are done.
+/// @param self LilyPackageScheduler* (&)
+static void
+work__LilyPackageScheduler(void *self, Usize index);
+
+CONSTRUCTOR(LilyPackageSchedulerNode *,
+            LilyPackageSchedulerNode,
+            LilyPackageDependencyTree *tree,
+            Usize id)
+{
+    LilyPackageSchedulerNode *self =
+      lily_malloc(sizeof(LilyPackageSchedulerNode));
+
+    self->tree = tree;
+    self->dependents = NEW(Vec);
+    self->pending = 0;
+    self->id = id;
+    self->cost = 0;
+    self->priority = 0;
+
+    return self;
+}
+
+bool
+cmp__LilyPackageSchedulerNode(const void *lhs, const void *rhs)
+{
+    const LilyPackageSchedulerNode *lhs_node = lhs;
+    const LilyPackageSchedulerNode *rhs_node = rhs;
+
+    if (lhs_node->priority != rhs_node->priority) {
+        return lhs_node->priority > rhs_node->priority;
+    }
+
+    return lhs_node->id < rhs_node->id;
+}
+
+DESTRUCTOR(LilyPackageSchedulerNode, LilyPackageSchedulerNode *self)
+{
+    FREE(Vec, self->dependents);
+    lily_free(self);
+}
+
+LilyPackageSchedulerNode *
+get_or_add_node__LilyPackageScheduler(LilyPackageScheduler *self,
+                                      LilyPackageDependencyTree *tree)
+{
+    // NOTE: The packages are identified by their global name (see
+    // LilyPackageDependencyGraph).
+    LilyPackageSchedulerNode *node =
+      get__HashMap(self->lookup, tree->package->global_name->buffer);
+
+    if (!node) {
+        node = NEW(LilyPackageSchedulerNode, tree, self->nodes->len);
+
+        push__Vec(self->nodes, node);
+        insert__HashMap(self->lookup, tree->package->global_name->buffer, node);
+    }
+
+    return node;
+}
+
+void
+add_edge__LilyPackageScheduler(LilyPackageSchedulerNode *dependency,
+                               LilyPackageSchedulerNode *dependent)
+{
+    if (dependency == dependent) {
+        return;
+    }
+
+    for (Usize i = 0; i < dependency->dependents->len; ++i) {
+        if (get__Vec(dependency->dependents, i) == dependent) {
+            return;
+        }
+    }
+
+    push__Vec(dependency->dependents, dependent);
+    ++dependent->pending;
+}
+
+void
+add_tree__LilyPackageScheduler(LilyPackageScheduler *self,
+                               LilyPackageDependencyTree *tree,
+                               LilyPackageSchedulerNode *parent)
+{
+    LilyPackageSchedulerNode *node =
+      get_or_add_node__LilyPackageScheduler(self, tree);
+
+    if (parent) {
+        add_edge__LilyPackageScheduler(parent, node);
+    }
+
+    if (tree->dependencies) {
+        for (Usize i = 0; i < tree->dependencies->len; ++i) {
+            add_edge__LilyPackageScheduler(
+              get_or_add_node__LilyPackageScheduler(
+                self, get__Vec(tree->dependencies, i)),
+              node);
+        }
+    }
+
+    for (Usize i = 0; i < tree->children->len; ++i) {
+        add_tree__LilyPackageScheduler(self, get__Vec(tree->children, i), node);
+    }
+}
+
+CONSTRUCTOR(LilyPackageScheduler,
+            LilyPackageScheduler,
+            const Vec *trees,
+            void (*run)(LilyPackageDependencyTree *tree))
+{
+    LilyPackageScheduler self = { .nodes = NEW(Vec),
+                                  .lookup = NEW(HashMap),
+                                  .ready = NEW(BinaryHeap,
+                                               &cmp__LilyPackageSchedulerNode),
+                                  .remaining = 0,
+                                  .running = 0,
+                                  .run = run };
+
+    for (Usize i = 0; i < trees->len; ++i) {
+        add_tree__LilyPackageScheduler(&self, get__Vec(trees, i), NULL);
+    }
+
+    self.remaining = self.nodes->len;
+
+    ASSERT(!pthread_mutex_init(&self.mutex, NULL));
+    ASSERT(!pthread_cond_init(&self.cond, NULL));
+
+    return self;
+}
+
+Vec *
+get_order__LilyPackageScheduler(const LilyPackageScheduler *self)
+{
+    // NOTE: Kahn's algorithm.
+    Vec *order = NEW(Vec); // Vec<LilyPackageSchedulerNode* (&)>*
+
+    if (self->nodes->len == 0) {
+        return order;
+    }
+
+    Usize *pending = lily_malloc(sizeof(Usize) * self->nodes->len);
+
+    for (Usize i = 0; i < self->nodes->len; ++i) {
+        LilyPackageSchedulerNode *node = get__Vec(self->nodes, i);
+
+        pending[i] = node->pending;
+
+        if (pending[i] == 0) {
+            push__Vec(order, node);
+        }
+    }
+
+    for (Usize i = 0; i < order->len; ++i) {
+        LilyPackageSchedulerNode *node = get__Vec(order, i);
+
+        for (Usize j = 0; j < node->dependents->len; ++j) {
+            LilyPackageSchedulerNode *dependent = get__Vec(node->dependents, j);
+
+            if (--pending[dependent->id] == 0) {
+                push__Vec(order, dependent);
+            }
+        }
+    }
+
+    ASSERT(order->len == self->nodes->len);
+
+    lily_free(pending);
+
+    return order;
+}
+
+void
+set_costs__LilyPackageScheduler(LilyPackageScheduler *self,
+                                Uint64 (*get_cost)(const LilyPackage *package,
+                                                   void *ctx),
+                                void *ctx)
+{
+    Vec *order = get_order__LilyPackageScheduler(self);
+
+    // NOTE: Calculate the critical path of each node, from the end of the DAG.
+    for (Usize i = order->len; i-- > 0;) {
+        LilyPackageSchedulerNode *node = get__Vec(order, i);
+        Uint64 max = 0;
+
+        node->cost = get_cost(node->tree->package, ctx);
+
+        for (Usize j = 0; j < node->dependents->len; ++j) {
+            LilyPackageSchedulerNode *dependent = get__Vec(node->dependents, j);
+
+            if (dependent->priority > max) {
+                max = dependent->priority;
+            }
+        }
+
+        node->priority = node->cost + max;
+    }
+
+    FREE(Vec, order);
+}
+
+void
+work__LilyPackageScheduler(void *self, [[maybe_unused]] Usize index)
+{
+    LilyPackageScheduler *scheduler = self;
+
+    pthread_mutex_lock(&scheduler->mutex);
+
+    for (;;) {
+        while (empty__BinaryHeap(scheduler->ready) &&
+               scheduler->remaining > 0) {
+            if (scheduler->running == 0) {
+                UNREACHABLE("cycle in the package dependencies");
+            }
+
+            pthread_cond_wait(&scheduler->cond, &scheduler->mutex);
+        }
+
+        if (scheduler->remaining == 0) {
+            break;
+        }
+
+        LilyPackageSchedulerNode *node = pop__BinaryHeap(scheduler->ready);
+
+        ++scheduler->running;
+
+        pthread_mutex_unlock(&scheduler->mutex);
+
+        scheduler->run(node->tree);
+
+        pthread_mutex_lock(&scheduler->mutex);
+
+        node->tree->is_done = true;
+        --scheduler->running;
+        --scheduler->remaining;
+
+        for (Usize i = 0; i < node->dependents->len; ++i) {
+            LilyPackageSchedulerNode *dependent = get__Vec(node->dependents, i);
+
+            if (--dependent->pending == 0) {
+                push__BinaryHeap(scheduler->ready, dependent);
+            }
+        }
+
+        pthread_cond_broadcast(&scheduler->cond);
+    }
+
+    pthread_mutex_unlock(&scheduler->mutex);
+}
+
+void
+run__LilyPackageScheduler(LilyPackageScheduler *self)
+{
+    if (self->nodes->len == 0) {
+        return;
+    }
+
+    for (Usize i = 0; i < self->nodes->len; ++i) {
+        LilyPackageSchedulerNode *node = get__Vec(self->nodes, i);
+
+        if (node->pending == 0) {
+            push__BinaryHeap(self->ready, node);
+        }
+    }
+
+    Usize jobs = reserve_jobs__ThreadPool(self->nodes->len - 1);
+    ThreadPool pool = NEW(ThreadPool, jobs + 1);
+
+    // NOTE: Each task of the pool is a worker, which runs the packages as soon
+    // as they are ready.
+    run__ThreadPool(&pool, jobs + 1, &work__LilyPackageScheduler, self);
+    release_jobs__ThreadPool(jobs);
+}
+
+DESTRUCTOR(LilyPackageScheduler, LilyPackageScheduler *self)
+{
+    FREE_BUFFER_ITEMS(
+      self->nodes->buffer, self->nodes->len, LilyPackageSchedulerNode);
+    FREE(Vec, self->nodes);
+    FREE(HashMap, self->lookup);
+    FREE(BinaryHeap, self->ready);
+    pthread_mutex_destroy(&self->mutex);
+    pthread_cond_destroy(&self->cond);
+}
@@ -213,7 +213,12 @@ IMPL_FOR_DEBUG(to_string, LilyAstDeclFun, const LilyAstDeclFun *self)
     }
 
     push_str__String(res, ", body =");
-    DEBUG_VEC_STRING(self->body, res, LilyAstBodyFunItem);
+
+    if (self->body) {
+        DEBUG_VEC_STRING(self->body, res, LilyAstBodyFunItem);
+    } else {
+        push_str__String(res, " NULL");
+    }
 
     push_str__String(res, ", req =");
 
@@ -273,8 +278,11 @@ DESTRUCTOR(LilyAstDeclFun, const LilyAstDeclFun *self)
         FREE(LilyAstDataType, self->return_data_type);
     }
 
-    FREE_BUFFER_ITEMS(self->body->buffer, self->body->len, LilyAstBodyFunItem);
-    FREE(Vec, self->body);
+    if (self->body) {
+        FREE_BUFFER_ITEMS(
+          self->body->buffer, self->body->len, LilyAstBodyFunItem);
+        FREE(Vec, self->body);
+    }
 
     if (self->req) {
         FREE_BUFFER_ITEMS(self->req->buffer, self->req->len, LilyAstExpr);
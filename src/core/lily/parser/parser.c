@@ -25,6 +25,7 @@
 #include <base/atof.h>
 #include <base/atoi.h>
 #include <base/optional.h>
+#include <base/thread_pool.h>
 
 #include <core/lily/lily.h>
 #include <core/lily/package/package.h>
@@ -32,6 +33,7 @@
 #include <core/lily/parser/parser.h>
 
 #include <stdio.h>
+#include <time.h>
 
 // Free LilyParseBlock type.
 static inline DESTRUCTOR(LilyParseBlock, const LilyParseBlock *self);
@@ -553,6 +555,30 @@ is_patt__LilyParser(const Vec *tokens);
 static bool
 is_block__LilyParser(const Vec *tokens);
 
+// Get the wall-clock time in nanoseconds (used to time the macro expansions).
+static Uint64
+get_time__LilyParser();
+
+/// @param params Vec<Vec<LilyToken* (&)>*>* (&)
+/// @param expand_tokens Vec<LilyToken*?>* (&)
+static void
+push_expand_tokens__LilyParser(const LilyMacro *macro,
+                               const Vec *params,
+                               Vec *expand_tokens);
+
+/// Replaces all uses of the parameters in the macro with the values passed in
+/// the macro expand.
+/// @param params Vec<Vec<LilyToken* (&)>*>* (&)
+/// @param expand_tokens Vec<LilyToken*?>* (&)
+/// @param tokens Vec<LilyToken* (&)>* (&)
+/// @return false if a macro identifier is not found.
+static bool
+substitute_macro_params__LilyParser(LilyParser *self,
+                                    const LilyMacro *macro,
+                                    const Vec *params,
+                                    const Vec *expand_tokens,
+                                    Vec *tokens);
+
 /// @param body Body of record
 static void
 apply_macro_expansion_in_record__LilyParser(LilyParser *self,
@@ -611,6 +637,41 @@ parse_decl__LilyParser(LilyParser *self, LilyPreparserDecl *decl);
 static void
 parse_decls__LilyParser(LilyParser *self, Vec *decls, const Vec *pre_decls);
 
+// NOTE: From this number of declarations, the declarations of the package are
+// parsed in parallel (see parse_decls_in_parallel__LilyParser).
+#define LILY_PARSER_PARALLEL_MIN_DECLS 16
+
+// NOTE: The parser of the task is a shallow copy of the parser of the package
+// with its own decls (which receives the declarations pushed by the parse of a
+// multiple constant) and its own counters (the counters of its buffer, which
+// are added to the counters of the package at the join, see
+// flush__DiagnosticBuffer). The other fields (package, root_package and
+// preparser_info) are shared by all the tasks, and they're only read during
+// the parse (the macro expansions, which write in the package, are applied
+// during the merge).
+typedef struct LilyParserTask
+{
+    LilyParser parser;
+    LilyPreparserDecl *pre_decl; // LilyPreparserDecl* (&)
+    LilyAstDecl *decl;           // LilyAstDecl*?
+    DiagnosticBuffer diagnostics;
+} LilyParserTask;
+
+/// @brief Parse the declaration of the task.
+/// @param tasks LilyParserTask* (&)
+static void
+run_task__LilyParser(void *tasks, Usize index);
+
+// Parse the declarations on the threads of the pool. The diagnostics of each
+// declaration are buffered, then the diagnostics and the declarations are
+// merged in the order of the declarations, so the result (and the output) is
+// the same as parse_decls__LilyParser. The macro expansions are applied during
+// the merge.
+static void
+parse_decls_in_parallel__LilyParser(LilyParser *self,
+                                    Vec *decls,
+                                    const Vec *pre_decls);
+
 #define SKIP_TO_TOKEN(k)                                 \
     while (self->current->kind != k &&                   \
            self->current->kind != LILY_TOKEN_KIND_EOF) { \
@@ -717,8 +778,8 @@ CONSTRUCTOR(LilyParseBlock, LilyParseBlock, LilyParser *parser, Vec *tokens)
                              .current = get__Vec(tokens, 0),
                              .previous = get__Vec(tokens, 0),
                              .file = &parser->package->file,
-                             .count_error = &parser->package->count_error,
-                             .count_warning = &parser->package->count_warning,
+                             .count_error = parser->count_error,
+                             .count_warning = parser->count_warning,
                              .position = 0 };
 }
 
@@ -3763,12 +3824,14 @@ parse_expr__LilyParseBlock(LilyParseBlock *self)
                             remove__Vec(self->tokens, position_r_paren);
                         }
 
+                        LilyTokenBuffer tokens =
+                          from_vec__LilyTokenBuffer(self->tokens);
                         LilyPreparser preparser = NEW(
-                          LilyPreparser, self->file, self->tokens, NULL, false);
+                          LilyPreparser, self->file, &tokens, NULL, false);
 
                         preparser.position = self->position;
-                        preparser.current =
-                          get__Vec(preparser.tokens, preparser.position);
+                        preparser.current = get__LilyTokenBuffer(
+                          preparser.tokens, preparser.position);
 
                         LilyPreparserFunBodyItem *lambda =
                           preparse_lambda__LilyPreparser(&preparser);
@@ -3779,6 +3842,7 @@ parse_expr__LilyParseBlock(LilyParseBlock *self)
                               get__Vec(self->tokens, self->position);
                             self->previous =
                               get__Vec(self->tokens, self->position - 1);
+
                             *self->count_error += preparser.count_error;
                             *self->count_warning += preparser.count_warning;
 
@@ -3786,7 +3850,10 @@ parse_expr__LilyParseBlock(LilyParseBlock *self)
                                                                  lambda);
 
                             FREE(LilyPreparserFunBodyItem, lambda);
+                            FREE(LilyTokenBuffer, &tokens);
                         } else {
+                            FREE(LilyTokenBuffer, &tokens);
+
                             return NULL;
                         }
 
@@ -3896,7 +3963,7 @@ parse_capture__LilyParseBlock(LilyParseBlock *self)
                                 NULL,
                                 NULL,
                                 from__String("expected `,`")),
-                              &self->parser->package->count_error);
+                              self->count_error);
                     }
                 }
             }
@@ -3914,7 +3981,7 @@ parse_capture__LilyParseBlock(LilyParseBlock *self)
                               NULL,
                               NULL,
                               from__String("expected `do`")),
-                  &self->parser->package->count_error);
+                  self->count_error);
             }
 
             switch (multiple->len) {
@@ -4022,7 +4089,7 @@ parse_asm_stmt__LilyParser(LilyParser *self,
                       NULL,
                       NULL,
                       NULL),
-          &self->package->count_error);
+          self->count_error);
 
         return NULL;
     }
@@ -4403,7 +4470,7 @@ parse_raise_stmt__LilyParser(LilyParser *self,
                       NULL,
                       NULL,
                       NULL),
-          &self->package->count_error);
+          self->count_error);
 
         return NULL;
     }
@@ -4678,7 +4745,7 @@ parse_fun_body_item_for_stmt__LilyParser(LilyParser *self,
                         NULL,
                         NULL,
                         NULL),
-                      &self->package->count_error);
+                      self->count_error);
 
                     FREE_BUFFER_ITEMS(
                       body->buffer, body->len, LilyAstBodyFunItem);
@@ -4700,7 +4767,7 @@ parse_fun_body_item_for_stmt__LilyParser(LilyParser *self,
                 NULL,
                 NULL,
                 NULL),
-              &self->package->count_error);
+              self->count_error);
 
             return NULL;
         default:
@@ -6239,7 +6306,20 @@ parse_fun_decl__LilyParser(LilyParser *self, LilyPreparserDecl *decl)
     }
 
     // 4. Parse body
-    Vec *body = parse_fun_body__LilyParser(self, decl->fun.body);
+    Vec *body = NULL;               // Vec<LilyAstBodyFunItem*>*?
+    Vec *lazy_body = NULL;          // Vec<LilyPreparserFunBodyItem*>*? (&)
+    LilyParser *lazy_parser = NULL; // LilyParser*? (&)
+
+    // NOTE: The body can only be parsed later if the preparser info is owned by
+    // the package (which is not the case when a macro is expanded).
+    if (has_lazy_fun_body__LilyPackage(self->package) &&
+        self->preparser_info == &self->package->preparser_info &&
+        !decl->fun.is_operator) {
+        lazy_body = decl->fun.body;
+        lazy_parser = &self->package->parser;
+    } else {
+        body = parse_fun_body__LilyParser(self, decl->fun.body);
+    }
 
     // 5. Parse req
     Vec *req = NULL; // Vec<LilyAstExpr*>*?
@@ -6293,6 +6373,8 @@ parse_fun_decl__LilyParser(LilyParser *self, LilyPreparserDecl *decl)
                            params,
                            return_data_type,
                            body,
+                           lazy_body,
+                           lazy_parser,
                            req,
                            when,
                            decl->fun.visibility,
@@ -7352,6 +7434,189 @@ is_block__LilyParser(const Vec *tokens)
     return false;
 }
 
+Uint64
+get_time__LilyParser()
+{
+    struct timespec ts;
+
+    timespec_get(&ts, TIME_UTC);
+
+    return (Uint64)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+void
+push_expand_tokens__LilyParser(const LilyMacro *macro,
+                               const Vec *params,
+                               Vec *expand_tokens)
+{
+    for (Usize i = 0; i < macro->params->len; ++i) {
+        Vec *param = get__Vec(params, i);
+        Location location =
+          clone__Location(&CAST(LilyToken *, get__Vec(param, 0))->location);
+
+        {
+            LilyToken *last = last__Vec(param);
+
+            end__Location(&location,
+                          last->location.end_line,
+                          last->location.end_column,
+                          last->location.end_position);
+        }
+
+        enum LilyTokenExpandKind kind;
+
+        switch (CAST(LilyMacroParam *, get__Vec(macro->params, i))->kind) {
+            case LILY_MACRO_PARAM_KIND_EXPR:
+                kind = LILY_TOKEN_EXPAND_KIND_EXPR;
+                break;
+            case LILY_MACRO_PARAM_KIND_PATT:
+                kind = LILY_TOKEN_EXPAND_KIND_PATT;
+                break;
+            case LILY_MACRO_PARAM_KIND_PATH:
+                kind = LILY_TOKEN_EXPAND_KIND_PATH;
+                break;
+            case LILY_MACRO_PARAM_KIND_DT:
+                kind = LILY_TOKEN_EXPAND_KIND_DT;
+                break;
+            default:
+                push__Vec(expand_tokens, NULL);
+                continue;
+        }
+
+        push__Vec(expand_tokens,
+                  NEW_VARIANT(LilyToken,
+                              expand,
+                              location,
+                              NEW(LilyTokenExpand, kind, param)));
+    }
+}
+
+bool
+substitute_macro_params__LilyParser(LilyParser *self,
+                                    const LilyMacro *macro,
+                                    const Vec *params,
+                                    const Vec *expand_tokens,
+                                    Vec *tokens)
+{
+    for (Usize i = 0; i < tokens->len;) {
+        LilyToken *token = get__Vec(tokens, i);
+
+        // Looks for identifier macro.
+        switch (token->kind) {
+            case LILY_TOKEN_KIND_IDENTIFIER_MACRO:
+                // Checks if the macro identifier matches a parameter in the
+                // macro declaration, otherwise issues an error saying that `the
+                // macro identifier is not found`.
+                for (Usize j = 0; j < macro->params->len; ++j) {
+                    LilyMacroParam *param = get__Vec(macro->params, j);
+
+                    if (!strcmp(token->identifier_macro->buffer,
+                                param->name->buffer)) {
+                        Vec *macro_expand_param = get__Vec(params, j);
+
+                        remove__Vec(tokens, i);
+
+                        // See if it is possible to push otherwise inserted at
+                        // the position of the `identifier_macro`.
+                        if (i > tokens->len) {
+                            switch (param->kind) {
+                                case LILY_MACRO_PARAM_KIND_TKS:
+                                    for (Usize k = 2;
+                                         k < macro_expand_param->len - 1;
+                                         ++k) {
+                                        push__Vec(
+                                          tokens,
+                                          get__Vec(macro_expand_param, k));
+                                    }
+                                    break;
+                                case LILY_MACRO_PARAM_KIND_EXPR:
+                                case LILY_MACRO_PARAM_KIND_PATT:
+                                case LILY_MACRO_PARAM_KIND_PATH:
+                                case LILY_MACRO_PARAM_KIND_DT:
+                                    push__Vec(tokens,
+                                              get__Vec(expand_tokens, j));
+                                    break;
+                                default:
+                                    for (Usize k = 0;
+                                         k < macro_expand_param->len;
+                                         ++k) {
+                                        push__Vec(
+                                          tokens,
+                                          get__Vec(macro_expand_param, k));
+                                    }
+                            }
+                        } else {
+                            switch (param->kind) {
+                                case LILY_MACRO_PARAM_KIND_TKS:
+                                    for (Usize k = 2;
+                                         k < macro_expand_param->len - 1;
+                                         ++k) {
+                                        insert__Vec(
+                                          tokens,
+                                          get__Vec(macro_expand_param, k),
+                                          i + (k - 2));
+                                    }
+                                    break;
+                                case LILY_MACRO_PARAM_KIND_EXPR:
+                                case LILY_MACRO_PARAM_KIND_PATT:
+                                case LILY_MACRO_PARAM_KIND_PATH:
+                                case LILY_MACRO_PARAM_KIND_DT:
+                                    insert__Vec(
+                                      tokens, get__Vec(expand_tokens, j), i);
+                                    break;
+                                default:
+                                    for (Usize k = 0;
+                                         k < macro_expand_param->len;
+                                         ++k) {
+                                        insert__Vec(
+                                          tokens,
+                                          get__Vec(macro_expand_param, k),
+                                          i + k);
+                                    }
+                            }
+                        }
+
+                        i += macro_expand_param->len;
+
+                        goto exit_loop;
+                    }
+                }
+
+                {
+                    const File *file = get_file_from_filename__LilyPackage(
+                      self->root_package, macro->location.filename);
+
+                    emit__Diagnostic(
+                      NEW_VARIANT(
+                        Diagnostic,
+                        simple_lily_error,
+                        file,
+                        &token->location,
+                        NEW(LilyError,
+                            LILY_ERROR_KIND_MACRO_IDENTIFIER_NOT_FOUND),
+                        NULL,
+                        NULL,
+                        format__String("unknown macro identifier named {S}",
+                                       token->identifier_macro)),
+                      self->count_error);
+
+                    return false;
+                }
+
+            exit_loop: {
+            }
+
+                break;
+            default:
+                break;
+        }
+
+        ++i;
+    }
+
+    return true;
+}
+
 #define CHECK_MACRO(decl)                                                          \
     /* 1. Looks for the macro. */                                                  \
     LilyMacro *macro =                                                             \
@@ -7367,7 +7632,7 @@ is_block__LilyParser(const Vec *tokens)
                       NULL,                                                        \
                       NULL,                                                        \
                       NULL),                                                       \
-          &self->package->count_error);                                            \
+          self->count_error);                                            \
                                                                                    \
         return;                                                                    \
     }                                                                              \
@@ -7385,7 +7650,34 @@ is_block__LilyParser(const Vec *tokens)
            macro->tokens->buffer,                                                  \
            macro->tokens->capacity *PTR_SIZE);                                     \
                                                                                    \
-    if (decl->macro_expand.params && macro->params) {                              \
+    /* NOTE: The expansion is memoized for the same sequence of tokens passed      \
+     * in the parameters, so the parameters don't need to be checked again. */     \
+    const LilyMacroExpansion *expansion = NULL; /* const LilyMacroExpansion*? */   \
+    String *expansion_key = NULL;               /* String*? */                     \
+    Uint64 expansion_start = get_time__LilyParser();                               \
+                                                                                   \
+    if (decl->macro_expand.params && macro->params &&                              \
+        decl->macro_expand.params->len == macro->params->len) {                    \
+        expansion_key = get_expansion_key__LilyMacro(decl->macro_expand.params);   \
+        expansion = get_expansion__LilyMacro(macro, expansion_key);                \
+    }                                                                              \
+                                                                                   \
+    if (expansion) {                                                               \
+        FREE(String, expansion_key);                                               \
+        expansion_key = NULL;                                                      \
+                                                                                   \
+        expand_tokens = NEW(Vec);                                                  \
+                                                                                   \
+        push_expand_tokens__LilyParser(                                            \
+          macro, decl->macro_expand.params, expand_tokens);                        \
+        apply_expansion__LilyMacro(macro,                                          \
+                                   expansion,                                      \
+                                   decl->macro_expand.params,                      \
+                                   expand_tokens,                                  \
+                                   &macro_tokens_copy);                            \
+                                                                                   \
+        ++self->package->count_memoized_macro_expansion;                           \
+    } else if (decl->macro_expand.params && macro->params) {                       \
         if (decl->macro_expand.params->len > macro->params->len) {                 \
             emit__Diagnostic(                                                      \
               NEW_VARIANT(                                                         \
@@ -7401,7 +7693,7 @@ is_block__LilyParser(const Vec *tokens)
                   "expected {d} parameters, obtained {d} parameters",              \
                   macro->params->len,                                              \
                   decl->macro_expand.params->len)),                                \
-              &self->package->count_error);                                        \
+              self->count_error);                                        \
                                                                                    \
             return;                                                                \
         } else if (decl->macro_expand.params->len < macro->params->len) {          \
@@ -7418,7 +7710,7 @@ is_block__LilyParser(const Vec *tokens)
                   "expected {d} parameters, obtained {d} parameters",              \
                   macro->params->len,                                              \
                   decl->macro_expand.params->len)),                                \
-              &self->package->count_error);                                        \
+              self->count_error);                                        \
                                                                                    \
             return;                                                                \
         } else {                                                                   \
@@ -7448,7 +7740,7 @@ is_block__LilyParser(const Vec *tokens)
                                 NULL,                                              \
                                 format__String("at parameter number {d}",          \
                                                i + 1)),                            \
-                              &self->package->count_error);                        \
+                              self->count_error);                        \
                                                                                    \
                             continue;                                              \
                         }                                                          \
@@ -7469,7 +7761,7 @@ is_block__LilyParser(const Vec *tokens)
                                 NULL,                                              \
                                 format__String("at parameter number {d}",          \
                                                i + 1)),                            \
-                              &self->package->count_error);                        \
+                              self->count_error);                        \
                                                                                    \
                             continue;                                              \
                         }                                                          \
@@ -7490,7 +7782,7 @@ is_block__LilyParser(const Vec *tokens)
                                 NULL,                                              \
                                 format__String("at parameter number {d}",          \
                                                i + 1)),                            \
-                              &self->package->count_error);                        \
+                              self->count_error);                        \
                                                                                    \
                             continue;                                              \
                         }                                                          \
@@ -7511,7 +7803,7 @@ is_block__LilyParser(const Vec *tokens)
                                 NULL,                                              \
                                 format__String("at parameter number {d}",          \
                                                i + 1)),                            \
-                              &self->package->count_error);                        \
+                              self->count_error);                        \
                                                                                    \
                             continue;                                              \
                         }                                                          \
@@ -7532,7 +7824,7 @@ is_block__LilyParser(const Vec *tokens)
                                 NULL,                                              \
                                 format__String("at parameter number {d}",          \
                                                i + 1)),                            \
-                              &self->package->count_error);                        \
+                              self->count_error);                        \
                                                                                    \
                             continue;                                              \
                         }                                                          \
@@ -7553,7 +7845,7 @@ is_block__LilyParser(const Vec *tokens)
                                 NULL,                                              \
                                 format__String("at parameter number {d}",          \
                                                i + 1)),                            \
-                              &self->package->count_error);                        \
+                              self->count_error);                        \
                                                                                    \
                             continue;                                              \
                         }                                                          \
@@ -7574,7 +7866,7 @@ is_block__LilyParser(const Vec *tokens)
                                 NULL,                                              \
                                 format__String("at parameter number {d}",          \
                                                i + 1)),                            \
-                              &self->package->count_error);                        \
+                              self->count_error);                        \
                                                                                    \
                             continue;                                              \
                         }                                                          \
@@ -7595,7 +7887,7 @@ is_block__LilyParser(const Vec *tokens)
                                 NULL,                                              \
                                 format__String("at parameter number {d}",          \
                                                i + 1)),                            \
-                              &self->package->count_error);                        \
+                              self->count_error);                        \
                                                                                    \
                             continue;                                              \
                         }                                                          \
@@ -7616,7 +7908,7 @@ is_block__LilyParser(const Vec *tokens)
                                 NULL,                                              \
                                 format__String("at parameter number {d}",          \
                                                i + 1)),                            \
-                              &self->package->count_error);                        \
+                              self->count_error);                        \
                                                                                    \
                             continue;                                              \
                         }                                                          \
@@ -7625,218 +7917,23 @@ is_block__LilyParser(const Vec *tokens)
                     default:                                                       \
                         UNREACHABLE("unknown variant");                            \
                 }                                                                  \
+            }                                                                      \
                                                                                    \
-                /* Fill in the vector of expansion tokens to be able to save       \
-                 * them locally and free them at the end of the analysis of        \
-                 * the macro. */                                                   \
-                for (Usize i = 0; i < macro->params->len; ++i) {                   \
-                    Location location = clone__Location(                           \
-                      &CAST(LilyToken *,                                           \
-                            CAST(Vec *, decl->macro_expand.params->buffer[i])      \
-                              ->buffer[0])                                         \
-                         ->location);                                              \
-                    {                                                              \
-                        LilyToken *last =                                          \
-                          last__Vec(decl->macro_expand.params->buffer[i]);         \
-                        end__Location(&location,                                   \
-                                      last->location.end_line,                     \
-                                      last->location.end_column,                   \
-                                      last->location.end_position);                \
-                    }                                                              \
-                    switch (CAST(LilyMacroParam *, get__Vec(macro->params, i))     \
-                              ->kind) {                                            \
-                        case LILY_MACRO_PARAM_KIND_EXPR:                           \
-                            push__Vec(                                             \
-                              expand_tokens,                                       \
-                              NEW_VARIANT(                                         \
-                                LilyToken,                                         \
-                                expand,                                            \
-                                location,                                          \
-                                NEW(LilyTokenExpand,                               \
-                                    LILY_TOKEN_EXPAND_KIND_EXPR,                   \
-                                    get__Vec(decl->macro_expand.params, i))));     \
-                            break;                                                 \
-                        case LILY_MACRO_PARAM_KIND_PATT:                           \
-                            push__Vec(                                             \
-                              expand_tokens,                                       \
-                              NEW_VARIANT(                                         \
-                                LilyToken,                                         \
-                                expand,                                            \
-                                location,                                          \
-                                NEW(LilyTokenExpand,                               \
-                                    LILY_TOKEN_EXPAND_KIND_PATT,                   \
-                                    get__Vec(decl->macro_expand.params, i))));     \
-                            break;                                                 \
-                        case LILY_MACRO_PARAM_KIND_PATH:                           \
-                            push__Vec(                                             \
-                              expand_tokens,                                       \
-                              NEW_VARIANT(                                         \
-                                LilyToken,                                         \
-                                expand,                                            \
-                                location,                                          \
-                                NEW(LilyTokenExpand,                               \
-                                    LILY_TOKEN_EXPAND_KIND_PATH,                   \
-                                    get__Vec(decl->macro_expand.params, i))));     \
-                            break;                                                 \
-                        case LILY_MACRO_PARAM_KIND_DT:                             \
-                            push__Vec(                                             \
-                              expand_tokens,                                       \
-                              NEW_VARIANT(                                         \
-                                LilyToken,                                         \
-                                expand,                                            \
-                                location,                                          \
-                                NEW(LilyTokenExpand,                               \
-                                    LILY_TOKEN_EXPAND_KIND_DT,                     \
-                                    get__Vec(decl->macro_expand.params, i))));     \
-                            break;                                                 \
-                        default:                                                   \
-                            push__Vec(expand_tokens, NULL);                        \
-                    }                                                              \
-                }                                                                  \
-                                                                                   \
-                /* Replaces all uses of the parameter in the macro with the        \
-                value passed in the macro expansion. */                            \
-                                                                                   \
-                for (Usize i = 0; i < macro_tokens_copy.len;) {                    \
-                    LilyToken *token = get__Vec(&macro_tokens_copy, i);            \
-                                                                                   \
-                    /* Looks for identifier macro. */                              \
-                    switch (token->kind) {                                         \
-                        case LILY_TOKEN_KIND_IDENTIFIER_MACRO:                     \
-                            /* Checks if the macro identifier matches a            \
-                            parameter in the macro declaration, otherwise          \
-                            issues an error saying that `the macro identifier      \
-                            is not found`. */                                      \
-                            for (Usize j = 0; j < macro->params->len; ++j) {       \
-                                LilyMacroParam *param =                            \
-                                  get__Vec(macro->params, j);                      \
-                                                                                   \
-                                if (!strcmp(token->identifier_macro->buffer,       \
-                                            param->name->buffer)) {                \
-                                    Vec *macro_expand_param =                      \
-                                      get__Vec(decl->macro_expand.params, j);      \
-                                                                                   \
-                                    remove__Vec(&macro_tokens_copy, i);            \
-                                                                                   \
-                                    /* See if it is possible to push otherwise     \
-                                    inserted at the position of the                \
-                                    `identifier_macro`. */                         \
-                                    if (i > macro_tokens_copy.len) {               \
-                                        switch (param->kind) {                     \
-                                            case LILY_MACRO_PARAM_KIND_TKS:        \
-                                                for (Usize k = 2;                  \
-                                                     k <                           \
-                                                     macro_expand_param->len -     \
-                                                       1;                          \
-                                                     ++k) {                        \
-                                                    push__Vec(                     \
-                                                      &macro_tokens_copy,          \
-                                                      get__Vec(                    \
-                                                        macro_expand_param,        \
-                                                        k));                       \
-                                                }                                  \
-                                                break;                             \
-                                            case LILY_MACRO_PARAM_KIND_EXPR:       \
-                                            case LILY_MACRO_PARAM_KIND_PATT:       \
-                                            case LILY_MACRO_PARAM_KIND_PATH:       \
-                                            case LILY_MACRO_PARAM_KIND_DT:         \
-                                                push__Vec(                         \
-                                                  &macro_tokens_copy,              \
-                                                  get__Vec(expand_tokens, j));     \
-                                                break;                             \
-                                            default:                               \
-                                                for (Usize k = 0;                  \
-                                                     k <                           \
-                                                     macro_expand_param->len;      \
-                                                     ++k) {                        \
-                                                    push__Vec(                     \
-                                                      &macro_tokens_copy,          \
-                                                      get__Vec(                    \
-                                                        macro_expand_param,        \
-                                                        k));                       \
-                                                }                                  \
-                                        }                                          \
-                                    } else {                                       \
-                                        switch (param->kind) {                     \
-                                            case LILY_MACRO_PARAM_KIND_TKS:        \
-                                                for (Usize k = 2;                  \
-                                                     k <                           \
-                                                     macro_expand_param->len -     \
-                                                       1;                          \
-                                                     ++k) {                        \
-                                                    insert__Vec(                   \
-                                                      &macro_tokens_copy,          \
-                                                      get__Vec(                    \
-                                                        macro_expand_param,        \
-                                                        k),                        \
-                                                      i + (k - 2));                \
-                                                }                                  \
-                                                break;                             \
-                                            case LILY_MACRO_PARAM_KIND_EXPR:       \
-                                            case LILY_MACRO_PARAM_KIND_PATT:       \
-                                            case LILY_MACRO_PARAM_KIND_PATH:       \
-                                            case LILY_MACRO_PARAM_KIND_DT:         \
-                                                insert__Vec(                       \
-                                                  &macro_tokens_copy,              \
-                                                  get__Vec(expand_tokens, j),      \
-                                                  i);                              \
-                                                break;                             \
-                                            default:                               \
-                                                for (Usize k = 0;                  \
-                                                     k <                           \
-                                                     macro_expand_param->len;      \
-                                                     ++k) {                        \
-                                                    insert__Vec(                   \
-                                                      &macro_tokens_copy,          \
-                                                      get__Vec(                    \
-                                                        macro_expand_param,        \
-                                                        k),                        \
-                                                      i + k);                      \
-                                                }                                  \
-                                        }                                          \
-                                    }                                              \
-                                                                                   \
-                                    i += macro_expand_param->len;                  \
-                                                                                   \
-                                    goto exit_loop;                                \
-                                }                                                  \
-                            }                                                      \
-                                                                                   \
-                            {                                                      \
-                                const File *file =                                 \
-                                  get_file_from_filename__LilyPackage(             \
-                                    self->root_package,                            \
-                                    macro->location.filename);                     \
-                                                                                   \
-                                emit__Diagnostic(                                  \
-                                  NEW_VARIANT(                                     \
-                                    Diagnostic,                                    \
-                                    simple_lily_error,                             \
-                                    file,                                          \
-                                    &token->location,                              \
-                                    NEW(                                           \
-                                      LilyError,                                   \
-                                      LILY_ERROR_KIND_MACRO_IDENTIFIER_NOT_FOUND), \
-                                    NULL,                                          \
-                                    NULL,                                          \
-                                    format__String(                                \
-                                      "unknown macro identifier named {S}",        \
-                                      token->identifier_macro)),                   \
-                                  &self->package->count_error);                    \
-                                                                                   \
-                                return;                                            \
-                            }                                                      \
-                                                                                   \
-                        exit_loop: {                                               \
-                        }                                                          \
+            /* Fill in the vector of expansion tokens to be able to save           \
+             * them locally and free them at the end of the analysis of the        \
+             * macro. */                                                           \
+            push_expand_tokens__LilyParser(                                        \
+              macro, decl->macro_expand.params, expand_tokens);                    \
                                                                                    \
-                        break;                                                     \
-                        default:                                                   \
-                            break;                                                 \
-                    }                                                              \
+            if (!substitute_macro_params__LilyParser(                              \
+                  self,                                                            \
+                  macro,                                                           \
+                  decl->macro_expand.params,                                       \
+                  expand_tokens,                                                   \
+                  &macro_tokens_copy)) {                                           \
+                FREE(String, expansion_key);                                       \
                                                                                    \
-                    ++i;                                                           \
-                }                                                                  \
+                return;                                                            \
             }                                                                      \
         }                                                                          \
     } else if (decl->macro_expand.params || macro->params) {                       \
@@ -7852,7 +7949,7 @@ is_block__LilyParser(const Vec *tokens)
                 NULL,                                                              \
                 NULL,                                                              \
                 NULL),                                                             \
-              &self->package->count_error);                                        \
+              self->count_error);                                        \
         } else {                                                                   \
             emit__Diagnostic(                                                      \
               NEW_VARIANT(                                                         \
@@ -7864,20 +7961,42 @@ is_block__LilyParser(const Vec *tokens)
                 NULL,                                                              \
                 NULL,                                                              \
                 NULL),                                                             \
-              &self->package->count_error);                                        \
+              self->count_error);                                        \
         }                                                                          \
                                                                                    \
         return;                                                                    \
     }                                                                              \
                                                                                    \
-    if (self->package->count_error > 0) {                                          \
+    if (*self->count_error > 0) {                                                  \
+        if (expansion_key) {                                                       \
+            FREE(String, expansion_key);                                           \
+        }                                                                          \
+                                                                                   \
         return;                                                                    \
-    }
+    }                                                                              \
+                                                                                   \
+    /* NOTE: The key is only built once, and on a miss it's moved to the           \
+     * memoized expansion. */                                                      \
+    if (expansion_key) {                                                           \
+        add_expansion__LilyMacro(macro,                                            \
+                                 expansion_key,                                    \
+                                 decl->macro_expand.params,                        \
+                                 expand_tokens,                                    \
+                                 &macro_tokens_copy);                              \
+    }                                                                              \
+                                                                                   \
+    ++self->package->count_macro_expansion;                                        \
+    self->package->macro_expansion_duration +=                                     \
+      get_time__LilyParser() - expansion_start;                                    \
+                                                                                   \
+    LilyTokenBuffer macro_tokens =                                                 \
+      from_vec__LilyTokenBuffer(&macro_tokens_copy);
 
 #define CLEAN_UP_CHECK_MACRO(id, dt)                       \
     FREE_BUFFER_ITEMS(id->buffer, id->len, dt);            \
     FREE(Vec, id);                                         \
     lily_free(macro_tokens_copy.buffer);                   \
+    FREE(LilyTokenBuffer, &macro_tokens);                  \
     if (expand_tokens) {                                   \
         for (Usize i = 0; i < expand_tokens->len; ++i) {   \
             LilyToken *token = get__Vec(expand_tokens, i); \
@@ -7901,9 +8020,9 @@ apply_macro_expansion_in_record__LilyParser(LilyParser *self,
         const File *file = get_file_from_filename__LilyPackage(
           self->root_package, macro->location.filename);
         LilyPreparser preparse_macro_expand =
-          NEW(LilyPreparser, file, &macro_tokens_copy, NULL, false);
+          NEW(LilyPreparser, file, &macro_tokens, NULL, false);
 
-        preparse_macro_expand.current = get__Vec(&macro_tokens_copy, 0);
+        preparse_macro_expand.current = get__LilyTokenBuffer(&macro_tokens, 0);
 
         Vec *pre_record_body_items =
           preparse_record_body__LilyPreparser(&preparse_macro_expand);
@@ -7919,6 +8038,8 @@ apply_macro_expansion_in_record__LilyParser(LilyParser *self,
                                           .root_package = self->root_package,
                                           .current = NULL,
                                           .preparser_info = NULL,
+                                          .count_error = self->count_error,
+                                          .count_warning = self->count_warning,
                                           .position = 0 };
 
         for (Usize i = 0; i < pre_record_body_items->len; ++i) {
@@ -7948,9 +8069,9 @@ apply_macro_expansion_in_enum__LilyParser(LilyParser *self,
         const File *file = get_file_from_filename__LilyPackage(
           self->root_package, macro->location.filename);
         LilyPreparser preparse_macro_expand =
-          NEW(LilyPreparser, file, &macro_tokens_copy, NULL, false);
+          NEW(LilyPreparser, file, &macro_tokens, NULL, false);
 
-        preparse_macro_expand.current = get__Vec(&macro_tokens_copy, 0);
+        preparse_macro_expand.current = get__LilyTokenBuffer(&macro_tokens, 0);
 
         Vec *pre_enum_body_items =
           preparse_enum_body__LilyPreparser(&preparse_macro_expand);
@@ -7966,6 +8087,8 @@ apply_macro_expansion_in_enum__LilyParser(LilyParser *self,
                                           .root_package = self->root_package,
                                           .current = NULL,
                                           .preparser_info = NULL,
+                                          .count_error = self->count_error,
+                                          .count_warning = self->count_warning,
                                           .position = 0 };
 
         for (Usize i = 0; i < pre_enum_body_items->len; ++i) {
@@ -7994,9 +8117,9 @@ apply_macro_expansion_in_class__LilyParser(LilyParser *self,
         const File *file = get_file_from_filename__LilyPackage(
           self->root_package, macro->location.filename);
         LilyPreparser preparse_macro_expand =
-          NEW(LilyPreparser, file, &macro_tokens_copy, NULL, false);
+          NEW(LilyPreparser, file, &macro_tokens, NULL, false);
 
-        preparse_macro_expand.current = get__Vec(&macro_tokens_copy, 0);
+        preparse_macro_expand.current = get__LilyTokenBuffer(&macro_tokens, 0);
 
         Vec *pre_class_body_items =
           preparse_class_body__LilyPreparser(&preparse_macro_expand);
@@ -8012,6 +8135,8 @@ apply_macro_expansion_in_class__LilyParser(LilyParser *self,
                                           .root_package = self->root_package,
                                           .current = NULL,
                                           .preparser_info = NULL,
+                                          .count_error = self->count_error,
+                                          .count_warning = self->count_warning,
                                           .position = 0 };
 
         Vec *expand_body =
@@ -8038,9 +8163,9 @@ apply_macro_expansion_in_record_object__LilyParser(
         const File *file = get_file_from_filename__LilyPackage(
           self->root_package, macro->location.filename);
         LilyPreparser preparse_macro_expand =
-          NEW(LilyPreparser, file, &macro_tokens_copy, NULL, false);
+          NEW(LilyPreparser, file, &macro_tokens, NULL, false);
 
-        preparse_macro_expand.current = get__Vec(&macro_tokens_copy, 0);
+        preparse_macro_expand.current = get__LilyTokenBuffer(&macro_tokens, 0);
 
         Vec *pre_record_object_body_items =
           preparse_record_object_body__LilyPreparser(&preparse_macro_expand);
@@ -8056,6 +8181,8 @@ apply_macro_expansion_in_record_object__LilyParser(
                                           .root_package = self->root_package,
                                           .current = NULL,
                                           .preparser_info = NULL,
+                                          .count_error = self->count_error,
+                                          .count_warning = self->count_warning,
                                           .position = 0 };
 
         Vec *expand_body = parse_record_object_body__LilyParser(
@@ -8083,9 +8210,9 @@ apply_macro_expansion_in_enum_object__LilyParser(
         const File *file = get_file_from_filename__LilyPackage(
           self->root_package, macro->location.filename);
         LilyPreparser preparse_macro_expand =
-          NEW(LilyPreparser, file, &macro_tokens_copy, NULL, false);
+          NEW(LilyPreparser, file, &macro_tokens, NULL, false);
 
-        preparse_macro_expand.current = get__Vec(&macro_tokens_copy, 0);
+        preparse_macro_expand.current = get__LilyTokenBuffer(&macro_tokens, 0);
 
         Vec *pre_enum_object_body_items =
           preparse_enum_object_body__LilyPreparser(&preparse_macro_expand);
@@ -8101,6 +8228,8 @@ apply_macro_expansion_in_enum_object__LilyParser(
                                           .root_package = self->root_package,
                                           .current = NULL,
                                           .preparser_info = NULL,
+                                          .count_error = self->count_error,
+                                          .count_warning = self->count_warning,
                                           .position = 0 };
 
         Vec *expand_body = parse_enum_object_body__LilyParser(
@@ -8127,9 +8256,9 @@ apply_macro_expansion_in_trait__LilyParser(LilyParser *self,
         const File *file = get_file_from_filename__LilyPackage(
           self->root_package, macro->location.filename);
         LilyPreparser preparse_macro_expand =
-          NEW(LilyPreparser, file, &macro_tokens_copy, NULL, false);
+          NEW(LilyPreparser, file, &macro_tokens, NULL, false);
 
-        preparse_macro_expand.current = get__Vec(&macro_tokens_copy, 0);
+        preparse_macro_expand.current = get__LilyTokenBuffer(&macro_tokens, 0);
 
         Vec *pre_trait_body_items =
           preparse_trait_body__LilyPreparser(&preparse_macro_expand);
@@ -8145,6 +8274,8 @@ apply_macro_expansion_in_trait__LilyParser(LilyParser *self,
                                           .root_package = self->root_package,
                                           .current = NULL,
                                           .preparser_info = NULL,
+                                          .count_error = self->count_error,
+                                          .count_warning = self->count_warning,
                                           .position = 0 };
 
         Vec *expand_body =
@@ -8176,9 +8307,9 @@ apply_macro_expansion_in_fun__LilyParser(LilyParser *self,
         const File *file = get_file_from_filename__LilyPackage(
           self->root_package, macro->location.filename);
         LilyPreparser preparse_macro_expand =
-          NEW(LilyPreparser, file, &macro_tokens_copy, NULL, false);
+          NEW(LilyPreparser, file, &macro_tokens, NULL, false);
 
-        preparse_macro_expand.current = get__Vec(&macro_tokens_copy, 0);
+        preparse_macro_expand.current = get__LilyTokenBuffer(&macro_tokens, 0);
 
         Vec *pre_fun_body_items = NEW(Vec);
 
@@ -8201,6 +8332,8 @@ apply_macro_expansion_in_fun__LilyParser(LilyParser *self,
                                           .root_package = self->root_package,
                                           .current = NULL,
                                           .preparser_info = NULL,
+                                          .count_error = self->count_error,
+                                          .count_warning = self->count_warning,
                                           .position = 0 };
 
         Vec *expand_body =
@@ -8227,7 +8360,7 @@ apply_macro_expansion__LilyParser(LilyParser *self,
           self->root_package, macro->location.filename);
         LilyPreparserInfo preparser_info = NEW(LilyPreparserInfo, NULL);
         LilyPreparser preparse_macro_expand =
-          NEW(LilyPreparser, file, &macro_tokens_copy, NULL, false);
+          NEW(LilyPreparser, file, &macro_tokens, NULL, false);
 
         run__LilyPreparser(&preparse_macro_expand, &preparser_info);
 
@@ -8256,6 +8389,7 @@ apply_macro_expansion__LilyParser(LilyParser *self,
         FREE(LilyPreparserInfo, &preparser_info);
         FREE(Vec, parser.decls);
         lily_free(macro_tokens_copy.buffer);
+        FREE(LilyTokenBuffer, &macro_tokens);
 
         if (expand_tokens) {
             for (Usize i = 0; i < expand_tokens->len; ++i) {
@@ -8325,6 +8459,8 @@ CONSTRUCTOR(LilyParser,
                          .preparser_info = preparser_info
                                              ? preparser_info
                                              : &package->preparser_info,
+                         .count_error = &package->count_error,
+                         .count_warning = &package->count_warning,
                          .position = 0 };
 }
 
@@ -8360,12 +8496,103 @@ parse_decls__LilyParser(LilyParser *self, Vec *decls, const Vec *pre_decls)
     }
 }
 
+void
+run_task__LilyParser(void *tasks, Usize index)
+{
+    LilyParserTask *task = &CAST(LilyParserTask *, tasks)[index];
+
+    // NOTE: The macro expansions are applied during the merge.
+    if (task->pre_decl->kind == LILY_PREPARSER_DECL_KIND_MACRO_EXPAND) {
+        return;
+    }
+
+    set_buffer__Diagnostic(&task->diagnostics);
+
+    task->decl = parse_decl__LilyParser(&task->parser, task->pre_decl);
+
+    set_buffer__Diagnostic(NULL);
+}
+
+void
+parse_decls_in_parallel__LilyParser(LilyParser *self,
+                                    Vec *decls,
+                                    const Vec *pre_decls)
+{
+    LilyParserTask *tasks =
+      lily_malloc(sizeof(LilyParserTask) * pre_decls->len);
+    // NOTE: The parser can run in a thread of the scheduler, so the threads
+    // are reserved from the budget shared by all the runs.
+    Usize jobs = reserve_jobs__ThreadPool(pre_decls->len - 1);
+    ThreadPool pool = NEW(ThreadPool, jobs + 1);
+
+    for (Usize i = 0; i < pre_decls->len; ++i) {
+        tasks[i] = (LilyParserTask){ .parser = *self,
+                                     .pre_decl = get__Vec(pre_decls, i),
+                                     .decl = NULL,
+                                     .diagnostics = NEW(DiagnosticBuffer) };
+        tasks[i].parser.decls = NEW(Vec);
+        tasks[i].parser.count_error = &tasks[i].diagnostics.count_error;
+        tasks[i].parser.count_warning = &tasks[i].diagnostics.count_warning;
+    }
+
+    run__ThreadPool(&pool, pre_decls->len, &run_task__LilyParser, tasks);
+    release_jobs__ThreadPool(jobs);
+
+    for (Usize i = 0; i < pre_decls->len; ++i) {
+        LilyParserTask *task = &tasks[i];
+
+        switch (task->pre_decl->kind) {
+            case LILY_PREPARSER_DECL_KIND_MACRO_EXPAND:
+                apply_macro_expansion__LilyParser(self, task->pre_decl, decls);
+
+                break;
+            default:
+                flush__DiagnosticBuffer(&task->diagnostics,
+                                        &self->package->count_error,
+                                        &self->package->count_warning);
+
+                for (Usize j = 0; j < task->parser.decls->len; ++j) {
+                    push__Vec(self->decls, get__Vec(task->parser.decls, j));
+                }
+
+                if (task->decl) {
+                    push__Vec(decls, task->decl);
+                }
+        }
+
+        FREE(DiagnosticBuffer, &task->diagnostics);
+        FREE(Vec, task->parser.decls);
+    }
+
+    lily_free(tasks);
+}
+
 void
 run__LilyParser(LilyParser *self, bool parse_for_macro_expand)
 {
-    parse_decls__LilyParser(self, self->decls, self->preparser_info->decls);
+    if (!parse_for_macro_expand &&
+        self->preparser_info->decls->len >= LILY_PARSER_PARALLEL_MIN_DECLS &&
+        get_default_jobs__ThreadPool() > 1) {
+        parse_decls_in_parallel__LilyParser(
+          self, self->decls, self->preparser_info->decls);
+    } else {
+        parse_decls__LilyParser(
+          self, self->decls, self->preparser_info->decls);
+    }
 
     if (!parse_for_macro_expand) {
+        if (self->package->count_macro_expansion > 0) {
+            char *msg = format(
+              "expanded {zu} macro(s) ({zu} memoized) in {f}s",
+              atomic_load(&self->package->count_macro_expansion),
+              atomic_load(&self->package->count_memoized_macro_expansion),
+              (Float64)atomic_load(&self->package->macro_expansion_duration) /
+                1000000000);
+
+            LOG_VERBOSE(self->package, msg);
+            lily_free(msg);
+        }
+
 #ifdef DEBUG_PARSER
         printf("====Parser(%s)====\n", self->package->file.name);
 
@@ -8405,6 +8632,26 @@ run__LilyParser(LilyParser *self, bool parse_for_macro_expand)
     }
 }
 
+void
+parse_lazy_fun_body__LilyParser(LilyAstDeclFun *fun)
+{
+    if (fun->body) {
+        return;
+    }
+
+    ASSERT(fun->lazy_body && fun->lazy_parser);
+
+    LilyParser *self = fun->lazy_parser;
+    Usize count_error = self->package->count_error;
+
+    fun->body = parse_fun_body__LilyParser(self, fun->lazy_body);
+    fun->lazy_body = NULL;
+
+    if (self->package->count_error > count_error) {
+        exit(1);
+    }
+}
+
 DESTRUCTOR(LilyParser, const LilyParser *self)
 {
     FREE_BUFFER_ITEMS(self->decls->buffer, self->decls->len, LilyAstDecl);
@@ -22,16 +22,19 @@
  * SOFTWARE.
  */
 
-#include <base/dir.h>
+#include <base/thread_pool.h>
 
 #include <cli/emit.h>
 
 #include <core/lily/lily.h>
 #include <core/lily/package/default_path.h>
+#include <core/lily/package/dependency_graph.h>
 #include <core/lily/package/package.h>
+#include <core/lily/package/path_cache.h>
 #include <core/lily/precompiler/precompiler.h>
 
 #include <ctype.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -40,35 +43,13 @@
 #include <base/print.h>
 #endif
 
-// NOTE: This define will be deleted when all thread operations are safe.
-#define PRECOMPILER_USE_MULTITHREAD
-#undef PRECOMPILER_USE_MULTITHREAD
-
-#ifdef PRECOMPILER_USE_MULTITHREAD
-#include <pthread.h>
-
-typedef struct LilyPrecompilerSubPackageWrapper
+typedef struct LilyPrecompilerSubPackagesRun
 {
-    const LilyPrecompiler *self; // const LilyPrecompiler* (&)
-    const LilyPreparserSubPackage
-      *sub_package;            // const LilyPreparserSubPackage* (&)
-    LilyPackage *root_package; // LilyPackage* (&)
-    LilyPackage *res;          // LilyPackage* (&)
-    String *pkg_filename;
-    char *default_path; // char*?
-} LilyPrecompilerSubPackageWrapper;
-
-// Construct LilyPrecompilerSubPackageWrapper type.
-static CONSTRUCTOR(LilyPrecompilerSubPackageWrapper *,
-                   LilyPrecompilerSubPackageWrapper,
-                   LilyPrecompiler *self,
-                   const LilyPreparserSubPackage *sub_package,
-                   LilyPackage *root_package);
-
-// Free LilyPrecompilerSubPackageWrapper type.
-static DESTRUCTOR(LilyPrecompilerSubPackageWrapper,
-                  LilyPrecompilerSubPackageWrapper *self);
-#endif
+    LilyPackage **sub_packages;    // LilyPackage** (&)
+    LilyPackage *root_package;     // LilyPackage* (&)
+    DiagnosticBuffer *diagnostics; // DiagnosticBuffer* (&) - One buffer for
+                                   // each sub package.
+} LilyPrecompilerSubPackagesRun;
 
 // Free LilyImportValue type (LILY_IMPORT_VALUE_KIND_ACCESS).
 static VARIANT_DESTRUCTOR(LilyImportValue, access, LilyImportValue *self);
@@ -92,39 +73,21 @@ check_import_to_build_dependency_tree__LilyPrecompiler(
   LilyPackage *package,
   LilyPackage *root_package);
 
-/// @return Vec<LilyPackage* (&)>*
-static Vec *
-collect_all_packages_to_build_dependency_tree__LilyPrecompiler(
-  LilyPackage *package,
-  Vec *dependencies_order);
-
-static void
-check_deps__LilyPrecompiler(LilyPackage *package,
-                            String *rejected_package_name);
-
 // Check recursive import.
 // e.g.:
 // <Package name>: <Dependencies>
 // A: [B, C]
 // B: [A, C]
 // C: []
-// This case would find a recursive import.
+// This case would find a recursive import (A -> B -> A).
 static void
 check_for_recursive_import_to_build_dependency_tree__LilyPrecompiler(
-  Vec *dependencies_order);
-
-// Sort dependencies_order by package->dependencies len.
-static void
-calculate_dependencies_order_to_build_dependency_tree__LilyPrecompiler(
-  Vec *dependencies_order);
-
-// Return true if the package is found otherwise return false.
-static bool
-package_is_find_in_dependencies_order__LilyPrecompiler(Vec *dependencies_order,
-                                                       LilyPackage *package);
+  const LilyPackageDependencyGraph *graph);
 
+// Add the packages to the dependency trees, layer by layer.
 static void
-build_tree__LilyPrecompiler(LilyPrecompiler *self, LilyPackage *package);
+build_trees__LilyPrecompiler(LilyPrecompiler *self,
+                             const LilyPackageDependencyGraph *graph);
 
 /// @param self Is the root LilyPrecompiler.
 static void
@@ -145,21 +108,41 @@ static LilyImport *
 precompile_import__LilyPrecompiler(LilyPrecompiler *self,
                                    const LilyPreparserImport *import);
 
-#ifdef PRECOMPILER_USE_MULTITHREAD
-static void
-configure_sub_package__LilyPrecompiler(
-  LilyPrecompilerSubPackageWrapper *wrapper);
-
-/// @return NULL
-static void *
-precompile_sub_package__LilyPrecompiler(void *w);
-#else
+/// @param default_path char** (&) - The generated default path of the sub
+/// package (char*?), which must be freed after the precompilation of the sub
+/// package.
 /// @return LilyPackage*
 static LilyPackage *
-precompile_sub_package__LilyPrecompiler(const LilyPrecompiler *self,
-                                        const LilyPreparserSubPackage *sub_pkg,
-                                        LilyPackage *root_package);
-#endif
+new_sub_package__LilyPrecompiler(const LilyPrecompiler *self,
+                                 const LilyPreparserSubPackage *sub_pkg,
+                                 LilyPackage *root_package,
+                                 char **default_path);
+
+// Run the scanner and the preparser of the sub package.
+/// @param sub_packages LilyPackage** (&)
+static void
+run_frontend_sub_package__LilyPrecompiler(void *sub_packages, Usize index);
+
+// Run the pre-compiler. When the check of the macros is deferred, the macros
+// are checked by the pre-compiler which has run the pre-compiler of this
+// package in a task (see check_sub_packages_macros__LilyPrecompiler).
+static void
+precompile__LilyPrecompiler(LilyPrecompiler *self,
+                            LilyPackage *root_package,
+                            bool precompile_macro_expand,
+                            bool defer_check_macros);
+
+// Run the scanner, the preparser and the precompiler of the sub package.
+/// @param run LilyPrecompilerSubPackagesRun* (&)
+static void
+precompile_sub_package__LilyPrecompiler(void *run, Usize index);
+
+// Check the macros of the sub packages (and of their own sub packages) in the
+// declaration order, so the public macros are added to the root package in the
+// same order as when the sub packages are precompiled one after the other.
+static void
+check_sub_packages_macros__LilyPrecompiler(LilyPackage *package,
+                                           LilyPackage *root_package);
 
 // Parse and check the parameters of the macros.
 static LilyMacro *
@@ -171,40 +154,10 @@ precompile_macro__LilyPrecompiler(LilyPrecompiler *self,
 static void
 check_macros__LilyPrecompiler(LilyPrecompiler *self, LilyPackage *root_package);
 
-#ifdef PRECOMPILER_USE_MULTITHREAD
-static threadlocal pthread_mutex_t sub_package_thread_mutex;
-#endif
-
-#ifdef PRECOMPILER_USE_MULTITHREAD
-CONSTRUCTOR(LilyPrecompilerSubPackageWrapper *,
-            LilyPrecompilerSubPackageWrapper,
-            LilyPrecompiler *self,
-            const LilyPreparserSubPackage *sub_package,
-            LilyPackage *root_package)
-{
-    LilyPrecompilerSubPackageWrapper *w =
-      lily_malloc(sizeof(LilyPrecompilerSubPackageWrapper));
-
-    w->self = self;
-    w->sub_package = sub_package;
-    w->root_package = root_package;
-    w->pkg_filename = NULL;
-    w->default_path = NULL;
-
-    return w;
-}
-
-DESTRUCTOR(LilyPrecompilerSubPackageWrapper,
-           LilyPrecompilerSubPackageWrapper *self)
-{
-    if (self->default_path) {
-        lily_free(self->default_path);
-    }
-
-    lily_free(self->pkg_filename);
-    lily_free(self);
-}
-#endif
+// NOTE: The public macros are pushed in the root package, which is shared by all
+// the packages parsed at the same time (the macros of a macro expansion are
+// checked by the parser, see apply_macro_expansion__LilyParser).
+static pthread_mutex_t macros_mutex = PTHREAD_MUTEX_INITIALIZER;
 
 CONSTRUCTOR(LilyImportValue *, LilyImportValue, enum LilyImportValueKind kind)
 {
@@ -573,6 +526,9 @@ CONSTRUCTOR(LilyMacro *,
     self->params = params;
     self->tokens = tokens;
     self->location = location;
+    self->expansions = NEW(HashMap);
+
+    ASSERT(!pthread_mutex_init(&self->expansions_mutex, NULL));
 
     return self;
 }
@@ -610,6 +566,162 @@ IMPL_FOR_DEBUG(debug, LilyMacro, const LilyMacro *self)
 }
 #endif
 
+// NOTE: Each token is prefixed by its kind and by the length of its string, so
+// two different sequences of tokens can't give the same key.
+String *
+get_expansion_key__LilyMacro(const Vec *params)
+{
+    String *res = NEW(String);
+
+    for (Usize i = 0; i < params->len; ++i) {
+        const Vec *param = get__Vec(params, i);
+        String *param_s = format__String("{zu};", param->len);
+
+        APPEND_AND_FREE(res, param_s);
+
+        for (Usize j = 0; j < param->len; ++j) {
+            String *token_s = to_string__LilyToken(get__Vec(param, j));
+            String *item_s =
+              format__String("{d}:{zu}:{Sr};",
+                             CAST(LilyToken *, get__Vec(param, j))->kind,
+                             token_s->len,
+                             token_s);
+
+            APPEND_AND_FREE(res, item_s);
+        }
+    }
+
+    return res;
+}
+
+const LilyMacroExpansion *
+get_expansion__LilyMacro(LilyMacro *self, const String *key)
+{
+    pthread_mutex_lock(&self->expansions_mutex);
+
+    const LilyMacroExpansion *res = get__HashMap(self->expansions, key->buffer);
+
+    pthread_mutex_unlock(&self->expansions_mutex);
+
+    return res;
+}
+
+void
+add_expansion__LilyMacro(LilyMacro *self,
+                         String *key,
+                         const Vec *params,
+                         const Vec *expand_tokens,
+                         const Vec *tokens)
+{
+    LilyMacroExpansion *expansion = lily_malloc(sizeof(LilyMacroExpansion));
+
+    expansion->key = key;
+    expansion->items =
+      lily_malloc(sizeof(LilyMacroExpansionItem) * (tokens->len + 1));
+    expansion->len = tokens->len;
+
+    // NOTE: The tokens of the macro keep their order in the expansion, so the
+    // search of the next token of the macro starts after the previous one.
+    Usize macro_token_index = 0;
+
+    for (Usize i = 0; i < tokens->len; ++i) {
+        const LilyToken *token = get__Vec(tokens, i);
+        LilyMacroExpansionItem *item = &expansion->items[i];
+
+        for (Usize j = 0; j < expand_tokens->len; ++j) {
+            if (get__Vec(expand_tokens, j) == token) {
+                *item = (LilyMacroExpansionItem){
+                    .kind = LILY_MACRO_EXPANSION_ITEM_KIND_EXPAND, .param = j
+                };
+
+                goto next;
+            }
+        }
+
+        for (Usize j = 0; j < params->len; ++j) {
+            const Vec *param = get__Vec(params, j);
+
+            for (Usize k = 0; k < param->len; ++k) {
+                if (get__Vec(param, k) == token) {
+                    *item = (LilyMacroExpansionItem){
+                        .kind = LILY_MACRO_EXPANSION_ITEM_KIND_PARAM_TOKEN,
+                        .param = j,
+                        .index = k
+                    };
+
+                    goto next;
+                }
+            }
+        }
+
+        for (Usize j = macro_token_index; j < self->tokens->len; ++j) {
+            if (get__Vec(self->tokens, j) == token) {
+                *item = (LilyMacroExpansionItem){
+                    .kind = LILY_MACRO_EXPANSION_ITEM_KIND_MACRO_TOKEN,
+                    .index = j
+                };
+                macro_token_index = j + 1;
+
+                goto next;
+            }
+        }
+
+        UNREACHABLE("the token of the expansion is not found");
+
+    next: {
+    }
+    }
+
+    pthread_mutex_lock(&self->expansions_mutex);
+
+    // NOTE: Another thread may have memoized the same expansion in the
+    // meantime.
+    if (get__HashMap(self->expansions, expansion->key->buffer)) {
+        FREE(LilyMacroExpansion, expansion);
+    } else {
+        insert__HashMap(self->expansions, expansion->key->buffer, expansion);
+    }
+
+    pthread_mutex_unlock(&self->expansions_mutex);
+}
+
+void
+apply_expansion__LilyMacro(const LilyMacro *self,
+                           const LilyMacroExpansion *expansion,
+                           const Vec *params,
+                           const Vec *expand_tokens,
+                           Vec *tokens)
+{
+    tokens->len = 0;
+
+    for (Usize i = 0; i < expansion->len; ++i) {
+        const LilyMacroExpansionItem *item = &expansion->items[i];
+
+        switch (item->kind) {
+            case LILY_MACRO_EXPANSION_ITEM_KIND_EXPAND:
+                push__Vec(tokens, get__Vec(expand_tokens, item->param));
+                break;
+            case LILY_MACRO_EXPANSION_ITEM_KIND_MACRO_TOKEN:
+                push__Vec(tokens, get__Vec(self->tokens, item->index));
+                break;
+            case LILY_MACRO_EXPANSION_ITEM_KIND_PARAM_TOKEN:
+                push__Vec(
+                  tokens,
+                  get__Vec(get__Vec(params, item->param), item->index));
+                break;
+            default:
+                UNREACHABLE("unknown variant");
+        }
+    }
+}
+
+DESTRUCTOR(LilyMacroExpansion, LilyMacroExpansion *self)
+{
+    FREE(String, self->key);
+    lily_free(self->items);
+    lily_free(self);
+}
+
 DESTRUCTOR(LilyMacro, LilyMacro *self)
 {
     if (self->params) {
@@ -618,6 +730,9 @@ DESTRUCTOR(LilyMacro, LilyMacro *self)
         FREE(Vec, self->params);
     }
 
+    FREE_HASHMAP_VALUES(self->expansions, LilyMacroExpansion);
+    FREE(HashMap, self->expansions);
+    pthread_mutex_destroy(&self->expansions_mutex);
     lily_free(self);
 }
 
@@ -672,27 +787,27 @@ check_import_to_build_dependency_tree__LilyPrecompiler(
     }
 }
 
-Vec *
-collect_all_packages_to_build_dependency_tree__LilyPrecompiler(
-  LilyPackage *package,
-  Vec *dependencies_order)
-{
-    push__Vec(dependencies_order, package);
-
-    for (Usize i = 0; i < package->sub_packages->len; ++i) {
-        dependencies_order =
-          collect_all_packages_to_build_dependency_tree__LilyPrecompiler(
-            get__Vec(package->sub_packages, i), dependencies_order);
-    }
-
-    return dependencies_order;
-}
-
 void
-check_deps__LilyPrecompiler(LilyPackage *package, String *rejected_package_name)
+check_for_recursive_import_to_build_dependency_tree__LilyPrecompiler(
+  const LilyPackageDependencyGraph *graph)
 {
-    if (!strcmp(package->name->buffer, rejected_package_name->buffer)) {
+    for (Usize i = 0; i < graph->cycles->len; ++i) {
+        // Vec<LilyPackageDependencyGraphNode* (&)>*
+        const Vec *cycle = get__Vec(graph->cycles, i);
+        LilyPackage *package =
+          CAST(LilyPackageDependencyGraphNode *, get__Vec(cycle, 0))->package;
         Location diagnostic_location = default__Location(package->file.name);
+        String *detail_msg = from__String("the cycle is: ");
+
+        for (Usize j = 0; j < cycle->len; ++j) {
+            push_str__String(
+              detail_msg,
+              CAST(LilyPackageDependencyGraphNode *, get__Vec(cycle, j))
+                ->package->global_name->buffer);
+            push_str__String(detail_msg, " -> ");
+        }
+
+        push_str__String(detail_msg, package->global_name->buffer);
 
         emit__Diagnostic(
           NEW_VARIANT(Diagnostic,
@@ -702,87 +817,71 @@ check_deps__LilyPrecompiler(LilyPackage *package, String *rejected_package_name)
                       NEW(LilyError, LILY_ERROR_KIND_RECURSIVE_IMPORT),
                       NULL,
                       NULL,
-                      NULL),
+                      detail_msg),
           &package->count_error);
-
-        return;
     }
 
-    for (Usize i = 0; i < package->package_dependencies->len; ++i) {
-        check_deps__LilyPrecompiler(get__Vec(package->package_dependencies, i),
-                                    rejected_package_name);
+    // NOTE: The packages can't be ordered with a recursive import.
+    if (graph->cycles->len > 0) {
+        exit(1);
     }
 }
 
 void
-check_for_recursive_import_to_build_dependency_tree__LilyPrecompiler(
-  Vec *dependencies_order)
+build_trees__LilyPrecompiler(LilyPrecompiler *self,
+                             const LilyPackageDependencyGraph *graph)
 {
-    for (Usize i = 0; i < dependencies_order->len; ++i) {
-        LilyPackage *pkg = get__Vec(dependencies_order, i);
+    // NOTE: The tree of each package (indexed by the id of the node of the
+    // package). The dependencies of a package are in the previous layers, so
+    // their trees are always built before the tree of the package.
+    LilyPackageDependencyTree **trees =
+      lily_calloc(graph->nodes->len, sizeof(LilyPackageDependencyTree *));
 
-        for (Usize j = 0; j < pkg->package_dependencies->len; ++j) {
-            check_deps__LilyPrecompiler(get__Vec(pkg->package_dependencies, j),
-                                        pkg->name);
-        }
-    }
-}
+    for (Usize i = 0; i < graph->layers->len; ++i) {
+        const Vec *layer = get__Vec(graph->layers, i);
 
-void
-calculate_dependencies_order_to_build_dependency_tree__LilyPrecompiler(
-  Vec *dependencies_order)
-{
-    for (Usize i = 0; i < dependencies_order->len; ++i) {
-        for (Usize j = i + 1; j < dependencies_order->len; ++j) {
-            if (CAST(LilyPackage *, get__Vec(dependencies_order, i))
-                  ->package_dependencies->len >
-                CAST(LilyPackage *, get__Vec(dependencies_order, j))
-                  ->package_dependencies->len) {
-                SWAP(dependencies_order->buffer[i],
-                     dependencies_order->buffer[j]);
-            }
-        }
-    }
-}
+        for (Usize j = 0; j < layer->len; ++j) {
+            LilyPackageDependencyGraphNode *node = get__Vec(layer, j);
 
-bool
-package_is_find_in_dependencies_order__LilyPrecompiler(Vec *dependencies_order,
-                                                       LilyPackage *package)
-{
-    for (Usize i = 0; i < dependencies_order->len; ++i) {
-        if (!strcmp(CAST(LilyPackage *, get__Vec(dependencies_order, i))
-                      ->global_name->buffer,
-                    package->global_name->buffer)) {
-            return true;
-        }
-    }
+            // 1. Push the packages with no package dependencies.
+            if (node->dependencies->len == 0) {
+                trees[node->id] =
+                  NEW(LilyPackageDependencyTree, node->package, NULL);
+                push__Vec(self->dependency_trees, trees[node->id]);
 
-    return false;
-}
+                continue;
+            }
 
-void
-build_tree__LilyPrecompiler(LilyPrecompiler *self, LilyPackage *package)
-{
-    LilyPackageDependencyTree *tree = determine_tree__LilyPackageDependencyTree(
-      self->dependency_trees, package);
+            // 2. Push the other packages in the tree of their first
+            // dependency.
+            Vec *dependencies =
+              NEW(Vec); // Vec<LilyPackageDependencyTree* (&)>*
+
+            for (Usize k = 0; k < node->dependencies->len; ++k) {
+                LilyPackageDependencyGraphNode *dependency =
+                  get__Vec(node->dependencies, k);
 
-    add_package__LilyPackageDependencyTree(
-      tree, self->dependency_trees, package);
+                ASSERT(trees[dependency->id]);
 
-    for (Usize i = 0; i < package->package_dependencies->len; ++i) {
-        LilyPackage *p = get__Vec(package->package_dependencies, i);
+                push__Vec(dependencies, trees[dependency->id]);
+            }
 
-        if (p->package_dependencies->len > 0) {
-            build_tree__LilyPrecompiler(self, p);
+            trees[node->id] =
+              NEW(LilyPackageDependencyTree, node->package, dependencies);
+            push__Vec(
+              CAST(LilyPackageDependencyTree *, get__Vec(dependencies, 0))
+                ->children,
+              trees[node->id]);
         }
     }
+
+    lily_free(trees);
 }
 
 // 1. Check import (only with `@package`).
-// 2. Collect all packages dependencies.
+// 2. Build the dependency graph of all packages.
 // 3. Check for recursive import.
-// 4. Calculate dependencies.
-// 5. Add package with fewer dependencies.
+// 4. Add the packages to the dependency trees.
 void
 build_dependency_tree__LilyPrecompiler(LilyPrecompiler *self,
                                        LilyPackage *package,
@@ -792,70 +891,38 @@ build_dependency_tree__LilyPrecompiler(LilyPrecompiler *self,
     check_import_to_build_dependency_tree__LilyPrecompiler(
       self, package, root_package);
 
-    // 2. Collect all packages dependencies.
-    Vec *dependencies_order =
-      collect_all_packages_to_build_dependency_tree__LilyPrecompiler(
-        package,
-        NEW(Vec)); // Vec<LilyPackage* (&)>*
+    // 2. Build the dependency graph of all packages.
+    LilyPackageDependencyGraph graph =
+      NEW(LilyPackageDependencyGraph, package);
 
     // 3. Check for recursive import.
     check_for_recursive_import_to_build_dependency_tree__LilyPrecompiler(
-      dependencies_order);
+      &graph);
 
 #ifdef ENV_DEBUG
-    PRINTLN("\n====Precompiler dependencies order before sort({S})====\n",
+    PRINTLN("\n====Precompiler dependency layers({S})====\n",
             root_package->name);
 
-    for (Usize i = 0; i < dependencies_order->len; ++i) {
-        LilyPackage *pkg = get__Vec(dependencies_order, i);
-
-        PRINTLN("package name: {S}, global_name: {S}, dependencies len: {d}",
-                pkg->name,
-                pkg->global_name,
-                pkg->package_dependencies->len);
-    }
-#endif
-
-    // 4. Calculate dependencies.
-    calculate_dependencies_order_to_build_dependency_tree__LilyPrecompiler(
-      dependencies_order);
-
-#ifdef ENV_DEBUG
-    PRINTLN("\n====Precompiler dependencies order({S})====\n",
-            root_package->name);
+    for (Usize i = 0; i < graph.layers->len; ++i) {
+        const Vec *layer = get__Vec(graph.layers, i);
 
-    for (Usize i = 0; i < dependencies_order->len; ++i) {
-        LilyPackage *pkg = get__Vec(dependencies_order, i);
+        for (Usize j = 0; j < layer->len; ++j) {
+            LilyPackageDependencyGraphNode *node = get__Vec(layer, j);
 
-        PRINTLN("package name: {S}, global_name: {S}, dependencies len: {d}",
-                pkg->name,
-                pkg->global_name,
-                pkg->package_dependencies->len);
+            PRINTLN("layer: {zu}, package name: {S}, global_name: {S}, "
+                    "dependencies len: {zu}",
+                    i,
+                    node->package->name,
+                    node->package->global_name,
+                    node->dependencies->len);
+        }
     }
 #endif
 
-    // 4. Add package with less dependencies.
-
-    // 4.1 Push all packages with no package dependencies.
-    for (Usize i = 0; i < dependencies_order->len;) {
-        if (CAST(LilyPackage *, get__Vec(dependencies_order, i))
-              ->package_dependencies->len == 0) {
-            push__Vec(self->dependency_trees,
-                      NEW(LilyPackageDependencyTree,
-                          get__Vec(dependencies_order, i),
-                          NULL));
-            remove__Vec(dependencies_order, i);
-        } else {
-            ++i;
-        }
-    }
+    // 4. Add the packages to the dependency trees.
+    build_trees__LilyPrecompiler(self, &graph);
 
-    // 4.2 Push all other packages.
-    for (Usize i = 0; i < dependencies_order->len; ++i) {
-        build_tree__LilyPrecompiler(self, get__Vec(dependencies_order, i));
-    }
-
-    FREE(Vec, dependencies_order);
+    FREE(LilyPackageDependencyGraph, &graph);
 }
 
 Vec *
@@ -1170,13 +1237,14 @@ precompile_import__LilyPrecompiler(LilyPrecompiler *self,
     return NEW(LilyImport, values, import->location, import->as);
 }
 
-#ifdef PRECOMPILER_USE_MULTITHREAD
-void
-configure_sub_package__LilyPrecompiler(
-  LilyPrecompilerSubPackageWrapper *wrapper)
+LilyPackage *
+new_sub_package__LilyPrecompiler(const LilyPrecompiler *self,
+                                 const LilyPreparserSubPackage *sub_pkg,
+                                 LilyPackage *root_package,
+                                 char **default_path)
 {
 #define INIT_IR()                                                        \
-    switch (wrapper->root_package->compiler.ir.kind) {                   \
+    switch (root_package->compiler.ir.kind) {                            \
         case LILY_IR_KIND_CC:                                            \
             /* TODO: add a linker for CC */                              \
             res->compiler.ir = NEW_VARIANT(LilyIr, cc, NEW(LilyIrCc));   \
@@ -1192,14 +1260,18 @@ configure_sub_package__LilyPrecompiler(
             break;                                                       \
         case LILY_IR_KIND_LLVM:                                          \
             res->compiler.ir = NEW_VARIANT(                              \
-              LilyIr, llvm, NEW(LilyIrLlvm, res->global_name->buffer));  \
+              LilyIr,                                                    \
+              llvm,                                                      \
+              NEW(LilyIrLlvm,                                            \
+                  res->global_name->buffer,                              \
+                  root_package->is_dynamic_lib));                        \
             res->compiler.linker = LILY_LINKER_KIND_LLVM;                \
             break;                                                       \
         default:                                                         \
             UNREACHABLE("unknown variant");                              \
     }
 
-    Vec *split_pkg_name = split__String(wrapper->sub_package->name, '.');
+    Vec *split_pkg_name = split__String(sub_pkg->name, '.');
 
 #ifdef LILY_WINDOWS_OS
     String *pkg_filename_join = join__Vec(split_pkg_name, '\\');
@@ -1209,7 +1281,7 @@ configure_sub_package__LilyPrecompiler(
 
     String *pkg_filename = NEW(String);
 
-    push_str__String(pkg_filename, (char *)wrapper->self->default_path);
+    push_str__String(pkg_filename, (char *)self->default_path);
 
 #ifdef LILY_WINDOWS_OS
     push_str__String(pkg_filename, "\\");
@@ -1219,29 +1291,31 @@ configure_sub_package__LilyPrecompiler(
 
     APPEND_AND_FREE(pkg_filename, pkg_filename_join);
 
-    LilyPackage *res = NULL;
-
-    if (is__Dir(pkg_filename->buffer)) {
+    // If it's a directory. Check if there is `pkg.lily` in the directory.
+    if (get_kind__LilyPackagePathCache(pkg_filename->buffer) ==
+        LILY_PACKAGE_PATH_KIND_DIR) {
 #ifdef LILY_WINDOWS_OS
         push_str__String(pkg_filename, "\\pkg.lily");
 #else
         push_str__String(pkg_filename, "/pkg.lily");
 #endif
 
-        char *default_path = generate_default_path(pkg_filename->buffer);
+        LilyPackage *res = NULL;
 
-        switch (wrapper->root_package->kind) {
+        *default_path = generate_default_path(pkg_filename->buffer);
+
+        switch (root_package->kind) {
             case LILY_PACKAGE_KIND_COMPILER:
                 res = NEW_VARIANT(LilyPackage,
                                   compiler,
-                                  wrapper->sub_package->name,
-                                  wrapper->sub_package->global_name,
-                                  wrapper->sub_package->visibility,
+                                  sub_pkg->name,
+                                  sub_pkg->global_name,
+                                  sub_pkg->visibility,
                                   pkg_filename->buffer,
                                   LILY_PACKAGE_STATUS_SUB_MAIN,
-                                  default_path,
-                                  wrapper->sub_package->global_name->buffer,
-                                  wrapper->root_package);
+                                  *default_path,
+                                  sub_pkg->global_name->buffer,
+                                  root_package);
 
                 INIT_IR();
 
@@ -1249,205 +1323,14 @@ configure_sub_package__LilyPrecompiler(
             case LILY_PACKAGE_KIND_INTERPRETER:
                 res = NEW_VARIANT(LilyPackage,
                                   interpreter,
-                                  wrapper->sub_package->name,
-                                  wrapper->sub_package->global_name,
-                                  wrapper->sub_package->visibility,
+                                  sub_pkg->name,
+                                  sub_pkg->global_name,
+                                  sub_pkg->visibility,
                                   pkg_filename->buffer,
                                   LILY_PACKAGE_STATUS_SUB_MAIN,
-                                  default_path,
-                                  wrapper->sub_package->global_name->buffer,
-                                  wrapper->root_package);
-                break;
-            case LILY_PACKAGE_KIND_JIT:
-                TODO("JIT");
-            default:
-                UNREACHABLE("unknown variant");
-        }
-
-        LOG_VERBOSE(res, "running");
-
-        wrapper->default_path = default_path;
-    } else {
-        push_str__String(pkg_filename, ".lily");
-
-        char *default_path = generate_default_path(pkg_filename->buffer);
-
-        switch (wrapper->root_package->kind) {
-            case LILY_PACKAGE_KIND_COMPILER:
-                res = NEW_VARIANT(LilyPackage,
-                                  compiler,
-                                  wrapper->sub_package->name,
-                                  wrapper->sub_package->global_name,
-                                  wrapper->sub_package->visibility,
-                                  pkg_filename->buffer,
-                                  LILY_PACKAGE_STATUS_NORMAL,
-                                  default_path,
-                                  wrapper->sub_package->global_name->buffer,
-                                  wrapper->root_package);
-
-                INIT_IR();
-
-                break;
-            case LILY_PACKAGE_KIND_INTERPRETER:
-                res = NEW_VARIANT(LilyPackage,
-                                  interpreter,
-                                  wrapper->sub_package->name,
-                                  wrapper->sub_package->global_name,
-                                  wrapper->sub_package->visibility,
-                                  pkg_filename->buffer,
-                                  LILY_PACKAGE_STATUS_NORMAL,
-                                  default_path,
-                                  wrapper->sub_package->global_name->buffer,
-                                  wrapper->root_package);
-
-                break;
-            case LILY_PACKAGE_KIND_JIT:
-                TODO("JIT");
-            default:
-                UNREACHABLE("unknown variant");
-        }
-
-        LOG_VERBOSE(res, "running");
-    }
-
-    wrapper->res = res;
-    wrapper->pkg_filename = pkg_filename;
-
-    // Clean up
-
-    FREE_BUFFER_ITEMS(split_pkg_name->buffer, split_pkg_name->len, String);
-    FREE(Vec, split_pkg_name);
-}
-
-void *
-precompile_sub_package__LilyPrecompiler(void *w)
-{
-#define RUN_PRECOMPILER()                                                  \
-    pthread_mutex_lock(&sub_package_thread_mutex);                         \
-                                                                           \
-    LOG_VERBOSE(wrapper->res, "running scanner");                          \
-                                                                           \
-    switch (wrapper->res->kind) {                                          \
-        case LILY_PACKAGE_KIND_COMPILER:                                   \
-            run__LilyScanner(&wrapper->res->scanner,                       \
-                             wrapper->res->compiler.config->dump_scanner); \
-            break;                                                         \
-        case LILY_PACKAGE_KIND_INTERPRETER:                                \
-            /* TODO: maybe set the dump scanner */                         \
-            run__LilyScanner(&wrapper->res->scanner, false);               \
-            break;                                                         \
-        case LILY_PACKAGE_KIND_JIT:                                        \
-            TODO("JIT: run scanner");                                      \
-        default:                                                           \
-            UNREACHABLE("unknown variant");                                \
-    }                                                                      \
-                                                                           \
-    LOG_VERBOSE(wrapper->res, "running preparser");                        \
-                                                                           \
-    run__LilyPreparser(&wrapper->res->preparser,                           \
-                       &wrapper->res->preparser_info);                     \
-                                                                           \
-    LOG_VERBOSE(wrapper->res, "running precompiler");                      \
-                                                                           \
-    run__LilyPrecompiler(                                                  \
-      &wrapper->res->precompiler, wrapper->root_package, false);
-
-    LilyPrecompilerSubPackageWrapper *wrapper = w;
-
-    RUN_PRECOMPILER();
-
-    init_module__LilyAnalysis(&wrapper->res->analysis);
-
-    return NULL;
-}
-#else
-LilyPackage *
-precompile_sub_package__LilyPrecompiler(const LilyPrecompiler *self,
-                                        const LilyPreparserSubPackage *sub_pkg,
-                                        LilyPackage *root_package)
-{
-#define INIT_IR()                                                        \
-    switch (root_package->compiler.ir.kind) {                            \
-        case LILY_IR_KIND_CC:                                            \
-            /* TODO: add a linker for CC */                              \
-            res->compiler.ir = NEW_VARIANT(LilyIr, cc, NEW(LilyIrCc));   \
-            res->compiler.linker = LILY_LINKER_KIND_CC;                  \
-            break;                                                       \
-        case LILY_IR_KIND_CPP:                                           \
-            /* TODO: add a linker for CPP */                             \
-            res->compiler.ir = NEW_VARIANT(LilyIr, cpp, NEW(LilyIrCpp)); \
-            res->compiler.linker = LILY_LINKER_KIND_CPP;                 \
-            break;                                                       \
-        case LILY_IR_KIND_JS:                                            \
-            res->compiler.ir = NEW_VARIANT(LilyIr, js, NEW(LilyIrJs));   \
-            break;                                                       \
-        case LILY_IR_KIND_LLVM:                                          \
-            res->compiler.ir = NEW_VARIANT(                              \
-              LilyIr, llvm, NEW(LilyIrLlvm, res->global_name->buffer));  \
-            res->compiler.linker = LILY_LINKER_KIND_LLVM;                \
-            break;                                                       \
-        default:                                                         \
-            UNREACHABLE("unknown variant");                              \
-    }
-
-    Vec *split_pkg_name = split__String(sub_pkg->name, '.');
-
-#ifdef LILY_WINDOWS_OS
-    String *pkg_filename_join = join__Vec(split_pkg_name, '\\');
-#else
-    String *pkg_filename_join = join__Vec(split_pkg_name, '/');
-#endif
-
-    String *pkg_filename = NEW(String);
-
-    push_str__String(pkg_filename, (char *)self->default_path);
-
-#ifdef LILY_WINDOWS_OS
-    push_str__String(pkg_filename, "\\");
-#else
-    push_str__String(pkg_filename, "/");
-#endif
-
-    APPEND_AND_FREE(pkg_filename, pkg_filename_join);
-
-    // If it's a directory. Check if there is `pkg.lily` in the directory.
-    if (is__Dir(pkg_filename->buffer)) {
-#ifdef LILY_WINDOWS_OS
-        push_str__String(pkg_filename, "\\pkg.lily");
-#else
-        push_str__String(pkg_filename, "/pkg.lily");
-#endif
-
-        char *default_path = generate_default_path(pkg_filename->buffer);
-        LilyPackage *res = NULL;
-
-        switch (root_package->kind) {
-            case LILY_PACKAGE_KIND_COMPILER:
-                NEW_VARIANT(LilyPackage,
-                            compiler,
-                            sub_pkg->name,
-                            sub_pkg->global_name,
-                            sub_pkg->visibility,
-                            pkg_filename->buffer,
-                            LILY_PACKAGE_STATUS_SUB_MAIN,
-                            default_path,
-                            sub_pkg->global_name->buffer,
-                            root_package);
-
-                INIT_IR();
-
-                break;
-            case LILY_PACKAGE_KIND_INTERPRETER:
-                NEW_VARIANT(LilyPackage,
-                            interpreter,
-                            sub_pkg->name,
-                            sub_pkg->global_name,
-                            sub_pkg->visibility,
-                            pkg_filename->buffer,
-                            LILY_PACKAGE_STATUS_SUB_MAIN,
-                            default_path,
-                            sub_pkg->global_name->buffer,
-                            root_package);
+                                  *default_path,
+                                  sub_pkg->global_name->buffer,
+                                  root_package);
 
                 break;
             case LILY_PACKAGE_KIND_JIT:
@@ -1458,16 +1341,9 @@ precompile_sub_package__LilyPrecompiler(const LilyPrecompiler *self,
 
         res->compiler.config = root_package->compiler.config;
 
-        run__LilyScanner(&res->scanner, res->compiler.config->dump_scanner);
-        run__LilyPreparser(&res->preparser, &res->preparser_info);
-        run__LilyPrecompiler(&res->precompiler, root_package, false);
-
-        init_module__LilyAnalysis(&res->analysis);
-
         FREE_BUFFER_ITEMS(split_pkg_name->buffer, split_pkg_name->len, String);
         FREE(Vec, split_pkg_name);
         lily_free(pkg_filename);
-        lily_free(default_path);
 
         return res;
     } else {
@@ -1475,6 +1351,8 @@ precompile_sub_package__LilyPrecompiler(const LilyPrecompiler *self,
 
         LilyPackage *res = NULL;
 
+        *default_path = NULL;
+
         switch (root_package->kind) {
             case LILY_PACKAGE_KIND_COMPILER:
                 res = NEW_VARIANT(LilyPackage,
@@ -1512,27 +1390,6 @@ precompile_sub_package__LilyPrecompiler(const LilyPrecompiler *self,
 
         res->compiler.config = root_package->compiler.config;
 
-        switch (res->kind) {
-            case LILY_PACKAGE_KIND_COMPILER:
-                run__LilyScanner(&res->scanner,
-                                 res->compiler.config->dump_scanner);
-                break;
-            case LILY_PACKAGE_KIND_INTERPRETER:
-                // TODO: maybe set the dump scanner
-                run__LilyScanner(&res->scanner, false);
-                break;
-            case LILY_PACKAGE_KIND_JIT:
-                TODO("JIT: run scanner");
-                break;
-            default:
-                UNREACHABLE("unknown variant");
-        }
-
-        run__LilyPreparser(&res->preparser, &res->preparser_info);
-        run__LilyPrecompiler(&res->precompiler, root_package, false);
-
-        init_module__LilyAnalysis(&res->analysis);
-
         FREE_BUFFER_ITEMS(split_pkg_name->buffer, split_pkg_name->len, String);
         FREE(Vec, split_pkg_name);
         lily_free(pkg_filename);
@@ -1540,7 +1397,63 @@ precompile_sub_package__LilyPrecompiler(const LilyPrecompiler *self,
         return res;
     }
 }
-#endif
+
+void
+run_frontend_sub_package__LilyPrecompiler(void *sub_packages, Usize index)
+{
+    LilyPackage *res = CAST(LilyPackage **, sub_packages)[index];
+
+    switch (res->kind) {
+        case LILY_PACKAGE_KIND_COMPILER:
+            run_scanner_and_preparser__LilyPackage(
+              res, res->compiler.config->dump_scanner);
+            break;
+        case LILY_PACKAGE_KIND_INTERPRETER:
+            // TODO: maybe set the dump scanner
+            run_scanner_and_preparser__LilyPackage(res, false);
+            break;
+        case LILY_PACKAGE_KIND_JIT:
+            TODO("JIT: run scanner");
+            break;
+        default:
+            UNREACHABLE("unknown variant");
+    }
+}
+
+void
+precompile_sub_package__LilyPrecompiler(void *run, Usize index)
+{
+    const LilyPrecompilerSubPackagesRun *self = run;
+    LilyPackage *sub_package = self->sub_packages[index];
+    DiagnosticBuffer *diagnostics = &self->diagnostics[index];
+    DiagnosticBuffer *prev_diagnostics = get_buffer__Diagnostic();
+
+    set_buffer__Diagnostic(diagnostics);
+
+    run_frontend_sub_package__LilyPrecompiler(self->sub_packages, index);
+
+    // NOTE: The errors are counted in the buffer, so the scanner and the
+    // preparser don't exit, then the sub package is not precompiled.
+    if (diagnostics->count_error == 0) {
+        precompile__LilyPrecompiler(
+          &sub_package->precompiler, self->root_package, false, true);
+        init_module__LilyAnalysis(&sub_package->analysis);
+    }
+
+    set_buffer__Diagnostic(prev_diagnostics);
+}
+
+void
+check_sub_packages_macros__LilyPrecompiler(LilyPackage *package,
+                                           LilyPackage *root_package)
+{
+    for (Usize i = 0; i < package->sub_packages->len; ++i) {
+        LilyPackage *sub_package = get__Vec(package->sub_packages, i);
+
+        check_macros__LilyPrecompiler(&sub_package->precompiler, root_package);
+        check_sub_packages_macros__LilyPrecompiler(sub_package, root_package);
+    }
+}
 
 LilyMacro *
 precompile_macro__LilyPrecompiler(LilyPrecompiler *self,
@@ -1782,6 +1695,14 @@ precompile_macro__LilyPrecompiler(LilyPrecompiler *self,
 void
 check_macros__LilyPrecompiler(LilyPrecompiler *self, LilyPackage *root_package)
 {
+    // NOTE: The macros before these indexes have already been checked by a
+    // previous run of the precompiler (e.g. by another package or by a macro
+    // expansion), so only the pairs with a new macro are checked below.
+    pthread_mutex_lock(&macros_mutex);
+
+    const Usize public_macros_start = root_package->public_macros->len;
+    const Usize private_macros_start = self->package->private_macros->len;
+
     // 1. Add the public macros obtained by the preparer to the public macros of
     // root_package.
     for (Usize i = 0; i < self->info->public_macros->len; ++i) {
@@ -1800,7 +1721,10 @@ check_macros__LilyPrecompiler(LilyPrecompiler *self, LilyPackage *root_package)
 
     // 3. Check name conflict for macros (public macros).
     for (Usize i = 0; i < root_package->public_macros->len; ++i) {
-        for (Usize j = i + 1; j < root_package->public_macros->len; ++j) {
+        for (Usize j =
+               i + 1 > public_macros_start ? i + 1 : public_macros_start;
+             j < root_package->public_macros->len;
+             ++j) {
             if (!strcmp(
                   CAST(LilyMacro *, get__Vec(root_package->public_macros, i))
                     ->name->buffer,
@@ -1840,7 +1764,10 @@ check_macros__LilyPrecompiler(LilyPrecompiler *self, LilyPackage *root_package)
 
     // 4. Check name conflict for macros (private macros).
     for (Usize i = 0; i < self->package->private_macros->len; ++i) {
-        for (Usize j = i + 1; j < self->package->private_macros->len; ++j) {
+        for (Usize j =
+               i + 1 > private_macros_start ? i + 1 : private_macros_start;
+             j < self->package->private_macros->len;
+             ++j) {
             if (!strcmp(
                   CAST(LilyMacro *, get__Vec(self->package->private_macros, i))
                     ->name->buffer,
@@ -1876,7 +1803,9 @@ check_macros__LilyPrecompiler(LilyPrecompiler *self, LilyPackage *root_package)
 
     // 5. Check name conflict for macros (all macros).
     for (Usize i = 0; i < self->package->private_macros->len; ++i) {
-        for (Usize j = 0; j < root_package->public_macros->len; ++j) {
+        for (Usize j = i < private_macros_start ? public_macros_start : 0;
+             j < root_package->public_macros->len;
+             ++j) {
             if (!strcmp(
                   CAST(LilyMacro *, get__Vec(self->package->private_macros, i))
                     ->name->buffer,
@@ -1913,12 +1842,15 @@ check_macros__LilyPrecompiler(LilyPrecompiler *self, LilyPackage *root_package)
             }
         }
     }
+
+    pthread_mutex_unlock(&macros_mutex);
 }
 
 void
-run__LilyPrecompiler(LilyPrecompiler *self,
-                     LilyPackage *root_package,
-                     bool precompile_macro_expand)
+precompile__LilyPrecompiler(LilyPrecompiler *self,
+                            LilyPackage *root_package,
+                            bool precompile_macro_expand,
+                            bool defer_check_macros)
 {
     // 1. Precompiler all imports
     for (Usize i = 0; i < self->info->public_imports->len; ++i) {
@@ -1940,57 +1872,85 @@ run__LilyPrecompiler(LilyPrecompiler *self,
     }
 
     // 2. Check macros
-    check_macros__LilyPrecompiler(self, root_package);
+    if (!defer_check_macros) {
+        check_macros__LilyPrecompiler(self, root_package);
+    }
 
     // 4. Precompiler all sub packages
-#ifdef PRECOMPILER_USE_MULTITHREAD
-    {
-        Vec *wrappers = NEW(Vec); // Vec<LilyPrecompilerSubPackageWrapper*>*
-        pthread_t *sub_package_threads = lily_malloc(
-          sizeof(pthread_t) * self->info->package->sub_packages->len);
+    if (self->info->package->sub_packages->len > 0) {
+        Usize sub_packages_len = self->info->package->sub_packages->len;
+        LilyPackage **sub_packages =
+          lily_malloc(sizeof(LilyPackage *) * sub_packages_len);
+        char **default_paths = lily_malloc(sizeof(char *) * sub_packages_len);
+
+        for (Usize i = 0; i < sub_packages_len; ++i) {
+            sub_packages[i] = new_sub_package__LilyPrecompiler(
+              self,
+              get__Vec(self->info->package->sub_packages, i),
+              root_package,
+              &default_paths[i]);
+        }
 
-        ASSERT(!pthread_mutex_init(&sub_package_thread_mutex, NULL));
+        // NOTE: Each sub package is scanned, preparsed and precompiled in its
+        // own task. The sub packages of the sub packages are precompiled in
+        // nested runs, so the threads are reserved in the budget shared by
+        // all the runs (see reserve_jobs__ThreadPool). The diagnostics of each
+        // sub package are buffered, then they're emitted in the declaration
+        // order (in the buffer of the enclosing task, if any).
+        {
+            DiagnosticBuffer *diagnostics =
+              lily_malloc(sizeof(DiagnosticBuffer) * sub_packages_len);
+            LilyPrecompilerSubPackagesRun run = { .sub_packages = sub_packages,
+                                                  .root_package = root_package,
+                                                  .diagnostics = diagnostics };
+            Usize jobs = reserve_jobs__ThreadPool(sub_packages_len - 1);
+            ThreadPool pool = NEW(ThreadPool, jobs + 1);
+            bool has_error = false;
+
+            for (Usize i = 0; i < sub_packages_len; ++i) {
+                diagnostics[i] = NEW(DiagnosticBuffer);
+            }
 
-        for (Usize i = 0; i < self->info->package->sub_packages->len; ++i) {
-            LilyPrecompilerSubPackageWrapper *wrapper =
-              NEW(LilyPrecompilerSubPackageWrapper,
-                  self,
-                  get__Vec(self->info->package->sub_packages, i),
-                  root_package);
+            run__ThreadPool(&pool,
+                            sub_packages_len,
+                            &precompile_sub_package__LilyPrecompiler,
+                            &run);
+            release_jobs__ThreadPool(jobs);
 
-            configure_sub_package__LilyPrecompiler(wrapper);
-            push__Vec(wrappers, wrapper);
+            for (Usize i = 0; i < sub_packages_len; ++i) {
+                has_error = has_error || diagnostics[i].count_error > 0;
 
-            ASSERT(wrapper->res);
+                flush__DiagnosticBuffer(&diagnostics[i],
+                                        &sub_packages[i]->count_error,
+                                        &sub_packages[i]->count_warning);
+                FREE(DiagnosticBuffer, &diagnostics[i]);
+            }
 
-            push__Vec(self->package->sub_packages, wrapper->res);
-        }
+            lily_free(diagnostics);
 
-        for (Usize i = 0; i < self->info->package->sub_packages->len; ++i) {
-            ASSERT(!pthread_create(&sub_package_threads[i],
-                                   NULL,
-                                   &precompile_sub_package__LilyPrecompiler,
-                                   get__Vec(wrappers, i)));
+            // NOTE: The enclosing task (if any) stops the build instead.
+            if (has_error && !get_buffer__Diagnostic()) {
+                exit(1);
+            }
         }
 
-        for (Usize i = 0; i < self->info->package->sub_packages->len; ++i) {
-            pthread_join(sub_package_threads[i], NULL);
-            FREE(LilyPrecompilerSubPackageWrapper, get__Vec(wrappers, i));
+        // NOTE: The sub packages are pushed in the declaration order.
+        for (Usize i = 0; i < sub_packages_len; ++i) {
+            push__Vec(self->package->sub_packages, sub_packages[i]);
+
+            if (default_paths[i]) {
+                lily_free(default_paths[i]);
+            }
         }
 
-        FREE(Vec, wrappers);
-        lily_free(sub_package_threads);
-        pthread_mutex_destroy(&sub_package_thread_mutex);
-    }
-#else
-    for (Usize i = 0; i < self->info->package->sub_packages->len; ++i) {
-        push__Vec(self->package->sub_packages,
-                  precompile_sub_package__LilyPrecompiler(
-                    self,
-                    get__Vec(self->info->package->sub_packages, i),
-                    root_package));
+        lily_free(sub_packages);
+        lily_free(default_paths);
+
+        if (!defer_check_macros) {
+            check_sub_packages_macros__LilyPrecompiler(self->package,
+                                                       root_package);
+        }
     }
-#endif
 
     // 5. Init dependency tree.
     if (!strcmp(self->package->name->buffer, root_package->name->buffer) &&
@@ -2047,6 +2007,15 @@ run__LilyPrecompiler(LilyPrecompiler *self,
 #endif
 }
 
+void
+run__LilyPrecompiler(LilyPrecompiler *self,
+                     LilyPackage *root_package,
+                     bool precompile_macro_expand)
+{
+    precompile__LilyPrecompiler(
+      self, root_package, precompile_macro_expand, false);
+}
+
 DESTRUCTOR(LilyPrecompiler, const LilyPrecompiler *self)
 {
     if (self->dependency_trees) {
@@ -32,6 +32,7 @@
 #include <core/shared/diagnostic.h>
 
 #include <ctype.h>
+#include <pthread.h>
 #include <stdio.h>
 
 #ifdef ENV_DEBUG
@@ -1288,6 +1289,28 @@ static VARIANT_DESTRUCTOR(LilyPreparserDecl, use, LilyPreparserDecl *self);
 // Free LilyPreparserDecl type.
 static DESTRUCTOR(LilyPreparserDecl, LilyPreparserDecl *self);
 
+typedef struct LilyPreparserScannerRun
+{
+    LilyScanner *scanner;          // LilyScanner* (&)
+    DiagnosticBuffer *diagnostics; // DiagnosticBuffer* (&)
+    bool has_error;
+} LilyPreparserScannerRun;
+
+// Run the scanner on the thread of the pipelined mode.
+/// @param run LilyPreparserScannerRun* (&)
+/// @return NULL
+static void *
+run_scanner__LilyPreparser(void *run);
+
+// Check if the token at the given index exists. In pipelined mode, it waits
+// for the scanner to produce this token (or to reach the end of the file).
+static inline bool
+has_token__LilyPreparser(const LilyPreparser *self, Usize index);
+
+// Get the token at the given index.
+static inline LilyToken *
+get_token__LilyPreparser(const LilyPreparser *self, Usize index);
+
 // Advance to the one position and update the current.
 static inline void
 next_token__LilyPreparser(LilyPreparser *self);
@@ -1714,10 +1737,11 @@ preparse_when_condition__LilyPreparser(LilyPreparser *self);
         }                                         \
     }
 
-static threadlocal enum LilyVisibility visibility_decl =
-  LILY_VISIBILITY_PRIVATE;
-static threadlocal Location location_decl;
-static threadlocal Location location_fun_body_item;
+// NOTE: This flag is used by the destructors of the preparser's items, which
+// have no preparser context. It's set on the current thread from the preparser
+// which is run (see run__LilyPreparser) or from the preparser info which is
+// freed (see LilyPreparserInfo.destroy_all), so the preparsers running on
+// other threads don't change it.
 static threadlocal bool destroy_all = false;
 
 CONSTRUCTOR(LilyPreparserImport *,
@@ -6773,28 +6797,42 @@ DESTRUCTOR(LilyPreparserDecl, LilyPreparserDecl *self)
     }
 }
 
+bool
+has_token__LilyPreparser(const LilyPreparser *self, Usize index)
+{
+    return self->stream ? has__LilyTokenStream(self->stream, index)
+                        : index < self->tokens->len;
+}
+
+LilyToken *
+get_token__LilyPreparser(const LilyPreparser *self, Usize index)
+{
+    return self->stream ? get__LilyTokenStream(self->stream, index)
+                        : get__LilyTokenBuffer(self->tokens, index);
+}
+
 void
 next_token__LilyPreparser(LilyPreparser *self)
 {
-    self->current = self->position + 1 < self->tokens->len
-                      ? get__Vec(self->tokens, ++self->position)
+    self->current = has_token__LilyPreparser(self, self->position + 1)
+                      ? get_token__LilyPreparser(self, ++self->position)
                       : self->current;
 }
 
 void
 jump__LilyPreparser(LilyPreparser *self, Usize n)
 {
-    if (self->position + n < self->tokens->len) {
+    if (has_token__LilyPreparser(self, self->position + n)) {
         self->position += n;
-        self->current = get__Vec(self->tokens, self->position);
+        self->current = get_token__LilyPreparser(self, self->position);
     }
 }
 
 LilyToken *
 peek_token__LilyPreparser(const LilyPreparser *self, Usize n)
 {
-    if (self->position + n < self->tokens->len) {
-        return get__Vec(self->tokens, self->position + n);
+    if (has_token__LilyPreparser(self, self->position + n)) {
+        return get_token__LilyPreparser(self, self->position + n);
     }
 
     return NULL;
@@ -6990,7 +7028,7 @@ preparse_import__LilyPreparser(LilyPreparser *self)
             break;
     }
 
-    END_LOCATION(&location_decl, self->current->location);
+    END_LOCATION(&self->location_decl, self->current->location);
 
     switch (self->current->kind) {
         case LILY_TOKEN_KIND_SEMICOLON:
@@ -7015,7 +7053,8 @@ preparse_import__LilyPreparser(LilyPreparser *self)
         }
     }
 
-    return NEW(LilyPreparserImport, import_value, as_value, location_decl);
+    return NEW(
+      LilyPreparserImport, import_value, as_value, self->location_decl);
 }
 
 LilyPreparserMacro *
@@ -7204,9 +7243,9 @@ get_tokens: {
     }
 }
 
-    END_LOCATION(&location_decl, self->current->location);
+    END_LOCATION(&self->location_decl, self->current->location);
 
-    return NEW(LilyPreparserMacro, name, params, tokens, location_decl);
+    return NEW(LilyPreparserMacro, name, params, tokens, self->location_decl);
 }
 
 int
@@ -7509,12 +7548,14 @@ preparse_module_body__LilyPreparser(LilyPreparser *self)
     // <module_body> = <module_decl> [ <module_body> ]*
     // <module_decl> = <constant_decl> | <error_decl> | <fun_decl> |
     //                 <module_decl> | <object_decl> | <type_decl>
-    location_decl = clone__Location(&self->current->location); // Save location.
-    visibility_decl = LILY_VISIBILITY_PRIVATE; // Default visibility is private.
+    self->location_decl =
+      clone__Location(&self->current->location); // Save location.
+    self->visibility_decl =
+      LILY_VISIBILITY_PRIVATE; // Default visibility is private.
 
     switch (self->current->kind) {
         case LILY_TOKEN_KIND_KEYWORD_PUB:
-            visibility_decl = LILY_VISIBILITY_PUBLIC;
+            self->visibility_decl = LILY_VISIBILITY_PUBLIC;
 
             next_token__LilyPreparser(self);
 
@@ -7536,7 +7577,7 @@ preparse_module_body__LilyPreparser(LilyPreparser *self)
                         case LILY_TOKEN_KIND_KEYWORD_object:
                             return preparse_object__LilyPreparser(self, true);
                         default:
-                            visibility_decl = LILY_VISIBILITY_PRIVATE;
+                            self->visibility_decl = LILY_VISIBILITY_PRIVATE;
 
                             goto unexpected_token;
                     }
@@ -7557,7 +7598,7 @@ preparse_module_body__LilyPreparser(LilyPreparser *self)
                                                  NULL),
                                      &self->count_error);
 
-                    visibility_decl = LILY_VISIBILITY_PRIVATE;
+                    self->visibility_decl = LILY_VISIBILITY_PRIVATE;
 
                     FREE(String, current_s);
 
@@ -7706,8 +7747,8 @@ parse_module_name: {
         }
     }
 
-    Location module_location = location_decl;
-    enum LilyVisibility module_visibility = visibility_decl;
+    Location module_location = self->location_decl;
+    enum LilyVisibility module_visibility = self->visibility_decl;
 
     // 2. Preparse body.
     while (self->current->kind != LILY_TOKEN_KIND_KEYWORD_END &&
@@ -7909,7 +7950,7 @@ LilyPreparserFunBodyItem *
 preparse_asm_block__LilyPreparser(LilyPreparser *self)
 {
     // asm ( <asm_block> ) ;
-    Location location = location_fun_body_item;
+    Location location = self->location_fun_body_item;
 
     next_token__LilyPreparser(self); // skip `asm` keyword
 
@@ -7968,7 +8009,7 @@ preparse_await_block__LilyPreparser(LilyPreparser *self)
     // await <await_block> ;
     // <await_block> = <tokens>
     // <tokens> = <token> [ <token> ]*
-    Location location = location_fun_body_item;
+    Location location = self->location_fun_body_item;
 
     next_token__LilyPreparser(self); // skip `await` keyword
 
@@ -8025,7 +8066,7 @@ LilyPreparserFunBodyItem *
 preparse_break_block__LilyPreparser(LilyPreparser *self)
 {
     // break [ <identifier_normal> ] ;
-    Location location = location_fun_body_item;
+    Location location = self->location_fun_body_item;
 
     next_token__LilyPreparser(self); // skip `break` keyword
 
@@ -8082,7 +8123,7 @@ preparse_defer_block__LilyPreparser(LilyPreparser *self)
     // defer <block> ;
     // <block> = <exprs> | <lambda> | <stmt_for> | <stmt_match> | <stmt_if> |
     //           <stmt_try> | <stmt_unsafe> | <stmt_while> | <stmt_block>
-    Location location = location_fun_body_item;
+    Location location = self->location_fun_body_item;
 
     next_token__LilyPreparser(self); // skip `defer` keyword
 
@@ -8127,7 +8168,8 @@ preparse_defer_block__LilyPreparser(LilyPreparser *self)
 
             break;
         default: {
-            LilyToken *prev = get__Vec(self->tokens, self->position - 1);
+            LilyToken *prev =
+              get_token__LilyPreparser(self, self->position - 1);
 
             switch (prev->kind) {
                 case LILY_TOKEN_KIND_SEMICOLON:
@@ -8167,7 +8209,7 @@ preparse_drop_block__LilyPreparser(LilyPreparser *self)
 {
     // drop <tokens> ;
     // <tokens> = <token> [ <token> ]*
-    Location location = location_fun_body_item;
+    Location location = self->location_fun_body_item;
 
     next_token__LilyPreparser(self); // skip `drop` keyword
 
@@ -8221,7 +8263,7 @@ preparse_if_block__LilyPreparser(LilyPreparser *self)
     // <elif_block> = <tokens>
     // <else_block> = <tokens>
     // <tokens> = <token> [ <token> ]*
-    Location location = location_fun_body_item;
+    Location location = self->location_fun_body_item;
     Vec *if_expr = NEW(Vec); // Vec<LilyToken* (&)>*
     Vec *if_capture = NULL;  // Vec<LilyToken* (&)>*?
     Vec *if_block = NULL;
@@ -8600,7 +8642,7 @@ preparse_for_block__LilyPreparser(LilyPreparser *self)
     // <for_capture> = <tokens>
     // <for_block> = <tokens>
     // <tokens> = <token> [ <token> ]*
-    Location location = location_fun_body_item;
+    Location location = self->location_fun_body_item;
 
     next_token__LilyPreparser(self); // skip `for` keyword
 
@@ -8965,7 +9007,7 @@ preparse_while_block__LilyPreparser(LilyPreparser *self)
     // <while_expr> = <tokens>
     // <while_block> = <tokens>
     // <tokens> = <token> [ <token> ]*
-    Location location = location_fun_body_item;
+    Location location = self->location_fun_body_item;
 
     next_token__LilyPreparser(self); // skip `while` keyword
 
@@ -9023,7 +9065,7 @@ preparse_raise_block__LilyPreparser(LilyPreparser *self)
     // raise <raise_expr> ;
     // <raise_expr> = <tokens>
     // <tokens> = <token> [ <token> ]*
-    Location location = location_fun_body_item;
+    Location location = self->location_fun_body_item;
 
     next_token__LilyPreparser(self); // skip `raise` keyword
 
@@ -9068,7 +9110,7 @@ preparse_return_block__LilyPreparser(LilyPreparser *self)
     // return [ <return_expr> ] ;
     // <return_expr> = <tokens>
     // <tokens> = <token> [ <token> ]*
-    Location location = location_fun_body_item;
+    Location location = self->location_fun_body_item;
 
     next_token__LilyPreparser(self); // skip `return` keyword
 
@@ -9132,7 +9174,7 @@ preparse_try_block__LilyPreparser(LilyPreparser *self)
     // <catch_expr> = <tokens>
     // <catch_block> = <tokens>
     // <tokens> = <token> [ <token> ]*
-    Location location = location_fun_body_item;
+    Location location = self->location_fun_body_item;
 
     jump__LilyPreparser(self, 2); // skip `try` and `do` keyword
 
@@ -9262,7 +9304,7 @@ preparse_match_block__LilyPreparser(LilyPreparser *self)
     // <match_expr> = <tokens>
     // <match_block> = <tokens>
     // <tokens> = <token> [ <token> ]*
-    Location location_match = location_fun_body_item;
+    Location location_match = self->location_fun_body_item;
 
     next_token__LilyPreparser(self); // skip `match` keyword
 
@@ -9410,9 +9452,8 @@ preparse_match_block__LilyPreparser(LilyPreparser *self)
 
         if (block) {
             if (block->kind == LILY_PREPARSER_FUN_BODY_ITEM_KIND_EXPRS) {
-                switch (
-                  CAST(LilyToken *, get__Vec(self->tokens, self->position - 1))
-                    ->kind) {
+                switch (get_token__LilyPreparser(self, self->position - 1)
+                          ->kind) {
                     case LILY_TOKEN_KIND_SEMICOLON:
                         break;
                     default:
@@ -9482,7 +9523,7 @@ preparse_next_block__LilyPreparser(LilyPreparser *self)
 {
     // next [ <next_name> ] ;
     // <next_name> = <identifier_normal>
-    Location location = location_fun_body_item;
+    Location location = self->location_fun_body_item;
 
     next_token__LilyPreparser(self); // skip `next` keyword
 
@@ -9539,7 +9580,7 @@ preparse_basic_block__LilyPreparser(LilyPreparser *self)
     // begin <basic_block_body> end
     // <basic_block_body> = <tokens>
     // <tokens> = <token> [ <token> ]*
-    Location location = location_fun_body_item;
+    Location location = self->location_fun_body_item;
 
     next_token__LilyPreparser(self); // skip `begin` keyword
 
@@ -9561,7 +9602,7 @@ preparse_basic_brace_block__LilyPreparser(LilyPreparser *self)
     // @{ <basic_brace_block_body> }
     // <basic_brace_block_body> = <tokens>
     // <tokens> = <token> [ <token> ]*
-    Location location = location_fun_body_item;
+    Location location = self->location_fun_body_item;
     Vec *body = NEW(Vec); // Vec<LilyPreparserFunBodyItem*>*
 
     while (!must_close_basic_brace_block__LilyPreparser(self)) {
@@ -9588,7 +9629,7 @@ preparse_unsafe_block__LilyPreparser(LilyPreparser *self)
     // unsafe <unsafe_block_body> end
     // <unsafe_block_body> = <tokens>
     // <tokens> = <token> [ <token> ]*
-    Location location = location_fun_body_item;
+    Location location = self->location_fun_body_item;
     Vec *body = NEW(Vec); // Vec<LilyPreparserFunBodyItem*>*
 
     // 1. Preparse unsafe block body
@@ -9798,7 +9839,7 @@ preparse_block__LilyPreparser(LilyPreparser *self,
                               bool (*must_close)(LilyPreparser *),
                               bool parse_semicolon)
 {
-    location_fun_body_item = clone__Location(&self->current->location);
+    self->location_fun_body_item = clone__Location(&self->current->location);
 
     switch (self->current->kind) {
         /*
@@ -10185,9 +10226,9 @@ preparse_block__LilyPreparser(LilyPreparser *self,
             LilyToken *previous = NULL;
 
             if (self->current->kind == LILY_TOKEN_KIND_EOF) {
-                previous = self->tokens->buffer[self->position];
+                previous = get_token__LilyPreparser(self, self->position);
             } else {
-                previous = self->tokens->buffer[self->position - 1];
+                previous = get_token__LilyPreparser(self, self->position - 1);
             }
 
             END_LOCATION(&location, previous->location);
@@ -10288,7 +10329,7 @@ preparse_fun__LilyPreparser(LilyPreparser *self)
     // <expr> = <tokens>
     next_token__LilyPreparser(self); // skip `fun` keyword
 
-    Location location = clone__Location(&location_decl);
+    Location location = clone__Location(&self->location_decl);
     String *object_impl = NULL;
     String *name = NULL;
     Vec *generic_params = NULL;   // Vec<Vec<LilyToken* (&)>*>*?
@@ -10586,7 +10627,7 @@ preparse_fun__LilyPreparser(LilyPreparser *self)
                            body,
                            req,
                            when,
-                           visibility_decl,
+                           self->visibility_decl,
                            false,
                            is_operator,
                            when_is_comptime,
@@ -10607,8 +10648,8 @@ preparse_constant__LilyPreparser(LilyPreparser *self)
             break;
     }
 
-    enum LilyVisibility visibility = visibility_decl;
-    Location location = clone__Location(&location_decl);
+    enum LilyVisibility visibility = self->visibility_decl;
+    Location location = clone__Location(&self->location_decl);
 
     // 1. Get name of the constant.
     GET_NAME(self, from__String("expected name of the constant"));
@@ -10700,8 +10741,8 @@ LilyPreparserDecl *
 preparse_constant_multiple__LilyPreparser(LilyPreparser *self)
 {
     // val (<name> [data_type], ...) := (<expr>,...);
-    enum LilyVisibility visibility = visibility_decl;
-    Location location = clone__Location(&location_decl);
+    enum LilyVisibility visibility = self->visibility_decl;
+    Location location = clone__Location(&self->location_decl);
 
     next_token__LilyPreparser(self); // skip `(`
 
@@ -11155,7 +11196,7 @@ return_attribute: {
                            default_expr,
                            is_get,
                            is_set,
-                           visibility_decl),
+                           self->visibility_decl),
                        location);
 }
 }
@@ -11252,7 +11293,7 @@ preparse_class_body__LilyPreparser(LilyPreparser *self)
                         case LILY_TOKEN_KIND_KEYWORD_VAL: {
                             next_token__LilyPreparser(self);
 
-                            visibility_decl = LILY_VISIBILITY_PUBLIC;
+                            self->visibility_decl = LILY_VISIBILITY_PUBLIC;
 
                             LilyPreparserClassBodyItem *attribute =
                               preparse_attribute_for_class__LilyPreparser(
@@ -11271,7 +11312,7 @@ preparse_class_body__LilyPreparser(LilyPreparser *self)
                         case LILY_TOKEN_KIND_KEYWORD_FUN: {
                             next_token__LilyPreparser(self);
 
-                            visibility_decl = LILY_VISIBILITY_PUBLIC;
+                            self->visibility_decl = LILY_VISIBILITY_PUBLIC;
 
                             LilyPreparserClassBodyItem *method =
                               preparse_method_for_class__LilyPreparser(self);
@@ -11340,7 +11381,7 @@ preparse_class_body__LilyPreparser(LilyPreparser *self)
                         case LILY_TOKEN_KIND_KEYWORD_VAL: {
                             next_token__LilyPreparser(self);
 
-                            visibility_decl = LILY_VISIBILITY_STATIC;
+                            self->visibility_decl = LILY_VISIBILITY_STATIC;
 
                             LilyPreparserClassBodyItem *attribute =
                               preparse_attribute_for_class__LilyPreparser(
@@ -11358,7 +11399,7 @@ preparse_class_body__LilyPreparser(LilyPreparser *self)
                         case LILY_TOKEN_KIND_KEYWORD_FUN: {
                             next_token__LilyPreparser(self);
 
-                            visibility_decl = LILY_VISIBILITY_STATIC;
+                            self->visibility_decl = LILY_VISIBILITY_STATIC;
 
                             LilyPreparserClassBodyItem *method =
                               preparse_method_for_class__LilyPreparser(self);
@@ -11500,7 +11541,7 @@ clean_up: {
     FREE_BUFFER_ITEMS(body->buffer, body->len, LilyPreparserTraitBodyItem);
     FREE(Vec, body);
 
-    visibility_decl = LILY_VISIBILITY_PRIVATE;
+    self->visibility_decl = LILY_VISIBILITY_PRIVATE;
 
     return NULL;
 }
@@ -11514,8 +11555,8 @@ preparse_class__LilyPreparser(LilyPreparser *self,
                               Vec *generic_params,
                               bool is_close)
 {
-    Location location = clone__Location(&location_decl);
-    enum LilyVisibility visibility = visibility_decl;
+    Location location = clone__Location(&self->location_decl);
+    enum LilyVisibility visibility = self->visibility_decl;
 
     // 1. Preparse class body
     Vec *body = preparse_class_body__LilyPreparser(self);
@@ -11563,7 +11604,7 @@ preparse_class__LilyPreparser(LilyPreparser *self,
               body->buffer, body->len, LilyPreparserClassBodyItem);
             FREE(Vec, body);
 
-            visibility_decl = LILY_VISIBILITY_PRIVATE;
+            self->visibility_decl = LILY_VISIBILITY_PRIVATE;
 
             return NULL;
         }
@@ -11694,7 +11735,7 @@ preparse_trait_body__LilyPreparser(LilyPreparser *self)
                         case LILY_TOKEN_KIND_KEYWORD_FUN: {
                             next_token__LilyPreparser(self);
 
-                            visibility_decl = LILY_VISIBILITY_STATIC;
+                            self->visibility_decl = LILY_VISIBILITY_STATIC;
 
                             LilyPreparserTraitBodyItem *prototype =
                               preparse_prototype__LilyPreparser(self);
@@ -11711,7 +11752,7 @@ preparse_trait_body__LilyPreparser(LilyPreparser *self)
                         case LILY_TOKEN_KIND_KEYWORD_VAL: {
                             next_token__LilyPreparser(self);
 
-                            visibility_decl = LILY_VISIBILITY_STATIC;
+                            self->visibility_decl = LILY_VISIBILITY_STATIC;
 
                             LilyPreparserTraitBodyItem *attribute =
                               preparse_attribute_for_trait__LilyPreparser(
@@ -11773,7 +11814,7 @@ preparse_trait_body__LilyPreparser(LilyPreparser *self)
                     goto clean_up;
                 }
 
-                visibility_decl = LILY_VISIBILITY_PRIVATE;
+                self->visibility_decl = LILY_VISIBILITY_PRIVATE;
 
                 break;
             }
@@ -11786,7 +11827,7 @@ preparse_trait_body__LilyPreparser(LilyPreparser *self)
                         case LILY_TOKEN_KIND_KEYWORD_FUN: {
                             next_token__LilyPreparser(self);
 
-                            visibility_decl = LILY_VISIBILITY_PUBLIC;
+                            self->visibility_decl = LILY_VISIBILITY_PUBLIC;
 
                             LilyPreparserTraitBodyItem *prototype =
                               preparse_prototype__LilyPreparser(self);
@@ -11803,7 +11844,7 @@ preparse_trait_body__LilyPreparser(LilyPreparser *self)
                         case LILY_TOKEN_KIND_KEYWORD_VAL: {
                             next_token__LilyPreparser(self);
 
-                            visibility_decl = LILY_VISIBILITY_PUBLIC;
+                            self->visibility_decl = LILY_VISIBILITY_PUBLIC;
 
                             LilyPreparserTraitBodyItem *attribute =
                               preparse_attribute_for_trait__LilyPreparser(
@@ -11865,7 +11906,7 @@ preparse_trait_body__LilyPreparser(LilyPreparser *self)
                     goto clean_up;
                 }
 
-                visibility_decl = LILY_VISIBILITY_PRIVATE;
+                self->visibility_decl = LILY_VISIBILITY_PRIVATE;
 
                 break;
             }
@@ -11960,7 +12001,7 @@ clean_up: {
     FREE_BUFFER_ITEMS(body->buffer, body->len, LilyPreparserTraitBodyItem);
     FREE(Vec, body);
 
-    visibility_decl = LILY_VISIBILITY_PRIVATE;
+    self->visibility_decl = LILY_VISIBILITY_PRIVATE;
 
     return NULL;
 }
@@ -11974,8 +12015,8 @@ preparse_trait__LilyPreparser(LilyPreparser *self,
                               bool is_close)
 {
     // trait <name> [generic_params] [inherits] [body] end
-    Location location = clone__Location(&location_decl);
-    enum LilyVisibility visibility = visibility_decl;
+    Location location = clone__Location(&self->location_decl);
+    enum LilyVisibility visibility = self->visibility_decl;
 
     // 1. Preparse body.
     Vec *body = preparse_trait_body__LilyPreparser(self);
@@ -12168,8 +12209,8 @@ preparse_record_object_body__LilyPreparser(LilyPreparser *self)
                               preparse_record_field__LilyPreparser(self, false);
 
                             {
-                                LilyToken *previous =
-                                  self->tokens->buffer[self->position - 1];
+                                LilyToken *previous = get_token__LilyPreparser(
+                                  self, self->position - 1);
 
                                 END_LOCATION(&location_field,
                                              previous->location);
@@ -12219,7 +12260,7 @@ preparse_record_object_body__LilyPreparser(LilyPreparser *self)
                 LilyToken *peeked = peek_token__LilyPreparser(self, 1);
 
                 if (peeked) {
-                    visibility_decl = LILY_VISIBILITY_PUBLIC;
+                    self->visibility_decl = LILY_VISIBILITY_PUBLIC;
 
                     switch (peeked->kind) {
                         case LILY_TOKEN_KIND_KEYWORD_FUN: {
@@ -12228,7 +12269,7 @@ preparse_record_object_body__LilyPreparser(LilyPreparser *self)
                             LilyPreparserRecordObjectBodyItem *method =
                               preparse_method_for_record__LilyPreparser(self);
 
-                            visibility_decl = LILY_VISIBILITY_PRIVATE;
+                            self->visibility_decl = LILY_VISIBILITY_PRIVATE;
 
                             if (method) {
                                 push__Vec(body, method);
@@ -12244,7 +12285,7 @@ preparse_record_object_body__LilyPreparser(LilyPreparser *self)
                             LilyPreparserRecordObjectBodyItem *constant =
                               preparse_constant_for_record__LilyPreparser(self);
 
-                            visibility_decl = LILY_VISIBILITY_PRIVATE;
+                            self->visibility_decl = LILY_VISIBILITY_PRIVATE;
 
                             if (constant) {
                                 push__Vec(body, constant);
@@ -12264,14 +12305,14 @@ preparse_record_object_body__LilyPreparser(LilyPreparser *self)
                               preparse_record_field__LilyPreparser(self, false);
 
                             {
-                                LilyToken *previous =
-                                  self->tokens->buffer[self->position - 1];
+                                LilyToken *previous = get_token__LilyPreparser(
+                                  self, self->position - 1);
 
                                 END_LOCATION(&location_field,
                                              previous->location);
                             }
 
-                            visibility_decl = LILY_VISIBILITY_PRIVATE;
+                            self->visibility_decl = LILY_VISIBILITY_PRIVATE;
 
                             if (field) {
                                 push__Vec(
@@ -12288,7 +12329,7 @@ preparse_record_object_body__LilyPreparser(LilyPreparser *self)
                             break;
                         }
                         default:
-                            visibility_decl = LILY_VISIBILITY_PRIVATE;
+                            self->visibility_decl = LILY_VISIBILITY_PRIVATE;
                             goto unexpected_token;
                     }
                 }
@@ -12340,8 +12381,8 @@ preparse_record_object__LilyPreparser(LilyPreparser *self,
                                       Vec *generic_params)
 {
     // object <name> [generic_params] record [impls] [body] end
-    enum LilyVisibility visibility = visibility_decl;
-    Location location = clone__Location(&location_decl);
+    enum LilyVisibility visibility = self->visibility_decl;
+    Location location = clone__Location(&self->location_decl);
 
     Vec *body = preparse_record_object_body__LilyPreparser(self);
 
@@ -12534,8 +12575,8 @@ preparse_enum_object_body__LilyPreparser(LilyPreparser *self)
                               preparse_enum_variant__LilyPreparser(self);
 
                             {
-                                LilyToken *previous =
-                                  self->tokens->buffer[self->position - 1];
+                                LilyToken *previous = get_token__LilyPreparser(
+                                  self, self->position - 1);
 
                                 END_LOCATION(&location_variant,
                                              previous->location);
@@ -12617,8 +12658,8 @@ preparse_enum_object__LilyPreparser(LilyPreparser *self,
                                     Vec *generic_params)
 {
     // object <name> [generic_params] enum [impls] [body] end
-    enum LilyVisibility visibility = visibility_decl;
-    Location location = clone__Location(&location_decl);
+    enum LilyVisibility visibility = self->visibility_decl;
+    Location location = clone__Location(&self->location_decl);
 
     Vec *body = preparse_enum_object_body__LilyPreparser(self);
 
@@ -13171,7 +13212,7 @@ preparse_record_field__LilyPreparser(LilyPreparser *self, bool is_mut)
     String *name = NULL;
     Vec *data_type = NEW(Vec); // Vec<LilyToken* (&)>*
     Vec *optional_expr = NULL; // Vec<LilyToken* (&)>*?
-    enum LilyVisibility visibility_field = visibility_decl;
+    enum LilyVisibility visibility_field = self->visibility_decl;
 
     switch (self->current->kind) {
         case LILY_TOKEN_KIND_KEYWORD_PUB:
@@ -13331,20 +13372,20 @@ preparse_record_body__LilyPreparser(LilyPreparser *self)
                             Location location_field =
                               clone__Location(&self->current->location);
 
-                            visibility_decl = LILY_VISIBILITY_PUBLIC;
+                            self->visibility_decl = LILY_VISIBILITY_PUBLIC;
 
                             LilyPreparserRecordField *field =
                               preparse_record_field__LilyPreparser(self, false);
 
                             {
-                                LilyToken *previous =
-                                  self->tokens->buffer[self->position - 1];
+                                LilyToken *previous = get_token__LilyPreparser(
+                                  self, self->position - 1);
 
                                 END_LOCATION(&location_field,
                                              previous->location);
                             }
 
-                            visibility_decl = LILY_VISIBILITY_PRIVATE;
+                            self->visibility_decl = LILY_VISIBILITY_PRIVATE;
 
                             if (field) {
                                 push__Vec(
@@ -13376,20 +13417,20 @@ preparse_record_body__LilyPreparser(LilyPreparser *self)
 
                             next_token__LilyPreparser(self);
 
-                            visibility_decl = LILY_VISIBILITY_PUBLIC;
+                            self->visibility_decl = LILY_VISIBILITY_PUBLIC;
 
                             LilyPreparserRecordField *field =
                               preparse_record_field__LilyPreparser(self, true);
 
                             {
-                                LilyToken *previous =
-                                  self->tokens->buffer[self->position - 1];
+                                LilyToken *previous = get_token__LilyPreparser(
+                                  self, self->position - 1);
 
                                 END_LOCATION(&location_field,
                                              previous->location);
                             }
 
-                            visibility_decl = LILY_VISIBILITY_PRIVATE;
+                            self->visibility_decl = LILY_VISIBILITY_PRIVATE;
 
                             if (field) {
                                 push__Vec(
@@ -13457,8 +13498,8 @@ preparse_record__LilyPreparser(LilyPreparser *self,
     // type <name> [ <generic_params> ] record = <body> end
 
     // 1. Get visibility
-    enum LilyVisibility visibility = visibility_decl;
-    Location location = clone__Location(&location_decl);
+    enum LilyVisibility visibility = self->visibility_decl;
+    Location location = clone__Location(&self->location_decl);
 
     Vec *body = preparse_record_body__LilyPreparser(self);
 
@@ -13660,8 +13701,8 @@ preparse_enum_body__LilyPreparser(LilyPreparser *self)
                               preparse_enum_variant__LilyPreparser(self);
 
                             {
-                                LilyToken *previous =
-                                  self->tokens->buffer[self->position - 1];
+                                LilyToken *previous = get_token__LilyPreparser(
+                                  self, self->position - 1);
 
                                 END_LOCATION(&location_variant,
                                              previous->location);
@@ -13724,8 +13765,8 @@ preparse_enum__LilyPreparser(LilyPreparser *self,
                              String *name,
                              Vec *generic_params)
 {
-    enum LilyVisibility visibility = visibility_decl;
-    Location location = clone__Location(&location_decl);
+    enum LilyVisibility visibility = self->visibility_decl;
+    Location location = clone__Location(&self->location_decl);
 
     Vec *body = preparse_enum_body__LilyPreparser(self);
 
@@ -13791,7 +13832,7 @@ preparse_alias__LilyPreparser(LilyPreparser *self,
 
     switch (self->current->kind) {
         case LILY_TOKEN_KIND_SEMICOLON:
-            END_LOCATION(&location_decl, self->current->location);
+            END_LOCATION(&self->location_decl, self->current->location);
 
             next_token__LilyPreparser(self);
 
@@ -13819,21 +13860,21 @@ preparse_alias__LilyPreparser(LilyPreparser *self,
 
     return NEW_VARIANT(LilyPreparserDecl,
                        type,
-                       location_decl,
+                       self->location_decl,
                        NEW_VARIANT(LilyPreparserType,
                                    alias,
                                    NEW(LilyPreparserAlias,
                                        name,
                                        generic_params,
                                        data_type,
-                                       visibility_decl)));
+                                       self->visibility_decl)));
 }
 
 LilyPreparserDecl *
 preparse_error__LilyPreparser(LilyPreparser *self)
 {
     // error <name> [ <generic_params> ] [ : <data_type> ] ;
-    Location location = clone__Location(&location_decl);
+    Location location = clone__Location(&self->location_decl);
 
     next_token__LilyPreparser(self); // skip `error`
 
@@ -13920,12 +13961,14 @@ preparse_error__LilyPreparser(LilyPreparser *self)
         }
     }
 
-    return NEW_VARIANT(
-      LilyPreparserDecl,
-      error,
-      location,
-      NEW(
-        LilyPreparserError, name, data_type, generic_params, visibility_decl));
+    return NEW_VARIANT(LilyPreparserDecl,
+                       error,
+                       location,
+                       NEW(LilyPreparserError,
+                           name,
+                           data_type,
+                           generic_params,
+                           self->visibility_decl));
 }
 
 LilyPreparserDecl *
@@ -14519,11 +14562,16 @@ CONSTRUCTOR(LilyPreparserInfo, LilyPreparserInfo, String *package_name)
         .private_macros = NEW(Vec),
         .decls = NEW(Vec),
         .package = NEW(LilyPreparserPackage, package_name),
+        .destroy_all = false,
     };
 }
 
 DESTRUCTOR(LilyPreparserInfo, const LilyPreparserInfo *self)
 {
+    bool prev_destroy_all = destroy_all;
+
+    destroy_all = self->destroy_all;
+
     FREE_BUFFER_ITEMS(self->public_imports->buffer,
                       self->public_imports->len,
                       LilyPreparserImport);
@@ -14548,36 +14596,44 @@ DESTRUCTOR(LilyPreparserInfo, const LilyPreparserInfo *self)
     FREE(Vec, self->decls);
 
     FREE(LilyPreparserPackage, self->package);
+
+    destroy_all = prev_destroy_all;
 }
 
 CONSTRUCTOR(LilyPreparser,
             LilyPreparser,
             const File *file,
-            const Vec *tokens,
+            const LilyTokenBuffer *tokens,
             const char *default_package_access,
             bool destroy_all)
 {
     return (LilyPreparser){ .file = file,
                             .tokens = tokens,
+                            .stream = NULL,
                             .current = NULL,
                             .position = 0,
                             .count_error = 0,
                             .count_warning = 0,
                             .default_package_access = default_package_access,
-                            .destroy_all = destroy_all };
+                            .destroy_all = destroy_all,
+                            .visibility_decl = LILY_VISIBILITY_PRIVATE,
+                            .location_decl = default__Location(file->name),
+                            .location_fun_body_item =
+                              default__Location(file->name) };
 }
 
 void
 run__LilyPreparser(LilyPreparser *self, LilyPreparserInfo *info)
 {
     destroy_all = self->destroy_all;
+    info->destroy_all = self->destroy_all;
 
-    self->current = get__Vec(self->tokens, 0);
+    self->current = get_token__LilyPreparser(self, 0);
 
     bool package_is_preparse = false;
 
     while (self->current->kind != LILY_TOKEN_KIND_EOF) {
-        location_decl = clone__Location(&self->current->location);
+        self->location_decl = clone__Location(&self->current->location);
 
         switch (self->current->kind) {
             /*
@@ -14643,7 +14699,7 @@ run__LilyPreparser(LilyPreparser *self, LilyPreparserInfo *info)
             }
 
             case LILY_TOKEN_KIND_KEYWORD_PUB:
-                visibility_decl = LILY_VISIBILITY_PUBLIC;
+                self->visibility_decl = LILY_VISIBILITY_PUBLIC;
 
                 next_token__LilyPreparser(self);
 
@@ -14787,7 +14843,7 @@ run__LilyPreparser(LilyPreparser *self, LilyPreparserInfo *info)
                     }
                 }
 
-                visibility_decl = LILY_VISIBILITY_PRIVATE;
+                self->visibility_decl = LILY_VISIBILITY_PRIVATE;
 
                 break;
 
@@ -15092,8 +15148,8 @@ exit_preparser: {
 #ifdef DEBUG_PREPARSER
     printf("\n====Preparser(%s)====\n", self->file->name);
 
-    for (Usize i = 0; i < self->tokens->len; ++i) {
-        CALL_DEBUG(LilyToken, get__Vec(self->tokens, i));
+    for (Usize i = 0; has_token__LilyPreparser(self, i); ++i) {
+        CALL_DEBUG(LilyToken, get_token__LilyPreparser(self, i));
     }
 
     printf("\n====Preparser public imports(%s)====\n", self->file->name);
@@ -15135,3 +15191,69 @@ exit_preparser: {
         exit(1);
     }
 }
+
+void *
+run_scanner__LilyPreparser(void *run)
+{
+    LilyPreparserScannerRun *self = run;
+
+    set_buffer__Diagnostic(self->diagnostics);
+    self->has_error = run__LilyScanner(self->scanner, false);
+
+    return NULL;
+}
+
+void
+run_pipelined__LilyPreparser(LilyPreparser *self,
+                             LilyPreparserInfo *info,
+                             LilyScanner *scanner)
+{
+    ASSERT(!scanner->stream);
+
+    pthread_t scanner_thread;
+    // NOTE: The diagnostics of the scanner and of the preparser are buffered,
+    // then they're moved to the buffer of the current thread (e.g. in a task of
+    // the precompiler) or printed, in the order of a sequential run. So the
+    // scanner never exits from its thread, and the diagnostics of the
+    // preparser are dropped if the scan has failed (they'd only be cascading
+    // errors of the tokens of the failed scan).
+    DiagnosticBuffer *diagnostics = get_buffer__Diagnostic();
+    DiagnosticBuffer scanner_diagnostics = NEW(DiagnosticBuffer);
+    DiagnosticBuffer preparser_diagnostics = NEW(DiagnosticBuffer);
+    LilyPreparserScannerRun run = { .scanner = scanner,
+                                    .diagnostics = &scanner_diagnostics,
+                                    .has_error = false };
+
+    scanner->stream = NEW(LilyTokenStream);
+    self->stream = scanner->stream;
+
+    ASSERT(!pthread_create(
+      &scanner_thread, NULL, &run_scanner__LilyPreparser, &run));
+
+    set_buffer__Diagnostic(&preparser_diagnostics);
+    run__LilyPreparser(self, info);
+
+    // NOTE: If the preparser has stopped before the EOF token, the rest of the
+    // stream is received, so that the scanner is never blocked on a full ring.
+    while (has__LilyTokenStream(self->stream, self->stream->len)) {
+    }
+
+    pthread_join(scanner_thread, NULL);
+    set_buffer__Diagnostic(diagnostics);
+
+    flush__DiagnosticBuffer(
+      &scanner_diagnostics, scanner->base.count_error, &self->count_warning);
+
+    if (!run.has_error) {
+        flush__DiagnosticBuffer(
+          &preparser_diagnostics, &self->count_error, &self->count_warning);
+    }
+
+    FREE(DiagnosticBuffer, &scanner_diagnostics);
+    FREE(DiagnosticBuffer, &preparser_diagnostics);
+
+    // NOTE: The enclosing task (if any) stops the build instead.
+    if (!diagnostics && (run.has_error || self->count_error > 0)) {
+        exit(1);
+    }
+}
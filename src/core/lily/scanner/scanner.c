@@ -28,6 +28,7 @@
 
 #include <core/lily/diagnostic/error.h>
 #include <core/lily/lily.h>
+#include <core/lily/scanner/perfect_hash.h>
 #include <core/lily/scanner/scanner.h>
 #include <core/shared/diagnostic.h>
 
@@ -157,6 +158,10 @@ next_char_by_token__LilyScanner(LilyScanner *self, const LilyToken *token);
 static inline void
 push_token__LilyScanner(LilyScanner *self, LilyToken *token);
 
+/// @brief Free a token which is not pushed (e.g. a comment).
+static inline void
+drop_token__LilyScanner(LilyScanner *self, LilyToken *token);
+
 /// @brief Check if current is a digit.
 static inline bool
 is_digit__LilyScanner(const LilyScanner *self);
@@ -289,9 +294,35 @@ verify_identifier_string__LilyScanner(
 static LilyToken *
 get_token__LilyScanner(LilyScanner *self);
 
+/// @brief Scan the next token. If the token is an opening delimiter, all the
+/// tokens until the closing delimiter are also scanned.
+static void
+scan_next_token__LilyScanner(LilyScanner *self);
+
+/// @brief Push the EOF token to tokens.
+static void
+push_eof_token__LilyScanner(LilyScanner *self);
+
+/// @brief Look for the index of the last token before the edit from which the
+/// scan can be resumed (the token must be outside of any delimiter).
+/// @return Return -1 if the scan must be resumed from the start of the file.
+static Isize
+get_resume_token__LilyScanner(const LilyScanner *self,
+                              const LilyScannerEdit *edit);
+
+/// @brief Shift the location of the tokens after a re-synchronization.
+static void
+shift_tokens__LilyScanner(LilyScanner *self,
+                          Usize start,
+                          Usize sync_line,
+                          Isize line_delta,
+                          Isize column_delta,
+                          Isize position_delta);
+
 #define HAS_REACH_END(self) SCANNER_HAS_REACH_END((self)->base)
 
-// NOTE: This table must be sorted in ascending order.
+// NOTE: After modifying this table, you must run `make perfect_hash` to
+// regenerate `include/core/lily/scanner/perfect_hash.h`.
 static const SizedStr lily_keywords[LILY_N_KEYWORD] = {
     SIZED_STR_FROM_RAW("Object"),   SIZED_STR_FROM_RAW("Self"),
     SIZED_STR_FROM_RAW("alias"),    SIZED_STR_FROM_RAW("and"),
@@ -367,7 +398,8 @@ static const enum LilyTokenKind lily_keyword_ids[LILY_N_KEYWORD] = {
     LILY_TOKEN_KIND_KEYWORD_WHILE,    LILY_TOKEN_KIND_KEYWORD_XOR,
 };
 
-// NOTE: This table must be sorted in ascending order.
+// NOTE: After modifying this table, you must run `make perfect_hash` to
+// regenerate `include/core/lily/scanner/perfect_hash.h`.
 static const SizedStr lily_at_keywords[LILY_N_AT_KEYWORD] = {
     SIZED_STR_FROM_RAW("builtin"), SIZED_STR_FROM_RAW("cc"),
     SIZED_STR_FROM_RAW("cpp"),     SIZED_STR_FROM_RAW("hide"),
@@ -383,6 +415,11 @@ static const enum LilyTokenKind lily_at_keyword_ids[LILY_N_AT_KEYWORD] = {
     LILY_TOKEN_KIND_KEYWORD_AT_SYS,
 };
 
+static_assert(LILY_KEYWORDS_PERFECT_HASH_KEYS_LEN == LILY_N_KEYWORD,
+              "the perfect hash of lily_keywords is out of date");
+static_assert(LILY_AT_KEYWORDS_PERFECT_HASH_KEYS_LEN == LILY_N_AT_KEYWORD,
+              "the perfect hash of lily_at_keywords is out of date");
+
 #define IS_ZERO '0'
 
 #define IS_DIGIT_WITHOUT_ZERO \
@@ -792,8 +829,11 @@ static const enum LilyTokenKind lily_at_keyword_ids[LILY_N_AT_KEYWORD] = {
 enum LilyTokenKind
 get_keyword__LilyScanner(const String *id)
 {
-    Int32 res = get_keyword__Scanner(
-      id, lily_keywords, (const Int32 *)lily_keyword_ids, LILY_N_KEYWORD);
+    Int32 res = get_keyword__Scanner(id,
+                                     lily_keywords,
+                                     (const Int32 *)lily_keyword_ids,
+                                     LILY_N_KEYWORD,
+                                     &lily_keywords_perfect_hash);
 
     if (res == -1) {
         return LILY_TOKEN_KIND_IDENTIFIER_NORMAL;
@@ -808,7 +848,8 @@ get_at_keyword__LilyScanner(const String *id)
     Int32 res = get_keyword__Scanner(id,
                                      lily_at_keywords,
                                      (const Int32 *)lily_at_keyword_ids,
-                                     LILY_N_AT_KEYWORD);
+                                     LILY_N_AT_KEYWORD,
+                                     &lily_at_keywords_perfect_hash);
 
     if (res == -1) {
         return LILY_TOKEN_KIND_IDENTIFIER_NORMAL;
@@ -938,7 +979,24 @@ next_char_by_token__LilyScanner(LilyScanner *self, const LilyToken *token)
 void
 push_token__LilyScanner(LilyScanner *self, LilyToken *token)
 {
-    push__Vec(self->tokens, token);
+    if (self->stream) {
+        push__LilyTokenStream(self->stream, token);
+    } else if (get_slots__LilyTokenBuffer() == &self->tokens) {
+        push_slot__LilyTokenBuffer(&self->tokens, token);
+    } else {
+        push__LilyTokenBuffer(&self->tokens, token);
+    }
+}
+
+void
+drop_token__LilyScanner(LilyScanner *self, LilyToken *token)
+{
+    // NOTE: The slot of the token is released with the buffer.
+    if (get_slots__LilyTokenBuffer() == &self->tokens) {
+        free_payload__LilyToken(token);
+    } else {
+        FREE(LilyToken, token);
+    }
 }
 
 bool
@@ -1794,7 +1852,7 @@ get_closing__LilyScanner(LilyScanner *self, char target)
 #define DEFAULT_FILTER_TOKEN(token)           \
     case LILY_TOKEN_KIND_COMMENT_LINE:        \
     case LILY_TOKEN_KIND_COMMENT_BLOCK:       \
-        FREE(LilyToken, token);               \
+        drop_token__LilyScanner(self, token); \
         break;                                \
     default:                                  \
         next_char__LilyScanner(self);         \
@@ -2651,9 +2709,161 @@ get_token__LilyScanner(LilyScanner *self)
 }
 
 void
-run__LilyScanner(LilyScanner *self, bool dump_scanner)
+scan_next_token__LilyScanner(LilyScanner *self)
 {
-    if (self->base.source.file->len > 1) {
+    LilyToken *token = get_token__LilyScanner(self);
+
+    if (token) {
+        next_char_by_token__LilyScanner(self, token);
+        end_token__LilyScanner(self,
+                               self->base.source.cursor.line,
+                               self->base.source.cursor.column,
+                               self->base.source.cursor.position);
+        set_all__Location(&token->location, &self->base.location);
+
+        switch (token->kind) {
+            DEFAULT_FILTER_TOKEN(token);
+        }
+    }
+}
+
+void
+push_eof_token__LilyScanner(LilyScanner *self)
+{
+    start_token__LilyScanner(self,
+                             self->base.source.cursor.line,
+                             self->base.source.cursor.column,
+                             self->base.source.cursor.position);
+    end_token__LilyScanner(self,
+                           self->base.source.cursor.line,
+                           self->base.source.cursor.column,
+                           self->base.source.cursor.position);
+    push_token__LilyScanner(self,
+                            NEW(LilyToken,
+                                LILY_TOKEN_KIND_EOF,
+                                clone__Location(&self->base.location)));
+}
+
+Isize
+get_resume_token__LilyScanner(const LilyScanner *self,
+                              const LilyScannerEdit *edit)
+{
+    Isize res = -1;
+    Usize depth = 0;
+
+    for (Usize i = 0; i < self->tokens.len; ++i) {
+        const LilyToken *token = get__LilyTokenBuffer(&self->tokens, i);
+
+        // NOTE: The token must not be adjacent to the edit, because the edit
+        // can extend it (e.g. `ab` + `c` => `abc`).
+        if (token->location.end_position + 1 >= edit->start_position) {
+            break;
+        }
+
+        switch (token->kind) {
+            case LILY_TOKEN_KIND_L_BRACE:
+            case LILY_TOKEN_KIND_L_HOOK:
+            case LILY_TOKEN_KIND_L_PAREN:
+                if (depth++ == 0) {
+                    res = i;
+                }
+
+                break;
+            case LILY_TOKEN_KIND_R_BRACE:
+            case LILY_TOKEN_KIND_R_HOOK:
+            case LILY_TOKEN_KIND_R_PAREN:
+                if (depth > 0) {
+                    --depth;
+                }
+
+                break;
+            default:
+                if (depth == 0) {
+                    res = i;
+                }
+        }
+    }
+
+    return res;
+}
+
+void
+shift_tokens__LilyScanner(LilyScanner *self,
+                          Usize start,
+                          Usize sync_line,
+                          Isize line_delta,
+                          Isize column_delta,
+                          Isize position_delta)
+{
+    for (Usize i = start; i < self->tokens.len; ++i) {
+        Location *location = &get__LilyTokenBuffer(&self->tokens, i)->location;
+
+        // NOTE: Only the columns of the tokens on the line of the
+        // re-synchronization are shifted.
+        if (location->start_line == sync_line) {
+            location->start_column += column_delta;
+        }
+
+        if (location->end_line == sync_line) {
+            location->end_column += column_delta;
+        }
+
+        location->start_line += line_delta;
+        location->end_line += line_delta;
+        location->start_position += position_delta;
+        location->end_position += position_delta;
+    }
+}
+
+LilyScannerChange
+relex__LilyScanner(LilyScanner *self, File *file, const LilyScannerEdit *edit)
+{
+    ASSERT(file == self->base.source.file);
+    ASSERT(!self->stream);
+    ASSERT(edit->start_position <= edit->end_position &&
+           edit->end_position <= file->len);
+
+    // 1. Look for the token from which the scan is resumed.
+    Isize resume_token = get_resume_token__LilyScanner(self, edit);
+    Usize start = resume_token == -1 ? 0 : resume_token;
+
+    // 2. Apply the edit on the file.
+    Usize replacement_len = strlen(edit->replacement);
+    Usize edit_end = edit->start_position + replacement_len; // new content
+    Isize position_delta =
+      (Isize)replacement_len - (edit->end_position - edit->start_position);
+
+    replace__File(
+      file, edit->start_position, edit->end_position, edit->replacement);
+
+    if (resume_token == -1) {
+        self->base.source.cursor = NEW(Cursor, file->content);
+    } else {
+        const Location *location =
+          &get__LilyTokenBuffer(&self->tokens, start)->location;
+
+        self->base.source.cursor =
+          (Cursor){ .position = location->start_position,
+                    .current = file->content[location->start_position],
+                    .line = location->start_line,
+                    .column = location->start_column };
+    }
+
+    // 3. Scan the new tokens, until the scanner re-synchronizes with an old
+    // token (outside of any delimiter) after the edit.
+    LilyTokenBuffer old_tokens = self->tokens;
+    Usize old_end = old_tokens.len;
+    Usize old_index = start;
+    Usize old_depth = 0;
+    bool is_sync = false;
+
+    self->tokens = NEW(LilyTokenBuffer);
+
+    LilyTokenBuffer *slots = get_slots__LilyTokenBuffer();
+
+    set_slots__LilyTokenBuffer(&self->tokens);
+
+    if (file->len > 1) {
         while (!HAS_REACH_END(self)) {
             skip_space__LilyScanner(self);
 
@@ -2661,63 +2871,153 @@ run__LilyScanner(LilyScanner *self, bool dump_scanner)
                 break;
             }
 
-            LilyToken *token = get_token__LilyScanner(self);
+            if (self->base.source.cursor.position >= edit_end) {
+                Usize old_position =
+                  self->base.source.cursor.position - position_delta;
+
+                while (old_index < old_tokens.len) {
+                    const LilyToken *old_token =
+                      get__LilyTokenBuffer(&old_tokens, old_index);
 
-            if (token) {
-                next_char_by_token__LilyScanner(self, token);
-                end_token__LilyScanner(self,
-                                       self->base.source.cursor.line,
-                                       self->base.source.cursor.column,
-                                       self->base.source.cursor.position);
-                set_all__Location(&token->location, &self->base.location);
+                    if (old_token->location.start_position >= old_position) {
+                        break;
+                    }
+
+                    switch (old_token->kind) {
+                        case LILY_TOKEN_KIND_L_BRACE:
+                        case LILY_TOKEN_KIND_L_HOOK:
+                        case LILY_TOKEN_KIND_L_PAREN:
+                            ++old_depth;
+                            break;
+                        case LILY_TOKEN_KIND_R_BRACE:
+                        case LILY_TOKEN_KIND_R_HOOK:
+                        case LILY_TOKEN_KIND_R_PAREN:
+                            if (old_depth > 0) {
+                                --old_depth;
+                            }
+
+                            break;
+                        default:
+                            break;
+                    }
 
-                switch (token->kind) {
-                    DEFAULT_FILTER_TOKEN(token);
+                    ++old_index;
                 }
 
-                if (HAS_REACH_END(self)) {
+                if (old_index < old_tokens.len && old_depth == 0 &&
+                    get__LilyTokenBuffer(&old_tokens, old_index)
+                        ->location.start_position == old_position) {
+                    old_end = old_index;
+                    is_sync = true;
+
                     break;
                 }
             }
+
+            scan_next_token__LilyScanner(self);
         }
     }
 
-    start_token__LilyScanner(self,
-                             self->base.source.cursor.line,
-                             self->base.source.cursor.column,
-                             self->base.source.cursor.position);
-    end_token__LilyScanner(self,
-                           self->base.source.cursor.line,
-                           self->base.source.cursor.column,
-                           self->base.source.cursor.position);
-    push__Vec(self->tokens,
-              NEW(LilyToken,
-                  LILY_TOKEN_KIND_EOF,
-                  clone__Location(&self->base.location)));
+    if (!is_sync) {
+        push_eof_token__LilyScanner(self);
+    }
+
+    set_slots__LilyTokenBuffer(slots);
+
+    // 4. Splice the new tokens in the old tokens, then shift the locations of
+    // the tokens after the re-synchronization.
+    LilyTokenBuffer new_tokens = self->tokens;
+    LilyScannerChange change = (LilyScannerChange){
+        .start = start, .old_end = old_end, .new_end = start + new_tokens.len
+    };
+
+    self->tokens = old_tokens;
+
+    splice__LilyTokenBuffer(&self->tokens, start, old_end, &new_tokens);
+
+    if (is_sync) {
+        const Location *sync_location =
+          &get__LilyTokenBuffer(&self->tokens, change.new_end)->location;
+
+        shift_tokens__LilyScanner(
+          self,
+          change.new_end,
+          sync_location->start_line,
+          (Isize)self->base.source.cursor.line - sync_location->start_line,
+          (Isize)self->base.source.cursor.column - sync_location->start_column,
+          position_delta);
+    }
+
+    return change;
+}
+
+bool
+run__LilyScanner(LilyScanner *self, bool dump_scanner)
+{
+    DiagnosticBuffer *diagnostics = get_buffer__Diagnostic();
+    Usize count_error = diagnostics ? diagnostics->count_error : 0;
+    LilyTokenBuffer *slots = get_slots__LilyTokenBuffer();
+
+    // NOTE: The tokens sent to a stream are copied in its ring, so they're
+    // only built in place when they're stored in the buffer of the scanner.
+    set_slots__LilyTokenBuffer(self->stream ? NULL : &self->tokens);
+
+    if (self->base.source.file->len > 1) {
+        while (!HAS_REACH_END(self)) {
+            skip_space__LilyScanner(self);
+
+            if (HAS_REACH_END(self)) {
+                break;
+            }
+
+            scan_next_token__LilyScanner(self);
+        }
+    }
+
+    push_eof_token__LilyScanner(self);
+    set_slots__LilyTokenBuffer(slots);
 
 #ifndef DEBUG_SCANNER
     if (dump_scanner) {
         printf("====Scanner(%s)====\n", self->base.source.file->name);
 
-        for (Usize i = 0; i < self->tokens->len; ++i) {
-            PRINTLN("{Sr}", to_string__LilyToken(get__Vec(self->tokens, i)));
+        for (Usize i = 0; i < self->tokens.len; ++i) {
+            PRINTLN(
+              "{Sr}",
+              to_string__LilyToken(get__LilyTokenBuffer(&self->tokens, i)));
         }
     }
 #else
     printf("====Scanner(%s)====\n", self->base.source.file->name);
 
-    for (Usize i = 0; i < self->tokens->len; ++i) {
-        CALL_DEBUG(LilyToken, get__Vec(self->tokens, i));
+    for (Usize i = 0; i < self->tokens.len; ++i) {
+        CALL_DEBUG(LilyToken, get__LilyTokenBuffer(&self->tokens, i));
     }
 #endif
 
-    if (*self->base.count_error > 0) {
+    bool has_error = false;
+
+    // NOTE: When the diagnostics are buffered, the errors are counted in the
+    // buffer. The scanner can't exit, because the diagnostics of the buffer
+    // would be lost, so the caller must stop after the scan instead.
+    if (diagnostics) {
+        has_error = diagnostics->count_error > count_error;
+    } else if (*self->base.count_error > 0) {
         exit(1);
     }
+
+    if (self->stream) {
+        close__LilyTokenStream(self->stream);
+    }
+
+    return has_error;
 }
 
 DESTRUCTOR(LilyScanner, const LilyScanner *self)
 {
-    FREE_BUFFER_ITEMS(self->tokens->buffer, self->tokens->len, LilyToken);
-    FREE(Vec, self->tokens);
+    FREE(LilyTokenBuffer, &self->tokens);
+
+    if (self->stream) {
+        FREE(LilyTokenStream, self->stream);
+    }
 }
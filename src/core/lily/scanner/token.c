@@ -26,6 +26,7 @@
 #include <base/new.h>
 
 #include <core/lily/scanner/token.h>
+#include <core/lily/scanner/token_buffer.h>
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -36,50 +37,65 @@
 #include <base/print.h>
 #endif
 
-// Free LilyToken type (LILY_TOKEN_KIND_COMMENT_DOC).
+// Free the payload of LilyToken type (LILY_TOKEN_KIND_COMMENT_DOC).
 static inline VARIANT_DESTRUCTOR(LilyToken, comment_doc, LilyToken *self);
 
-// Free LilyToken type (LILY_TOKEN_KIND_IDENTIFIER_DOLLAR).
+// Free the payload of LilyToken type (LILY_TOKEN_KIND_IDENTIFIER_DOLLAR).
 static inline VARIANT_DESTRUCTOR(LilyToken, identifier_dollar, LilyToken *self);
 
-// Free LilyToken type (LILY_TOKEN_KIND_IDENTIFIER_MACRO).
+// Free the payload of LilyToken type (LILY_TOKEN_KIND_IDENTIFIER_MACRO).
 static inline VARIANT_DESTRUCTOR(LilyToken, identifier_macro, LilyToken *self);
 
-// Free LilyToken type (LILY_TOKEN_KIND_IDENTIFIER_NORMAL).
+// Free the payload of LilyToken type (LILY_TOKEN_KIND_IDENTIFIER_NORMAL).
 static inline VARIANT_DESTRUCTOR(LilyToken, identifier_normal, LilyToken *self);
 
-// Free LilyToken type (LILY_TOKEN_KIND_IDENTIFIER_OPERATOR).
+// Free the payload of LilyToken type (LILY_TOKEN_KIND_IDENTIFIER_OPERATOR).
 static inline VARIANT_DESTRUCTOR(LilyToken,
                                  identifier_operator,
                                  LilyToken *self);
 
-// Free LilyToken type (LILY_TOKEN_KIND_IDENTIFIER_STRING).
+// Free the payload of LilyToken type (LILY_TOKEN_KIND_IDENTIFIER_STRING).
 static inline VARIANT_DESTRUCTOR(LilyToken, identifier_string, LilyToken *self);
 
-// Free LilyToken type (LILY_TOKEN_KIND_LITERAL_BYTES).
+// Free the payload of LilyToken type (LILY_TOKEN_KIND_LITERAL_BYTES).
 static inline VARIANT_DESTRUCTOR(LilyToken, literal_bytes, LilyToken *self);
 
-// Free LilyToken type (LILY_TOKEN_KIND_LITERAL_CSTR).
+// Free the payload of LilyToken type (LILY_TOKEN_KIND_LITERAL_CSTR).
 static inline VARIANT_DESTRUCTOR(LilyToken, literal_cstr, LilyToken *self);
 
-// Free LilyToken type (LILY_TOKEN_KIND_LITERAL_FLOAT).
+// Free the payload of LilyToken type (LILY_TOKEN_KIND_LITERAL_FLOAT).
 static inline VARIANT_DESTRUCTOR(LilyToken, literal_float, LilyToken *self);
 
-// Free LilyToken type (LILY_TOKEN_KIND_LITERAL_INT_2).
+// Free the payload of LilyToken type (LILY_TOKEN_KIND_LITERAL_INT_2).
 static inline VARIANT_DESTRUCTOR(LilyToken, literal_int_2, LilyToken *self);
 
-// Free LilyToken type (LILY_TOKEN_KIND_LITERAL_INT_8).
+// Free the payload of LilyToken type (LILY_TOKEN_KIND_LITERAL_INT_8).
 static inline VARIANT_DESTRUCTOR(LilyToken, literal_int_8, LilyToken *self);
 
-// Free LilyToken type (LILY_TOKEN_KIND_LITERAL_INT_10).
+// Free the payload of LilyToken type (LILY_TOKEN_KIND_LITERAL_INT_10).
 static inline VARIANT_DESTRUCTOR(LilyToken, literal_int_10, LilyToken *self);
 
-// Free LilyToken type (LILY_TOKEN_KIND_LITERAL_INT_16).
+// Free the payload of LilyToken type (LILY_TOKEN_KIND_LITERAL_INT_16).
 static inline VARIANT_DESTRUCTOR(LilyToken, literal_int_16, LilyToken *self);
 
-// Free LilyToken type (LILY_TOKEN_KIND_LITERAL_STR).
+// Free the payload of LilyToken type (LILY_TOKEN_KIND_LITERAL_STR).
 static inline VARIANT_DESTRUCTOR(LilyToken, literal_str, LilyToken *self);
 
+/// @brief Allocate a token in a slot of the buffer of the current thread (see
+/// set_slots__LilyTokenBuffer), or on the heap if no buffer is set.
+/// @return LilyToken*
+static inline LilyToken *
+alloc__LilyToken();
+
+LilyToken *
+alloc__LilyToken()
+{
+    LilyTokenBuffer *slots = get_slots__LilyTokenBuffer();
+
+    return slots ? take_slot__LilyTokenBuffer(slots)
+                 : lily_malloc(sizeof(LilyToken));
+}
+
 #ifdef ENV_DEBUG
 char *
 IMPL_FOR_DEBUG(to_string, LilyTokenExpandKind, enum LilyTokenExpandKind self)
@@ -114,7 +130,7 @@ IMPL_FOR_DEBUG(to_string, LilyTokenExpand, const LilyTokenExpand *self)
 
 CONSTRUCTOR(LilyToken *, LilyToken, enum LilyTokenKind kind, Location location)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = kind;
     self->location = location;
@@ -129,7 +145,7 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     String *comment_debug)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_COMMENT_DEBUG;
     self->location = location;
@@ -145,7 +161,7 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     String *comment_doc)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_COMMENT_DOC;
     self->location = location;
@@ -160,7 +176,7 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     LilyTokenExpand expand)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_EXPAND;
     self->location = location;
@@ -175,7 +191,7 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     String *identifier_dollar)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_IDENTIFIER_DOLLAR;
     self->location = location;
@@ -190,7 +206,7 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     String *identifier_macro)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_IDENTIFIER_MACRO;
     self->location = location;
@@ -205,7 +221,7 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     String *identifier_normal)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_IDENTIFIER_NORMAL;
     self->location = location;
@@ -220,7 +236,7 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     String *identifier_operator)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_IDENTIFIER_OPERATOR;
     self->location = location;
@@ -235,7 +251,7 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     String *identifier_string)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_IDENTIFIER_STRING;
     self->location = location;
@@ -250,7 +266,7 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     Uint8 literal_byte)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_BYTE;
     self->location = location;
@@ -265,7 +281,7 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     Uint8 *literal_bytes)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_BYTES;
     self->location = location;
@@ -280,7 +296,7 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     char literal_char)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_CHAR;
     self->location = location;
@@ -295,7 +311,7 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     char *literal_cstr)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_CSTR;
     self->location = location;
@@ -310,7 +326,7 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     String *literal_float)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_FLOAT;
     self->location = location;
@@ -325,7 +341,7 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     String *literal_int_2)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_INT_2;
     self->location = location;
@@ -340,7 +356,7 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     String *literal_int_8)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_INT_8;
     self->location = location;
@@ -355,7 +371,7 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     String *literal_int_10)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_INT_10;
     self->location = location;
@@ -370,7 +386,7 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     String *literal_int_16)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_INT_16;
     self->location = location;
@@ -385,7 +401,7 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     String *literal_str)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_STR;
     self->location = location;
@@ -400,7 +416,7 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     Float32 literal_suffix_float32)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_SUFFIX_FLOAT32;
     self->location = location;
@@ -415,7 +431,7 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     Float64 literal_suffix_float64)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_SUFFIX_FLOAT64;
     self->location = location;
@@ -430,7 +446,7 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     Int16 literal_suffix_int16)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_SUFFIX_INT16;
     self->location = location;
@@ -445,7 +461,7 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     Int32 literal_suffix_int32)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_SUFFIX_INT32;
     self->location = location;
@@ -460,7 +476,7 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     Int64 literal_suffix_int64)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_SUFFIX_INT64;
     self->location = location;
@@ -475,7 +491,7 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     Int8 literal_suffix_int8)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_SUFFIX_INT8;
     self->location = location;
@@ -490,7 +506,7 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     Isize literal_suffix_isize)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_SUFFIX_ISIZE;
     self->location = location;
@@ -505,7 +521,7 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     Uint16 literal_suffix_uint16)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_SUFFIX_UINT16;
     self->location = location;
@@ -520,7 +536,7 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     Uint32 literal_suffix_uint32)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_SUFFIX_UINT32;
     self->location = location;
@@ -535,7 +551,7 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     Uint64 literal_suffix_uint64)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_SUFFIX_UINT64;
     self->location = location;
@@ -550,7 +566,7 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     Uint8 literal_suffix_uint8)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_SUFFIX_UINT8;
     self->location = location;
@@ -565,7 +581,7 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     Usize literal_suffix_usize)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_SUFFIX_USIZE;
     self->location = location;
@@ -1697,85 +1713,71 @@ clone__LilyToken(const LilyToken *self)
 VARIANT_DESTRUCTOR(LilyToken, comment_doc, LilyToken *self)
 {
     FREE(String, self->comment_doc);
-    lily_free(self);
 }
 
 VARIANT_DESTRUCTOR(LilyToken, identifier_dollar, LilyToken *self)
 {
     FREE(String, self->identifier_dollar);
-    lily_free(self);
 }
 
 VARIANT_DESTRUCTOR(LilyToken, identifier_macro, LilyToken *self)
 {
     FREE(String, self->identifier_macro);
-    lily_free(self);
 }
 
 VARIANT_DESTRUCTOR(LilyToken, identifier_operator, LilyToken *self)
 {
     FREE(String, self->identifier_operator);
-    lily_free(self);
 }
 
 VARIANT_DESTRUCTOR(LilyToken, identifier_normal, LilyToken *self)
 {
     FREE(String, self->identifier_normal);
-    lily_free(self);
 }
 
 VARIANT_DESTRUCTOR(LilyToken, identifier_string, LilyToken *self)
 {
     FREE(String, self->identifier_string);
-    lily_free(self);
 }
 
 VARIANT_DESTRUCTOR(LilyToken, literal_bytes, LilyToken *self)
 {
     lily_free(self->literal_bytes);
-    lily_free(self);
 }
 
 VARIANT_DESTRUCTOR(LilyToken, literal_cstr, LilyToken *self)
 {
     lily_free(self->literal_cstr);
-    lily_free(self);
 }
 
 VARIANT_DESTRUCTOR(LilyToken, literal_float, LilyToken *self)
 {
     FREE(String, self->literal_float);
-    lily_free(self);
 }
 
 VARIANT_DESTRUCTOR(LilyToken, literal_int_2, LilyToken *self)
 {
     FREE(String, self->literal_int_2);
-    lily_free(self);
 }
 
 VARIANT_DESTRUCTOR(LilyToken, literal_int_8, LilyToken *self)
 {
     FREE(String, self->literal_int_8);
-    lily_free(self);
 }
 
 VARIANT_DESTRUCTOR(LilyToken, literal_int_10, LilyToken *self)
 {
     FREE(String, self->literal_int_10);
-    lily_free(self);
 }
 
 VARIANT_DESTRUCTOR(LilyToken, literal_int_16, LilyToken *self)
 {
     FREE(String, self->literal_int_16);
-    lily_free(self);
 }
 
 VARIANT_DESTRUCTOR(LilyToken, literal_str, LilyToken *self)
 {
     FREE(String, self->literal_str);
-    lily_free(self);
 }
 
 VARIANT_DESTRUCTOR(LilyToken, macro_expand, LilyToken *self)
@@ -1783,7 +1785,8 @@ VARIANT_DESTRUCTOR(LilyToken, macro_expand, LilyToken *self)
     lily_free(self);
 }
 
-DESTRUCTOR(LilyToken, LilyToken *self)
+void
+free_payload__LilyToken(LilyToken *self)
 {
     switch (self->kind) {
         case LILY_TOKEN_KIND_COMMENT_DOC:
@@ -1829,6 +1832,12 @@ DESTRUCTOR(LilyToken, LilyToken *self)
             FREE_VARIANT(LilyToken, literal_str, self);
             break;
         default:
-            lily_free(self);
+            break;
     }
 }
+
+DESTRUCTOR(LilyToken, LilyToken *self)
+{
+    free_payload__LilyToken(self);
+    lily_free(self);
+}
@@ -0,0 +1,227 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2025 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/alloc.h>
+#include <base/macros.h>
+
+#include <core/lily/scanner/token_buffer.h>
+
+#include <string.h>
+
+/// @brief Grow the order of the tokens, if it can't contain `len` tokens.
+static void
+grow__LilyTokenBuffer(LilyTokenBuffer *self, Usize len);
+
+// The buffer in which the tokens constructed by the current thread are built.
+static threadlocal LilyTokenBuffer *token_slots = NULL;
+
+void
+grow__LilyTokenBuffer(LilyTokenBuffer *self, Usize len)
+{
+    if (len <= self->capacity) {
+        return;
+    }
+
+    Usize capacity =
+      self->capacity ? self->capacity : LILY_TOKEN_BUFFER_DEFAULT_CAPACITY;
+
+    while (capacity < len) {
+        capacity *= 2;
+    }
+
+    self->capacity = capacity;
+    self->items =
+      lily_realloc(self->items, sizeof(LilyToken *) * self->capacity);
+}
+
+LilyToken *
+take_slot__LilyTokenBuffer(LilyTokenBuffer *self)
+{
+    if (!self->chunks) {
+        self->chunks = NEW(Vec);
+    }
+
+    if (self->chunks->len == 0 || self->chunk_len == self->chunk_capacity) {
+        if (self->chunks->len == 0) {
+            self->chunk_capacity = LILY_TOKEN_BUFFER_DEFAULT_CAPACITY;
+        } else if (self->chunk_capacity < LILY_TOKEN_BUFFER_CHUNK_CAPACITY) {
+            self->chunk_capacity *= 2;
+        }
+
+        push__Vec(self->chunks,
+                  lily_malloc(sizeof(LilyToken) * self->chunk_capacity));
+        self->chunk_len = 0;
+    }
+
+    LilyToken *chunk = last__Vec(self->chunks);
+
+    return &chunk[self->chunk_len++];
+}
+
+LilyTokenBuffer
+from_vec__LilyTokenBuffer(const Vec *tokens)
+{
+    LilyTokenBuffer self = NEW(LilyTokenBuffer);
+
+    self.own_payloads = false;
+
+    grow__LilyTokenBuffer(&self, tokens->len);
+
+    for (Usize i = 0; i < tokens->len; ++i) {
+        self.items[self.len++] = get__Vec(tokens, i);
+    }
+
+    return self;
+}
+
+void
+push__LilyTokenBuffer(LilyTokenBuffer *self, LilyToken *token)
+{
+    LilyToken *slot = take_slot__LilyTokenBuffer(self);
+
+    *slot = *token;
+
+    grow__LilyTokenBuffer(self, self->len + 1);
+
+    self->items[self->len++] = slot;
+
+    // NOTE: The payload of the token is now owned by the buffer.
+    lily_free(token);
+}
+
+void
+push_slot__LilyTokenBuffer(LilyTokenBuffer *self, LilyToken *slot)
+{
+    ASSERT(self->chunks && self->chunks->len > 0);
+
+    grow__LilyTokenBuffer(self, self->len + 1);
+
+    self->items[self->len++] = slot;
+}
+
+void
+set_slots__LilyTokenBuffer(LilyTokenBuffer *buffer)
+{
+    token_slots = buffer;
+}
+
+LilyTokenBuffer *
+get_slots__LilyTokenBuffer()
+{
+    return token_slots;
+}
+
+void
+splice__LilyTokenBuffer(LilyTokenBuffer *self,
+                        Usize start,
+                        Usize end,
+                        LilyTokenBuffer *tokens)
+{
+    ASSERT(start <= end && end <= self->len);
+
+    if (self->own_payloads) {
+        for (Usize i = start; i < end; ++i) {
+            free_payload__LilyToken(self->items[i]);
+        }
+    }
+
+    Usize len = self->len - (end - start) + tokens->len;
+
+    grow__LilyTokenBuffer(self, len);
+
+    // Move the tokens after `end`, then insert the new tokens.
+    memmove(&self->items[start + tokens->len],
+            &self->items[end],
+            sizeof(LilyToken *) * (self->len - end));
+
+    if (tokens->len > 0) {
+        memcpy(&self->items[start],
+               tokens->items,
+               sizeof(LilyToken *) * tokens->len);
+    }
+
+    self->len = len;
+
+    // NOTE: The chunks of `tokens` are now owned by `self`. The last chunk of
+    // `self` stays the last one, so the next pushed tokens are still stored
+    // after the tokens of `self`. The slots of the replaced tokens are only
+    // released with the buffer.
+    if (tokens->chunks) {
+        if (!self->chunks) {
+            self->chunks = NEW(Vec);
+        }
+
+        void *last = self->chunks->len > 0 ? pop__Vec(self->chunks) : NULL;
+
+        append__Vec(self->chunks, tokens->chunks);
+
+        if (last) {
+            push__Vec(self->chunks, last);
+        } else {
+            self->chunk_len = tokens->chunk_len;
+            self->chunk_capacity = tokens->chunk_capacity;
+        }
+
+        FREE(Vec, tokens->chunks);
+    }
+
+    if (tokens->items) {
+        lily_free(tokens->items);
+    }
+
+    *tokens = NEW(LilyTokenBuffer);
+}
+
+Vec *
+to_vec__LilyTokenBuffer(const LilyTokenBuffer *self)
+{
+    Vec *res = NEW(Vec); // Vec<LilyToken* (&)>*
+
+    for (Usize i = 0; i < self->len; ++i) {
+        push__Vec(res, self->items[i]);
+    }
+
+    return res;
+}
+
+DESTRUCTOR(LilyTokenBuffer, const LilyTokenBuffer *self)
+{
+    if (self->own_payloads) {
+        for (Usize i = 0; i < self->len; ++i) {
+            free_payload__LilyToken(self->items[i]);
+        }
+    }
+
+    if (self->items) {
+        lily_free(self->items);
+    }
+
+    if (self->chunks) {
+        for (Usize i = 0; i < self->chunks->len; ++i) {
+            lily_free(get__Vec(self->chunks, i));
+        }
+
+        FREE(Vec, self->chunks);
+    }
+}
@@ -0,0 +1,241 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2025 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/alloc.h>
+#include <base/assert.h>
+
+#include <core/lily/scanner/token_stream.h>
+
+/// @brief Move all the tokens of the ring into the chunks (consumer side). If
+/// the ring is empty, wait for the producer.
+/// @return Return false if the stream is closed and the ring is empty.
+static bool
+receive__LilyTokenStream(LilyTokenStream *self);
+
+/// @brief Free the payloads of the tokens of the chunk, then free the chunk.
+static void
+free_chunk__LilyTokenStream(LilyTokenStream *self, Usize chunk_index);
+
+CONSTRUCTOR(LilyTokenStream *, LilyTokenStream)
+{
+    LilyTokenStream *self = lily_malloc(sizeof(LilyTokenStream));
+
+    self->ring =
+      lily_malloc(sizeof(LilyToken) * LILY_TOKEN_STREAM_RING_CAPACITY);
+    self->ring_start = 0;
+    self->ring_len = 0;
+    self->is_closed = false;
+    self->chunks = NEW(Vec);
+    self->len = 0;
+
+    ASSERT(!pthread_mutex_init(&self->mutex, NULL));
+    ASSERT(!pthread_cond_init(&self->not_empty, NULL));
+    ASSERT(!pthread_cond_init(&self->not_full, NULL));
+
+    return self;
+}
+
+void
+push__LilyTokenStream(LilyTokenStream *self, LilyToken *token)
+{
+    pthread_mutex_lock(&self->mutex);
+
+    ASSERT(!self->is_closed);
+
+    while (self->ring_len == LILY_TOKEN_STREAM_RING_CAPACITY) {
+        pthread_cond_wait(&self->not_full, &self->mutex);
+    }
+
+    self->ring[(self->ring_start + self->ring_len++) %
+               LILY_TOKEN_STREAM_RING_CAPACITY] = *token;
+
+    // NOTE: The consumer only waits when the ring is empty.
+    if (self->ring_len == 1) {
+        pthread_cond_signal(&self->not_empty);
+    }
+
+    pthread_mutex_unlock(&self->mutex);
+
+    lily_free(token);
+}
+
+void
+close__LilyTokenStream(LilyTokenStream *self)
+{
+    pthread_mutex_lock(&self->mutex);
+
+    self->is_closed = true;
+
+    pthread_cond_signal(&self->not_empty);
+    pthread_mutex_unlock(&self->mutex);
+}
+
+bool
+receive__LilyTokenStream(LilyTokenStream *self)
+{
+    pthread_mutex_lock(&self->mutex);
+
+    while (self->ring_len == 0 && !self->is_closed) {
+        pthread_cond_wait(&self->not_empty, &self->mutex);
+    }
+
+    if (self->ring_len == 0) {
+        pthread_mutex_unlock(&self->mutex);
+
+        return false;
+    }
+
+    // NOTE: The producer only waits when the ring is full.
+    bool was_full = self->ring_len == LILY_TOKEN_STREAM_RING_CAPACITY;
+
+    while (self->ring_len > 0) {
+        if (self->len % LILY_TOKEN_STREAM_CHUNK_CAPACITY == 0) {
+            push__Vec(self->chunks,
+                      lily_malloc(sizeof(LilyToken) *
+                                  LILY_TOKEN_STREAM_CHUNK_CAPACITY));
+        }
+
+        LilyToken *chunk = last__Vec(self->chunks);
+
+        chunk[self->len++ % LILY_TOKEN_STREAM_CHUNK_CAPACITY] =
+          self->ring[self->ring_start];
+        self->ring_start =
+          (self->ring_start + 1) % LILY_TOKEN_STREAM_RING_CAPACITY;
+        --self->ring_len;
+    }
+
+    if (was_full) {
+        pthread_cond_signal(&self->not_full);
+    }
+
+    pthread_mutex_unlock(&self->mutex);
+
+    return true;
+}
+
+bool
+has__LilyTokenStream(LilyTokenStream *self, Usize index)
+{
+    while (index >= self->len) {
+        if (!receive__LilyTokenStream(self)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+LilyToken *
+get__LilyTokenStream(LilyTokenStream *self, Usize index)
+{
+    ASSERT(has__LilyTokenStream(self, index));
+
+    LilyToken *chunk =
+      get__Vec(self->chunks, index / LILY_TOKEN_STREAM_CHUNK_CAPACITY);
+
+    ASSERT(chunk);
+
+    return &chunk[index % LILY_TOKEN_STREAM_CHUNK_CAPACITY];
+}
+
+void
+free_chunk__LilyTokenStream(LilyTokenStream *self, Usize chunk_index)
+{
+    LilyToken *chunk = get__Vec(self->chunks, chunk_index);
+
+    if (!chunk) {
+        return;
+    }
+
+    Usize start = chunk_index * LILY_TOKEN_STREAM_CHUNK_CAPACITY;
+    Usize end = start + LILY_TOKEN_STREAM_CHUNK_CAPACITY < self->len
+                  ? start + LILY_TOKEN_STREAM_CHUNK_CAPACITY
+                  : self->len;
+
+    for (Usize i = start; i < end; ++i) {
+        free_payload__LilyToken(&chunk[i - start]);
+    }
+
+    lily_free(chunk);
+    replace__Vec(self->chunks, chunk_index, NULL);
+}
+
+void
+release__LilyTokenStream(LilyTokenStream *self, const Vec *kept)
+{
+    ASSERT(self->is_closed && self->ring_len == 0);
+
+    bool *is_kept = lily_calloc(self->chunks->len + 1, sizeof(bool));
+
+    for (Usize i = 0; i < kept->len; ++i) {
+        Uptr token = (Uptr)get__Vec(kept, i);
+
+        // NOTE: The kept tokens which are not received from this stream are
+        // ignored (e.g. the EOF token of a macro).
+        for (Usize j = 0; j < self->chunks->len; ++j) {
+            Uptr chunk = (Uptr)get__Vec(self->chunks, j);
+
+            if (chunk && token >= chunk &&
+                token < chunk + sizeof(LilyToken) *
+                                  LILY_TOKEN_STREAM_CHUNK_CAPACITY) {
+                is_kept[j] = true;
+
+                break;
+            }
+        }
+    }
+
+    for (Usize i = 0; i < self->chunks->len; ++i) {
+        if (!is_kept[i]) {
+            free_chunk__LilyTokenStream(self, i);
+        }
+    }
+
+    lily_free(is_kept);
+}
+
+DESTRUCTOR(LilyTokenStream, LilyTokenStream *self)
+{
+    for (Usize i = 0; i < self->chunks->len; ++i) {
+        free_chunk__LilyTokenStream(self, i);
+    }
+
+    // NOTE: The ring is not empty, if the consumer has stopped before the end
+    // of the stream.
+    for (Usize i = 0; i < self->ring_len; ++i) {
+        Usize ring_index =
+          (self->ring_start + i) % LILY_TOKEN_STREAM_RING_CAPACITY;
+
+        free_payload__LilyToken(&self->ring[ring_index]);
+    }
+
+    FREE(Vec, self->chunks);
+    lily_free(self->ring);
+
+    pthread_mutex_destroy(&self->mutex);
+    pthread_cond_destroy(&self->not_empty);
+    pthread_cond_destroy(&self->not_full);
+
+    lily_free(self);
+}
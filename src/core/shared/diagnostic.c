@@ -38,6 +38,13 @@
 // Free DiagnosticLevel type.
 static DESTRUCTOR(DiagnosticLevel, const DiagnosticLevel *self);
 
+// Print the diagnostic or store it in the buffer of the current thread.
+static void
+print__Diagnostic(const Diagnostic *self);
+
+static threadlocal DiagnosticBuffer *diagnostic_buffer =
+  NULL; // DiagnosticBuffer*? (&)
+
 // Free DiagnosticDetail type.
 static inline DESTRUCTOR(DiagnosticDetail, const DiagnosticDetail *self);
 
@@ -1427,9 +1434,13 @@ emit_warning__Diagnostic(Diagnostic self,
         }
     }
 
-    *count_warning += 1;
+    if (diagnostic_buffer) {
+        ++diagnostic_buffer->count_warning;
+    } else {
+        *count_warning += 1;
+    }
 
-    PRINTLN("{Sr}", to_string__Diagnostic(&self));
+    print__Diagnostic(&self);
 
     FREE(Diagnostic, &self);
 }
@@ -1447,7 +1458,7 @@ emit_note__Diagnostic(Diagnostic self)
             UNREACHABLE("expected note diagnostic level");
     }
 
-    PRINTLN("{Sr}", to_string__Diagnostic(&self));
+    print__Diagnostic(&self);
 
     FREE(Diagnostic, &self);
 }
@@ -1460,17 +1471,80 @@ emit__Diagnostic(Diagnostic self, Usize *count_error)
         case DIAGNOSTIC_LEVEL_KIND_CI_ERROR:
         case DIAGNOSTIC_LEVEL_KIND_CPP_ERROR:
         case DIAGNOSTIC_LEVEL_KIND_LILY_ERROR:
-            *count_error += 1;
+            if (diagnostic_buffer) {
+                ++diagnostic_buffer->count_error;
+            } else {
+                *count_error += 1;
+            }
+
             break;
         default:
             UNREACHABLE("expected error diagnostic level");
     }
 
-    PRINTLN("{Sr}", to_string__Diagnostic(&self));
+    print__Diagnostic(&self);
 
     FREE(Diagnostic, &self);
 }
 
+void
+print__Diagnostic(const Diagnostic *self)
+{
+    if (diagnostic_buffer) {
+        push__Vec(diagnostic_buffer->messages, to_string__Diagnostic(self));
+    } else {
+        PRINTLN("{Sr}", to_string__Diagnostic(self));
+    }
+}
+
+void
+set_buffer__Diagnostic(DiagnosticBuffer *buffer)
+{
+    diagnostic_buffer = buffer;
+}
+
+DiagnosticBuffer *
+get_buffer__Diagnostic()
+{
+    return diagnostic_buffer;
+}
+
+void
+flush__DiagnosticBuffer(DiagnosticBuffer *self,
+                        Usize *count_error,
+                        Usize *count_warning)
+{
+    if (diagnostic_buffer) {
+        ASSERT(diagnostic_buffer != self);
+
+        append__Vec(diagnostic_buffer->messages, self->messages);
+
+        self->messages->len = 0;
+        diagnostic_buffer->count_error += self->count_error;
+        diagnostic_buffer->count_warning += self->count_warning;
+        self->count_error = 0;
+        self->count_warning = 0;
+
+        return;
+    }
+
+    for (Usize i = 0; i < self->messages->len; ++i) {
+        PRINTLN("{Sr}", get__Vec(self->messages, i));
+    }
+
+    self->messages->len = 0;
+    *count_error += self->count_error;
+    *count_warning += self->count_warning;
+    self->count_error = 0;
+    self->count_warning = 0;
+}
+
+DESTRUCTOR(DiagnosticBuffer, const DiagnosticBuffer *self)
+{
+    FREE_BUFFER_ITEMS(self->messages->buffer, self->messages->len, String);
+    FREE(Vec, self->messages);
+}
+
 // Free Diagnostic type.
 DESTRUCTOR(Diagnostic, const Diagnostic *self)
 {
@@ -22,10 +22,33 @@
  * SOFTWARE.
  */
 
+#include <base/hash/fnv.h>
+
 #include <core/shared/search.h>
 
 #include <string.h>
 
+/// @brief Get the slot of the key in the ids table.
+/// @note This function must be kept in sync with the `get_slot` function of
+/// `scripts/perfect_hash_generator.py`.
+static inline Usize
+get_slot__SearchPerfectHash(Uint64 hash,
+                            Uint16 displacement,
+                            const Usize ids_s_len);
+
+static inline Usize
+get_slot__SearchPerfectHash(Uint64 hash,
+                            Uint16 displacement,
+                            const Usize ids_s_len)
+{
+    hash ^= displacement * 0x9e3779b97f4a7c15;
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccd;
+    hash ^= hash >> 33;
+
+    return hash % ids_s_len;
+}
+
 Int32
 get_id__Search(const String *id,
                const SizedStr ids_s[],
@@ -61,3 +84,26 @@ get_id__Search(const String *id,
 
     return -1;
 }
+
+Int32
+get_id_with_perfect_hash__Search(const String *id,
+                                 const SizedStr ids_s[],
+                                 const Int32 ids[],
+                                 const Usize ids_s_len,
+                                 const SearchPerfectHash *perfect_hash)
+{
+    const Uint64 hash = hash_fnv1a_64(id->buffer);
+    const Uint16 displacement =
+      perfect_hash
+        ->displacements[(hash >> 32) % perfect_hash->displacements_len];
+    const Usize index = perfect_hash->indexes[get_slot__SearchPerfectHash(
+      hash, displacement, ids_s_len)];
+    const SizedStr *current = &ids_s[index];
+
+    if (current->len == id->len &&
+        !memcmp(current->buffer, id->buffer, id->len)) {
+        return ids[index];
+    }
+
+    return -1;
+}
@@ -96,7 +96,8 @@ extern inline CONSTRUCTOR(LilyConfigRun,
                           bool verbose,
                           Vec *args,
                           Usize max_stack,
-                          Usize max_heap);
+                          Usize max_heap,
+                          bool lazy);
 
 // <cli/lily/config/test.h>
 extern inline CONSTRUCTOR(LilyConfigTest, LilyConfigTest, const char *filename);
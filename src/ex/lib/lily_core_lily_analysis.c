@@ -645,9 +645,6 @@ extern inline VARIANT_CONSTRUCTOR(LilyCheckedScopeResponse,
                                   LilyCheckedScopeContainer scope_container,
                                   LilyCheckedGenericParam *generic);
 
-extern inline DESTRUCTOR(LilyCheckedScopeResponse,
-                         const LilyCheckedScopeResponse *self);
-
 // <core/lily/analysis/checked/scope_stmt.h>
 extern inline VARIANT_CONSTRUCTOR(LilyCheckedScopeStmt,
                                   LilyCheckedScopeStmt,
@@ -676,6 +673,8 @@ extern inline VARIANT_CONSTRUCTOR(LilyCheckedScopeStmt,
 
 // <core/lily/analysis/checked/scope.h>
 extern inline DESTRUCTOR(LilyCheckedScopeCatch, LilyCheckedScopeCatch *self);
+extern inline DESTRUCTOR(LilyCheckedScopeResolution,
+                         LilyCheckedScopeResolution *self);
 
 // <core/lily/analysis/checked/signature.h>
 extern inline void
@@ -299,6 +299,8 @@ extern inline CONSTRUCTOR(LilyAstDeclFun,
                           Vec *params,
                           LilyAstDataType *return_data_type,
                           Vec *body,
+                          Vec *lazy_body,
+                          LilyParser *lazy_parser,
                           Vec *req,
                           Vec *when,
                           enum LilyVisibility visibility,
@@ -27,6 +27,7 @@
 
 #include <core/lily/scanner/scanner.h>
 #include <core/lily/scanner/token.h>
+#include <core/lily/scanner/token_buffer.h>
 
 #include "lily_base.c"
 #include "lily_core_shared.c"
@@ -43,4 +44,10 @@ extern inline CONSTRUCTOR(LilyTokenExpand,
                           enum LilyTokenExpandKind kind,
                           Vec *tokens);
 
+// <core/lily/scanner/token_buffer.h>
+extern inline CONSTRUCTOR(LilyTokenBuffer, LilyTokenBuffer);
+
+extern inline LilyToken *
+get__LilyTokenBuffer(const LilyTokenBuffer *self, Usize index);
+
 #endif // LILY_EX_LIB_LILY_CORE_LILY_SCANNER_C
\ No newline at end of file
@@ -108,9 +108,14 @@ extern inline CONSTRUCTOR(DiagnosticDetail,
                           String *msg,
                           const Location *location);
 
+extern inline CONSTRUCTOR(DiagnosticBuffer, DiagnosticBuffer);
+
 // <core/shared/file.h>
 extern inline CONSTRUCTOR(File, File, char *name, char *content);
 
+extern inline void
+replace__File(File *self, Usize start, Usize end, const char *replacement);
+
 extern inline DESTRUCTOR(File, const File *self);
 
 // <core/shared/location.h>
@@ -150,7 +155,8 @@ extern inline Int32
 get_keyword__Scanner(const String *id,
                      const SizedStr keywords[],
                      const Int32 keyword_ids[],
-                     const Usize keywords_len);
+                     const Usize keywords_len,
+                     const SearchPerfectHash *keywords_perfect_hash);
 
 // <core/shared/source.h>
 extern inline CONSTRUCTOR(Source, Source, Cursor cursor, const File *file);
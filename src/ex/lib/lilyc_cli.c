@@ -35,6 +35,7 @@ extern inline CONSTRUCTOR(LilycConfig,
                           const char *filename,
                           const char *target,
                           const char *output,
+                          const char *daemon,
                           bool build,
                           bool run_scanner,
                           bool run_preparser,
@@ -64,6 +65,8 @@ extern inline CONSTRUCTOR(LilycConfig,
                           bool o3,
                           bool oz,
                           bool verbose,
-                          bool run);
+                          bool run,
+                          Usize jobs,
+                          bool watch);
 
 #endif // LILY_EX_LIB_LILYC_CLI_C
@@ -1,17 +1,20 @@
 #include "allocator.c"
 #include "atof.c"
 #include "atoi.c"
+#include "binary_heap.c"
 #include "buffer.c"
 #include "format.c"
 #include "hash_map.c"
 #include "hash_set.c"
 #include "itoa.c"
+#include "jobserver.c"
 #include "memory/arena.c"
 #include "memory/global.c"
 #include "memory/page.c"
 #include "stack.c"
 #include "str.c"
 #include "string.c"
+#include "thread_pool.c"
 #include "vec.c"
 #include "vec_bit.c"
 
@@ -37,6 +40,11 @@ main()
               CALL_CASE(atoi),
               CALL_CASE(atoi_safe));
     ADD_SUITE(2, atof, CALL_CASE(atof__Float32), CALL_CASE(atof__Float64));
+    ADD_SUITE(3,
+              binary_heap,
+              CALL_CASE(binary_heap_push),
+              CALL_CASE(binary_heap_pop),
+              CALL_CASE(binary_heap_empty));
     ADD_SUITE(1, buffer, CALL_CASE(buffer_push));
     ADD_SUITE(9,
               format,
@@ -63,6 +71,11 @@ main()
               CALL_CASE(itoa_base_2),
               CALL_CASE(itoa_base_8),
               CALL_CASE(itoa_base_16));
+    ADD_SUITE(3,
+              jobserver,
+              CALL_CASE(jobserver_without_makeflags),
+              CALL_CASE(jobserver_pipe),
+              CALL_CASE(jobserver_release_at_exit));
     ADD_SUITE(1, memory_arena, CALL_CASE(memory_arena_alloc));
     ADD_SUITE(1, memory_global, CALL_CASE(memory_global_alloc));
     ADD_SUITE(1, memory_page, CALL_CASE(memory_page_alloc));
@@ -87,6 +100,11 @@ main()
               CALL_CASE(string_split),
               CALL_CASE(string_pop),
               CALL_CASE(string_push));
+    ADD_SUITE(3,
+              thread_pool,
+              CALL_CASE(thread_pool_run),
+              CALL_CASE(thread_pool_default_jobs),
+              CALL_CASE(thread_pool_nested_jobs));
     ADD_SUITE(19,
               vec,
               CALL_CASE(vec_append),
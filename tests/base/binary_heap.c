@@ -0,0 +1,59 @@
+#include <base/binary_heap.h>
+#include <base/new.h>
+#include <base/test.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+SUITE(binary_heap);
+
+static bool
+binary_heap_is_greater(const void *lhs, const void *rhs)
+{
+    return (Uptr)lhs > (Uptr)rhs;
+}
+
+CASE(binary_heap_push, {
+    BinaryHeap *h = NEW(BinaryHeap, &binary_heap_is_greater);
+
+    push__BinaryHeap(h, (int *)20);
+    push__BinaryHeap(h, (int *)30);
+    push__BinaryHeap(h, (int *)10);
+
+    TEST_ASSERT_EQ(h->len, 3);
+    TEST_ASSERT_EQ(peek__BinaryHeap(h), (int *)30);
+
+    FREE(BinaryHeap, h);
+});
+
+CASE(binary_heap_pop, {
+    BinaryHeap *h = NEW(BinaryHeap, &binary_heap_is_greater);
+
+    for (Uptr i = 0; i < 100; ++i) {
+        push__BinaryHeap(h, (int *)((i * 37) % 100));
+    }
+
+    for (Uptr i = 100; i-- > 0;) {
+        TEST_ASSERT_EQ(pop__BinaryHeap(h), (int *)i);
+    }
+
+    TEST_ASSERT(empty__BinaryHeap(h));
+
+    FREE(BinaryHeap, h);
+});
+
+CASE(binary_heap_empty, {
+    BinaryHeap *h = NEW(BinaryHeap, &binary_heap_is_greater);
+
+    TEST_ASSERT(empty__BinaryHeap(h));
+
+    push__BinaryHeap(h, (int *)10);
+
+    TEST_ASSERT(!empty__BinaryHeap(h));
+
+    pop__BinaryHeap(h);
+
+    TEST_ASSERT(empty__BinaryHeap(h));
+
+    FREE(BinaryHeap, h);
+});
@@ -0,0 +1,89 @@
+#include <base/format.h>
+#include <base/jobserver.h>
+#include <base/test.h>
+#include <base/thread_pool.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+SUITE(jobserver);
+
+CASE(jobserver_without_makeflags, {
+    TEST_ASSERT(!init__Jobserver(NULL));
+    TEST_ASSERT(!init__Jobserver("-j4"));
+    TEST_ASSERT(!init__Jobserver("-j4 --jobserver-auth=-1,-1"));
+    TEST_ASSERT(!is_active__Jobserver());
+    TEST_ASSERT_EQ(try_acquire__Jobserver(3), 3);
+
+    release__Jobserver(3);
+    close__Jobserver();
+});
+
+CASE(jobserver_pipe, {
+    int fds[2];
+
+    TEST_ASSERT_EQ(pipe(fds), 0);
+    TEST_ASSERT_EQ(write(fds[1], "++", 2), 2);
+
+    char *makeflags = format("-j3 --jobserver-auth={d},{d}", fds[0], fds[1]);
+
+    TEST_ASSERT(init__Jobserver(makeflags));
+    TEST_ASSERT(is_active__Jobserver());
+
+    // NOTE: Only 2 tokens are available, and the acquisition never blocks.
+    TEST_ASSERT_EQ(try_acquire__Jobserver(5), 2);
+    TEST_ASSERT_EQ(try_acquire__Jobserver(1), 0);
+
+    release__Jobserver(1);
+
+    TEST_ASSERT_EQ(try_acquire__Jobserver(2), 1);
+
+    release__Jobserver(2);
+
+    // The reserved threads take a token from the jobserver.
+    set_default_jobs__ThreadPool(8);
+
+    TEST_ASSERT_EQ(reserve_jobs__ThreadPool(4), 2);
+
+    release_jobs__ThreadPool(2);
+    set_default_jobs__ThreadPool(0);
+    close__Jobserver();
+
+    char tokens[3];
+
+    TEST_ASSERT_EQ(read(fds[0], tokens, sizeof(tokens)), 2);
+
+    lily_free(makeflags);
+    close(fds[0]);
+    close(fds[1]);
+});
+
+CASE(jobserver_release_at_exit, {
+    int fds[2];
+
+    TEST_ASSERT_EQ(pipe(fds), 0);
+    TEST_ASSERT_EQ(write(fds[1], "++", 2), 2);
+
+    char *makeflags = format("-j3 --jobserver-auth={d},{d}", fds[0], fds[1]);
+    pid_t pid = fork();
+
+    // NOTE: The child exits on an error without releasing its tokens.
+    if (pid == 0) {
+        init__Jobserver(makeflags);
+        try_acquire__Jobserver(2);
+        exit(1);
+    }
+
+    TEST_ASSERT(pid > 0);
+    TEST_ASSERT_EQ(waitpid(pid, NULL, 0), pid);
+
+    char tokens[3];
+
+    TEST_ASSERT_EQ(read(fds[0], tokens, sizeof(tokens)), 2);
+
+    lily_free(makeflags);
+    close(fds[0]);
+    close(fds[1]);
+});
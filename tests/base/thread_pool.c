@@ -0,0 +1,144 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2025 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/new.h>
+#include <base/test.h>
+#include <base/thread_pool.h>
+
+#include <stdatomic.h>
+
+#define THREAD_POOL_TASKS_LEN 1000
+
+SUITE(thread_pool);
+
+static void
+thread_pool_task(void *ctx, Usize index)
+{
+    atomic_int *runs = ctx;
+
+    atomic_fetch_add(&runs[index], 1);
+}
+
+CASE(thread_pool_run, {
+    atomic_int runs[THREAD_POOL_TASKS_LEN] = { 0 };
+    ThreadPool pool = NEW(ThreadPool, 4);
+
+    run__ThreadPool(&pool, THREAD_POOL_TASKS_LEN, &thread_pool_task, runs);
+
+    // NOTE: Each task must be run exactly once.
+    for (Usize i = 0; i < THREAD_POOL_TASKS_LEN; ++i) {
+        TEST_ASSERT_EQ(atomic_load(&runs[i]), 1);
+    }
+});
+
+CASE(thread_pool_default_jobs, {
+    set_default_jobs__ThreadPool(3);
+
+    ThreadPool pool = NEW(ThreadPool, 0);
+
+    TEST_ASSERT_EQ(pool.jobs, 3);
+
+    set_default_jobs__ThreadPool(0);
+
+    TEST_ASSERT(get_default_jobs__ThreadPool() >= 1);
+});
+
+#define THREAD_POOL_NESTED_JOBS 4
+#define THREAD_POOL_NESTED_DEPTH 3
+#define THREAD_POOL_NESTED_TASKS_LEN 8
+
+typedef struct ThreadPoolNestedRun
+{
+    Usize depth;
+    atomic_size_t *running;
+    atomic_size_t *max_running;
+    atomic_size_t *leaves;
+} ThreadPoolNestedRun;
+
+static void
+thread_pool_nested_task(void *ctx, Usize index)
+{
+    const ThreadPoolNestedRun *run = ctx;
+
+    if (run->depth == THREAD_POOL_NESTED_DEPTH) {
+        Usize running = atomic_fetch_add(run->running, 1) + 1;
+        Usize max_running = atomic_load(run->max_running);
+
+        while (running > max_running &&
+               !atomic_compare_exchange_weak(
+                 run->max_running, &max_running, running))
+            ;
+
+        atomic_fetch_add(run->leaves, 1);
+        atomic_fetch_sub(run->running, 1);
+
+        return;
+    }
+
+    ThreadPoolNestedRun nested_run = *run;
+    Usize jobs = reserve_jobs__ThreadPool(THREAD_POOL_NESTED_TASKS_LEN - 1);
+    ThreadPool pool = NEW(ThreadPool, jobs + 1);
+
+    ++nested_run.depth;
+
+    run__ThreadPool(&pool,
+                    THREAD_POOL_NESTED_TASKS_LEN,
+                    &thread_pool_nested_task,
+                    &nested_run);
+    release_jobs__ThreadPool(jobs);
+}
+
+CASE(thread_pool_nested_jobs, {
+    atomic_size_t running = 0;
+    atomic_size_t max_running = 0;
+    atomic_size_t leaves = 0;
+    ThreadPoolNestedRun run;
+
+    run.depth = 0;
+    run.running = &running;
+    run.max_running = &max_running;
+    run.leaves = &leaves;
+
+    set_default_jobs__ThreadPool(THREAD_POOL_NESTED_JOBS);
+
+    // NOTE: The nested runs must never use more threads than the default
+    // number of jobs.
+    for (Usize i = 0; i < 50; ++i) {
+        thread_pool_nested_task(&run, 0);
+    }
+
+    TEST_ASSERT_EQ(atomic_load(&leaves),
+                   50 * THREAD_POOL_NESTED_TASKS_LEN *
+                     THREAD_POOL_NESTED_TASKS_LEN *
+                     THREAD_POOL_NESTED_TASKS_LEN);
+    TEST_ASSERT(atomic_load(&max_running) <= THREAD_POOL_NESTED_JOBS);
+
+    // NOTE: All the reserved threads must be released.
+    Usize jobs = reserve_jobs__ThreadPool(THREAD_POOL_NESTED_JOBS);
+
+    TEST_ASSERT_EQ(jobs, THREAD_POOL_NESTED_JOBS - 1);
+
+    release_jobs__ThreadPool(jobs);
+    set_default_jobs__ThreadPool(0);
+});
@@ -0,0 +1,62 @@
+#include <base/fork.h>
+#include <base/new.h>
+#include <base/test.h>
+#include <base/vec.h>
+
+#include <cli/lilyd/config.h>
+
+#include <command/lilyd/lilyd.h>
+
+#include <poll.h>
+#include <unistd.h>
+
+#define SOCKET_PATH "./tests/command/lilyd/lilyd.sock"
+#define FILE_MAIN "./tests/command/lilyd/input/main.lily"
+#define FILE_MISSING "./tests/command/lilyd/input/missing.lily"
+
+SIMPLE(round_trip, {
+    LilydConfig config = NEW(LilydConfig, SOCKET_PATH, 1, 0);
+
+    // NOTE: Remove the socket of a previous run, so the client doesn't connect
+    // before the server is listening.
+    unlink(SOCKET_PATH);
+
+    Fork server = run__Fork();
+
+    if (server == 0) {
+        run__Lilyd(&config);
+        _exit(0);
+    }
+
+    TEST_ASSERT(server != -1);
+
+    // Wait (at most 5 seconds) until the server is listening.
+    for (Usize i = 0; i < 500 && access(SOCKET_PATH, F_OK) == -1; ++i) {
+        poll(NULL, 0, 10);
+    }
+
+    Vec *args = init__Vec(3, "lilyc", "--run-scanner", FILE_MAIN);
+    Vec *args_error = init__Vec(3, "lilyc", "--run-scanner", FILE_MISSING);
+
+    // The exit status of the compilation is sent back to the client.
+    TEST_ASSERT_EQ(send_request__Lilyd(SOCKET_PATH, args), 0);
+    TEST_ASSERT_EQ(send_request__Lilyd(SOCKET_PATH, args_error), 1);
+
+    FREE(Vec, args);
+    FREE(Vec, args_error);
+
+    // The server exits after its idle timeout, and removes its socket.
+    int status = 0;
+
+    TEST_ASSERT_EQ(waitpid(server, &status, 0), server);
+    TEST_ASSERT(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    TEST_ASSERT(access(SOCKET_PATH, F_OK) == -1);
+});
+
+int
+main()
+{
+    NEW_TEST("lilyd");
+    ADD_SIMPLE(round_trip);
+    RUN_TEST();
+}
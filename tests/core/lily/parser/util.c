@@ -72,9 +72,10 @@ run_parse_data_type(File *file, Usize *count_error, Usize *count_warning)
 
     run__LilyScanner(&scanner, false);
 
+    Vec *tokens = to_vec__LilyTokenBuffer(&scanner.tokens);
     LilyParseBlock parse_block =
-      (LilyParseBlock){ .tokens = scanner.tokens,
-                        .current = get__Vec(scanner.tokens, 0),
+      (LilyParseBlock){ .tokens = tokens,
+                        .current = get__Vec(tokens, 0),
                         .file = file,
                         .count_error = count_error,
                         .count_warning = count_warning,
@@ -82,6 +83,7 @@ run_parse_data_type(File *file, Usize *count_error, Usize *count_warning)
 
     LilyAstDataType *dt = CALL_TEST(parse_data_type, &parse_block);
 
+    FREE(Vec, tokens);
     FREE(LilyScanner, &scanner);
 
     return dt;
@@ -108,9 +110,10 @@ run_parse_expr(File *file, Usize *count_error, Usize *count_warning)
 
     run__LilyScanner(&scanner, false);
 
+    Vec *tokens = to_vec__LilyTokenBuffer(&scanner.tokens);
     LilyParseBlock parse_block =
-      (LilyParseBlock){ .tokens = scanner.tokens,
-                        .current = get__Vec(scanner.tokens, 0),
+      (LilyParseBlock){ .tokens = tokens,
+                        .current = get__Vec(tokens, 0),
                         .file = file,
                         .count_error = count_error,
                         .count_warning = count_warning,
@@ -118,6 +121,7 @@ run_parse_expr(File *file, Usize *count_error, Usize *count_warning)
 
     LilyAstExpr *expr = CALL_TEST(parse_expr, &parse_block);
 
+    FREE(Vec, tokens);
     FREE(LilyScanner, &scanner);
 
     return expr;
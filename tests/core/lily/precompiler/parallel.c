@@ -0,0 +1,33 @@
+#include "util.c"
+
+#include <base/test.h>
+#include <base/thread_pool.h>
+
+#include <string.h>
+
+SIMPLE(parallel, {
+    // NOTE: The sub packages are precompiled concurrently, but their macros
+    // must be merged in the declaration order (a, b, c, d, then the sub
+    // package of d).
+    const char *expected_macros[] = { "a", "b", "c", "d", "e" };
+
+    set_default_jobs__ThreadPool(4);
+
+    {
+        RUN_PRECOMPILER(FILE_PARALLEL);
+
+        TEST_ASSERT_EQ(self->sub_packages->len, 4);
+        TEST_ASSERT_EQ(self->public_macros->len, 5);
+
+        for (Usize i = 0; i < self->public_macros->len; ++i) {
+            TEST_ASSERT(
+              !strcmp(CAST(LilyMacro *, get__Vec(self->public_macros, i))
+                        ->name->buffer,
+                      expected_macros[i]));
+        }
+
+        FREE_PRECOMPILER();
+    }
+
+    set_default_jobs__ThreadPool(0);
+});
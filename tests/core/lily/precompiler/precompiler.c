@@ -1,6 +1,7 @@
 #include "import.c"
 #include "macro.c"
 #include "package.c"
+#include "parallel.c"
 
 #include <base/test.h>
 
@@ -11,5 +12,6 @@ main()
     ADD_SIMPLE(import);
     ADD_SIMPLE(macro);
     ADD_SIMPLE(package);
+    ADD_SIMPLE(parallel);
     RUN_TEST();
 }
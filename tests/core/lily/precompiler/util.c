@@ -12,6 +12,7 @@
 #define FILE_IMPORT "./tests/core/lily/precompiler/input/import.lily"
 #define FILE_MACRO "./tests/core/lily/precompiler/input/macro.lily"
 #define FILE_PACKAGE "./tests/core/lily/precompiler/input/package/main.lily"
+#define FILE_PARALLEL "./tests/core/lily/precompiler/input/parallel/main.lily"
 
 #define RUN_PRECOMPILER(filename)                                          \
     LilyLibrary *lib = NULL;                                               \
@@ -43,7 +44,7 @@
     run__LilyPreparser(&self->preparser, &self->preparser_info);           \
                                                                            \
     SET_ROOT_PACKAGE_NAME(self);                                           \
-    COMPILER_SET_ROOT_PACKAGE_IR(self->compiler.config, self);             \
+    COMPILER_SET_ROOT_PACKAGE_IR(self->compiler.config, self, (&program)); \
     COMPILER_SET_ROOT_PACKAGE_PROGRAM(self, (&program), lib);              \
     LOAD_ROOT_PACKAGE_RESOURCES(self, (&program));                         \
                                                                            \
@@ -0,0 +1,168 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2025 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "util.c"
+
+#include <base/test.h>
+
+#include <string.h>
+
+// NOTE: The source contains more tokens than the capacity of the ring of the
+// stream, so the scanner waits for the preparser (back-pressure), and the
+// tokens are received in several chunks.
+#define PIPELINED_FUN_COUNT 2000
+
+// Check that the pipelined preparser produces the same declarations as the
+// preparser run after the scanner, and that the release of the tokens keeps
+// the tokens of the macros.
+static bool
+check_pipelined(Usize fun_count)
+{
+    String *content = from__String("macro one = { 1 };\n");
+
+    for (Usize i = 0; i < fun_count; ++i) {
+        String *fun = format__String("fun f{zu}(x, y) = x + y end\n", i);
+
+        APPEND_AND_FREE(content, fun);
+    }
+
+    File file = (File){ .name = "pipelined.lily",
+                        .content = content->buffer,
+                        .len = content->len };
+    String *package_name = from__String("example");
+    Usize count_error = 0;
+    LilyScanner scanner = NEW(LilyScanner,
+                              NEW(Source, NEW(Cursor, file.content), &file),
+                              &count_error);
+    LilyPreparser preparser =
+      NEW(LilyPreparser, &file, &scanner.tokens, "", true);
+    LilyPreparserInfo preparser_info =
+      run_preparser(&file, &scanner, &preparser, package_name);
+    LilyScanner pipelined_scanner =
+      NEW(LilyScanner,
+          NEW(Source, NEW(Cursor, file.content), &file),
+          &count_error);
+    LilyPreparser pipelined_preparser =
+      NEW(LilyPreparser, &file, &pipelined_scanner.tokens, "", true);
+    LilyPreparserInfo pipelined_preparser_info =
+      NEW(LilyPreparserInfo, package_name);
+
+    run_pipelined__LilyPreparser(
+      &pipelined_preparser, &pipelined_preparser_info, &pipelined_scanner);
+
+    bool res = count_error == 0 &&
+               pipelined_scanner.stream->len == scanner.tokens.len &&
+               preparser_info.decls->len == fun_count &&
+               pipelined_preparser_info.decls->len == fun_count;
+
+    for (Usize i = 0; res && i < fun_count; ++i) {
+        LilyPreparserDecl *decl = get__Vec(preparser_info.decls, i);
+        LilyPreparserDecl *pipelined_decl =
+          get__Vec(pipelined_preparser_info.decls, i);
+
+        res = pipelined_decl->kind == LILY_PREPARSER_DECL_KIND_FUN &&
+              !memcmp(&pipelined_decl->location,
+                      &decl->location,
+                      sizeof(Location)) &&
+              !strcmp(pipelined_decl->fun.name->buffer,
+                      decl->fun.name->buffer) &&
+              pipelined_decl->fun.params->len == decl->fun.params->len;
+    }
+
+    if (res) {
+        LilyTokenStream *stream = pipelined_scanner.stream;
+        const LilyPreparserMacro *macro =
+          get__Vec(pipelined_preparser_info.private_macros, 0);
+        const LilyToken *macro_token = get__Vec(macro->tokens, 0);
+
+        release__LilyTokenStream(stream, macro->tokens);
+
+        res = stream->chunks->len > 1 && get__Vec(stream->chunks, 0) &&
+              !get__Vec(stream->chunks, 1) &&
+              macro_token->kind == LILY_TOKEN_KIND_LITERAL_INT_10;
+    }
+
+    FREE(LilyScanner, &scanner);
+    FREE(LilyPreparserInfo, &preparser_info);
+    FREE(LilyScanner, &pipelined_scanner);
+    FREE(LilyPreparserInfo, &pipelined_preparser_info);
+    FREE(String, package_name);
+    FREE(String, content);
+
+    return res;
+}
+
+// Check that the scanner doesn't exit when the diagnostics are buffered, and
+// that the diagnostics of the preparser are dropped when the scan has failed
+// (only the errors of the scanner are kept).
+static bool
+check_pipelined_scan_error()
+{
+    File file = (File){ .name = "pipelined_scan_error.lily",
+                        .content = "1 \"hello\n",
+                        .len = 9 };
+    Usize count_error = 0;
+    DiagnosticBuffer scanner_diagnostics = NEW(DiagnosticBuffer);
+    DiagnosticBuffer diagnostics = NEW(DiagnosticBuffer);
+    LilyScanner scanner = NEW(LilyScanner,
+                              NEW(Source, NEW(Cursor, file.content), &file),
+                              &count_error);
+
+    set_buffer__Diagnostic(&scanner_diagnostics);
+
+    bool res = run__LilyScanner(&scanner, false);
+
+    String *package_name = from__String("example");
+    LilyScanner pipelined_scanner =
+      NEW(LilyScanner,
+          NEW(Source, NEW(Cursor, file.content), &file),
+          &count_error);
+    LilyPreparser pipelined_preparser =
+      NEW(LilyPreparser, &file, &pipelined_scanner.tokens, "", true);
+    LilyPreparserInfo pipelined_preparser_info =
+      NEW(LilyPreparserInfo, package_name);
+
+    set_buffer__Diagnostic(&diagnostics);
+    run_pipelined__LilyPreparser(
+      &pipelined_preparser, &pipelined_preparser_info, &pipelined_scanner);
+    set_buffer__Diagnostic(NULL);
+
+    res = res && count_error == 0 && scanner_diagnostics.count_error > 0 &&
+          diagnostics.count_error == scanner_diagnostics.count_error &&
+          diagnostics.messages->len == scanner_diagnostics.messages->len;
+
+    FREE(DiagnosticBuffer, &scanner_diagnostics);
+    FREE(DiagnosticBuffer, &diagnostics);
+    FREE(LilyScanner, &scanner);
+    FREE(LilyScanner, &pipelined_scanner);
+    FREE(LilyPreparserInfo, &pipelined_preparser_info);
+    FREE(String, package_name);
+
+    return res;
+}
+
+SIMPLE(pipelined, {
+    TEST_ASSERT(check_pipelined(PIPELINED_FUN_COUNT));
+    TEST_ASSERT(check_pipelined_scan_error());
+});
@@ -20,6 +20,7 @@
 #include "module.c"
 #include "next.c"
 #include "package.c"
+#include "pipelined.c"
 #include "raise.c"
 #include "record.c"
 #include "record_object.c"
@@ -65,5 +66,6 @@ main()
     ADD_SIMPLE(enum);
     ADD_SIMPLE(alias);
     ADD_SIMPLE(error);
+    ADD_SIMPLE(pipelined);
     RUN_TEST();
 }
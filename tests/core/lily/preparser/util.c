@@ -59,7 +59,7 @@ run_preparser(File *file,
                               NEW(Source, NEW(Cursor, file.content), &file), \
                               &count_error);                                 \
     LilyPreparser preparser =                                                \
-      NEW(LilyPreparser, &file, scanner.tokens, "", true);                   \
+      NEW(LilyPreparser, &file, &scanner.tokens, "", true);                  \
     String *package_name = from__String("example");                          \
     LilyPreparserInfo preparser_info =                                       \
       run_preparser(&file, &scanner, &preparser, package_name);
@@ -8,7 +8,7 @@
 SIMPLE(comment_doc, {
     RUN_SCANNER(FILE_COMMENT_DOC);
 
-    LilyToken *token = get__Vec(scanner.tokens, 0);
+    LilyToken *token = get__LilyTokenBuffer(&scanner.tokens, 0);
 
     TEST_ASSERT_EQ(token->kind, LILY_TOKEN_KIND_COMMENT_DOC);
     TEST_ASSERT(!strcmp(token->comment_doc->buffer, " this is a comment doc"));
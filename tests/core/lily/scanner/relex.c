@@ -0,0 +1,114 @@
+#include "util.c"
+
+#include <base/test.h>
+
+#include <string.h>
+
+// Check that the tokens obtained after the relex of the edit are the same as
+// the tokens obtained after a complete scan of the edited file, and that the
+// tokens outside of the change are not moved. The buffer in which the scanner
+// builds its tokens must also be unset after the scan and after the relex.
+static bool
+check_relex(const char *filename,
+            LilyScannerEdit edit,
+            LilyScannerChange *change)
+{
+    char *content = read_file__File(filename);
+    File file = NEW(File, (char *)filename, content);
+    Usize count_error = 0;
+    LilyScanner scanner = run_scanner(&file, &count_error);
+    Vec *old_tokens =
+      to_vec__LilyTokenBuffer(&scanner.tokens); // Vec<LilyToken* (&)>*
+
+    *change = relex__LilyScanner(&scanner, &file, &edit);
+
+    bool is_slots_unset = !get_slots__LilyTokenBuffer();
+
+    char *expected_content = lily_malloc(file.len + 1);
+
+    memcpy(expected_content, file.content, file.len + 1);
+
+    File expected_file = (File){ .name = file.name,
+                                 .content = expected_content,
+                                 .len = file.len };
+    LilyScanner expected_scanner = run_scanner(&expected_file, &count_error);
+    bool res = is_slots_unset && count_error == 0 &&
+               scanner.tokens.len == expected_scanner.tokens.len;
+
+    for (Usize i = 0; res && i < scanner.tokens.len; ++i) {
+        LilyToken *token = get__LilyTokenBuffer(&scanner.tokens, i);
+        LilyToken *expected_token =
+          get__LilyTokenBuffer(&expected_scanner.tokens, i);
+        String *token_s = to_string__LilyToken(token);
+        String *expected_token_s = to_string__LilyToken(expected_token);
+
+        res = token->kind == expected_token->kind &&
+              !memcmp(&token->location,
+                      &expected_token->location,
+                      sizeof(Location)) &&
+              !strcmp(token_s->buffer, expected_token_s->buffer);
+
+        FREE(String, token_s);
+        FREE(String, expected_token_s);
+    }
+
+    for (Usize i = 0; res && i < scanner.tokens.len; ++i) {
+        if (i < change->start) {
+            res = get__LilyTokenBuffer(&scanner.tokens, i) ==
+                  get__Vec(old_tokens, i);
+        } else if (i >= change->new_end) {
+            res = get__LilyTokenBuffer(&scanner.tokens, i) ==
+                  get__Vec(old_tokens, i - change->new_end + change->old_end);
+        }
+    }
+
+    FREE(Vec, old_tokens);
+    FREE(File, &file);
+    FREE(LilyScanner, &scanner);
+    FREE(File, &expected_file);
+    FREE(LilyScanner, &expected_scanner);
+
+    return res;
+}
+
+SIMPLE(relex, {
+    LilyScannerChange change;
+
+    // Rename `y` to `yy` in the body of `add`.
+    TEST_ASSERT(check_relex(
+      FILE_RELEX,
+      (LilyScannerEdit){
+        .start_position = 42, .end_position = 43, .replacement = "yy" },
+      &change));
+    TEST_ASSERT(change.old_end - change.start < 5);
+
+    // Insert a new line in the body of `main`.
+    TEST_ASSERT(check_relex(
+      FILE_RELEX,
+      (LilyScannerEdit){ .start_position = 60,
+                         .end_position = 60,
+                         .replacement = "    val x := 1;\n" },
+      &change));
+    TEST_ASSERT(change.old_end - change.start <= 1);
+
+    // Change the content of a string.
+    TEST_ASSERT(check_relex(
+      FILE_RELEX,
+      (LilyScannerEdit){
+        .start_position = 74, .end_position = 79, .replacement = "world!" },
+      &change));
+
+    // Remove the second parameter of `add` (inside a delimiter).
+    TEST_ASSERT(check_relex(
+      FILE_RELEX,
+      (LilyScannerEdit){
+        .start_position = 15, .end_position = 24, .replacement = "" },
+      &change));
+
+    // Replace the whole file.
+    TEST_ASSERT(check_relex(
+      FILE_RELEX,
+      (LilyScannerEdit){
+        .start_position = 0, .end_position = 140, .replacement = "fun f = end" },
+      &change));
+});
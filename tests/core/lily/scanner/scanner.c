@@ -29,6 +29,7 @@
 #include "literal_suffix_usize.c"
 #include "operator.c"
 #include "other_comment.c"
+#include "relex.c"
 #include "separator.c"
 
 #include <base/test.h>
@@ -46,6 +47,7 @@ main()
     ADD_SIMPLE(keyword);
     ADD_SIMPLE(separator);
     ADD_SIMPLE(operator);
+    ADD_SIMPLE(relex);
     ADD_SUITE(21,
               literal,
               CALL_CASE(literal_byte),
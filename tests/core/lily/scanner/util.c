@@ -54,6 +54,7 @@
 #define FILE_LITERAL_CSTR "./tests/core/lily/scanner/input/literal_cstr.lily"
 #define FILE_SEPARATOR "./tests/core/lily/scanner/input/separator.lily"
 #define FILE_OPERATOR "./tests/core/lily/scanner/input/operator.lily"
+#define FILE_RELEX "./tests/core/lily/scanner/input/relex.lily"
 
 LilyScanner
 run_scanner(File *file, Usize *count_error)
@@ -76,12 +77,12 @@ run_scanner(File *file, Usize *count_error)
     FREE(File, &file); \
     FREE(LilyScanner, &scanner);
 
-#define GET_TOKEN(idx) CAST(LilyToken *, get__Vec(scanner.tokens, idx))
+#define GET_TOKEN(idx) get__LilyTokenBuffer(&scanner.tokens, idx)
 
 #define SCANNER_ITERATOR() Usize it = 0;
 
-#define CURRENT() CAST(LilyToken *, get__Vec(scanner.tokens, it))
-#define NEXT() CAST(LilyToken *, get__Vec(scanner.tokens, it++))
-#define PREVIOUS() CAST(LilyToken *, get__Vec(scanner.tokens, it - 1))
+#define CURRENT() get__LilyTokenBuffer(&scanner.tokens, it)
+#define NEXT() get__LilyTokenBuffer(&scanner.tokens, it++)
+#define PREVIOUS() get__LilyTokenBuffer(&scanner.tokens, it - 1)
 
 #endif // UTIL_C